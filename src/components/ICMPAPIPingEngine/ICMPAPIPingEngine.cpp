@@ -74,6 +74,8 @@ class Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngineData {
 
         int m_timeout;
         int m_interval;
+
+        Nedrysoft::RouteAnalyser::PingPayload m_payload;
 };
 
 Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::ICMPAPIPingEngine(Nedrysoft::Core::IPVersion version) :
@@ -111,6 +113,18 @@ auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::addTarget(
     return(pingTarget);
 }
 
+auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::addTarget(
+        QHostAddress hostAddress,
+        int ttl,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload ) -> Nedrysoft::RouteAnalyser::IPingTarget * {
+
+    ICMPAPIPingTarget *pingTarget = new ICMPAPIPingTarget(this, hostAddress, ttl, payload);
+
+    d->m_targetList.append(pingTarget);
+
+    return(pingTarget);
+}
+
 auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::removeTarget(
         Nedrysoft::RouteAnalyser::IPingTarget *pingTarget) -> bool {
 
@@ -161,6 +175,12 @@ auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::setTimeout(int timeout) ->
     return true;
 }
 
+auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::setPayload(
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void {
+
+    d->m_payload = payload;
+}
+
 auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::saveConfiguration() -> QJsonObject {
     return QJsonObject();
 }
@@ -180,7 +200,16 @@ auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::singleShot(
         int ttl,
         double timeout ) -> Nedrysoft::RouteAnalyser::PingResult {
 
-    QByteArray dataBuffer = QString("pingnoo ping").toLatin1();
+    return singleShot(hostAddress, ttl, timeout, d->m_payload.data(d->m_payload.size()));
+}
+
+auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::singleShot(
+        QHostAddress hostAddress,
+        int ttl,
+        double timeout,
+        const QByteArray &payload ) -> Nedrysoft::RouteAnalyser::PingResult {
+
+    QByteArray dataBuffer = payload;
     QByteArray replyBuffer;
     HANDLE icmpHandle;
     Nedrysoft::RouteAnalyser::PingResult::ResultCode resultCode =
@@ -298,7 +327,8 @@ auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine::singleShot(
         epoch,
         roundTripTime/1e9,
         nullptr,
-        -1
+        -1,
+        dataBuffer.length()
     );
 }
 
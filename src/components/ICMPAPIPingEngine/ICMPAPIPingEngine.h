@@ -85,6 +85,15 @@ namespace Nedrysoft { namespace ICMPAPIPingEngine {
              */
             auto setTimeout(int timeout) -> bool override;
 
+            /**
+             * @brief       Sets the payload carried by probes that are not sent to a target.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IPingEngine::setPayload
+             *
+             * @param[in]   payload the payload.
+             */
+            auto setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void override;
+
             /**
              * @brief       Starts ping operations for this engine instance.
              *
@@ -126,6 +135,23 @@ namespace Nedrysoft { namespace ICMPAPIPingEngine {
              */
             auto addTarget(QHostAddress hostAddress, int ttl) -> Nedrysoft::RouteAnalyser::IPingTarget * override;
 
+            /**
+             * @brief       Adds a ping target to this engine instance with a specific payload.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IPingEngine::addTarget
+             *
+             * @param[in]   hostAddress the host address of the ping target.
+             * @param[in]   ttl the time to live to use.
+             * @param[in]   payload the payload to use for probes.
+             *
+             * @returns     returns a pointer to the created ping target.
+             */
+            auto addTarget(
+                    QHostAddress hostAddress,
+                    int ttl,
+                    const Nedrysoft::RouteAnalyser::PingPayload &payload
+            ) -> Nedrysoft::RouteAnalyser::IPingTarget * override;
+
             /**
              * @brief       Transmits a single ping.
              *
@@ -142,6 +168,24 @@ namespace Nedrysoft { namespace ICMPAPIPingEngine {
                     int ttl,
                     double timeout ) -> Nedrysoft::RouteAnalyser::PingResult override;
 
+            /**
+             * @brief       Transmits a single ping carrying the given payload.
+             *
+             * @note        This is a blocking function.
+             *
+             * @param[in]   hostAddress the target host address.
+             * @param[in]   ttl time to live for this packet.
+             * @param[in]   timeout time in seconds to wait for response.
+             * @param[in]   payload the payload to send in the echo request.
+             *
+             * @returns     the result of the ping.
+             */
+            auto singleShot(
+                    QHostAddress hostAddress,
+                    int ttl,
+                    double timeout,
+                    const QByteArray &payload ) -> Nedrysoft::RouteAnalyser::PingResult;
+
             /**
              * @brief       Removes a ping target from this engine instance.
              *
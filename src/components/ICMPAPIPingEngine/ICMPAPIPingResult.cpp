@@ -31,6 +31,8 @@ Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingResult::ICMPAPIPingResult(Nedrysoft::Ro
     m_hostAddress = result.hostAddress();
     m_requestTime = result.requestTime();
     m_roundTripTime = result.roundTripTime();
+    m_hops = result.hops();
+    m_payloadSize = result.payloadSize();
 }
 
 void Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingResult::setSampleNumber(int sampleNumber) {
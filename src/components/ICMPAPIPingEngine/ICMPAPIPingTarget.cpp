@@ -60,18 +60,21 @@ class Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingTargetData {
         uint16_t m_id;
         void *m_userData;
         unsigned int m_ttl;
+        Nedrysoft::RouteAnalyser::PingPayload m_payload;
 };
 
 Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingTarget::ICMPAPIPingTarget(
         Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine *engine,
         const QHostAddress &hostAddress,
-        int ttl) :
+        int ttl,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) :
 
             d(std::make_shared<Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingTargetData>(this)) {
 
     d->m_hostAddress = hostAddress;
     d->m_engine = engine;
     d->m_ttl = ttl;
+    d->m_payload = payload;
 }
 
 auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingTarget::setHostAddress(QHostAddress hostAddress) -> void {
@@ -90,6 +93,10 @@ auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingTarget::id() -> uint16_t {
     return d->m_id;
 }
 
+auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingTarget::payload() -> Nedrysoft::RouteAnalyser::PingPayload {
+    return d->m_payload;
+}
+
 auto Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingTarget::userData() -> void * {
     return d->m_userData;
 }
@@ -25,6 +25,7 @@
 #define PINGNOO_COMPONENTS_ICMPAPIPINGENGINE_ICMPAPIPINGTARGET_H
 
 #include <IPingTarget>
+#include <PingPayload>
 
 namespace Nedrysoft { namespace ICMPAPIPingEngine {
     class ICMPAPIPingTargetData;
@@ -51,10 +52,13 @@ namespace Nedrysoft { namespace ICMPAPIPingEngine {
              * @param[in]   engine the ping engine to be associated with this target.
              * @param[in]   hostAddress the target of the ping.
              * @param[in]   ttl the TTL to be used in the ping.
+             * @param[in]   payload the payload to be carried by each ping.
              */
             ICMPAPIPingTarget(Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingEngine *engine,
                               const QHostAddress &hostAddress,
-                              int ttl = 0);
+                              int ttl = 0,
+                              const Nedrysoft::RouteAnalyser::PingPayload &payload =
+                                      Nedrysoft::RouteAnalyser::PingPayload());
 
         public:
             /**
@@ -136,7 +140,15 @@ namespace Nedrysoft { namespace ICMPAPIPingEngine {
              */
             auto id() -> uint16_t;
 
+            /**
+             * @brief       Returns the payload used for this target.
+             *
+             * @returns     the payload.
+             */
+            auto payload() -> Nedrysoft::RouteAnalyser::PingPayload;
+
             friend class ICMPAPIPingTransmitter;
+            friend class ICMPAPIPingWorker;
 
         protected:
             //! @cond
@@ -44,10 +44,13 @@ Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingWorker::ICMPAPIPingWorker(
 }
 
 void Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingWorker::doWork() {
+    auto payload = m_target->payload();
+
     Nedrysoft::ICMPAPIPingEngine::ICMPAPIPingResult pingResult = m_engine->singleShot(
         m_target->hostAddress(),
         m_target->ttl(),
-        DefaultTransmitTimeout
+        DefaultTransmitTimeout,
+        payload.data(payload.sizeForSample(m_sampleNumber))
     );
 
     pingResult.setSampleNumber(m_sampleNumber);
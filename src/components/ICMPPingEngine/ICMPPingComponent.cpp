@@ -23,11 +23,15 @@
 
 #include "ICMPPingComponent.h"
 #include "ICMPPingEngineFactory.h"
+#include "TCPPingEngineFactory.h"
+#include "UDPPingEngineFactory.h"
 
 #include <IComponentManager>
 
 ICMPPingComponent::ICMPPingComponent() :
-        m_engineFactory(nullptr) {
+        m_engineFactory(nullptr),
+        m_udpEngineFactory(nullptr),
+        m_tcpEngineFactory(nullptr) {
 
 }
 
@@ -36,6 +40,20 @@ ICMPPingComponent::~ICMPPingComponent() {
 }
 
 auto ICMPPingComponent::finaliseEvent() -> void {
+    if (m_tcpEngineFactory) {
+        Nedrysoft::ComponentSystem::removeObject(m_tcpEngineFactory);
+
+        delete m_tcpEngineFactory;
+    }
+
+    if (m_udpEngineFactory) {
+        Nedrysoft::ComponentSystem::removeObject(m_udpEngineFactory);
+
+        delete m_udpEngineFactory;
+    }
+
+    // the icmp factory owns the shared receiver, so must be destroyed after the other factories.
+
     if (m_engineFactory) {
         Nedrysoft::ComponentSystem::removeObject(m_engineFactory);
 
@@ -47,4 +65,12 @@ auto ICMPPingComponent::initialiseEvent() -> void {
     m_engineFactory = new Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory();
 
     Nedrysoft::ComponentSystem::addObject(m_engineFactory);
+
+    m_udpEngineFactory = new Nedrysoft::ICMPPingEngine::UDPPingEngineFactory();
+
+    Nedrysoft::ComponentSystem::addObject(m_udpEngineFactory);
+
+    m_tcpEngineFactory = new Nedrysoft::ICMPPingEngine::TCPPingEngineFactory();
+
+    Nedrysoft::ComponentSystem::addObject(m_tcpEngineFactory);
 }
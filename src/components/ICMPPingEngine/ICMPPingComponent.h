@@ -30,10 +30,13 @@
 
 namespace Nedrysoft { namespace ICMPPingEngine {
     class ICMPPingEngineFactory;
+    class TCPPingEngineFactory;
+    class UDPPingEngineFactory;
 }}
 
 /**
- * @brief       The ICMPPingComponent class provides a socket based ICMP ping engine for all platforms.
+ * @brief       The ICMPPingComponent class provides a socket based ICMP ping engine for all platforms, along with
+ *              UDP and TCP SYN engines which share its receiver.
  */
 class NEDRYSOFT_ICMPPINGENGINE_DLLSPEC ICMPPingComponent :
         public QObject,
@@ -80,6 +83,8 @@ class NEDRYSOFT_ICMPPINGENGINE_DLLSPEC ICMPPingComponent :
         //! @cond
 
         Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory *m_engineFactory;
+        Nedrysoft::ICMPPingEngine::UDPPingEngineFactory *m_udpEngineFactory;
+        Nedrysoft::ICMPPingEngine::TCPPingEngineFactory *m_tcpEngineFactory;
 
         //! @endcond
 };
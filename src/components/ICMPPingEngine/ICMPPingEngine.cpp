@@ -36,16 +36,47 @@
 #include <QMap>
 #include <QMutex>
 #include <QThread>
+#include <QVector>
 #include <cstdint>
 
 constexpr auto DefaultReceiveTimeout = 1000;
 constexpr auto DefaultTerminateThreadTimeout = 5000;
 constexpr auto DefaultTransmitInterval = 2500;
 
+constexpr auto MinimumIPv4MTU = 68;
+constexpr auto MinimumIPv6MTU = 1280;
+constexpr auto MaximumProbeMTU = 9000;
+constexpr auto MaximumPathMTUHops = 255;
+constexpr auto PathMTUProbeRetries = 1;
+constexpr auto PathMTURoundTripMultiplier = 4;
+constexpr auto MinimumPathMTURoundWait = 50;
+constexpr auto PathMTUIdentifier = 6667;
+constexpr auto SingleShotIdentifier = 6666;
+constexpr auto SingleShotSequence = 5555;
+constexpr auto PathMTUHopBits = 8;
+constexpr auto PathMTUHopMask = 0xFF;
+
 constexpr auto SecondsToMs(double seconds) {
     return seconds*1000;
 }
 
+/**
+ * @private
+ *
+ * @brief       The binary search state of the path MTU probe for a single hop.
+ */
+struct PathMTUProbe {
+    Nedrysoft::ICMPSocket::ICMPSocket *socket;
+    int lowerBound;
+    int upperBound;
+    int nextHopMtu;
+    int probeSize;
+    int retries;
+    qint64 roundTripTime;
+    bool responded;
+    bool waiting;
+};
+
 /**
  * @brief       Private class to store the ping engines instance data.
  */
@@ -90,17 +121,32 @@ class Nedrysoft::ICMPPingEngine::ICMPPingEngineData {
 
         int m_interval;
 
+        Nedrysoft::RouteAnalyser::PingPayload m_payload;
+
         QDateTime m_epoch;
 
         Nedrysoft::Core::IPVersion m_version;
 
+        Nedrysoft::ICMPPacket::Protocol m_protocol;
+
+        bool m_datagram;
+
         Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker *m_receiverWorker;
 };
 
-Nedrysoft::ICMPPingEngine::ICMPPingEngine::ICMPPingEngine(Nedrysoft::Core::IPVersion version) :
-        d(std::make_shared<Nedrysoft::ICMPPingEngine::ICMPPingEngineData>(this)) {
+Nedrysoft::ICMPPingEngine::ICMPPingEngine::ICMPPingEngine(
+        Nedrysoft::Core::IPVersion version,
+        Nedrysoft::ICMPPacket::Protocol protocol) :
+
+            d(std::make_shared<Nedrysoft::ICMPPingEngine::ICMPPingEngineData>(this)) {
 
     d->m_version = version;
+    d->m_protocol = protocol;
+
+    // unprivileged datagram sockets are preferred for ICMP, the kernel only delivers our own replies to them.
+
+    d->m_datagram = ( protocol == Nedrysoft::ICMPPacket::ICMP ) &&
+                    Nedrysoft::ICMPSocket::ICMPSocket::datagramSocketsAvailable();
 
     qRegisterMetaType<QElapsedTimer>("QElapsedTimer");
 }
@@ -132,6 +178,18 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::addTarget(
     return target;
 }
 
+auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::addTarget(
+        QHostAddress hostAddress,
+        int ttl,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) -> Nedrysoft::RouteAnalyser::IPingTarget * {
+
+    auto target = new Nedrysoft::ICMPPingEngine::ICMPPingTarget(this, hostAddress, ttl, payload);
+
+    d->m_targetList.append(target);
+
+    return target;
+}
+
 auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::removeTarget(Nedrysoft::RouteAnalyser::IPingTarget *target) -> bool {
     Q_UNUSED(target)
 
@@ -159,12 +217,34 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::start() -> bool {
 
     d->m_receiverWorker = Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance();
 
-    connect(d->m_receiverWorker,
-            &Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::packetReceived,
-            this,
-            &Nedrysoft::ICMPPingEngine::ICMPPingEngine::onPacketReceived,
-            Qt::DirectConnection
-    );
+    if (d->m_datagram) {
+        connect(d->m_receiverWorker,
+                &Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::packetDecoded,
+                this,
+                &Nedrysoft::ICMPPingEngine::ICMPPingEngine::onPacketDecoded,
+                Qt::DirectConnection
+        );
+    } else {
+        d->m_receiverWorker->enableRawICMP();
+
+        connect(d->m_receiverWorker,
+                &Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::packetReceived,
+                this,
+                &Nedrysoft::ICMPPingEngine::ICMPPingEngine::onPacketReceived,
+                Qt::DirectConnection
+        );
+    }
+
+    if (d->m_protocol == Nedrysoft::ICMPPacket::TCP) {
+        d->m_receiverWorker->enableTCP();
+
+        connect(d->m_receiverWorker,
+                &Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::tcpPacketReceived,
+                this,
+                &Nedrysoft::ICMPPingEngine::ICMPPingEngine::onTCPPacketReceived,
+                Qt::DirectConnection
+        );
+    }
 
     // transmitter thread
 
@@ -295,6 +375,12 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::setTimeout(int timeout) -> bool
     return true;
 }
 
+auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::setPayload(
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void {
+
+    d->m_payload = payload;
+}
+
 auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::timeoutRequests() -> void {
     QMutexLocker locker(&d->m_requestsMutex);
     QMutableMapIterator<uint32_t, Nedrysoft::ICMPPingEngine::ICMPPingItem *> i(d->m_pingRequests);
@@ -320,7 +406,10 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::timeoutRequests() -> void {
                             pingItem->transmitEpoch(),
                             pingItem->elapsedTime()/1e9,
                             pingItem->target(),
-                            -1);
+                            -1,
+                            pingItem->payloadSize());
+
+                    pingResult.setRequestTimestamp(pingItem->transmitTimestamp());
 
                     Q_EMIT result(pingResult);
                 }
@@ -355,29 +444,88 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::version() -> Nedrysoft::Core::IP
     return d->m_version;
 }
 
+auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::protocol() -> Nedrysoft::ICMPPacket::Protocol {
+    return d->m_protocol;
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::usesDatagramSockets() -> bool {
+    return d->m_datagram;
+}
+
 void Nedrysoft::ICMPPingEngine::ICMPPingEngine::onPacketReceived(
         QElapsedTimer receiveTimer,
         QByteArray receiveBuffer,
         QHostAddress receiveAddress ) {
 
-    Nedrysoft::RouteAnalyser::PingResult::ResultCode resultCode =
-        Nedrysoft::RouteAnalyser::PingResult::ResultCode::NoReply;
+    Q_UNUSED(receiveTimer)
 
     auto responsePacket = Nedrysoft::ICMPPacket::ICMPPacket::fromData(
         receiveBuffer,
         static_cast<Nedrysoft::ICMPPacket::IPVersion>(this->version())
     );
 
+    processResponse(responsePacket, receiveAddress);
+}
+
+void Nedrysoft::ICMPPingEngine::ICMPPingEngine::onTCPPacketReceived(
+        QElapsedTimer receiveTimer,
+        QByteArray receiveBuffer,
+        QHostAddress receiveAddress ) {
+
+    Q_UNUSED(receiveTimer)
+
+    auto responsePacket = Nedrysoft::ICMPPacket::ICMPPacket::fromTCPData(
+        receiveBuffer,
+        static_cast<Nedrysoft::ICMPPacket::IPVersion>(this->version())
+    );
+
+    processResponse(responsePacket, receiveAddress);
+}
+
+void Nedrysoft::ICMPPingEngine::ICMPPingEngine::onPacketDecoded(
+        QElapsedTimer receiveTimer,
+        Nedrysoft::ICMPPacket::ICMPPacket responsePacket,
+        QHostAddress receiveAddress ) {
+
+    Q_UNUSED(receiveTimer)
+
+    processResponse(responsePacket, receiveAddress);
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::processResponse(
+        Nedrysoft::ICMPPacket::ICMPPacket &responsePacket,
+        const QHostAddress &receiveAddress ) -> void {
+
+    Nedrysoft::RouteAnalyser::PingResult::ResultCode resultCode =
+        Nedrysoft::RouteAnalyser::PingResult::ResultCode::NoReply;
+
     if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::Invalid) {
         return;
     }
 
-    if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::EchoReply) {
-        resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::Ok;
+    // ids and sequences are only unique within a protocol, so responses to other probe types are ignored.
+
+    if (responsePacket.protocol() != d->m_protocol) {
+        return;
     }
 
-    if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::TimeExceeded) {
-        resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::TimeExceeded;
+    switch(responsePacket.resultCode()) {
+        case Nedrysoft::ICMPPacket::EchoReply:
+        case Nedrysoft::ICMPPacket::PortUnreachable:
+        case Nedrysoft::ICMPPacket::SynAck:
+        case Nedrysoft::ICMPPacket::Reset: {
+            resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::Ok;
+            break;
+        }
+
+        case Nedrysoft::ICMPPacket::TimeExceeded: {
+            resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::TimeExceeded;
+            break;
+        }
+
+        default: {
+            break;
+        }
     }
 
     auto pingItem = this->getRequest(Nedrysoft::Utils::fzMake32(responsePacket.id(), responsePacket.sequence()));
@@ -396,9 +544,12 @@ void Nedrysoft::ICMPPingEngine::ICMPPingEngine::onPacketReceived(
                 pingItem->transmitEpoch(),
                 elapsedTime,
                 pingItem->target(),
-                -1
+                -1,
+                pingItem->payloadSize()
             );
 
+            pingResult.setRequestTimestamp(pingItem->transmitTimestamp());
+
             pingItem->setServiced(true);
 
             pingItem->unlock();
@@ -431,39 +582,55 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::singleShot(
         int ttl,
         double timeout ) -> Nedrysoft::RouteAnalyser::PingResult {
 
-    Nedrysoft::ICMPSocket::ICMPSocket *writeSocket;
-    Nedrysoft::ICMPSocket::ICMPSocket *readSocket;
+    Nedrysoft::ICMPSocket::ICMPSocket *writeSocket = nullptr;
+    Nedrysoft::ICMPSocket::ICMPSocket *readSocket = nullptr;
+    Nedrysoft::ICMPSocket::IPVersion socketVersion;
 
     Nedrysoft::RouteAnalyser::PingResult pingResult;
 
     if (hostAddress.protocol() == QAbstractSocket::IPv4Protocol) {
-        writeSocket = Nedrysoft::ICMPSocket::ICMPSocket::createWriteSocket(ttl, Nedrysoft::ICMPSocket::V4);
+        socketVersion = Nedrysoft::ICMPSocket::V4;
     } else if (hostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
-        writeSocket = Nedrysoft::ICMPSocket::ICMPSocket::createWriteSocket(ttl, Nedrysoft::ICMPSocket::V6);
+        socketVersion = Nedrysoft::ICMPSocket::V6;
+    } else {
+        return pingResult;
     }
 
-    if (hostAddress.protocol() == QAbstractSocket::IPv4Protocol) {
-        readSocket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(Nedrysoft::ICMPSocket::V4);
-    } else if (hostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
-        readSocket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(Nedrysoft::ICMPSocket::V6);
+    if (d->m_datagram) {
+        // a datagram socket receives both the reply and any ICMP error, so it is used for reading and writing.
+
+        writeSocket = Nedrysoft::ICMPSocket::ICMPSocket::createDatagramSocket(ttl, socketVersion);
+        readSocket = writeSocket;
+    } else {
+        writeSocket = Nedrysoft::ICMPSocket::ICMPSocket::createWriteSocket(ttl, socketVersion);
+        readSocket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(socketVersion);
     }
 
-    QByteArray receiveBuffer;
+    if (!writeSocket || !readSocket) {
+        delete writeSocket;
 
-    // TODO: fix
+        if (readSocket != writeSocket) {
+            delete readSocket;
+        }
+
+        return pingResult;
+    }
 
-    int id = 6666;
-    int sequenceId = 5555 + ttl;
+    QByteArray receiveBuffer;
+
+    int id = writeSocket->isDatagram() ? writeSocket->localPort() : SingleShotIdentifier;
+    int sequenceId = SingleShotSequence + ttl;
 
     auto buffer = Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
         id,
         sequenceId,
-        52,
+        d->m_payload.data(d->m_payload.size()),
         hostAddress,
         static_cast<Nedrysoft::ICMPPacket::IPVersion>(version())
     );
 
     auto transmitEpoch = QDateTime::currentDateTime();
+    auto transmitTimestamp = Nedrysoft::RouteAnalyser::PingResult::timestamp();
 
     writeSocket->sendto(buffer, hostAddress);
 
@@ -480,59 +647,367 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::singleShot(
             return pingResult;
         }
 
-        if (readSocket->recvfrom(receiveBuffer, receiveAddress, remaining)) {
-            auto responseTime = QDateTime::currentDateTime();
-            auto roundTripTime = timer.nsecsElapsed();
+        int errorType;
+        int errorCode;
+        uint32_t errorInfo;
+        auto isError = false;
 
-            Nedrysoft::RouteAnalyser::PingResult::ResultCode resultCode;
+        if (readSocket->isDatagram()) {
+            if (!Nedrysoft::ICMPSocket::ICMPSocket::waitForReadyRead({readSocket}, remaining)) {
+                continue;
+            }
+
+            isError = readSocket->recvError(receiveBuffer, receiveAddress, errorType, errorCode, errorInfo) != -1;
 
-            if (!receiveBuffer.length()) {
+            if (!isError && ( readSocket->recvfrom(receiveBuffer, receiveAddress, 0) == -1 )) {
                 continue;
             }
+        } else if (readSocket->recvfrom(receiveBuffer, receiveAddress, remaining) == -1) {
+            continue;
+        }
+
+        auto responseTime = QDateTime::currentDateTime();
+        auto roundTripTime = timer.nsecsElapsed();
+        auto packetVersion = static_cast<Nedrysoft::ICMPPacket::IPVersion>(this->version());
+
+        Nedrysoft::RouteAnalyser::PingResult::ResultCode resultCode;
+
+        if (!receiveBuffer.length()) {
+            continue;
+        }
 
-            auto responsePacket = Nedrysoft::ICMPPacket::ICMPPacket::fromData(
+        auto responsePacket = isError ?
+            Nedrysoft::ICMPPacket::ICMPPacket::fromSocketError(
                 receiveBuffer,
-                static_cast<Nedrysoft::ICMPPacket::IPVersion>(this->version())
-            );
+                errorType,
+                errorCode,
+                errorInfo,
+                packetVersion ) :
+            readSocket->isDatagram() ?
+                Nedrysoft::ICMPPacket::ICMPPacket::fromDatagramData(receiveBuffer, packetVersion) :
+                Nedrysoft::ICMPPacket::ICMPPacket::fromData(receiveBuffer, packetVersion);
+
+        if ((responsePacket.id()!=id) || (responsePacket.sequence()!=sequenceId)) {
+            continue;
+        }
+
+        if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::Invalid) {
+            continue;
+        }
+
+        if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::EchoReply) {
+            resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::Ok;
+        }
+
+        if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::TimeExceeded) {
+            resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::TimeExceeded;
+        }
+
+        int hopsToTarget = -1;
+
+        if (responsePacket.ttl()!=-1) {
+            hopsToTarget = ttl-responsePacket.ttl();
+        }
+
+        pingResult = Nedrysoft::RouteAnalyser::PingResult(
+            0,
+            resultCode,
+            receiveAddress,
+            transmitEpoch,
+            roundTripTime/1e9,
+            nullptr,
+            hopsToTarget
+        );
+
+        pingResult.setRequestTimestamp(transmitTimestamp);
+
+        break;
+    }
+
+    if (readSocket != writeSocket) {
+        delete readSocket;
+    }
+
+    delete writeSocket;
 
-            if ((responsePacket.id()!=id) || (responsePacket.sequence()!=sequenceId)) {
+    return pingResult;
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingEngine::discoverPathMTU(
+        QHostAddress hostAddress,
+        const QList<QHostAddress> &route,
+        double timeout ) -> QList<int> {
+
+    Nedrysoft::ICMPSocket::IPVersion socketVersion;
+    int minimumMtu;
+
+    if (hostAddress.protocol() == QAbstractSocket::IPv4Protocol) {
+        socketVersion = Nedrysoft::ICMPSocket::V4;
+        minimumMtu = MinimumIPv4MTU;
+    } else if (hostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
+        socketVersion = Nedrysoft::ICMPSocket::V6;
+        minimumMtu = MinimumIPv6MTU;
+    } else {
+        return QList<int>();
+    }
+
+    auto hops = qMin(static_cast<int>(route.count()), MaximumPathMTUHops);
+
+    /**
+     * a datagram socket receives the replies and ICMP errors for its own probes, so in datagram mode each hop is
+     * read from its own socket and no separate read socket is needed.
+     */
+
+    Nedrysoft::ICMPSocket::ICMPSocket *readSocket = nullptr;
+
+    if (!d->m_datagram) {
+        readSocket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(socketVersion);
+
+        if (!readSocket) {
+            return QList<int>();
+        }
+    }
+
+    QVector<PathMTUProbe> probes;
+
+    for (auto hop=1;hop<=hops;hop++) {
+        // a hop that did not respond during route discovery is not probed, its MTU is reported as unknown.
+
+        if (route.at(hop-1).isNull()) {
+            probes.append(PathMTUProbe{nullptr, minimumMtu, minimumMtu, -1, 0, 0, -1, false, false});
+
+            continue;
+        }
+
+        auto socket = d->m_datagram ?
+            Nedrysoft::ICMPSocket::ICMPSocket::createDatagramSocket(hop, socketVersion) :
+            Nedrysoft::ICMPSocket::ICMPSocket::createWriteSocket(hop, socketVersion);
+
+        if ((!socket) || (!socket->setDontFragment(true))) {
+            delete socket;
+
+            for (auto &probe : probes) {
+                delete probe.socket;
+            }
+
+            delete readSocket;
+
+            return QList<int>();
+        }
+
+        probes.append(PathMTUProbe{socket, minimumMtu, MaximumProbeMTU, -1, 0, 0, -1, false, false});
+    }
+
+    /**
+     * each round sends a single probe to every hop that has not yet converged, the hop and round are encoded
+     * into the sequence id so that late replies from a previous round are ignored.
+     *
+     * the first probe to a hop is the minimum MTU, which every link must carry, a hop that does not answer it is
+     * not responding to us at all and is given up on rather than searched.
+     */
+
+    for (auto round=0;;round++) {
+        auto pendingProbes = 0;
+
+        QElapsedTimer timer;
+
+        timer.start();
+
+        for (auto hop=1;hop<=hops;hop++) {
+            auto &probe = probes[hop-1];
+
+            if (probe.lowerBound >= probe.upperBound) {
                 continue;
             }
 
-            if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::Invalid) {
+            if (!probe.responded) {
+                probe.probeSize = probe.lowerBound;
+            } else if (( probe.nextHopMtu > probe.lowerBound ) && ( probe.nextHopMtu <= probe.upperBound )) {
+                probe.probeSize = probe.nextHopMtu;
+            } else if (!probe.retries) {
+                probe.probeSize = ( probe.lowerBound + probe.upperBound + 1 ) / 2;
+            }
+
+            probe.nextHopMtu = -1;
+
+            auto buffer = Nedrysoft::ICMPPacket::ICMPPacket::pingPacketOfSize(
+                PathMTUIdentifier,
+                static_cast<uint16_t>(( ( round & PathMTUHopMask ) << PathMTUHopBits ) | hop),
+                probe.probeSize,
+                hostAddress,
+                static_cast<Nedrysoft::ICMPPacket::IPVersion>(socketVersion)
+            );
+
+            if (probe.socket->sendto(buffer, hostAddress) != buffer.length()) {
+                // the local interface mtu was exceeded, so this size can never reach the hop.
+
+                probe.upperBound = probe.probeSize - 1;
+                probe.retries = 0;
+
                 continue;
             }
 
-            if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::EchoReply) {
-                resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::Ok;
+            probe.waiting = true;
+
+            pendingProbes++;
+        }
+
+        if (!pendingProbes) {
+            break;
+        }
+
+        QList<Nedrysoft::ICMPSocket::ICMPSocket *> datagramSockets;
+
+        if (d->m_datagram) {
+            for (auto &probe : probes) {
+                if (probe.socket) {
+                    datagramSockets.append(probe.socket);
+                }
             }
+        }
+
+        // once every pending hop has answered, the round only waits a few of its round trips for the replies.
 
-            if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::TimeExceeded) {
-                resultCode = Nedrysoft::RouteAnalyser::PingResult::ResultCode::TimeExceeded;
+        auto roundWait = static_cast<qint64>(SecondsToMs(timeout));
+        auto slowestRoundTrip = static_cast<qint64>(0);
+
+        for (auto &probe : probes) {
+            if (!probe.waiting) {
+                continue;
             }
 
-            int hopsToTarget = -1;
+            if (probe.roundTripTime < 0) {
+                slowestRoundTrip = -1;
 
-            if (responsePacket.ttl()!=-1) {
-                hopsToTarget = ttl-responsePacket.ttl();
+                break;
             }
 
-            pingResult = Nedrysoft::RouteAnalyser::PingResult(
-                0,
-                resultCode,
-                receiveAddress,
-                transmitEpoch,
-                roundTripTime/1e9,
-                nullptr,
-                hopsToTarget
+            slowestRoundTrip = qMax(slowestRoundTrip, probe.roundTripTime);
+        }
+
+        if (slowestRoundTrip >= 0) {
+            roundWait = qMin(
+                roundWait,
+                qMax(static_cast<qint64>(MinimumPathMTURoundWait), slowestRoundTrip * PathMTURoundTripMultiplier)
             );
+        }
 
-            break;
+        while (( pendingProbes ) && ( timer.elapsed() < roundWait )) {
+            QByteArray receiveBuffer;
+            QHostAddress receiveAddress;
+            Nedrysoft::ICMPSocket::ICMPSocket *receiveSocket = nullptr;
+            int errorType;
+            int errorCode;
+            uint32_t errorInfo;
+            auto isError = false;
+
+            auto remaining = static_cast<int>(roundWait - timer.elapsed());
+            auto packetVersion = static_cast<Nedrysoft::ICMPPacket::IPVersion>(socketVersion);
+
+            if (d->m_datagram) {
+                receiveSocket = Nedrysoft::ICMPSocket::ICMPSocket::waitForReadyRead(datagramSockets, remaining);
+
+                if (!receiveSocket) {
+                    continue;
+                }
+
+                // the next hop mtu of a fragmentation needed error is passed in the error info.
+
+                isError = receiveSocket->recvError(
+                    receiveBuffer,
+                    receiveAddress,
+                    errorType,
+                    errorCode,
+                    errorInfo ) != -1;
+
+                if (!isError && ( receiveSocket->recvfrom(receiveBuffer, receiveAddress, 0) <= 0 )) {
+                    continue;
+                }
+            } else if (readSocket->recvfrom(receiveBuffer, receiveAddress, remaining) <= 0) {
+                continue;
+            }
+
+            auto responsePacket = isError ?
+                Nedrysoft::ICMPPacket::ICMPPacket::fromSocketError(
+                    receiveBuffer,
+                    errorType,
+                    errorCode,
+                    errorInfo,
+                    packetVersion ) :
+                d->m_datagram ?
+                    Nedrysoft::ICMPPacket::ICMPPacket::fromDatagramData(receiveBuffer, packetVersion) :
+                    Nedrysoft::ICMPPacket::ICMPPacket::fromData(receiveBuffer, packetVersion);
+
+            // the operating system replaces the identifier of a datagram probe with the local port of the socket.
+
+            int expectedId = receiveSocket ? receiveSocket->localPort() : PathMTUIdentifier;
+
+            if (( responsePacket.resultCode() == Nedrysoft::ICMPPacket::Invalid ) ||
+                ( responsePacket.id() != expectedId )) {
+                continue;
+            }
+
+            auto hop = responsePacket.sequence() & PathMTUHopMask;
+
+            if (( hop < 1 ) || ( hop > hops ) ||
+                ( ( responsePacket.sequence() >> PathMTUHopBits ) != ( round & PathMTUHopMask ) )) {
+                continue;
+            }
+
+            auto &probe = probes[hop-1];
+
+            if (( !probe.waiting ) || ( receiveSocket && ( receiveSocket != probe.socket ) )) {
+                continue;
+            }
+
+            if (responsePacket.resultCode() == Nedrysoft::ICMPPacket::FragmentationNeeded) {
+                auto nextHopMtu = responsePacket.mtu();
+
+                if (( nextHopMtu > probe.lowerBound ) && ( nextHopMtu < probe.probeSize )) {
+                    probe.upperBound = nextHopMtu;
+                    probe.nextHopMtu = nextHopMtu;
+                } else {
+                    probe.upperBound = probe.probeSize - 1;
+                }
+            } else {
+                probe.lowerBound = probe.probeSize;
+                probe.responded = true;
+            }
+
+            probe.roundTripTime = qMax(probe.roundTripTime, timer.elapsed());
+            probe.retries = 0;
+            probe.waiting = false;
+
+            pendingProbes--;
+        }
+
+        // a probe that was not answered is retried once before we assume it was silently dropped for being too large.
+
+        for (auto &probe : probes) {
+            if (!probe.waiting) {
+                continue;
+            }
+
+            probe.waiting = false;
+
+            if (probe.retries < PathMTUProbeRetries) {
+                probe.retries++;
+            } else {
+                probe.upperBound = probe.probeSize - 1;
+                probe.retries = 0;
+            }
         }
     }
 
-    delete writeSocket;
+    QList<int> pathMtu;
+
+    for (auto &probe : probes) {
+        pathMtu.append(probe.responded ? probe.lowerBound : -1);
+
+        delete probe.socket;
+    }
+
     delete readSocket;
 
-    return pingResult;
-}
\ No newline at end of file
+    return pathMtu;
+}
@@ -24,6 +24,8 @@
 #ifndef PINGNOO_COMPONENTS_ICMPPINGENGINE_ICMPPINGENGINE_H
 #define PINGNOO_COMPONENTS_ICMPPINGENGINE_ICMPPINGENGINE_H
 
+#include "ICMPPacket/ICMPPacket.h"
+
 #include <IInterface>
 #include <IPingEngine>
 #include <IPingEngineFactory>
@@ -50,8 +52,18 @@ namespace Nedrysoft { namespace ICMPPingEngine {
         public:
             /**
              * @brief       Constructs an ICMPPingEngine for the given IP version.
+             *
+             * @details     The engine probes using ICMP echo requests by default, UDP or TCP SYN probes can be used
+             *              instead for paths that filter ICMP echo.  All probe protocols share the ICMP receiver, as
+             *              intermediate hops always respond with ICMP time exceeded messages.
+             *
+             * @param[in]   version the IP version of the engine.
+             * @param[in]   protocol the protocol used for probes.
              */
-            explicit ICMPPingEngine(Nedrysoft::Core::IPVersion version);
+            explicit ICMPPingEngine(
+                Nedrysoft::Core::IPVersion version,
+                Nedrysoft::ICMPPacket::Protocol protocol = Nedrysoft::ICMPPacket::ICMP
+            );
 
             /**
              * @brief       Destroys the ICMPPingEngine.
@@ -89,6 +101,15 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             auto setTimeout(int timeout) -> bool override;
 
+            /**
+             * @brief       Sets the payload carried by probes that are not sent to a target.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IPingEngine::setPayload
+             *
+             * @param[in]   payload the payload.
+             */
+            auto setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void override;
+
             /**
              * @brief       Starts ping operations for this engine instance.
              *
@@ -130,10 +151,28 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             auto addTarget(QHostAddress hostAddress, int ttl) -> Nedrysoft::RouteAnalyser::IPingTarget * override;
 
+            /**
+             * @brief       Adds a ping target to this engine instance with a specific payload.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IPingEngine::addTarget
+             *
+             * @param[in]   hostAddress the host address of the ping target.
+             * @param[in]   ttl the time to live to use.
+             * @param[in]   payload the payload to use for probes.
+             *
+             * @returns     returns a pointer to the created ping target.
+             */
+            auto addTarget(
+                QHostAddress hostAddress,
+                int ttl,
+                const Nedrysoft::RouteAnalyser::PingPayload &payload
+            ) -> Nedrysoft::RouteAnalyser::IPingTarget * override;
+
             /**
              * @brief       Transmits a single ping.
              *
-             * @note        This is a blocking function.
+             * @note        This is a blocking function, single shot pings always use ICMP regardless of the probe
+             *              protocol of the engine.
              *
              * @param[in]   hostAddress the target host address.
              * @param[in]   ttl time to live for this packet.
@@ -147,6 +186,31 @@ namespace Nedrysoft { namespace ICMPPingEngine {
                 double timeout
             ) -> Nedrysoft::RouteAnalyser::PingResult override;
 
+            /**
+             * @brief       Discovers the path MTU to each hop on the route to a host.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IPingEngine::discoverPathMTU
+             *
+             * @details     When the engine uses unprivileged datagram sockets, each hop is probed from its own
+             *              socket and the MTU is taken from the ICMP error queue of that socket.
+             *
+             *              A hop is first probed at the minimum MTU and is given up on if it does not answer, once
+             *              every hop being probed has answered, a round only waits for a few of its round trips.
+             *
+             * @note        This is a blocking function.
+             *
+             * @param[in]   hostAddress the target host address.
+             * @param[in]   route the address of each hop to the target, null for hops that did not respond.
+             * @param[in]   timeout the longest time in seconds to wait for a round of probes.
+             *
+             * @returns     the path MTU for each hop, -1 if the MTU could not be determined for that hop.
+             */
+            auto discoverPathMTU(
+                QHostAddress hostAddress,
+                const QList<QHostAddress> &route,
+                double timeout
+            ) -> QList<int> override;
+
             /**
              * @brief       Removes a ping target from this engine instance.
              *
@@ -209,6 +273,47 @@ namespace Nedrysoft { namespace ICMPPingEngine {
                 QHostAddress receiveAddress
             );
 
+            /**
+             * @brief       Called when a TCP segment is available for processing.
+             *
+             * @details     Only connected for TCP engines, a SYN-ACK or RST from the target completes a probe.
+             *
+             * @param[in]   receiveTimer a timer started when the segment was received.
+             * @param[in]   receiveBuffer the actual segment data.
+             * @param[in]   receiveAddress the IP address that the segment came from.
+             */
+            Q_SLOT void onTCPPacketReceived(
+                QElapsedTimer receiveTimer,
+                QByteArray receiveBuffer,
+                QHostAddress receiveAddress
+            );
+
+            /**
+             * @brief       Called when a response has been read and decoded from a datagram socket.
+             *
+             * @details     Only connected for engines using unprivileged datagram sockets.
+             *
+             * @param[in]   receiveTimer a timer started when the response was received.
+             * @param[in]   responsePacket the decoded response.
+             * @param[in]   receiveAddress the IP address that the response came from.
+             */
+            Q_SLOT void onPacketDecoded(
+                QElapsedTimer receiveTimer,
+                Nedrysoft::ICMPPacket::ICMPPacket responsePacket,
+                QHostAddress receiveAddress
+            );
+
+            /**
+             * @brief       Matches a decoded response against the in flight requests and signals the result.
+             *
+             * @param[in]   responsePacket the decoded response.
+             * @param[in]   receiveAddress the IP address that the response came from.
+             */
+            auto processResponse(
+                Nedrysoft::ICMPPacket::ICMPPacket &responsePacket,
+                const QHostAddress &receiveAddress
+            ) -> void;
+
         protected:
             /**
              * @brief       Checks for any timed out requests and removes and signals that a timeout occurred.
@@ -272,6 +377,24 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             auto version() -> Nedrysoft::Core::IPVersion;
 
+            /**
+             * @brief       Returns the protocol used for probes by the engine.
+             *
+             * @returns     the probe protocol.
+             */
+            auto protocol() -> Nedrysoft::ICMPPacket::Protocol;
+
+            /**
+             * @brief       Returns whether the engine probes using unprivileged ICMP datagram sockets.
+             *
+             * @details     Under linux, ICMP engines use datagram sockets when permitted by net.ipv4.ping_group_range,
+             *              the kernel delivers replies and errors only to the socket that sent the probe.  Otherwise
+             *              raw sockets are used and all ICMP packets are read by the shared receiver.
+             *
+             * @returns     true if datagram sockets are used; otherwise false.
+             */
+            auto usesDatagramSockets() -> bool;
+
             /**
              * @brief       Stops all ping transmissions for this instance.
              *
@@ -286,6 +409,7 @@ namespace Nedrysoft { namespace ICMPPingEngine {
             friend class ICMPPingTransmitter;
             friend class ICMPPingTimeout;
             friend class ICMPPingReceiverWorker;
+            friend class ICMPPingTarget;
 
         protected:
             //! @cond
@@ -25,6 +25,8 @@
 #include "ICMPPingEngine.h"
 #include "ICMPPingReceiverWorker.h"
 
+constexpr auto AlternativeProtocolPriority = 0.5;
+
 /**
  * @brief       Private class to store the ping engines instance data.
  */
@@ -36,7 +38,8 @@ class Nedrysoft::ICMPPingEngine::ICMPPingEngineFactoryData {
          * @param[in]   parent the ICMPPingEngineFactory instance that this data belongs to.
          */
         ICMPPingEngineFactoryData(Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory *parent) :
-                m_factory(parent) {
+                m_factory(parent),
+                m_protocol(Nedrysoft::ICMPPacket::ICMP) {
 
         }
 
@@ -46,6 +49,8 @@ class Nedrysoft::ICMPPingEngine::ICMPPingEngineFactoryData {
         Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory *m_factory;
 
         QList<Nedrysoft::ICMPPingEngine::ICMPPingEngine *> m_engineList;
+
+        Nedrysoft::ICMPPacket::Protocol m_protocol;
 };
 
 Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::ICMPPingEngineFactory() :
@@ -53,13 +58,23 @@ Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::ICMPPingEngineFactory() :
 
 }
 
+Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::ICMPPingEngineFactory(Nedrysoft::ICMPPacket::Protocol protocol) :
+        d(std::make_shared<Nedrysoft::ICMPPingEngine::ICMPPingEngineFactoryData>(this)) {
+
+    d->m_protocol = protocol;
+}
+
 Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::~ICMPPingEngineFactory() {
     qDeleteAll(d->m_engineList);
 
-    auto receiverWorker = Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance(true);
+    // the receiver is shared by engines of all protocols, the component destroys the ICMP factory last.
 
-    if (receiverWorker) {
-        delete receiverWorker;
+    if (d->m_protocol == Nedrysoft::ICMPPacket::ICMP) {
+        auto receiverWorker = Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance(true);
+
+        if (receiverWorker) {
+            delete receiverWorker;
+        }
     }
 
     d.reset();
@@ -68,7 +83,7 @@ Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::~ICMPPingEngineFactory() {
 auto Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::createEngine(
         Nedrysoft::Core::IPVersion version ) -> Nedrysoft::RouteAnalyser::IPingEngine * {
 
-    auto engineInstance = new Nedrysoft::ICMPPingEngine::ICMPPingEngine(version);
+    auto engineInstance = new Nedrysoft::ICMPPingEngine::ICMPPingEngine(version, d->m_protocol);
 
     d->m_engineList.append(engineInstance);
 
@@ -86,11 +101,33 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::loadConfiguration(QJsonOb
 }
 
 auto Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::description() -> QString {
-    return tr("ICMP Socket");
+    switch(d->m_protocol) {
+        case Nedrysoft::ICMPPacket::UDP: {
+            return tr("UDP Socket");
+        }
+
+        case Nedrysoft::ICMPPacket::TCP: {
+            return tr("TCP SYN Socket");
+        }
+
+        default: {
+            return tr("ICMP Socket");
+        }
+    }
 }
 
 auto Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::priority() -> double {
+    // UDP and TCP probes are alternatives for paths which filter ICMP echo, they are never the default engine.
+
+    if (d->m_protocol != Nedrysoft::ICMPPacket::ICMP) {
+        return available() ? AlternativeProtocolPriority : 0;
+    }
+
 #if defined(Q_OS_LINUX)
+    if (Nedrysoft::ICMPSocket::ICMPSocket::datagramSocketsAvailable()) {
+        return 1;
+    }
+
     auto socket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(Nedrysoft::ICMPSocket::V4);
 
     if (socket) {
@@ -105,7 +142,26 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::priority() -> double {
 }
 
 auto Nedrysoft::ICMPPingEngine::ICMPPingEngineFactory::available() -> bool {
+    if (d->m_protocol == Nedrysoft::ICMPPacket::TCP) {
 #if defined(Q_OS_LINUX)
+        auto tcpSocket = Nedrysoft::ICMPSocket::ICMPSocket::createTCPReadSocket(Nedrysoft::ICMPSocket::V4);
+
+        if (!tcpSocket) {
+            return false;
+        }
+
+        delete tcpSocket;
+#else
+        return false;
+#endif
+    }
+
+#if defined(Q_OS_LINUX)
+    if (( d->m_protocol == Nedrysoft::ICMPPacket::ICMP ) &&
+        Nedrysoft::ICMPSocket::ICMPSocket::datagramSocketsAvailable()) {
+        return true;
+    }
+
     auto socket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(Nedrysoft::ICMPSocket::V4);
 
     if (socket) {
@@ -24,6 +24,7 @@
 #ifndef PINGNOO_COMPONENTS_ICMPPINGENGINE_ICMPPINGENGINEFACTORY_H
 #define PINGNOO_COMPONENTS_ICMPPINGENGINE_ICMPPINGENGINEFACTORY_H
 
+#include "ICMPPacket/ICMPPacket.h"
 #include "ICMPSocket/ICMPSocket.h"
 
 #include <IInterface>
@@ -58,6 +59,17 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             ~ICMPPingEngineFactory();
 
+        protected:
+            /**
+             * @brief       Constructs an ICMPPingEngineFactory which creates engines using the given probe protocol.
+             *
+             * @note        Used by the UDP and TCP factories, which must be distinct classes as factories are
+             *              identified by class name.
+             *
+             * @param[in]   protocol the probe protocol of the created engines.
+             */
+            explicit ICMPPingEngineFactory(Nedrysoft::ICMPPacket::Protocol protocol);
+
         public:
             /**
              * @brief       Creates a ICMPPingEngine instance.
@@ -88,8 +100,10 @@ namespace Nedrysoft { namespace ICMPPingEngine {
             /**
              * @brief      Returns whether the ping engine is available for use.
              *
-             * @note       Under linux, the ICMP ping engine may not be available if raw sockets cannot
-             *             be created, so this allows us to disable a ping engine from being used.
+             * @note       Under linux, the ICMP ping engine may not be available if neither unprivileged datagram
+             *             sockets nor raw sockets can be created, so this allows us to disable a ping engine from
+             *             being used.  UDP probes require the raw ICMP socket to read responses and TCP SYN probes
+             *             require raw TCP sockets which are only available under linux.
              *
              * @returns    true if available; otherwise false.
              */
@@ -23,14 +23,18 @@
 
 #include "ICMPPingItem.h"
 
+#include <PingResult>
+
 #include <QTimer>
 
 Nedrysoft::ICMPPingEngine::ICMPPingItem::ICMPPingItem() :
+        m_transmitTimestamp(0),
         m_id(0),
         m_sequenceId(0),
         m_serviced(false),
         m_target(nullptr),
-        m_sampleNumber(0) {
+        m_sampleNumber(0),
+        m_payloadSize(-1) {
 
 }
 
@@ -53,6 +57,7 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingItem::sequenceId() -> uint16_t {
 auto Nedrysoft::ICMPPingEngine::ICMPPingItem::startTimer() -> void {
     m_elapsedTimer.restart();
     m_transmitEpoch = QDateTime::currentDateTime();
+    m_transmitTimestamp = Nedrysoft::RouteAnalyser::PingResult::timestamp();
 }
 
 auto Nedrysoft::ICMPPingEngine::ICMPPingItem::stopTimer() -> void {
@@ -87,6 +92,10 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingItem::transmitEpoch() -> QDateTime {
     return m_transmitEpoch;
 }
 
+auto Nedrysoft::ICMPPingEngine::ICMPPingItem::transmitTimestamp() -> qint64 {
+    return m_transmitTimestamp;
+}
+
 auto Nedrysoft::ICMPPingEngine::ICMPPingItem::setSampleNumber(unsigned long sampleNumber) -> void {
     m_sampleNumber = sampleNumber;
 }
@@ -95,6 +104,14 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingItem::sampleNumber() -> unsigned long {
     return m_sampleNumber;
 }
 
+auto Nedrysoft::ICMPPingEngine::ICMPPingItem::setPayloadSize(int payloadSize) -> void {
+    m_payloadSize = payloadSize;
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingItem::payloadSize() -> int {
+    return m_payloadSize;
+}
+
 auto Nedrysoft::ICMPPingEngine::ICMPPingItem::lock() -> bool {
     return m_mutex.tryLock();
 }
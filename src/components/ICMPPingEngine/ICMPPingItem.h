@@ -115,6 +115,20 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             auto sampleNumber() -> unsigned long;
 
+            /**
+             * @brief       Sets the payload size carried by this request.
+             *
+             * @param[in]   payloadSize the payload size in bytes.
+             */
+            auto setPayloadSize(int payloadSize) -> void;
+
+            /**
+             * @brief       Returns the payload size carried by this request.
+             *
+             * @returns     the payload size in bytes.
+             */
+            auto payloadSize() -> int;
+
             /**
               * @brief       Sets the target associated with this request.
               *
@@ -163,6 +177,15 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             auto transmitEpoch() -> QDateTime;
 
+            /**
+             * @brief       Returns the monotonic timestamp at which the request was transmitted.
+             *
+             * @see         Nedrysoft::RouteAnalyser::PingResult::timestamp
+             *
+             * @returns     the time in nanoseconds since the unix epoch.
+             */
+            auto transmitTimestamp() -> qint64;
+
             /**
              * @brief       Locks the item for exclusive access.
              *
@@ -180,6 +203,7 @@ namespace Nedrysoft { namespace ICMPPingEngine {
 
             QElapsedTimer m_elapsedTimer;
             QDateTime m_transmitEpoch;
+            qint64 m_transmitTimestamp;
 
             int64_t m_elapsedTime;
 
@@ -192,6 +216,8 @@ namespace Nedrysoft { namespace ICMPPingEngine {
 
             unsigned long m_sampleNumber;
 
+            int m_payloadSize;
+
             QMutex m_mutex;
 
             //! @endcond
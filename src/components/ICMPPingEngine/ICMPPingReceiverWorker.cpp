@@ -34,14 +34,19 @@
 #include <QtEndian>
 #include <spdlog/spdlog.h>
 
-constexpr auto DefaultReplyTimeout = 1000;
+// the socket set is only updated between waits, so the timeout bounds the delay before a new socket is read.
+
+constexpr auto DefaultReplyTimeout = 100;
 
 Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::ICMPPingReceiverWorker() :
         m_engine(nullptr),
         m_receiveWorker(nullptr),
         m_receiverThread(nullptr),
         m_socket(nullptr),
-        m_isRunning(false) {
+        m_tcpSocket(nullptr),
+        m_isRunning(false),
+        m_rawEnabled(false),
+        m_tcpEnabled(false) {
 
 }
 
@@ -62,6 +67,14 @@ Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::~ICMPPingReceiverWorker() {
     if (m_socket) {
         delete m_socket;
     }
+
+    if (m_tcpSocket) {
+        delete m_tcpSocket;
+    }
+
+    qDeleteAll(m_datagramSockets);
+    qDeleteAll(m_pendingSockets);
+    qDeleteAll(m_releasedSockets);
 }
 
 auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance(bool returnNull) -> Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker * {
@@ -92,26 +105,176 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance(bool returnN
 
 void Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::doWork() {
     QByteArray receiveBuffer;
-
-    m_socket =  Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(
-        static_cast<Nedrysoft::ICMPSocket::IPVersion>(Nedrysoft::ICMPSocket::V4)
-    );
-
     QHostAddress receiveAddress;
 
     m_isRunning = true;
 
     while (QThread::currentThread()->isRunning() && (m_isRunning)) {
         QElapsedTimer receiveTimer;
+        QList<Nedrysoft::ICMPSocket::ICMPSocket *> sockets;
+
+        updateDatagramSockets();
+
+        if (m_rawEnabled && !m_socket) {
+            QMutexLocker locker(&m_filterMutex);
+
+            m_socket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(Nedrysoft::ICMPSocket::V4);
+
+            updateFilter();
+        }
+
+        if (m_tcpEnabled && !m_tcpSocket) {
+            m_tcpSocket = Nedrysoft::ICMPSocket::ICMPSocket::createTCPReadSocket(Nedrysoft::ICMPSocket::V4);
+        }
+
+        if (m_socket) {
+            sockets.append(m_socket);
+        }
+
+        if (m_tcpSocket) {
+            sockets.append(m_tcpSocket);
+        }
+
+        sockets.append(m_datagramSockets);
+
+        if (sockets.isEmpty()) {
+            QThread::msleep(DefaultReplyTimeout);
+
+            continue;
+        }
+
+        auto readySocket = Nedrysoft::ICMPSocket::ICMPSocket::waitForReadyRead(sockets, DefaultReplyTimeout);
+
+        if (!readySocket) {
+            continue;
+        }
+
+        if (readySocket->isDatagram()) {
+            readDatagramSocket(readySocket);
 
-        auto result = m_socket->recvfrom(receiveBuffer, receiveAddress, DefaultReplyTimeout);
+            continue;
+        }
+
+        auto result = readySocket->recvfrom(receiveBuffer, receiveAddress, 0);
 
         receiveTimer.restart();
 
         if (result!=-1) {
-            SPDLOG_TRACE("ICMP Packet Received");
+            if (readySocket == m_tcpSocket) {
+                SPDLOG_TRACE("TCP Packet Received");
+
+                Q_EMIT tcpPacketReceived(receiveTimer, receiveBuffer, receiveAddress);
+            } else {
+                SPDLOG_TRACE("ICMP Packet Received");
 
-            Q_EMIT packetReceived(receiveTimer, receiveBuffer, receiveAddress);
+                Q_EMIT packetReceived(receiveTimer, receiveBuffer, receiveAddress);
+            }
         }
     }
-}
\ No newline at end of file
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::readDatagramSocket(
+        Nedrysoft::ICMPSocket::ICMPSocket *socket) -> void {
+
+    QByteArray receiveBuffer;
+    QHostAddress receiveAddress;
+    QElapsedTimer receiveTimer;
+    int type;
+    int code;
+    uint32_t info;
+
+    auto version = static_cast<Nedrysoft::ICMPPacket::IPVersion>(socket->version());
+
+    // errors (time exceeded, fragmentation needed) are queued separately from replies, so both are drained.
+
+    while (socket->recvError(receiveBuffer, receiveAddress, type, code, info) != -1) {
+        receiveTimer.restart();
+
+        SPDLOG_TRACE("ICMP Error Received");
+
+        Q_EMIT packetDecoded(
+            receiveTimer,
+            Nedrysoft::ICMPPacket::ICMPPacket::fromSocketError(receiveBuffer, type, code, info, version),
+            receiveAddress
+        );
+    }
+
+    while (socket->recvfrom(receiveBuffer, receiveAddress, 0) != -1) {
+        receiveTimer.restart();
+
+        SPDLOG_TRACE("ICMP Packet Received");
+
+        Q_EMIT packetDecoded(
+            receiveTimer,
+            Nedrysoft::ICMPPacket::ICMPPacket::fromDatagramData(receiveBuffer, version),
+            receiveAddress
+        );
+    }
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::updateDatagramSockets() -> void {
+    QMutexLocker locker(&m_socketsMutex);
+
+    m_datagramSockets.append(m_pendingSockets);
+
+    m_pendingSockets.clear();
+
+    for (auto socket : m_releasedSockets) {
+        m_datagramSockets.removeAll(socket);
+
+        delete socket;
+    }
+
+    m_releasedSockets.clear();
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::addSocket(Nedrysoft::ICMPSocket::ICMPSocket *socket) -> void {
+    QMutexLocker locker(&m_socketsMutex);
+
+    m_pendingSockets.append(socket);
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::releaseSocket(
+        Nedrysoft::ICMPSocket::ICMPSocket *socket) -> void {
+
+    QMutexLocker locker(&m_socketsMutex);
+
+    if (m_pendingSockets.removeAll(socket)) {
+        delete socket;
+    } else {
+        m_releasedSockets.append(socket);
+    }
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::registerIdentifiers(uint16_t first, uint16_t last) -> void {
+    QMutexLocker locker(&m_filterMutex);
+
+    m_identifierRanges.append(qMakePair(first, last));
+
+    updateFilter();
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::unregisterIdentifiers(uint16_t first, uint16_t last) -> void {
+    QMutexLocker locker(&m_filterMutex);
+
+    if (m_identifierRanges.removeOne(qMakePair(first, last))) {
+        updateFilter();
+    }
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::updateFilter() -> void {
+    // the filter is attached from the calling thread, the kernel swaps the program atomically so this is safe
+    // while the receive thread is waiting on the socket.
+
+    if (m_socket) {
+        m_socket->setIdentifierFilter(m_identifierRanges);
+    }
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::enableRawICMP() -> void {
+    m_rawEnabled = true;
+}
+
+auto Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::enableTCP() -> void {
+    m_tcpEnabled = true;
+}
@@ -24,11 +24,17 @@
 #ifndef PINGNOO_COMPONENTS_ICMPPINGENGINE_ICMPPINGRECEIVERWORKER_H
 #define PINGNOO_COMPONENTS_ICMPPINGENGINE_ICMPPINGRECEIVERWORKER_H
 
+#include "ICMPPacket/ICMPPacket.h"
+
 #include <QObject>
 #include <QByteArray>
 #include <QElapsedTimer>
 #include <QHostAddress>
+#include <QList>
+#include <QMutex>
+#include <QPair>
 #include <QThread>
+#include <atomic>
 
 namespace Nedrysoft { namespace ICMPSocket {
     class ICMPSocket;
@@ -86,6 +92,96 @@ namespace Nedrysoft { namespace ICMPPingEngine {
                 QHostAddress receiveAddress
             );
 
+            /**
+             * @brief       This signal is emitted when a TCP segment has been received.
+             *
+             * @note        TCP segments are only read once a TCP probe engine has called enableTCP().
+             *
+             * @param[in]   receiveTimer a timer started from when the segment was received.
+             * @param[in]   receiveBuffer the segment data.
+             * @param[in]   receiveAddress the address the segment was received from.
+             */
+            Q_SIGNAL void tcpPacketReceived(
+                QElapsedTimer receiveTimer,
+                QByteArray receiveBuffer,
+                QHostAddress receiveAddress
+            );
+
+            /**
+             * @brief       This signal is emitted when a response has been read from a registered datagram socket.
+             *
+             * @details     Datagram sockets deliver replies and errors in different forms, so they are decoded by
+             *              the receiver rather than by each engine.
+             *
+             * @param[in]   receiveTimer a timer started from when the response was received.
+             * @param[in]   packet the decoded response.
+             * @param[in]   receiveAddress the address the response was received from.
+             */
+            Q_SIGNAL void packetDecoded(
+                QElapsedTimer receiveTimer,
+                Nedrysoft::ICMPPacket::ICMPPacket packet,
+                QHostAddress receiveAddress
+            );
+
+            /**
+             * @brief       Requests that the receiver reads all incoming ICMP packets from a shared raw socket.
+             *
+             * @details     The raw socket requires elevated privileges under linux and receives every ICMP packet
+             *              on the host, so it is only opened for engines which cannot use datagram sockets.
+             *
+             * @note        This function is called from the engine thread while the receive thread is running.
+             */
+            auto enableRawICMP() -> void;
+
+            /**
+             * @brief       Adds a datagram socket to the set of sockets read by the receiver.
+             *
+             * @param[in]   socket the datagram socket, the receiver reads from it until it is released.
+             */
+            auto addSocket(Nedrysoft::ICMPSocket::ICMPSocket *socket) -> void;
+
+            /**
+             * @brief       Removes a datagram socket from the receiver and deletes it.
+             *
+             * @note        The socket may be in use by the receive thread, so ownership passes to the receiver which
+             *              deletes the socket once it is no longer being read.
+             *
+             * @param[in]   socket the datagram socket.
+             */
+            auto releaseSocket(Nedrysoft::ICMPSocket::ICMPSocket *socket) -> void;
+
+            /**
+             * @brief       Registers a range of probe identifiers which the shared raw socket should accept.
+             *
+             * @details     The shared raw socket has a kernel filter attached which drops any ICMP packet that is
+             *              not a response to a registered identifier, the filter is regenerated immediately so
+             *              that responses to the first probe sent with the identifiers are not lost.
+             *
+             * @note        Ranges are reference counted, each call must be matched with unregisterIdentifiers().
+             *
+             * @param[in]   first the first identifier in the range.
+             * @param[in]   last the last identifier in the range.
+             */
+            auto registerIdentifiers(uint16_t first, uint16_t last) -> void;
+
+            /**
+             * @brief       Unregisters a range of probe identifiers previously registered with registerIdentifiers().
+             *
+             * @param[in]   first the first identifier in the range.
+             * @param[in]   last the last identifier in the range.
+             */
+            auto unregisterIdentifiers(uint16_t first, uint16_t last) -> void;
+
+            /**
+             * @brief       Requests that the receiver also reads incoming TCP segments.
+             *
+             * @details     Replies to TCP SYN probes arrive as TCP segments rather than ICMP messages, reading
+             *              all incoming TCP traffic has a cost, so the raw TCP socket is only opened on request.
+             *
+             * @note        This function is called from the engine thread while the receive thread is running.
+             */
+            auto enableTCP() -> void;
+
             friend class ICMPPingEngine;
             friend class ICMPPingEngineFactory;
 
@@ -95,6 +191,25 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             auto doWork() -> void;
 
+            /**
+             * @brief       Reads all pending errors and replies from a datagram socket.
+             *
+             * @param[in]   socket the datagram socket.
+             */
+            auto readDatagramSocket(Nedrysoft::ICMPSocket::ICMPSocket *socket) -> void;
+
+            /**
+             * @brief       Attaches a filter for the registered identifiers to the shared raw socket.
+             *
+             * @note        Must be called with m_filterMutex locked.
+             */
+            auto updateFilter() -> void;
+
+            /**
+             * @brief       Applies pending socket additions and releases to the set of datagram sockets.
+             */
+            auto updateDatagramSockets() -> void;
+
         private:
             //! @cond
 
@@ -102,8 +217,19 @@ namespace Nedrysoft { namespace ICMPPingEngine {
             Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker *m_receiveWorker;
             QThread *m_receiverThread;
             Nedrysoft::ICMPSocket::ICMPSocket *m_socket;
+            Nedrysoft::ICMPSocket::ICMPSocket *m_tcpSocket;
+
+            QList<Nedrysoft::ICMPSocket::ICMPSocket *> m_datagramSockets;
+            QList<Nedrysoft::ICMPSocket::ICMPSocket *> m_pendingSockets;
+            QList<Nedrysoft::ICMPSocket::ICMPSocket *> m_releasedSockets;
+            QMutex m_socketsMutex;
+
+            QList<QPair<uint16_t, uint16_t> > m_identifierRanges;
+            QMutex m_filterMutex;
 
             bool m_isRunning;
+            std::atomic<bool> m_rawEnabled;
+            std::atomic<bool> m_tcpEnabled;
 
             //! @endcond
     };
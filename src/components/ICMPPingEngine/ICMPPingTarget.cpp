@@ -23,6 +23,7 @@
 
 #include "ICMPPingTarget.h"
 #include "ICMPPingEngine.h"
+#include "ICMPPingReceiverWorker.h"
 #include "ICMPSocket/ICMPSocket.h"
 
 #include <QHostAddress>
@@ -44,6 +45,8 @@ class Nedrysoft::ICMPPingEngine::ICMPPingTargetData {
                 m_socket(nullptr),
                 m_userData(nullptr),
                 m_ttl(0),
+                m_filterRegistered(false),
+                m_filterIdentifier(0),
                 m_id(Nedrysoft::Core::ICore::getInstance()->random(1.0, UINT16_MAX-1)) {
 
         }
@@ -59,23 +62,39 @@ class Nedrysoft::ICMPPingEngine::ICMPPingTargetData {
         uint16_t m_id;
         void *m_userData;
         int m_ttl;
+        bool m_filterRegistered;
+        uint16_t m_filterIdentifier;
+        Nedrysoft::RouteAnalyser::PingPayload m_payload;
+        QHostAddress m_sourceAddress;
 };
 
 Nedrysoft::ICMPPingEngine::ICMPPingTarget::ICMPPingTarget(
         Nedrysoft::ICMPPingEngine::ICMPPingEngine *engine,
         QHostAddress hostAddress,
-        int ttl) :
+        int ttl,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) :
 
             d(std::make_shared<Nedrysoft::ICMPPingEngine::ICMPPingTargetData>(this)) {
 
     d->m_hostAddress = std::move(hostAddress);
     d->m_engine = engine;
     d->m_ttl = ttl;
+    d->m_payload = payload;
 }
 
 Nedrysoft::ICMPPingEngine::ICMPPingTarget::~ICMPPingTarget() {
     if (d->m_socket) {
-        delete d->m_socket;
+        auto receiverWorker = Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance(true);
+
+        if (d->m_filterRegistered && receiverWorker) {
+            receiverWorker->unregisterIdentifiers(d->m_filterIdentifier, d->m_filterIdentifier);
+        }
+
+        if (d->m_socket->isDatagram() && receiverWorker) {
+            receiverWorker->releaseSocket(d->m_socket);
+        } else {
+            delete d->m_socket;
+        }
     }
 
     d.reset();
@@ -95,24 +114,80 @@ auto Nedrysoft::ICMPPingEngine::ICMPPingTarget::engine() -> Nedrysoft::RouteAnal
 
 auto Nedrysoft::ICMPPingEngine::ICMPPingTarget::socket() -> Nedrysoft::ICMPSocket::ICMPSocket * {
     if (d->m_socket==nullptr) {
+        Nedrysoft::ICMPSocket::IPVersion version;
+
         if (d->m_hostAddress.protocol() == QAbstractSocket::IPv4Protocol) {
-            d->m_socket = Nedrysoft::ICMPSocket::ICMPSocket::createWriteSocket(
-                    d->m_ttl,
-                    Nedrysoft::ICMPSocket::V4 );
+            version = Nedrysoft::ICMPSocket::V4;
         } else if (d->m_hostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
-            d->m_socket = Nedrysoft::ICMPSocket::ICMPSocket::createWriteSocket(
-                    d->m_ttl,
-                    Nedrysoft::ICMPSocket::V6);
+            version = Nedrysoft::ICMPSocket::V6;
+        } else {
+            return nullptr;
+        }
+
+        switch(d->m_engine->protocol()) {
+            case Nedrysoft::ICMPPacket::UDP: {
+                d->m_socket = Nedrysoft::ICMPSocket::ICMPSocket::createUDPWriteSocket(d->m_ttl, version);
+                break;
+            }
+
+            case Nedrysoft::ICMPPacket::TCP: {
+                d->m_socket = Nedrysoft::ICMPSocket::ICMPSocket::createTCPWriteSocket(d->m_ttl, version);
+                break;
+            }
+
+            default: {
+                if (d->m_engine->usesDatagramSockets()) {
+                    d->m_socket = Nedrysoft::ICMPSocket::ICMPSocket::createDatagramSocket(d->m_ttl, version);
+
+                    if (d->m_socket) {
+                        Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance()->addSocket(d->m_socket);
+                    }
+                } else {
+                    d->m_socket = Nedrysoft::ICMPSocket::ICMPSocket::createWriteSocket(d->m_ttl, version);
+                }
+
+                break;
+            }
+        }
+
+        // responses to probes sent from raw sockets arrive on the shared raw socket, which only accepts responses
+        // quoting a registered identifier; for UDP probes the identifier is the source port of the socket.
+
+        if (d->m_socket && !d->m_socket->isDatagram() && (version == Nedrysoft::ICMPSocket::V4)) {
+            if (d->m_engine->protocol() == Nedrysoft::ICMPPacket::UDP) {
+                d->m_filterIdentifier = d->m_socket->localPort();
+            } else {
+                d->m_filterIdentifier = d->m_id;
+            }
+
+            Nedrysoft::ICMPPingEngine::ICMPPingReceiverWorker::getInstance()->registerIdentifiers(
+                d->m_filterIdentifier,
+                d->m_filterIdentifier
+            );
+
+            d->m_filterRegistered = true;
         }
     }
 
     return d->m_socket;
 }
 
+auto Nedrysoft::ICMPPingEngine::ICMPPingTarget::sourceAddress() -> QHostAddress {
+    if (d->m_sourceAddress.isNull()) {
+        d->m_sourceAddress = Nedrysoft::ICMPSocket::ICMPSocket::localAddress(d->m_hostAddress);
+    }
+
+    return d->m_sourceAddress;
+}
+
 auto Nedrysoft::ICMPPingEngine::ICMPPingTarget::id() -> uint16_t {
     return d->m_id;
 }
 
+auto Nedrysoft::ICMPPingEngine::ICMPPingTarget::payload() -> Nedrysoft::RouteAnalyser::PingPayload {
+    return d->m_payload;
+}
+
 auto Nedrysoft::ICMPPingEngine::ICMPPingTarget::ttl() -> uint16_t {
     return d->m_ttl;
 }
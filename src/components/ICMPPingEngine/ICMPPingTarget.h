@@ -25,6 +25,7 @@
 #define PINGNOO_COMPONENTS_ICMPPINGENGINE_ICMPPINGTARGET_H
 
 #include <IPingTarget>
+#include <PingPayload>
 
 #if defined(Q_OS_WIN)
 #include <WS2tcpip.h>
@@ -61,8 +62,14 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              * @param[in]   engine the ping engine to be associated with this target.
              * @param[in]   hostAddress the target of the ping.
              * @param[in]   ttl the TTL to be used in the ping.
+             * @param[in]   payload the payload to be carried by each ping.
              */
-            ICMPPingTarget(Nedrysoft::ICMPPingEngine::ICMPPingEngine *engine, QHostAddress hostAddress, int ttl = 0);
+            ICMPPingTarget(
+                Nedrysoft::ICMPPingEngine::ICMPPingEngine *engine,
+                QHostAddress hostAddress,
+                int ttl = 0,
+                const Nedrysoft::RouteAnalyser::PingPayload &payload = Nedrysoft::RouteAnalyser::PingPayload()
+            );
 
             /**
              * @brief       Destroys the ICMPPingTarget.
@@ -156,6 +163,23 @@ namespace Nedrysoft { namespace ICMPPingEngine {
              */
             auto id() -> uint16_t;
 
+            /**
+             * @brief       Returns the payload used for this target.
+             *
+             * @returns     the payload.
+             */
+            auto payload() -> Nedrysoft::RouteAnalyser::PingPayload;
+
+            /**
+             * @brief       Returns the local address used to reach the target.
+             *
+             * @details     The address is required to calculate the checksum of TCP SYN probes, it is determined
+             *              on first use and then cached.
+             *
+             * @returns     the local address.
+             */
+            auto sourceAddress() -> QHostAddress;
+
             friend class ICMPPingTransmitter;
 
         protected:
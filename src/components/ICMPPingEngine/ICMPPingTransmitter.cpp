@@ -35,6 +35,9 @@
 #include <spdlog/spdlog.h>
 
 constexpr auto DefaultTransmitInterval = 10000;
+constexpr auto UDPBasePort = 33434;
+constexpr auto UDPPortRange = 1024;
+constexpr auto TCPProbePort = 443;
 
 //! @cond
 uint16_t Nedrysoft::ICMPPingEngine::ICMPPingTransmitter::m_sequenceId = 1;
@@ -71,28 +74,77 @@ void Nedrysoft::ICMPPingEngine::ICMPPingTransmitter::doWork() {
 
         for (auto target : m_targets) {
             auto socket = target->socket();
-
-            auto pingItem = new Nedrysoft::ICMPPingEngine::ICMPPingItem();
+            auto payload = target->payload();
+            auto payloadSize = payload.sizeForSample(sampleNumber);
+            auto probeId = target->id();
+            uint16_t destinationPort = 0;
+            QByteArray buffer;
+
+            if (!socket) {
+                continue;
+            }
 
             m_sequenceMutex.lock();
             uint16_t currentSequenceId = m_sequenceId++;
             m_sequenceMutex.unlock();
 
+            switch(m_engine->protocol()) {
+                case Nedrysoft::ICMPPacket::UDP: {
+                    // the ICMP response quotes the ports of the datagram, the source port identifies the target
+                    // and the destination port (in the traceroute port range) identifies the sequence.
+
+                    probeId = socket->localPort();
+                    currentSequenceId = UDPBasePort + ( currentSequenceId % UDPPortRange );
+                    destinationPort = currentSequenceId;
+
+                    buffer = payload.data(payloadSize);
+
+                    break;
+                }
+
+                case Nedrysoft::ICMPPacket::TCP: {
+                    payloadSize = 0;
+
+                    buffer = Nedrysoft::ICMPPacket::ICMPPacket::tcpSynPacket(
+                            probeId,
+                            currentSequenceId,
+                            TCPProbePort,
+                            target->sourceAddress(),
+                            target->hostAddress(),
+                            static_cast<Nedrysoft::ICMPPacket::IPVersion>(m_engine->version()) );
+
+                    break;
+                }
+
+                default: {
+                    // the kernel replaces the echo id of datagram sockets with the identifier of the socket.
+
+                    if (socket->isDatagram()) {
+                        probeId = socket->localPort();
+                    }
+
+                    buffer = Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
+                            probeId,
+                            currentSequenceId,
+                            payload.data(payloadSize),
+                            target->hostAddress(),
+                            static_cast<Nedrysoft::ICMPPacket::IPVersion>(m_engine->version()) );
+
+                    break;
+                }
+            }
+
+            auto pingItem = new Nedrysoft::ICMPPingEngine::ICMPPingItem();
+
             pingItem->setTarget(target);
-            pingItem->setId(target->id());
+            pingItem->setId(probeId);
             pingItem->setSequenceId(currentSequenceId);
             pingItem->setSampleNumber(sampleNumber);
+            pingItem->setPayloadSize(payloadSize);
 
             m_engine->addRequest(pingItem);
 
-            auto buffer = Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
-                    target->id(),
-                    currentSequenceId,
-                    52,
-                    target->hostAddress(),
-                    static_cast<Nedrysoft::ICMPPacket::IPVersion>(m_engine->version()) );
-
-            auto result = socket->sendto(buffer, target->hostAddress());
+            auto result = socket->sendto(buffer, target->hostAddress(), destinationPort);
 
             pingItem->startTimer();
 
@@ -38,7 +38,8 @@ constexpr auto MaximumValue = 0.06;
 Nedrysoft::JitterPlot::JitterBackgroundLayer::JitterBackgroundLayer(QCustomPlot *customPlot) :
         QCPItemRect(customPlot),
         m_targetJitter(0.03),
-        m_maximumJitter(0.06) {
+        m_maximumJitter(0.06),
+        m_roundedMask(RoundedRectangleRadius) {
 
 }
 
@@ -49,6 +50,8 @@ auto Nedrysoft::JitterPlot::JitterBackgroundLayer::draw(QCPPainter *painter) ->
     if (m_bufferedImage.size()!=rect.size()) {
         m_bufferedImage = QPixmap(rect.size());
 
+        m_bufferedImage.fill(Qt::transparent);
+
         rect.translate(-rect.left(), -rect.top());
 
         QPainter bufferPainter(&m_bufferedImage);
@@ -61,19 +64,15 @@ auto Nedrysoft::JitterPlot::JitterBackgroundLayer::draw(QCPPainter *painter) ->
                          ( m_targetJitter / m_maximumJitter ));
 
         bufferPainter.drawLine(QPoint(rect.left(), targetY), QPoint(rect.right(), targetY));
-    }
-
-    painter->save();
 
-    QPainterPath clippingPath;
+        bufferPainter.end();
 
-    clippingPath.addRoundedRect(parentPlot()->axisRect()->rect(), RoundedRectangleRadius, RoundedRectangleRadius);
+        // the corners are rounded once when the background is rendered rather than clipping every draw.
 
-    painter->setClipPath(clippingPath);
+        m_roundedMask.apply(m_bufferedImage);
+    }
 
     painter->drawPixmap(topLeft, m_bufferedImage);
-
-    painter->restore();
 }
 
 auto Nedrysoft::JitterPlot::JitterBackgroundLayer::setRange(double targetJitter, double maximumJitter) -> void {
@@ -26,6 +26,8 @@
 
 #include "QCustomPlot/qcustomplot.h"
 
+#include <RoundedMask>
+
 namespace Nedrysoft { namespace JitterPlot {
     /**
      * @brief       The GraphLatencyLayer renders the background with the latency colours.
@@ -64,6 +66,7 @@ namespace Nedrysoft { namespace JitterPlot {
             double m_targetJitter;
             double m_maximumJitter;
             QPixmap m_bufferedImage;
+            Nedrysoft::RouteAnalyser::RoundedMask m_roundedMask;
 
             //! @endcond
     };
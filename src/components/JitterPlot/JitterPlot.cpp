@@ -34,7 +34,6 @@ constexpr auto DefaultGraphHeight = 150;
 
 Nedrysoft::JitterPlot::JitterPlot::JitterPlot(const QMargins &margins) :
         m_customPlot(0),
-        m_previousValue(-1),
         m_margins(margins) {
 
 }
@@ -124,26 +123,28 @@ auto Nedrysoft::JitterPlot::JitterPlot::widget() -> QWidget * {
 
 auto Nedrysoft::JitterPlot::JitterPlot::update(double time, double value) -> void {
     if (m_customPlot) {
-        if (m_previousValue!=-1) {
-            m_customPlot->graph(0)->addData(time, std::abs(value - m_previousValue));
-        }
+        // the jitter is calculated the same way as the jitter column, the results are in the order they arrived.
 
-        m_previousValue = value;
+        m_linkQuality.addReply(value);
 
-        if (m_customPlot->isVisible()) {
-            if (!m_customPlot->visibleRegion().isEmpty()) {
-                m_customPlot->replot(QCustomPlot::rpQueuedReplot);
-            }
+        if (m_linkQuality.jitter() >= 0) {
+            m_customPlot->graph(0)->addData(time, m_linkQuality.jitter());
         }
     }
 }
 
 auto Nedrysoft::JitterPlot::JitterPlot::updateRange(double min, double max) -> void {
     m_customPlot->xAxis->setRange(min, max);
-    m_customPlot->replot(QCustomPlot::rpQueuedReplot);
 }
 
 auto Nedrysoft::JitterPlot::JitterPlot::setRange(double targetJitter, double maximumJitter) -> void {
     m_backgroundLayer->setRange(targetJitter, maximumJitter);
-    m_customPlot->replot(QCustomPlot::rpQueuedReplot);
-}
\ No newline at end of file
+}
+
+auto Nedrysoft::JitterPlot::JitterPlot::clear() -> void {
+    m_linkQuality = Nedrysoft::RouteAnalyser::LinkQuality();
+
+    if (m_customPlot) {
+        m_customPlot->graph(0)->data()->clear();
+    }
+}
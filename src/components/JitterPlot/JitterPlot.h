@@ -25,6 +25,7 @@
 #define NEDRYSOFT_JITTERPLOT_JITTERPLOT_H
 
 #include <IPlot>
+#include <LinkQuality>
 
 #include "QCustomPlot/qcustomplot.h"
 
@@ -87,11 +88,18 @@ namespace Nedrysoft { namespace JitterPlot {
              */
             auto setRange(double target, double max) -> void override;
 
+            /**
+             * @brief       Removes every result from the plot.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IPlot::clear
+             */
+            auto clear() -> void override;
+
         private:
             //! @cond
 
             QCustomPlot *m_customPlot;
-            double m_previousValue;
+            Nedrysoft::RouteAnalyser::LinkQuality m_linkQuality;
             Nedrysoft::JitterPlot::JitterBackgroundLayer *m_backgroundLayer;
             QMargins m_margins;
 
@@ -57,10 +57,19 @@ auto Nedrysoft::PingCommandPingEngine::PingCommandPingEngine::addTarget(
         QHostAddress hostAddress,
         int ttl ) -> Nedrysoft::RouteAnalyser::IPingTarget * {
 
+    return addTarget(hostAddress, ttl, Nedrysoft::RouteAnalyser::PingPayload());
+}
+
+auto Nedrysoft::PingCommandPingEngine::PingCommandPingEngine::addTarget(
+        QHostAddress hostAddress,
+        int ttl,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload ) -> Nedrysoft::RouteAnalyser::IPingTarget * {
+
     auto newTarget = new Nedrysoft::PingCommandPingEngine::PingCommandPingTarget(
         this,
         hostAddress,
-        ttl
+        ttl,
+        payload
     );
 
     m_pingTargets.append(newTarget);
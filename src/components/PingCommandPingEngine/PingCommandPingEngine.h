@@ -125,6 +125,26 @@ namespace Nedrysoft { namespace PingCommandPingEngine {
              */
             auto addTarget(QHostAddress hostAddress, int ttl) -> Nedrysoft::RouteAnalyser::IPingTarget * override;
 
+            /**
+             * @brief       Adds a ping target to this engine instance with a specific payload.
+             *
+             * @note        The ping command is unable to generate random payloads, random payloads are sent using
+             *              the default fill of the ping command.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IPingEngine::addTarget
+             *
+             * @param[in]   hostAddress the host address of the ping target.
+             * @param[in]   ttl the time to live to use.
+             * @param[in]   payload the payload to use for probes.
+             *
+             * @returns     returns a pointer to the created ping target.
+             */
+            auto addTarget(
+                QHostAddress hostAddress,
+                int ttl,
+                const Nedrysoft::RouteAnalyser::PingPayload &payload
+            ) -> Nedrysoft::RouteAnalyser::IPingTarget * override;
+
             /**
              * @brief       Removes a ping target from this engine instance.
              *
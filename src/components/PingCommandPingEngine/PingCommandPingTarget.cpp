@@ -41,36 +41,51 @@ constexpr auto ReplyTimeout = 3;
 constexpr auto NanosecondsInMillisecond = 1.0e6;
 constexpr auto PacketLostRegularExpression = R"(100% packet loss)";
 constexpr auto TtlExceededRegularExpression = R"(From\ (?<ip>[\d\.]*)\ .*exceeded)";
+constexpr auto MaximumPatternLength = 16;
 
 Nedrysoft::PingCommandPingEngine::PingCommandPingTarget::PingCommandPingTarget(
         Nedrysoft::PingCommandPingEngine::PingCommandPingEngine *engine,
         QHostAddress hostAddress,
-        int ttl) :
+        int ttl,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) :
             m_userdata(nullptr),
             m_quitThread(false),
             m_engine(engine),
             m_ttl(ttl),
-            m_hostAddress(hostAddress) {
+            m_hostAddress(hostAddress),
+            m_payload(payload) {
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
     m_workerThread = QThread::create([=]() {
 #else
     m_workerThread = new std::thread([=]() {
 #endif
-        auto pingArguments = QStringList() <<
-                "-W" << QString("%1").arg(ReplyTimeout) <<
-                "-D" <<
-                "-c" << "1" <<
-                "-t" << QString("%1").arg(ttl) <<
-                m_hostAddress.toString();
+        auto patternArguments = QStringList();
+
+        if (m_payload.pattern() != Nedrysoft::RouteAnalyser::PingPayload::Pattern::Random) {
+            // the ping command repeats the pattern to fill the payload, so only the first bytes are required.
+
+            patternArguments << "-p" << QString::fromLatin1(m_payload.data(MaximumPatternLength).toHex());
+        }
 
         int sampleNumber = 0;
 
         while(!m_quitThread) {
+            auto payloadSize = m_payload.sizeForSample(sampleNumber);
+
+            auto pingArguments = QStringList() <<
+                    "-W" << QString("%1").arg(ReplyTimeout) <<
+                    "-D" <<
+                    "-c" << "1" <<
+                    "-t" << QString("%1").arg(ttl) <<
+                    "-s" << QString("%1").arg(payloadSize) <<
+                    patternArguments <<
+                    m_hostAddress.toString();
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
-            QThread *pingThread = QThread::create([sampleNumber, pingArguments, engine, pingThread, this]() {
+            QThread *pingThread = QThread::create([sampleNumber, payloadSize, pingArguments, engine, pingThread, this]() {
 #else
-            std::thread *pingThread = new std::thread([sampleNumber, pingArguments, engine, pingThread, this]() {
+            std::thread *pingThread = new std::thread([sampleNumber, payloadSize, pingArguments, engine, pingThread, this]() {
 #endif
                 QProcess pingProcess;
                 qint64 started, finished;
@@ -105,7 +120,9 @@ Nedrysoft::PingCommandPingEngine::PingCommandPingTarget::PingCommandPingTarget(
                         m_hostAddress,
                         epoch,
                         roundTripTime,
-                        this
+                        this,
+                        -1,
+                        payloadSize
                     );
 
                     engine->emitResult(pingResult);
@@ -120,7 +137,9 @@ Nedrysoft::PingCommandPingEngine::PingCommandPingTarget::PingCommandPingTarget(
                             QHostAddress(ttlExceededMatch.captured("ip")),
                             epoch,
                             roundTripTime,
-                            this
+                            this,
+                            -1,
+                            payloadSize
                         );
 
                         engine->emitResult(pingResult);
@@ -131,7 +150,9 @@ Nedrysoft::PingCommandPingEngine::PingCommandPingTarget::PingCommandPingTarget(
                             QHostAddress(packetLostMatch.captured("ip")),
                             epoch,
                             roundTripTime,
-                            this
+                            this,
+                            -1,
+                            payloadSize
                         );
 
                         engine->emitResult(pingResult);
@@ -25,6 +25,7 @@
 #define PINGNOO_COMPONENTS_PINGCOMMANDPINGENGINE_PINGCOMMANDPINGTARGET_H
 
 #include <IPingTarget>
+#include <PingPayload>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
 #include <QThread>
@@ -55,11 +56,13 @@ namespace Nedrysoft { namespace PingCommandPingEngine {
              * @param[in]   engine the ping engine to be associated with this target.
              * @param[in]   hostAddress the target of the ping.
              * @param[in]   ttl the TTL to be used in the ping.
+             * @param[in]   payload the payload to be carried by each ping.
              */
             PingCommandPingTarget(
                 Nedrysoft::PingCommandPingEngine::PingCommandPingEngine *engine,
                 QHostAddress hostAddress,
-                int ttl = 0
+                int ttl = 0,
+                const Nedrysoft::RouteAnalyser::PingPayload &payload = Nedrysoft::RouteAnalyser::PingPayload()
             );
 
             /**
@@ -150,6 +153,7 @@ namespace Nedrysoft { namespace PingCommandPingEngine {
             PingCommandPingEngine *m_engine;
             int m_ttl;
             QHostAddress m_hostAddress;
+            Nedrysoft::RouteAnalyser::PingPayload m_payload;
 
             //! @endcond
     };
@@ -26,22 +26,47 @@
 constexpr auto RoundedRectangleRadius = 10;
 
 Nedrysoft::RouteAnalyser::BarChart::BarChart(QCPAxis *keyAxis, QCPAxis *valueAxis) :
-        QCPBars(keyAxis, valueAxis) {
+        QCPBars(keyAxis, valueAxis),
+        m_roundedMask(RoundedRectangleRadius) {
 
 }
 
 void Nedrysoft::RouteAnalyser::BarChart::draw(QCPPainter *painter) {
     auto rect = parentPlot()->axisRect()->rect();
-    QPainterPath clippingPath;
 
     rect.adjust(0,1,0,0);
 
-    clippingPath.addRoundedRect(rect, RoundedRectangleRadius, RoundedRectangleRadius);
-
-    painter->save();
-    painter->setClipPath(clippingPath);
+    // the bars are clipped to the axis rectangle by QCustomPlot, only the bars that reach into the corners need
+    // to have the corners covered.
 
     QCPBars::draw(painter);
 
-    painter->restore();
+    if (!keyAxis()) {
+        return;
+    }
+
+    auto halfWidth = width() / 2;
+    Qt::Edges edges;
+
+    if (hasBars(keyAxis()->pixelToCoord(rect.left()) - halfWidth,
+                keyAxis()->pixelToCoord(rect.left() + RoundedRectangleRadius) + halfWidth)) {
+
+        edges |= Qt::LeftEdge;
+    }
+
+    if (hasBars(keyAxis()->pixelToCoord(rect.right() - RoundedRectangleRadius) - halfWidth,
+                keyAxis()->pixelToCoord(rect.right()) + halfWidth)) {
+
+        edges |= Qt::RightEdge;
+    }
+
+    if (edges) {
+        m_roundedMask.drawCorners(painter, rect, parentPlot()->palette().color(QPalette::Base), edges);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::BarChart::hasBars(double lower, double upper) const -> bool {
+    auto dataIterator = data()->findBegin(lower, false);
+
+    return ( dataIterator != data()->constEnd() ) && ( dataIterator->key <= upper );
 }
\ No newline at end of file
@@ -31,9 +31,14 @@
 
 #pragma warning(pop)
 
+#include "RoundedMask.h"
+
 namespace Nedrysoft { namespace RouteAnalyser {
     /**
-     * @brief       The BarChart class is a subclass of QCPBars which clips the chart to a rounded rectangle.
+     * @brief       The BarChart class is a subclass of QCPBars which keeps the chart within a rounded rectangle.
+     *
+     * @details     Rather than clipping to a rounded path, the corners are covered with pre-rendered corner pieces
+     *              when a bar reaches into them.
      */
     class BarChart :
             public QCPBars {
@@ -56,6 +61,23 @@ namespace Nedrysoft { namespace RouteAnalyser {
              * @param[in]   painter the QPainter to draw in.
              */
             virtual void draw(QCPPainter *painter);
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       Returns whether any bar overlaps a key range.
+             *
+             * @param[in]   lower the lower key of the range.
+             * @param[in]   upper the upper key of the range.
+             *
+             * @returns     true if a bar overlaps the range; otherwise false.
+             */
+            auto hasBars(double lower, double upper) const -> bool;
+
+            Nedrysoft::RouteAnalyser::RoundedMask m_roundedMask;
+
+            //! @endcond
     };
 }}
 
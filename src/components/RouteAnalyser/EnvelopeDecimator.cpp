@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EnvelopeDecimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr auto PointsPerColumn = 4;
+
+Nedrysoft::RouteAnalyser::EnvelopeDecimator::EnvelopeDecimator() :
+        m_columnWidth(0) {
+
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::setColumnWidth(double width) -> void {
+    width = std::max(width, 0.0);
+
+    if (width == m_columnWidth) {
+        return;
+    }
+
+    m_columnWidth = width;
+
+    clear();
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::columnWidth() const -> double {
+    return m_columnWidth;
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::append(double time, double value) -> double {
+    auto start = columnStart(time);
+    auto point = Point {time, value};
+
+    if (m_columns.empty() || (start > m_columns.back().start)) {
+        m_columns.push_back(Column {start, point, point, point, point});
+
+        return start;
+    }
+
+    auto column = m_columns.end() - 1;
+
+    if (start != column->start) {
+        column = std::lower_bound(
+            m_columns.begin(),
+            m_columns.end(),
+            start,
+            [](const Column &entry, double value) {
+                return entry.start < value;
+            }
+        );
+
+        if (column->start != start) {
+            m_columns.insert(column, Column {start, point, point, point, point});
+
+            return start;
+        }
+    }
+
+    // a sample at the same time as an existing point replaces it, an interval rollup is appended again at the
+    // same time as it grows.
+
+    if (time <= column->first.time) {
+        column->first = point;
+    }
+
+    if (time >= column->last.time) {
+        column->last = point;
+    }
+
+    if ((value < column->minimum.value) || ((time == column->minimum.time) && (value <= column->minimum.value))) {
+        column->minimum = point;
+    }
+
+    if ((value > column->maximum.value) || ((time == column->maximum.time) && (value >= column->maximum.value))) {
+        column->maximum = point;
+    }
+
+    return start;
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::columnStart(double time) const -> double {
+    if (m_columnWidth <= 0) {
+        return time;
+    }
+
+    return std::floor(time / m_columnWidth) * m_columnWidth;
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::columnEnd(double time) const -> double {
+    if (m_columnWidth <= 0) {
+        return std::nextafter(time, HUGE_VAL);
+    }
+
+    return columnStart(time) + m_columnWidth;
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::points(double start, double end) const -> QVector<Point> {
+    QVector<Point> points;
+
+    auto first = std::lower_bound(
+        m_columns.begin(),
+        m_columns.end(),
+        start,
+        [](const Column &entry, double value) {
+            return entry.start < value;
+        }
+    );
+
+    for (auto column = first; (column != m_columns.end()) && (column->start <= end); column++) {
+        addPoints(*column, points);
+    }
+
+    return points;
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::points() const -> QVector<Point> {
+    QVector<Point> points;
+
+    points.reserve(static_cast<int>(m_columns.size()) * PointsPerColumn);
+
+    for (auto &column : m_columns) {
+        addPoints(column, points);
+    }
+
+    return points;
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::removeBefore(double time) -> void {
+    while (!m_columns.empty() && (columnEnd(m_columns.front().start) <= time)) {
+        m_columns.pop_front();
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::columnCount() const -> int {
+    return static_cast<int>(m_columns.size());
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::clear() -> void {
+    m_columns.clear();
+}
+
+auto Nedrysoft::RouteAnalyser::EnvelopeDecimator::addPoints(const Column &column, QVector<Point> &points) -> void {
+    Point columnPoints[PointsPerColumn] = {column.first, column.minimum, column.maximum, column.last};
+
+    // the minimum and maximum may occur in either order, they are drawn in the order that they were sampled so
+    // that the step line passes through them as it did for the original series.
+
+    if (columnPoints[1].time > columnPoints[2].time) {
+        std::swap(columnPoints[1], columnPoints[2]);
+    }
+
+    auto previousTime = 0.0;
+
+    for (auto index = 0; index < PointsPerColumn; index++) {
+        if ((index > 0) && (columnPoints[index].time == previousTime)) {
+            // points at the same time are merged, the minimum and maximum take the place of the first point so
+            // that the extremes of the column are drawn.
+
+            if ((index == 1) || (index == 2)) {
+                points.last() = columnPoints[index];
+            }
+
+            continue;
+        }
+
+        previousTime = columnPoints[index].time;
+
+        points.append(columnPoints[index]);
+    }
+}
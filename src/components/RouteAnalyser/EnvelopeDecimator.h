@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_ENVELOPEDECIMATOR_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_ENVELOPEDECIMATOR_H
+
+#include <QVector>
+#include <deque>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The EnvelopeDecimator class reduces a series to the points needed to draw it at a given width.
+     *
+     * @details     The time axis is divided into columns the width of a pixel, and each column keeps only its first,
+     *              minimum, maximum and last samples, so a spike is never lost however many samples share a pixel
+     *              and a series is drawn with at most four points per pixel.
+     *
+     *              The columns are aligned to multiples of the column width rather than to the start of the
+     *              viewport, so the columns are unchanged as the viewport follows new samples and an appended
+     *              sample only changes the column that it falls in.
+     */
+    class EnvelopeDecimator {
+        public:
+            /**
+             * @brief       A point of the decimated series.
+             */
+            struct Point {
+                double time;                            //! time of the sample in seconds since the unix epoch.
+                double value;                           //! value of the sample.
+            };
+
+            /**
+             * @brief       Constructs an empty EnvelopeDecimator.
+             */
+            EnvelopeDecimator();
+
+            /**
+             * @brief       Sets the width of a column.
+             *
+             * @note        The decimator is cleared if the width changes.
+             *
+             * @param[in]   width the width in seconds; zero or less keeps every sample.
+             */
+            auto setColumnWidth(double width) -> void;
+
+            /**
+             * @brief       Returns the width of a column.
+             *
+             * @returns     the width in seconds.
+             */
+            auto columnWidth() const -> double;
+
+            /**
+             * @brief       Adds a sample.
+             *
+             * @details     Samples are normally appended to the last column in O(1), a sample that is earlier than
+             *              the last column is placed with a binary search.
+             *
+             * @param[in]   time the time of the sample in seconds since the unix epoch.
+             * @param[in]   value the value of the sample.
+             *
+             * @returns     the start time of the column that the sample was added to.
+             */
+            auto append(double time, double value) -> double;
+
+            /**
+             * @brief       Returns the start time of the column that a time falls in.
+             *
+             * @param[in]   time the time in seconds since the unix epoch.
+             *
+             * @returns     the start time of the column.
+             */
+            auto columnStart(double time) const -> double;
+
+            /**
+             * @brief       Returns the end time (exclusive) of the column that a time falls in.
+             *
+             * @param[in]   time the time in seconds since the unix epoch.
+             *
+             * @returns     the end time of the column.
+             */
+            auto columnEnd(double time) const -> double;
+
+            /**
+             * @brief       Returns the points of the columns that start within a range.
+             *
+             * @param[in]   start the start time of the range.
+             * @param[in]   end the end time of the range.
+             *
+             * @returns     the points in time order.
+             */
+            auto points(double start, double end) const -> QVector<Point>;
+
+            /**
+             * @brief       Returns the points of all columns.
+             *
+             * @returns     the points in time order.
+             */
+            auto points() const -> QVector<Point>;
+
+            /**
+             * @brief       Removes the columns that end before a time.
+             *
+             * @param[in]   time the time in seconds since the unix epoch.
+             */
+            auto removeBefore(double time) -> void;
+
+            /**
+             * @brief       Returns the number of columns.
+             *
+             * @returns     the number of columns.
+             */
+            auto columnCount() const -> int;
+
+            /**
+             * @brief       Removes all columns.
+             */
+            auto clear() -> void;
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       The envelope of the samples in a column.
+             */
+            struct Column {
+                double start;
+                Point first;
+                Point minimum;
+                Point maximum;
+                Point last;
+            };
+
+            /**
+             * @brief       Appends the points of a column in time order, omitting samples that are repeated.
+             *
+             * @param[in]   column the column.
+             * @param[out]  points the list to append to.
+             */
+            static auto addPoints(const Column &column, QVector<Point> &points) -> void;
+
+            std::deque<Column> m_columns;
+            double m_columnWidth;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_ENVELOPEDECIMATOR_H
@@ -38,44 +38,18 @@ constexpr auto TinyNumber = 0.0001;
 
 constexpr auto LatencyStopLineColour = Qt::black;
 
-constexpr auto UnusedRemovalTime = 5;
-
-//! @cond
-QMap<QString, QPixmap> Nedrysoft::RouteAnalyser::GraphLatencyLayer::m_buffers;
-QMap<QString, uint64_t> Nedrysoft::RouteAnalyser::GraphLatencyLayer::m_age;
-//! @endcond
-
 Nedrysoft::RouteAnalyser::GraphLatencyLayer::GraphLatencyLayer(QCustomPlot *customPlot) :
-        QCPItemRect(customPlot) {
+        QCPItemRect(customPlot),
+        m_backgroundCache(Nedrysoft::RouteAnalyser::LatencyBackgroundCache::getInstance()),
+        m_backgroundKey(),
+        m_backgroundGeneration(0),
+        m_backgroundValid(false),
+        m_roundedMask(RoundedRectangleRadius) {
 
 }
 
 auto Nedrysoft::RouteAnalyser::GraphLatencyLayer::invalidate() -> void {
-    m_buffers.clear();
-    m_age.clear();
-}
-
-auto Nedrysoft::RouteAnalyser::GraphLatencyLayer::removeUnused() -> void {
-    QMutableMapIterator<QString, uint64_t> mapIterator(m_age);
-
-    //TODO: this should probably be protected with a mutex.
-
-    while(mapIterator.hasNext()) {
-        mapIterator.next();
-
-#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
-        auto secondsSinceEpoch = QDateTime::currentSecsSinceEpoch();
-#else
-        auto secondsSinceEpoch = abs(QDateTime::currentDateTime().secsTo(QDateTime(QDate(1970,1,1), QTime(0, 0))));
-#endif
-
-        if (secondsSinceEpoch-mapIterator.value()>UnusedRemovalTime) {
-            QString key = mapIterator.key();
-
-            m_buffers.remove(key);
-            m_age.remove(key);
-        }
-    }
+    m_backgroundValid = false;
 }
 
 auto Nedrysoft::RouteAnalyser::GraphLatencyLayer::draw(QCPPainter *painter) -> void {
@@ -90,99 +64,118 @@ auto Nedrysoft::RouteAnalyser::GraphLatencyLayer::draw(QCPPainter *painter) -> v
     auto idealStop = latencySettings->warningValue()/graphMaxLatency;
     auto warningStop = latencySettings->criticalValue()/graphMaxLatency;
 
-    QString bufferName = QString("%1_%2_%3_%4_%5")
-            .arg(rect.size().width())
-            .arg(rect.size().height())
-            .arg(idealStop)
-            .arg(warningStop).arg(latencySettings->gradientFill());
+    auto key = Nedrysoft::RouteAnalyser::LatencyBackgroundCache::Key {
+        rect.width(),
+        rect.height(),
+        idealStop,
+        warningStop,
+        latencySettings->gradientFill()
+    };
 
-    if (!m_buffers.contains(bufferName)) {
-        rect.translate(-rect.left(), -rect.top());
+    // the layer keeps the background that it last drew, so the shared cache is only consulted when the size or
+    // latency stops change or the cache has been cleared.
 
-        QPixmap bufferedImage(rect.size());
+    if (( !m_backgroundValid ) ||
+        ( !(key == m_backgroundKey) ) ||
+        ( m_backgroundCache && (m_backgroundCache->generation() != m_backgroundGeneration) )) {
 
-        QPainter bufferPainter(&bufferedImage);
+        if (( !m_backgroundCache ) || ( !m_backgroundCache->find(key, m_background) )) {
+            m_background = renderBackground(rect.size(), idealStop, warningStop);
 
-        QLinearGradient graphGradient = QLinearGradient(QPoint(rect.x(), rect.bottom()), QPoint(rect.x(), rect.top()));
+            if (m_backgroundCache) {
+                m_backgroundCache->insert(key, m_background);
+            }
+        }
 
-        if (idealStop > 1) {
-            graphGradient.setColorAt(0, QColor(latencySettings->idealColour()));
-            graphGradient.setColorAt(1, QColor(latencySettings->idealColour()));
-        } else {
-            if (warningStop > 1) {
-                if (idealStop < 1) {
-                    graphGradient.setColorAt(0, QColor(latencySettings->idealColour()));
-                    graphGradient.setColorAt(1, QColor(latencySettings->warningColour()));
-
-                    if (!latencySettings->gradientFill()) {
-                        graphGradient.setColorAt(idealStop, QColor(latencySettings->warningColour()));
-                        graphGradient.setColorAt(idealStop-TinyNumber, QColor(latencySettings->idealColour()));
-                    }
-                }
-            } else {
+        m_backgroundKey = key;
+        m_backgroundGeneration = m_backgroundCache ? m_backgroundCache->generation() : 0;
+        m_backgroundValid = true;
+    }
+
+    painter->drawPixmap(topLeft, m_background);
+}
+
+auto Nedrysoft::RouteAnalyser::GraphLatencyLayer::renderBackground(
+        const QSize &size,
+        double idealStop,
+        double warningStop) -> QPixmap {
+
+    auto latencySettings = Nedrysoft::RouteAnalyser::LatencySettings::getInstance();
+    auto rect = QRect(QPoint(0, 0), size);
+
+    QPixmap bufferedImage(rect.size());
+
+    bufferedImage.fill(Qt::transparent);
+
+    QPainter bufferPainter(&bufferedImage);
+
+    QLinearGradient graphGradient = QLinearGradient(QPoint(rect.x(), rect.bottom()), QPoint(rect.x(), rect.top()));
+
+    if (idealStop > 1) {
+        graphGradient.setColorAt(0, QColor(latencySettings->idealColour()));
+        graphGradient.setColorAt(1, QColor(latencySettings->idealColour()));
+    } else {
+        if (warningStop > 1) {
+            if (idealStop < 1) {
                 graphGradient.setColorAt(0, QColor(latencySettings->idealColour()));
-                graphGradient.setColorAt(idealStop, QColor(latencySettings->warningColour()));
-                graphGradient.setColorAt(warningStop, QColor(latencySettings->criticalColour()));
-                graphGradient.setColorAt(1, QColor(latencySettings->criticalColour()));
+                graphGradient.setColorAt(1, QColor(latencySettings->warningColour()));
 
                 if (!latencySettings->gradientFill()) {
+                    graphGradient.setColorAt(idealStop, QColor(latencySettings->warningColour()));
                     graphGradient.setColorAt(idealStop-TinyNumber, QColor(latencySettings->idealColour()));
-                    graphGradient.setColorAt(warningStop-TinyNumber, QColor(latencySettings->warningColour()));
                 }
             }
-        }
-
-        bufferPainter.fillRect(rect, graphGradient);
-
-        auto startPoint = QPointF();
-        auto endPoint = QPointF();
-        auto floatingPointRect = QRectF(rect);
-
-        if (idealStop < 1) {
-            startPoint = QPointF(
-                floatingPointRect.left(),
-                floatingPointRect.bottom()-(idealStop*floatingPointRect.height())
-            );
+        } else {
+            graphGradient.setColorAt(0, QColor(latencySettings->idealColour()));
+            graphGradient.setColorAt(idealStop, QColor(latencySettings->warningColour()));
+            graphGradient.setColorAt(warningStop, QColor(latencySettings->criticalColour()));
+            graphGradient.setColorAt(1, QColor(latencySettings->criticalColour()));
 
-            endPoint = QPointF(
-                floatingPointRect.right(),
-                floatingPointRect.bottom()-(idealStop*floatingPointRect.height())
-            );
+            if (!latencySettings->gradientFill()) {
+                graphGradient.setColorAt(idealStop-TinyNumber, QColor(latencySettings->idealColour()));
+                graphGradient.setColorAt(warningStop-TinyNumber, QColor(latencySettings->warningColour()));
+            }
         }
+    }
 
-        auto pen = QPen(Qt::DashLine);
+    bufferPainter.fillRect(rect, graphGradient);
 
-        pen.setColor(LatencyStopLineColour);
+    auto startPoint = QPointF();
+    auto endPoint = QPointF();
+    auto floatingPointRect = QRectF(rect);
 
-        bufferPainter.setPen(pen);
+    if (idealStop < 1) {
+        startPoint = QPointF(
+            floatingPointRect.left(),
+            floatingPointRect.bottom()-(idealStop*floatingPointRect.height())
+        );
 
-        bufferPainter.drawLine(startPoint, endPoint);
+        endPoint = QPointF(
+            floatingPointRect.right(),
+            floatingPointRect.bottom()-(idealStop*floatingPointRect.height())
+        );
+    }
 
-        if (warningStop < 1) {
-            startPoint = QPointF(rect.left(), floatingPointRect.bottom() - (warningStop * floatingPointRect.height()));
-            endPoint = QPointF(rect.right(), floatingPointRect.bottom() - (warningStop * floatingPointRect.height()));
+    auto pen = QPen(Qt::DashLine);
 
-            bufferPainter.drawLine(startPoint, endPoint);
-        }
+    pen.setColor(LatencyStopLineColour);
 
-        bufferPainter.end();
+    bufferPainter.setPen(pen);
 
-        m_buffers[bufferName] = bufferedImage;
-    }
+    bufferPainter.drawLine(startPoint, endPoint);
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
-    auto secondsSinceEpoch = QDateTime::currentSecsSinceEpoch();
-#else
-    auto secondsSinceEpoch = abs(QDateTime::currentDateTime().secsTo(QDateTime(QDate(1970,1,1), QTime(0, 0))));
-#endif
+    if (warningStop < 1) {
+        startPoint = QPointF(rect.left(), floatingPointRect.bottom() - (warningStop * floatingPointRect.height()));
+        endPoint = QPointF(rect.right(), floatingPointRect.bottom() - (warningStop * floatingPointRect.height()));
 
-    m_age[bufferName] = secondsSinceEpoch;
+        bufferPainter.drawLine(startPoint, endPoint);
+    }
 
-    QPainterPath clippingPath;
+    bufferPainter.end();
 
-    clippingPath.addRoundedRect(parentPlot()->axisRect()->rect(), RoundedRectangleRadius, RoundedRectangleRadius);
+    // the corners are rounded as the background is rendered, so drawing it does not need a clip path.
 
-    painter->setClipPath(clippingPath);
+    m_roundedMask.apply(bufferedImage);
 
-    painter->drawPixmap(topLeft, m_buffers[bufferName]);
+    return bufferedImage;
 }
@@ -24,6 +24,8 @@
 #ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_GRAPHLATENCYLAYER_H
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_GRAPHLATENCYLAYER_H
 
+#include "LatencyBackgroundCache.h"
+#include "RoundedMask.h"
 #include "QCustomPlot/qcustomplot.h"
 
 namespace Nedrysoft { namespace RouteAnalyser {
@@ -43,12 +45,7 @@ namespace Nedrysoft { namespace RouteAnalyser {
             explicit GraphLatencyLayer(QCustomPlot *customPlot);
 
             /**
-             * @brief       Removes buffered offscreen background Pixmaps.
-             */
-            static auto removeUnused() -> void;
-
-            /**
-             * @brief       Clears all offscreen buffers
+             * @brief       Releases the background of this layer so that it is fetched again on the next draw.
              */
             auto invalidate() -> void;
 
@@ -63,8 +60,23 @@ namespace Nedrysoft { namespace RouteAnalyser {
         private:
             //! @cond
 
-            static QMap<QString, QPixmap> m_buffers;
-            static QMap<QString, uint64_t> m_age;
+            /**
+             * @brief       Renders the background for a plot size and latency stops.
+             *
+             * @param[in]   size the size of the axis rectangle.
+             * @param[in]   idealStop the position of the warning threshold.
+             * @param[in]   warningStop the position of the critical threshold.
+             *
+             * @returns     the background.
+             */
+            auto renderBackground(const QSize &size, double idealStop, double warningStop) -> QPixmap;
+
+            Nedrysoft::RouteAnalyser::LatencyBackgroundCache *m_backgroundCache;
+            Nedrysoft::RouteAnalyser::LatencyBackgroundCache::Key m_backgroundKey;
+            QPixmap m_background;
+            quint64 m_backgroundGeneration;
+            bool m_backgroundValid;
+            Nedrysoft::RouteAnalyser::RoundedMask m_roundedMask;
 
             //! @endcond
     };
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HopGraphList.h"
+
+#include <QEvent>
+#include <QLayout>
+#include <algorithm>
+
+Nedrysoft::RouteAnalyser::HopGraphList::HopGraphList(QWidget *parent) :
+        QWidget(parent),
+        m_rowCount(0),
+        m_rowHeight(0) {
+
+    setFixedHeight(0);
+}
+
+Nedrysoft::RouteAnalyser::HopGraphList::~HopGraphList() {
+
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::setSurfaceFactory(std::function<QWidget *()> factory) -> void {
+    m_surfaceFactory = factory;
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::setSurfaceBinder(
+        std::function<void(QWidget *surface, int row)> binder) -> void {
+
+    m_surfaceBinder = binder;
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::setSurfaceUnbinder(
+        std::function<void(QWidget *surface, int row)> unbinder) -> void {
+
+    m_surfaceUnbinder = unbinder;
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::setRowCount(int count) -> void {
+    for (auto surfaceIterator = m_boundSurfaces.begin(); surfaceIterator != m_boundSurfaces.end(); surfaceIterator++) {
+        if (m_surfaceUnbinder) {
+            m_surfaceUnbinder(surfaceIterator.value(), surfaceIterator.key());
+        }
+
+        surfaceIterator.value()->hide();
+
+        m_freeSurfaces.append(surfaceIterator.value());
+    }
+
+    m_boundSurfaces.clear();
+
+    m_rowCount = std::max(count, 0);
+
+    if ((m_rowCount) && (!m_rowHeight)) {
+        // the first surface is created up front to measure the height of a row.
+
+        auto surface = takeSurface();
+
+        if (surface) {
+            m_freeSurfaces.append(surface);
+        }
+    }
+
+    setFixedHeight(m_rowCount * m_rowHeight);
+
+    updateSurfaces();
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::rowCount() const -> int {
+    return m_rowCount;
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::boundSurfaces() const -> QMap<int, QWidget *> {
+    return m_boundSurfaces;
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::takeSurface() -> QWidget * {
+    if (!m_freeSurfaces.isEmpty()) {
+        return m_freeSurfaces.takeLast();
+    }
+
+    if (!m_surfaceFactory) {
+        return nullptr;
+    }
+
+    auto surface = m_surfaceFactory();
+
+    surface->setParent(this);
+    surface->hide();
+
+    if (!m_rowHeight) {
+        m_rowHeight = surface->layout() ? surface->layout()->sizeHint().height() : surface->sizeHint().height();
+    }
+
+    return surface;
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::updateSurfaces() -> void {
+    if ((!parentWidget()) || (!m_rowHeight)) {
+        return;
+    }
+
+    // the list is moved upwards inside the viewport of the scroll area as it is scrolled.
+
+    auto top = std::max(-y(), 0);
+    auto bottom = top + parentWidget()->height() - 1;
+
+    auto firstRow = std::max(top / m_rowHeight, 0);
+    auto lastRow = std::min(bottom / m_rowHeight, m_rowCount - 1);
+
+    for (auto surfaceIterator = m_boundSurfaces.begin(); surfaceIterator != m_boundSurfaces.end();) {
+        auto row = surfaceIterator.key();
+
+        if ((row >= firstRow) && (row <= lastRow)) {
+            surfaceIterator++;
+
+            continue;
+        }
+
+        if (m_surfaceUnbinder) {
+            m_surfaceUnbinder(surfaceIterator.value(), row);
+        }
+
+        surfaceIterator.value()->hide();
+
+        m_freeSurfaces.append(surfaceIterator.value());
+
+        surfaceIterator = m_boundSurfaces.erase(surfaceIterator);
+    }
+
+    for (auto row = firstRow; row <= lastRow; row++) {
+        auto surface = m_boundSurfaces.value(row);
+
+        if (!surface) {
+            surface = takeSurface();
+
+            if (!surface) {
+                return;
+            }
+
+            m_boundSurfaces[row] = surface;
+
+            if (m_surfaceBinder) {
+                m_surfaceBinder(surface, row);
+            }
+        }
+
+        surface->setGeometry(0, row * m_rowHeight, width(), m_rowHeight);
+        surface->show();
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::event(QEvent *event) -> bool {
+    if (event->type() == QEvent::ParentAboutToChange) {
+        if (parentWidget()) {
+            parentWidget()->removeEventFilter(this);
+        }
+    } else if (event->type() == QEvent::ParentChange) {
+        if (parentWidget()) {
+            parentWidget()->installEventFilter(this);
+        }
+    }
+
+    return QWidget::event(event);
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::eventFilter(QObject *watched, QEvent *event) -> bool {
+    if ((watched == parentWidget()) && (event->type() == QEvent::Resize)) {
+        updateSurfaces();
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::moveEvent(QMoveEvent *event) -> void {
+    QWidget::moveEvent(event);
+
+    updateSurfaces();
+}
+
+auto Nedrysoft::RouteAnalyser::HopGraphList::resizeEvent(QResizeEvent *event) -> void {
+    QWidget::resizeEvent(event);
+
+    updateSurfaces();
+}
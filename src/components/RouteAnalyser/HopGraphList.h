@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_HOPGRAPHLIST_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_HOPGRAPHLIST_H
+
+#include <QList>
+#include <QMap>
+#include <QWidget>
+#include <functional>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The HopGraphList class provides a virtualised list of the graphs of each hop.
+     *
+     * @details     The list is placed inside a scroll area and takes the height of every hop, but graph surfaces
+     *              are only created for the rows that can be seen.  As the list is scrolled, surfaces that leave the
+     *              view are unbound from their hop and recycled for the rows that come into view, so the number of
+     *              surfaces depends on the height of the view rather than on the number of hops.
+     */
+    class HopGraphList :
+            public QWidget {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       Constructs a new HopGraphList.
+             *
+             * @param[in]   parent the parent widget.
+             */
+            explicit HopGraphList(QWidget *parent = nullptr);
+
+            /**
+             * @brief       Destroys the HopGraphList.
+             */
+            ~HopGraphList();
+
+            /**
+             * @brief       Sets the function that creates a new graph surface.
+             *
+             * @details     All surfaces are expected to have the same height, the height of the first surface is
+             *              used as the height of each row.
+             *
+             * @param[in]   factory the function.
+             */
+            auto setSurfaceFactory(std::function<QWidget *()> factory) -> void;
+
+            /**
+             * @brief       Sets the function that binds a surface to a row.
+             *
+             * @param[in]   binder the function.
+             */
+            auto setSurfaceBinder(std::function<void(QWidget *surface, int row)> binder) -> void;
+
+            /**
+             * @brief       Sets the function that releases a surface from its row.
+             *
+             * @param[in]   unbinder the function.
+             */
+            auto setSurfaceUnbinder(std::function<void(QWidget *surface, int row)> unbinder) -> void;
+
+            /**
+             * @brief       Sets the number of rows in the list.
+             *
+             * @note        The surfaces that are bound are rebound so that the rows can be reordered.
+             *
+             * @param[in]   count the number of rows.
+             */
+            auto setRowCount(int count) -> void;
+
+            /**
+             * @brief       Returns the number of rows in the list.
+             *
+             * @returns     the number of rows.
+             */
+            auto rowCount() const -> int;
+
+            /**
+             * @brief       Returns the surfaces that are currently bound to rows.
+             *
+             * @returns     the map of row to surface.
+             */
+            auto boundSurfaces() const -> QMap<int, QWidget *>;
+
+            /**
+             * @brief       Binds surfaces to the rows that can be seen and releases those that cannot.
+             */
+            auto updateSurfaces() -> void;
+
+        protected:
+            /**
+             * @brief       Reimplements: QObject::event(QEvent *event).
+             *
+             * @param[in]   event the event information.
+             *
+             * @returns     true if the event was handled; otherwise false.
+             */
+            auto event(QEvent *event) -> bool override;
+
+            /**
+             * @brief       Reimplements: QObject::eventFilter(QObject *watched, QEvent *event).
+             *
+             * @details     The parent of the list is watched so that surfaces are bound when the view is resized.
+             *
+             * @param[in]   watched the object that caused the event.
+             * @param[in]   event the event information.
+             *
+             * @returns     true if event was handled; otherwise false.
+             */
+            auto eventFilter(QObject *watched, QEvent *event) -> bool override;
+
+            /**
+             * @brief       Reimplements: QWidget::moveEvent(QMoveEvent *event).
+             *
+             * @details     The scroll area scrolls the list by moving it.
+             *
+             * @param[in]   event the event information.
+             */
+            auto moveEvent(QMoveEvent *event) -> void override;
+
+            /**
+             * @brief       Reimplements: QWidget::resizeEvent(QResizeEvent *event).
+             *
+             * @param[in]   event the event information.
+             */
+            auto resizeEvent(QResizeEvent *event) -> void override;
+
+        private:
+            /**
+             * @brief       Returns a surface that is not bound to a row, creating one if required.
+             *
+             * @returns     the surface; nullptr if no factory has been set.
+             */
+            auto takeSurface() -> QWidget *;
+
+        private:
+            //! @cond
+
+            std::function<QWidget *()> m_surfaceFactory;
+            std::function<void(QWidget *, int)> m_surfaceBinder;
+            std::function<void(QWidget *, int)> m_surfaceUnbinder;
+
+            QMap<int, QWidget *> m_boundSurfaces;
+            QList<QWidget *> m_freeSurfaces;
+
+            int m_rowCount;
+            int m_rowHeight;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_HOPGRAPHLIST_H
@@ -25,6 +25,7 @@
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_IPINGENGINE_H
 
 #include "RouteAnalyserSpec.h"
+#include "PingPayload.h"
 #include "PingResult.h"
 
 #include <IConfiguration>
@@ -85,6 +86,21 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             virtual auto setTimeout(int timeout) -> bool = 0;
 
+            /**
+             * @brief       Sets the payload carried by probes that are not sent to a target.
+             *
+             * @details     Targets carry their own payload, this payload is used by singleShot() so that route
+             *              discovery probes are the same as the probes that are later sent to each hop.
+             *
+             * @note        Engines that are unable to choose the payload of a single shot probe do not need to
+             *              reimplement this function.
+             *
+             * @param[in]   payload the payload.
+             */
+            virtual auto setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void {
+                Q_UNUSED(payload)
+            }
+
             /**
              * @brief       Starts ping operations for this engine instance.
              *
@@ -118,6 +134,24 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             virtual auto addTarget(QHostAddress hostAddress, int ttl) -> IPingTarget * = 0;
 
+            /**
+             * @brief       Adds a ping target to this engine instance with a specific payload.
+             *
+             * @note        Engines that are unable to fill the payload with the requested pattern should honour
+             *              the payload size and fall back to their default fill.
+             *
+             * @param[in]   hostAddress the host address of the ping target.
+             * @param[in]   ttl the time to live to use.
+             * @param[in]   payload the payload size, pattern and sweep size to use for probes.
+             *
+             * @returns     returns a pointer to the created ping target.
+             */
+            virtual auto addTarget(
+                QHostAddress hostAddress,
+                int ttl,
+                const Nedrysoft::RouteAnalyser::PingPayload &payload
+            ) -> IPingTarget * = 0;
+
             /**
              * @brief       Transmits a single ping.
              *
@@ -135,6 +169,36 @@ namespace Nedrysoft { namespace RouteAnalyser {
                 double timeout
             ) -> Nedrysoft::RouteAnalyser::PingResult = 0;
 
+            /**
+             * @brief       Discovers the path MTU to each hop on the route to a host.
+             *
+             * @details     Probes are sent with fragmentation disabled and the payload size is binary searched for
+             *              every hop in parallel, fragmentation needed (IPv4) and packet too big (IPv6) responses
+             *              are used to narrow the search.
+             *
+             * @note        This is a blocking function, engines that are unable to disable fragmentation do not
+             *              need to reimplement this function.
+             *
+             * @param[in]   hostAddress the target host address.
+             * @param[in]   route the address of each hop to the target, null for hops that did not respond.
+             * @param[in]   timeout the longest time in seconds to wait for a round of probes.
+             *
+             * @returns     the path MTU for each hop (index 0 is hop 1), -1 if the MTU could not be determined
+             *              for that hop; an empty list if the engine does not support path MTU discovery.
+             */
+            virtual auto discoverPathMTU(
+                QHostAddress hostAddress,
+                const QList<QHostAddress> &route,
+                double timeout
+            ) -> QList<int> {
+
+                Q_UNUSED(hostAddress)
+                Q_UNUSED(route)
+                Q_UNUSED(timeout)
+
+                return QList<int>();
+            }
+
             /**
              * @brief       Removes a ping target from this engine instance.
              *
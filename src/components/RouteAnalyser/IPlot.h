@@ -32,6 +32,9 @@ namespace Nedrysoft { namespace RouteAnalyser {
     /**
      * @brief       The IPlot interface provides additional plots to the main route analyser.
      *
+     * @note        Plots do not redraw themselves when they are changed, the route analyser schedules the redraw
+     *              of the plot widget so that it is drawn in the same frame as the hop graphs.
+     *
      * @class       Nedrysoft::RouteAnalyser::IPlot IPlot.h <IPlot>
      */
     class NEDRYSOFT_ROUTEANALYSER_DLLSPEC IPlot :
@@ -75,6 +78,14 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             virtual auto setRange(double targetJitter, double maximumJitter) -> void = 0;
 
+            /**
+             * @brief       Removes every result from the plot.
+             *
+             * @details     Plots are reused for different hops as the hop graphs are scrolled, the plot is cleared
+             *              before the results of the new hop are added.
+             */
+            virtual auto clear() -> void = 0;
+
             // Classes with virtual functions should not have a public non-virtual destructor:
             virtual ~IPlot() = default;
     };
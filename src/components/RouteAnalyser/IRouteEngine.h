@@ -25,6 +25,7 @@
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_IROUTEENGINE_H
 
 #include "RouteAnalyserSpec.h"
+#include "PingPayload.h"
 
 #include <ICore>
 #include <IInterface>
@@ -69,6 +70,23 @@ namespace Nedrysoft { namespace RouteAnalyser {
                     QString host,
                     Nedrysoft::Core::IPVersion ipVersion ) -> void = 0;
 
+            /**
+             * @brief       Sets whether the path MTU to each hop is discovered once the route has been found.
+             *
+             * @note        The result is delivered by the pathMTUResult signal, engines which do not support path
+             *              MTU discovery never emit the signal.
+             *
+             * @param[in]   enabled true if path MTU discovery is enabled; otherwise false.
+             */
+            virtual auto setPathMTUDiscoveryEnabled(bool enabled) -> void = 0;
+
+            /**
+             * @brief       Sets the payload carried by the probes that discover the route.
+             *
+             * @param[in]   payload the payload.
+             */
+            virtual auto setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void = 0;
+
             /**
              * @brief       Signal emitted when the route discovery is completed.
              *
@@ -86,6 +104,15 @@ namespace Nedrysoft { namespace RouteAnalyser {
                 const int totalHops,
                 const int maximumHops
             );
+
+            /**
+             * @brief       Signal emitted when path MTU discovery has completed.
+             *
+             * @param[in]   hostAddress the address of the host that was the target.
+             * @param[in]   pathMTU the path MTU to each hop (index 0 is hop 1), -1 if the MTU could not be
+             *              determined.
+             */
+            Q_SIGNAL void pathMTUResult(const QHostAddress hostAddress, const QList<int> pathMTU);
     };
 }}
 
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyBackgroundCache.h"
+
+#include <functional>
+
+constexpr auto DefaultBudget = 32LL*1024*1024;
+constexpr auto BitsPerByte = 8;
+constexpr auto HashMultiplier = static_cast<std::size_t>(31);
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::Key::operator==(const Key &other) const -> bool {
+    return ( width == other.width ) &&
+           ( height == other.height ) &&
+           ( idealStop == other.idealStop ) &&
+           ( warningStop == other.warningStop ) &&
+           ( gradientFill == other.gradientFill );
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::KeyHash::operator()(const Key &key) const -> std::size_t {
+    auto hash = std::hash<int>()(key.width);
+
+    hash = (hash * HashMultiplier) + std::hash<int>()(key.height);
+    hash = (hash * HashMultiplier) + std::hash<double>()(key.idealStop);
+    hash = (hash * HashMultiplier) + std::hash<double>()(key.warningStop);
+    hash = (hash * HashMultiplier) + std::hash<bool>()(key.gradientFill);
+
+    return hash;
+}
+
+Nedrysoft::RouteAnalyser::LatencyBackgroundCache::LatencyBackgroundCache(QObject *parent) :
+        QObject(parent),
+        m_budget(DefaultBudget),
+        m_cost(0),
+        m_hits(0),
+        m_misses(0),
+        m_generation(0) {
+
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::find(const Key &key, QPixmap &pixmap) -> bool {
+    auto indexIterator = m_index.find(key);
+
+    if (indexIterator == m_index.end()) {
+        m_misses++;
+
+        return false;
+    }
+
+    // the entry is moved to the front of the list so that the least recently used entry is always at the back.
+
+    m_entries.splice(m_entries.begin(), m_entries, indexIterator->second);
+
+    pixmap = indexIterator->second->pixmap;
+
+    m_hits++;
+
+    return true;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::insert(const Key &key, const QPixmap &pixmap) -> void {
+    auto cost = static_cast<qint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / BitsPerByte;
+    auto indexIterator = m_index.find(key);
+
+    if (indexIterator != m_index.end()) {
+        m_cost -= indexIterator->second->cost;
+
+        m_entries.erase(indexIterator->second);
+        m_index.erase(indexIterator);
+    }
+
+    m_entries.push_front(Entry {key, pixmap, cost});
+    m_index[key] = m_entries.begin();
+
+    m_cost += cost;
+
+    evict();
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::setBudget(qint64 budget) -> void {
+    m_budget = budget;
+
+    evict();
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::budget() const -> qint64 {
+    return m_budget;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::cost() const -> qint64 {
+    return m_cost;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::count() const -> int {
+    return static_cast<int>(m_entries.size());
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::hits() const -> quint64 {
+    return m_hits;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::misses() const -> quint64 {
+    return m_misses;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::generation() const -> quint64 {
+    return m_generation;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::clear() -> void {
+    m_entries.clear();
+    m_index.clear();
+
+    m_cost = 0;
+    m_generation++;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyBackgroundCache::evict() -> void {
+    // the most recently inserted entry is kept even if it exceeds the budget on its own, as it is about to be drawn.
+
+    while (( m_cost > m_budget ) && ( m_entries.size() > 1 )) {
+        auto &entry = m_entries.back();
+
+        m_cost -= entry.cost;
+
+        m_index.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYBACKGROUNDCACHE_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYBACKGROUNDCACHE_H
+
+#include <IComponentManager>
+#include <QObject>
+#include <QPixmap>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The LatencyBackgroundCache class holds the rendered backgrounds of the latency graphs.
+     *
+     * @details     A single cache is shared by every graph in the application, backgrounds are identified by the
+     *              size of the plot and the positions of the latency stops, and are evicted in least recently used
+     *              order once the pixmaps held exceed the byte budget, so no periodic clean up is required.
+     */
+    class LatencyBackgroundCache :
+            public QObject {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       Identifies a rendered background.
+             */
+            struct Key {
+                int width;                              //! width of the axis rectangle in pixels.
+                int height;                             //! height of the axis rectangle in pixels.
+                double idealStop;                       //! position of the warning threshold (0 = bottom, 1 = top).
+                double warningStop;                     //! position of the critical threshold (0 = bottom, 1 = top).
+                bool gradientFill;                      //! true if the colours are blended.
+
+                /**
+                 * @brief       Compares two keys.
+                 *
+                 * @param[in]   other the key to compare with.
+                 *
+                 * @returns     true if the keys are equal; otherwise false.
+                 */
+                auto operator==(const Key &other) const -> bool;
+            };
+
+            /**
+             * @brief       Hashes a key.
+             */
+            struct KeyHash {
+                /**
+                 * @brief       Returns the hash of a key.
+                 *
+                 * @param[in]   key the key.
+                 *
+                 * @returns     the hash.
+                 */
+                auto operator()(const Key &key) const -> std::size_t;
+            };
+
+        public:
+            /**
+             * @brief       Constructs a new LatencyBackgroundCache.
+             *
+             * @param[in]   parent the parent object.
+             */
+            explicit LatencyBackgroundCache(QObject *parent = nullptr);
+
+            /**
+             * @brief       Returns the LatencyBackgroundCache instance.
+             *
+             * @returns     the cache; nullptr if it has not been created.
+             */
+            static auto getInstance() -> LatencyBackgroundCache * {
+                return Nedrysoft::ComponentSystem::getObject<Nedrysoft::RouteAnalyser::LatencyBackgroundCache>();
+            }
+
+            /**
+             * @brief       Looks up a background.
+             *
+             * @param[in]   key the key of the background.
+             * @param[out]  pixmap the background if found.
+             *
+             * @returns     true if the background was found; otherwise false.
+             */
+            auto find(const Key &key, QPixmap &pixmap) -> bool;
+
+            /**
+             * @brief       Adds a background, evicting the least recently used backgrounds to stay within the budget.
+             *
+             * @param[in]   key the key of the background.
+             * @param[in]   pixmap the background.
+             */
+            auto insert(const Key &key, const QPixmap &pixmap) -> void;
+
+            /**
+             * @brief       Sets the number of bytes that the cached pixmaps may occupy.
+             *
+             * @param[in]   budget the budget in bytes.
+             */
+            auto setBudget(qint64 budget) -> void;
+
+            /**
+             * @brief       Returns the number of bytes that the cached pixmaps may occupy.
+             *
+             * @returns     the budget in bytes.
+             */
+            auto budget() const -> qint64;
+
+            /**
+             * @brief       Returns the number of bytes occupied by the cached pixmaps.
+             *
+             * @returns     the size in bytes.
+             */
+            auto cost() const -> qint64;
+
+            /**
+             * @brief       Returns the number of cached backgrounds.
+             *
+             * @returns     the number of backgrounds.
+             */
+            auto count() const -> int;
+
+            /**
+             * @brief       Returns the number of lookups that found a background.
+             *
+             * @returns     the number of hits.
+             */
+            auto hits() const -> quint64;
+
+            /**
+             * @brief       Returns the number of lookups that did not find a background.
+             *
+             * @returns     the number of misses.
+             */
+            auto misses() const -> quint64;
+
+            /**
+             * @brief       Returns the generation of the cache.
+             *
+             * @details     The generation changes whenever the cache is cleared, so a layer that keeps the last
+             *              background it drew can tell that it is stale.
+             *
+             * @returns     the generation.
+             */
+            auto generation() const -> quint64;
+
+            /**
+             * @brief       Removes all backgrounds, called when the latency colours or gradient are changed.
+             */
+            auto clear() -> void;
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       A cached background.
+             */
+            struct Entry {
+                Key key;
+                QPixmap pixmap;
+                qint64 cost;
+            };
+
+            /**
+             * @brief       Evicts the least recently used backgrounds until the cost is within the budget.
+             */
+            auto evict() -> void;
+
+            std::list<Entry> m_entries;
+            std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+
+            qint64 m_budget;
+            qint64 m_cost;
+            quint64 m_hits;
+            quint64 m_misses;
+            quint64 m_generation;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYBACKGROUNDCACHE_H
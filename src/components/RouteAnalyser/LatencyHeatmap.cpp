@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyHeatmap.h"
+
+#include "LatencySettings.h"
+
+#include <QPainter>
+#include <QResizeEvent>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+constexpr auto RowsPerHop = 4;
+constexpr auto LossRows = 1;
+constexpr auto HopRowHeight = 8;
+constexpr auto DefaultWidth = 400;
+constexpr auto LossColour = qRgb(255, 0, 0);
+constexpr auto SampleResolution = 0.001;
+constexpr auto ColumnWidthTolerance = 1e-9;
+
+// timeouts are reported after later replies, so the columns covering this many seconds are rendered again.
+
+constexpr auto RefreshPeriod = 10.0;
+
+Nedrysoft::RouteAnalyser::LatencyHeatmap::LatencyHeatmap(QWidget *parent) :
+        QWidget(parent),
+        m_sampleStore(nullptr),
+        m_start(0),
+        m_end(0),
+        m_columnWidth(0),
+        m_firstColumn(0),
+        m_valid(false) {
+
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+Nedrysoft::RouteAnalyser::LatencyHeatmap::~LatencyHeatmap() = default;
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::setSampleStore(
+        const Nedrysoft::RouteAnalyser::SampleStore *sampleStore) -> void {
+
+    m_sampleStore = sampleStore;
+    m_valid = false;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::setHops(const QList<int> &hops) -> void {
+    if (hops == m_hops) {
+        return;
+    }
+
+    m_hops = hops;
+    m_valid = false;
+
+    updateGeometry();
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::invalidate() -> void {
+    m_valid = false;
+
+    setRange(m_start, m_end);
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::setRange(double start, double end) -> void {
+    m_start = start;
+    m_end = end;
+
+    auto columns = width();
+
+    if ((!m_sampleStore) || (m_hops.isEmpty()) || (columns <= 0) || (end <= start)) {
+        return;
+    }
+
+    // the range is divided into columns that are aligned to multiples of the column width, so that a range which
+    // has moved by whole columns can reuse the columns that are already rendered.
+
+    auto columnWidth = (end - start) / columns;
+
+    if (std::abs(columnWidth - m_columnWidth) <= m_columnWidth * ColumnWidthTolerance) {
+        columnWidth = m_columnWidth;
+    }
+
+    auto firstColumn = static_cast<qint64>(std::floor(start / columnWidth));
+    auto shift = firstColumn - m_firstColumn;
+
+    if ((!m_valid) ||
+        (columnWidth != m_columnWidth) ||
+        (m_image.width() != columns) ||
+        (m_image.height() != m_hops.count() * RowsPerHop) ||
+        (shift < 0) ||
+        (shift >= columns)) {
+
+        m_image = QImage(columns, m_hops.count() * RowsPerHop, QImage::Format_RGB32);
+        m_columnWidth = columnWidth;
+        m_firstColumn = firstColumn;
+        m_valid = true;
+
+        renderColumns(0, columns - 1);
+    } else {
+        if (shift) {
+            shiftColumns(static_cast<int>(shift));
+
+            m_firstColumn = firstColumn;
+        }
+
+        auto refreshColumns = static_cast<int>(std::ceil(RefreshPeriod / m_columnWidth));
+
+        renderColumns(std::max(columns - static_cast<int>(shift) - refreshColumns, 0), columns - 1);
+    }
+
+    update();
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::renderColumns(int firstColumn, int lastColumn) -> void {
+    auto latencySettings = Nedrysoft::RouteAnalyser::LatencySettings::getInstance();
+    auto backgroundColour = palette().color(QPalette::Base).rgb();
+
+    if (!latencySettings) {
+        m_image.fill(backgroundColour);
+
+        return;
+    }
+
+    auto idealColour = latencySettings->idealColour();
+    auto warningColour = latencySettings->warningColour();
+    auto criticalColour = latencySettings->criticalColour();
+    auto warningValue = latencySettings->warningValue();
+    auto criticalValue = latencySettings->criticalValue();
+
+    for (auto column = firstColumn; column <= lastColumn; column++) {
+        auto start = static_cast<double>(m_firstColumn + column) * m_columnWidth;
+
+        for (auto row = 0; row < m_hops.count(); row++) {
+            // the end of an aggregate is inclusive, so the sample at the start of the next column is excluded.
+
+            auto aggregate = m_sampleStore->aggregate(
+                m_hops.at(row) - 1,
+                start,
+                start + m_columnWidth - SampleResolution
+            );
+            auto colour = backgroundColour;
+
+            if (aggregate.replies) {
+                if (aggregate.maximum < warningValue) {
+                    colour = idealColour;
+                } else if (aggregate.maximum < criticalValue) {
+                    colour = warningColour;
+                } else {
+                    colour = criticalColour;
+                }
+            } else if (aggregate.lost) {
+                colour = LossColour;
+            }
+
+            for (auto line = 0; line < RowsPerHop; line++) {
+                auto lineColour = colour;
+
+                if ((line >= RowsPerHop - LossRows) && (aggregate.lost)) {
+                    lineColour = LossColour;
+                }
+
+                reinterpret_cast<QRgb *>(m_image.scanLine(row * RowsPerHop + line))[column] = lineColour;
+            }
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::shiftColumns(int columns) -> void {
+    auto remainingColumns = static_cast<size_t>(m_image.width() - columns);
+
+    for (auto row = 0; row < m_image.height(); row++) {
+        auto line = reinterpret_cast<QRgb *>(m_image.scanLine(row));
+
+        memmove(line, line + columns, remainingColumns * sizeof(QRgb));
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::paintEvent(QPaintEvent *event) -> void {
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+
+    if (m_image.isNull()) {
+        painter.fillRect(rect(), palette().color(QPalette::Base));
+
+        return;
+    }
+
+    // each hop is a few pixels high in the image, so it is scaled to the widget without smoothing.
+
+    painter.drawImage(rect(), m_image);
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyHeatmap::resizeEvent(QResizeEvent *event) -> void {
+    QWidget::resizeEvent(event);
+
+    if (event->size().width() != event->oldSize().width()) {
+        m_valid = false;
+
+        setRange(m_start, m_end);
+    }
+}
+
+QSize Nedrysoft::RouteAnalyser::LatencyHeatmap::sizeHint() const {
+    return QSize(DefaultWidth, std::max(static_cast<int>(m_hops.count()), 1) * HopRowHeight);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYHEATMAP_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYHEATMAP_H
+
+#include "SampleStore.h"
+
+#include <QImage>
+#include <QList>
+#include <QWidget>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The LatencyHeatmap widget shows the latency of every hop of a route over time in a single image.
+     *
+     * @details     Each hop is a row and each pixel column summarises the samples of a time interval.  A cell is
+     *              coloured by the latency thresholds of the LatencySettings, and a strip along the bottom of the
+     *              row marks intervals where requests were lost.
+     *
+     *              The cells are rendered into an image with a few pixels per hop, which is scaled to the widget
+     *              when it is painted.  When the range moves by whole columns, the image is shifted and only the new
+     *              columns are rendered, along with the recent columns that may still receive samples.
+     */
+    class LatencyHeatmap :
+            public QWidget {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       Constructs a new LatencyHeatmap.
+             *
+             * @param[in]   parent the parent widget.
+             */
+            explicit LatencyHeatmap(QWidget *parent = nullptr);
+
+            /**
+             * @brief       Destroys the LatencyHeatmap.
+             */
+            ~LatencyHeatmap();
+
+            /**
+             * @brief       Sets the store that the samples are read from.
+             *
+             * @param[in]   sampleStore the sample store.
+             */
+            auto setSampleStore(const Nedrysoft::RouteAnalyser::SampleStore *sampleStore) -> void;
+
+            /**
+             * @brief       Sets the hops that are shown.
+             *
+             * @details     Hops that did not respond during route discovery are not shown, so each row is mapped
+             *              to the hop that it shows.
+             *
+             * @param[in]   hops the hop numbers (starting at 1) of the rows.
+             */
+            auto setHops(const QList<int> &hops) -> void;
+
+            /**
+             * @brief       Sets the time range that is shown.
+             *
+             * @param[in]   start the start of the range in seconds since the unix epoch.
+             * @param[in]   end the end of the range in seconds since the unix epoch.
+             */
+            auto setRange(double start, double end) -> void;
+
+            /**
+             * @brief       Renders every column again.
+             */
+            auto invalidate() -> void;
+
+        protected:
+            /**
+             * @brief       Reimplements: QWidget::paintEvent(QPaintEvent *event).
+             *
+             * @param[in]   event the event information.
+             */
+            auto paintEvent(QPaintEvent *event) -> void override;
+
+            /**
+             * @brief       Reimplements: QWidget::resizeEvent(QResizeEvent *event).
+             *
+             * @param[in]   event the event information.
+             */
+            auto resizeEvent(QResizeEvent *event) -> void override;
+
+            /**
+             * @brief       Returns the recommended size for the widget.
+             *
+             * @returns     the size of the widget.
+             */
+            QSize sizeHint() const override;
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       Renders a range of columns into the image.
+             *
+             * @param[in]   firstColumn the first column.
+             * @param[in]   lastColumn the last column.
+             */
+            auto renderColumns(int firstColumn, int lastColumn) -> void;
+
+            /**
+             * @brief       Moves the columns of the image to the left.
+             *
+             * @param[in]   columns the number of columns to move by.
+             */
+            auto shiftColumns(int columns) -> void;
+
+            const Nedrysoft::RouteAnalyser::SampleStore *m_sampleStore;
+            QImage m_image;
+            QList<int> m_hops;
+            double m_start;
+            double m_end;
+            double m_columnWidth;
+            qint64 m_firstColumn;
+            bool m_valid;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYHEATMAP_H
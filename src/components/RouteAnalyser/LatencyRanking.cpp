@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyRanking.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+constexpr auto NotRanked = -1;
+
+Nedrysoft::RouteAnalyser::LatencyRanking::LatencyRanking() {
+
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::update(int hop, double value) -> void {
+    if (hop < 0) {
+        return;
+    }
+
+    if (value < 0) {
+        remove(hop);
+
+        return;
+    }
+
+    if (hop >= static_cast<int>(m_positions.size())) {
+        m_positions.resize(static_cast<size_t>(hop) + 1, NotRanked);
+    }
+
+    auto position = m_positions[static_cast<size_t>(hop)];
+
+    if (position == NotRanked) {
+        m_heap.push_back(Entry {hop, value});
+        m_positions[static_cast<size_t>(hop)] = static_cast<int>(m_heap.size()) - 1;
+
+        siftUp(m_heap.size() - 1);
+
+        return;
+    }
+
+    auto &entry = m_heap[static_cast<size_t>(position)];
+    auto previousValue = entry.value;
+
+    entry.value = value;
+
+    if (value > previousValue) {
+        siftUp(static_cast<size_t>(position));
+    } else if (value < previousValue) {
+        siftDown(static_cast<size_t>(position));
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::remove(int hop) -> void {
+    if ((hop < 0) || (hop >= static_cast<int>(m_positions.size())) ||
+        (m_positions[static_cast<size_t>(hop)] == NotRanked)) {
+
+        return;
+    }
+
+    auto position = static_cast<size_t>(m_positions[static_cast<size_t>(hop)]);
+    auto last = m_heap.size() - 1;
+
+    swap(position, last);
+
+    m_heap.pop_back();
+    m_positions[static_cast<size_t>(hop)] = NotRanked;
+
+    // the entry moved into the vacated position may belong above or below it.
+
+    if (position < m_heap.size()) {
+        auto movedHop = static_cast<size_t>(m_heap[position].hop);
+
+        siftUp(position);
+        siftDown(static_cast<size_t>(m_positions[movedHop]));
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::maximum() const -> int {
+    if (m_heap.empty()) {
+        return NotRanked;
+    }
+
+    return m_heap.front().hop;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::isMaximum(int hop) const -> bool {
+    return (!m_heap.empty()) && (m_heap.front().hop == hop);
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::top(int count) const -> QVector<int> {
+    QVector<int> hops;
+
+    auto compare = [this](size_t first, size_t second) {
+        return m_heap[first].value < m_heap[second].value;
+    };
+
+    std::priority_queue<size_t, std::vector<size_t>, decltype(compare)> candidates(compare);
+
+    if (!m_heap.empty()) {
+        candidates.push(0);
+    }
+
+    while ((hops.count() < count) && (!candidates.empty())) {
+        auto position = candidates.top();
+
+        candidates.pop();
+
+        hops.append(m_heap[position].hop);
+
+        for (auto child = position * 2 + 1; child <= position * 2 + 2; child++) {
+            if (child < m_heap.size()) {
+                candidates.push(child);
+            }
+        }
+    }
+
+    return hops;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::count() const -> int {
+    return static_cast<int>(m_heap.size());
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::clear() -> void {
+    m_heap.clear();
+    m_positions.clear();
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::siftUp(size_t position) -> void {
+    while (position > 0) {
+        auto parent = (position - 1) / 2;
+
+        if (m_heap[parent].value >= m_heap[position].value) {
+            break;
+        }
+
+        swap(parent, position);
+
+        position = parent;
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::siftDown(size_t position) -> void {
+    while (true) {
+        auto largest = position;
+
+        for (auto child = position * 2 + 1; child <= position * 2 + 2; child++) {
+            if ((child < m_heap.size()) && (m_heap[child].value > m_heap[largest].value)) {
+                largest = child;
+            }
+        }
+
+        if (largest == position) {
+            break;
+        }
+
+        swap(largest, position);
+
+        position = largest;
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencyRanking::swap(size_t first, size_t second) -> void {
+    std::swap(m_heap[first], m_heap[second]);
+
+    m_positions[static_cast<size_t>(m_heap[first].hop)] = static_cast<int>(first);
+    m_positions[static_cast<size_t>(m_heap[second].hop)] = static_cast<int>(second);
+}
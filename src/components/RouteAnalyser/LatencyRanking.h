@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYRANKING_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYRANKING_H
+
+#include <QVector>
+#include <cstddef>
+#include <vector>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The LatencyRanking class ranks the hops of a route by a latency value.
+     *
+     * @details     The hops are held in a binary max heap with an index from hop to heap position, so the value of a
+     *              hop can be raised or lowered in place (increase and decrease key) and the hop with the largest
+     *              value is always at the root, each update is O(log hops) and the maximum is O(1).
+     */
+    class LatencyRanking {
+        public:
+            /**
+             * @brief       Constructs an empty LatencyRanking.
+             */
+            LatencyRanking();
+
+            /**
+             * @brief       Sets the value of a hop.
+             *
+             * @param[in]   hop the hop number.
+             * @param[in]   value the latency value; a negative value removes the hop as it has no latency.
+             */
+            auto update(int hop, double value) -> void;
+
+            /**
+             * @brief       Removes a hop.
+             *
+             * @param[in]   hop the hop number.
+             */
+            auto remove(int hop) -> void;
+
+            /**
+             * @brief       Returns the hop with the largest value.
+             *
+             * @returns     the hop number; -1 if no hops are ranked.
+             */
+            auto maximum() const -> int;
+
+            /**
+             * @brief       Returns whether a hop has the largest value.
+             *
+             * @param[in]   hop the hop number.
+             *
+             * @returns     true if the hop has the largest value; otherwise false.
+             */
+            auto isMaximum(int hop) const -> bool;
+
+            /**
+             * @brief       Returns the hops with the largest values.
+             *
+             * @details     The heap is walked from the root with a second heap of candidates, so the cost depends on
+             *              the number of hops requested rather than the number ranked.
+             *
+             * @param[in]   count the number of hops to return.
+             *
+             * @returns     the hop numbers in descending order of value.
+             */
+            auto top(int count) const -> QVector<int>;
+
+            /**
+             * @brief       Returns the number of hops that are ranked.
+             *
+             * @returns     the number of hops.
+             */
+            auto count() const -> int;
+
+            /**
+             * @brief       Removes all hops.
+             */
+            auto clear() -> void;
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       A ranked hop.
+             */
+            struct Entry {
+                int hop;
+                double value;
+            };
+
+            /**
+             * @brief       Moves the entry at a heap position towards the root until the heap is ordered.
+             *
+             * @param[in]   position the heap position.
+             */
+            auto siftUp(std::size_t position) -> void;
+
+            /**
+             * @brief       Moves the entry at a heap position towards the leaves until the heap is ordered.
+             *
+             * @param[in]   position the heap position.
+             */
+            auto siftDown(std::size_t position) -> void;
+
+            /**
+             * @brief       Exchanges two heap positions and updates the index.
+             *
+             * @param[in]   first the first heap position.
+             * @param[in]   second the second heap position.
+             */
+            auto swap(std::size_t first, std::size_t second) -> void;
+
+            std::vector<Entry> m_heap;
+            std::vector<int> m_positions;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYRANKING_H
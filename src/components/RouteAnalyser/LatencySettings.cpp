@@ -190,15 +190,27 @@ auto Nedrysoft::RouteAnalyser::LatencySettings::saveToFile(QString filename) ->
 }
 
 auto Nedrysoft::RouteAnalyser::LatencySettings::setWarningValue(QString value) -> void {
+    auto previousThreshold = m_warningThreshold;
+
     if (!Nedrysoft::Utils::parseIntervalString(value, m_warningThreshold)) {
         return;
     }
+
+    if (m_warningThreshold != previousThreshold) {
+        Q_EMIT thresholdsChanged();
+    }
 }
 
 auto Nedrysoft::RouteAnalyser::LatencySettings::setCriticalValue(QString value) -> void {
+    auto previousThreshold = m_criticalThreshold;
+
     if (!Nedrysoft::Utils::parseIntervalString(value, m_criticalThreshold)) {
         return;
     }
+
+    if (m_criticalThreshold != previousThreshold) {
+        Q_EMIT thresholdsChanged();
+    }
 }
 
 auto Nedrysoft::RouteAnalyser::LatencySettings::idealColour() -> QRgb {
@@ -242,6 +254,8 @@ auto Nedrysoft::RouteAnalyser::LatencySettings::resetColours() -> void {
 auto Nedrysoft::RouteAnalyser::LatencySettings::resetThresholds() -> void {
     m_warningThreshold = WarningDefaultValue;
     m_criticalThreshold = CriticalDefaultValue;
+
+    Q_EMIT thresholdsChanged();
 }
 
 auto Nedrysoft::RouteAnalyser::LatencySettings::setGradientFill(bool useGradient) -> void {
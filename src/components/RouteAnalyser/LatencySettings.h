@@ -98,9 +98,9 @@ namespace Nedrysoft { namespace RouteAnalyser {
             auto setWarningValue(QString value) -> void;
 
             /**
-             * @brief       Sets the warning value by parsing the given string.
+             * @brief       Sets the critical value by parsing the given string.
              *
-             * @param[in]   value the warning threshold.
+             * @param[in]   value the critical threshold.
              */
             auto setCriticalValue(QString value) -> void;
 
@@ -160,6 +160,11 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto resetThresholds() -> void;
 
+            /**
+             * @brief       This signal is emitted when the warning or critical threshold changes.
+             */
+            Q_SIGNAL void thresholdsChanged();
+
             /**
              * @brief       This signal is emitted when the user changes the default colours.
              */
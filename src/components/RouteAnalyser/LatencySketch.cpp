@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencySketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+// a relative accuracy of 1% needs ~800 buckets to cover 10us to 60s, so the cap is only reached by outliers.
+
+constexpr auto RelativeAccuracy = 0.01;
+constexpr auto Gamma = (1.0 + RelativeAccuracy) / (1.0 - RelativeAccuracy);
+constexpr auto MaximumBuckets = 2048;
+constexpr auto MinimumValue = 1e-9;
+
+Nedrysoft::RouteAnalyser::LatencySketch::LatencySketch() :
+        m_firstIndex(0),
+        m_zeroCount(0),
+        m_count(0),
+        m_mean(0),
+        m_sumOfSquares(0),
+        m_minimum(0),
+        m_maximum(0) {
+
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::bucketIndex(double value) const -> int {
+    return static_cast<int>(std::ceil(std::log(value) / std::log(Gamma)));
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::bucketValue(int index) const -> double {
+    return 2.0 * std::pow(Gamma, index) / (Gamma + 1.0);
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::addToBucket(int index, uint64_t count) -> void {
+    if (m_buckets.empty()) {
+        m_firstIndex = index;
+        m_buckets.resize(1, 0);
+    }
+
+    auto lastIndex = m_firstIndex + static_cast<int>(m_buckets.size()) - 1;
+
+    if ((index < m_firstIndex) || (index > lastIndex)) {
+        auto newFirstIndex = std::min(index, m_firstIndex);
+        auto newLastIndex = std::max(index, lastIndex);
+
+        // collapse the lowest buckets if the range would exceed the cap.
+
+        newFirstIndex = std::max(newFirstIndex, newLastIndex - MaximumBuckets + 1);
+
+        std::vector<uint64_t> buckets(static_cast<size_t>(newLastIndex - newFirstIndex + 1), 0);
+
+        for (size_t i = 0; i < m_buckets.size(); i++) {
+            auto bucket = std::max(m_firstIndex + static_cast<int>(i), newFirstIndex);
+
+            buckets[static_cast<size_t>(bucket - newFirstIndex)] += m_buckets[i];
+        }
+
+        m_buckets.swap(buckets);
+        m_firstIndex = newFirstIndex;
+    }
+
+    index = std::max(index, m_firstIndex);
+
+    m_buckets[static_cast<size_t>(index - m_firstIndex)] += count;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::add(double value) -> void {
+    m_count++;
+
+    if (m_count == 1) {
+        m_minimum = value;
+        m_maximum = value;
+    } else {
+        m_minimum = std::min(m_minimum, value);
+        m_maximum = std::max(m_maximum, value);
+    }
+
+    auto delta = value - m_mean;
+
+    m_mean += delta / static_cast<double>(m_count);
+    m_sumOfSquares += delta * (value - m_mean);
+
+    if (value < MinimumValue) {
+        m_zeroCount++;
+    } else {
+        addToBucket(bucketIndex(value), 1);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::merge(const Nedrysoft::RouteAnalyser::LatencySketch &other) -> void {
+    if (other.m_count == 0) {
+        return;
+    }
+
+    if (m_count == 0) {
+        *this = other;
+
+        return;
+    }
+
+    auto count = m_count + other.m_count;
+    auto delta = other.m_mean - m_mean;
+
+    m_sumOfSquares += other.m_sumOfSquares +
+                      delta * delta * static_cast<double>(m_count) * static_cast<double>(other.m_count) /
+                      static_cast<double>(count);
+
+    m_mean += delta * static_cast<double>(other.m_count) / static_cast<double>(count);
+    m_count = count;
+    m_minimum = std::min(m_minimum, other.m_minimum);
+    m_maximum = std::max(m_maximum, other.m_maximum);
+    m_zeroCount += other.m_zeroCount;
+
+    for (size_t i = 0; i < other.m_buckets.size(); i++) {
+        if (other.m_buckets[i]) {
+            addToBucket(other.m_firstIndex + static_cast<int>(i), other.m_buckets[i]);
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::clear() -> void {
+    *this = LatencySketch();
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::quantile(double quantile) const -> double {
+    if (m_count == 0) {
+        return -1;
+    }
+
+    auto rank = static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(m_count - 1));
+
+    if (rank < m_zeroCount) {
+        return m_minimum;
+    }
+
+    auto total = m_zeroCount;
+
+    for (size_t i = 0; i < m_buckets.size(); i++) {
+        total += m_buckets[i];
+
+        if (total > rank) {
+            return std::clamp(bucketValue(m_firstIndex + static_cast<int>(i)), m_minimum, m_maximum);
+        }
+    }
+
+    return m_maximum;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::count() const -> uint64_t {
+    return m_count;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::mean() const -> double {
+    if (m_count == 0) {
+        return -1;
+    }
+
+    return m_mean;
+}
+
+auto Nedrysoft::RouteAnalyser::LatencySketch::standardDeviation() const -> double {
+    if (m_count == 0) {
+        return -1;
+    }
+
+    return std::sqrt(m_sumOfSquares / static_cast<double>(m_count));
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYSKETCH_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYSKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The LatencySketch class is a bounded memory summary of a latency distribution.
+     *
+     * @details     Quantiles are estimated with a DDSketch, values are counted in logarithmically sized buckets so
+     *              that any quantile is returned with a fixed relative error.  The number of buckets is capped, if
+     *              the range of values would exceed the cap then the lowest buckets are collapsed together which
+     *              only affects the accuracy of the lowest quantiles.
+     *
+     *              The mean and standard deviation are tracked with Welford's algorithm, which unlike a running
+     *              average does not lose precision as the number of samples grows.
+     *
+     *              Adding a value is constant time and two sketches can be merged, for example to combine the
+     *              results of several sessions.
+     */
+    class LatencySketch {
+        public:
+            /**
+             * @brief       Constructs an empty LatencySketch.
+             */
+            LatencySketch();
+
+            /**
+             * @brief       Adds a value to the sketch.
+             *
+             * @param[in]   value the latency in seconds.
+             */
+            auto add(double value) -> void;
+
+            /**
+             * @brief       Merges another sketch into this sketch.
+             *
+             * @param[in]   other the sketch to merge.
+             */
+            auto merge(const Nedrysoft::RouteAnalyser::LatencySketch &other) -> void;
+
+            /**
+             * @brief       Removes all values from the sketch.
+             */
+            auto clear() -> void;
+
+            /**
+             * @brief       Returns the estimated value at the given quantile.
+             *
+             * @param[in]   quantile the quantile between 0 and 1, i.e 0.95 for the 95th percentile.
+             *
+             * @returns     the latency in seconds if the sketch contains values; otherwise -1.
+             */
+            auto quantile(double quantile) const -> double;
+
+            /**
+             * @brief       Returns the number of values added to the sketch.
+             *
+             * @returns     the number of values.
+             */
+            auto count() const -> uint64_t;
+
+            /**
+             * @brief       Returns the mean of the values.
+             *
+             * @returns     the mean latency in seconds if the sketch contains values; otherwise -1.
+             */
+            auto mean() const -> double;
+
+            /**
+             * @brief       Returns the population standard deviation of the values.
+             *
+             * @returns     the standard deviation in seconds if the sketch contains values; otherwise -1.
+             */
+            auto standardDeviation() const -> double;
+
+        private:
+            /**
+             * @brief       Returns the bucket index for a value.
+             *
+             * @param[in]   value the value.
+             *
+             * @returns     the bucket index.
+             */
+            auto bucketIndex(double value) const -> int;
+
+            /**
+             * @brief       Returns the value represented by a bucket.
+             *
+             * @param[in]   index the bucket index.
+             *
+             * @returns     the value.
+             */
+            auto bucketValue(int index) const -> double;
+
+            /**
+             * @brief       Adds a count to a bucket, extending or collapsing the bucket range as required.
+             *
+             * @param[in]   index the bucket index.
+             * @param[in]   count the count to add.
+             */
+            auto addToBucket(int index, uint64_t count) -> void;
+
+        private:
+            //! @cond
+
+            std::vector<uint64_t> m_buckets;
+            int m_firstIndex;
+            uint64_t m_zeroCount;
+
+            uint64_t m_count;
+            double m_mean;
+            double m_sumOfSquares;
+            double m_minimum;
+            double m_maximum;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_LATENCYSKETCH_H
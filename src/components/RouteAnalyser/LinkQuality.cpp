@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LinkQuality.h"
+
+#include <QtGlobal>
+#include <cmath>
+
+constexpr auto JitterGain = 1.0/16.0;
+constexpr auto MillisecondsPerSecond = 1000.0;
+
+// E-model constants from ITU-T G.107 (default values) and G.113 Appendix I (G.711 with packet loss concealment).
+
+constexpr auto DefaultTransmissionRating = 93.2;
+constexpr auto DelayImpairmentFactor = 0.024;
+constexpr auto DelayImpairmentThreshold = 177.3;
+constexpr auto DelayImpairmentExcessFactor = 0.11;
+constexpr auto EquipmentImpairment = 0.0;
+constexpr auto PacketLossRobustness = 25.1;
+constexpr auto PacketisationDelay = 20.0;
+constexpr auto JitterBufferFactor = 2.0;
+
+Nedrysoft::RouteAnalyser::LinkQuality::LinkQuality() :
+        m_replyCount(0),
+        m_lostCount(0),
+        m_meanRoundTripTime(0),
+        m_previousRoundTripTime(-1),
+        m_jitter(-1),
+        m_currentBurst(0),
+        m_maximumBurst(0) {
+
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::addReply(double roundTripTime) -> void {
+    m_replyCount++;
+
+    m_meanRoundTripTime += (roundTripTime - m_meanRoundTripTime) / static_cast<double>(m_replyCount);
+
+    if (m_previousRoundTripTime >= 0) {
+        auto difference = std::abs(roundTripTime - m_previousRoundTripTime);
+
+        if (m_jitter < 0) {
+            m_jitter = 0;
+        }
+
+        m_jitter += (difference - m_jitter) * JitterGain;
+    }
+
+    m_previousRoundTripTime = roundTripTime;
+
+    if (m_currentBurst) {
+        m_lossBursts[m_currentBurst]++;
+
+        m_currentBurst = 0;
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::addLoss() -> void {
+    m_lostCount++;
+    m_currentBurst++;
+
+    m_maximumBurst = qMax(m_maximumBurst, m_currentBurst);
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::jitter() const -> double {
+    return m_jitter;
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::lossBursts() const -> QMap<int, uint64_t> {
+    return m_lossBursts;
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::meanLossBurst() const -> double {
+    uint64_t burstCount = 0;
+    uint64_t burstTotal = 0;
+
+    for (auto it = m_lossBursts.constBegin(); it != m_lossBursts.constEnd(); it++) {
+        burstCount += it.value();
+        burstTotal += it.value() * static_cast<uint64_t>(it.key());
+    }
+
+    if (burstCount == 0) {
+        return 0;
+    }
+
+    return static_cast<double>(burstTotal) / static_cast<double>(burstCount);
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::maximumLossBurst() const -> int {
+    return m_maximumBurst;
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::rFactor() const -> double {
+    if (m_replyCount == 0) {
+        return -1;
+    }
+
+    auto jitter = qMax(m_jitter, 0.0);
+
+    auto delay = ( m_meanRoundTripTime / 2.0 + jitter * JitterBufferFactor ) * MillisecondsPerSecond +
+                 PacketisationDelay;
+
+    auto delayImpairment = DelayImpairmentFactor * delay;
+
+    if (delay > DelayImpairmentThreshold) {
+        delayImpairment += DelayImpairmentExcessFactor * ( delay - DelayImpairmentThreshold );
+    }
+
+    auto lossFraction = static_cast<double>(m_lostCount) / static_cast<double>(m_replyCount + m_lostCount);
+
+    // for random loss the expected mean burst length is 1/(1-p), BurstR is the ratio of the observed to expected.
+
+    auto burstRatio = qMax(1.0, meanLossBurst() * ( 1.0 - lossFraction ));
+    auto lossPercent = lossFraction * 100.0;
+
+    auto equipmentImpairment = EquipmentImpairment +
+                               ( 95.0 - EquipmentImpairment ) * lossPercent /
+                               ( lossPercent / burstRatio + PacketLossRobustness );
+
+    return qBound(0.0, DefaultTransmissionRating - delayImpairment - equipmentImpairment, 100.0);
+}
+
+auto Nedrysoft::RouteAnalyser::LinkQuality::meanOpinionScore() const -> double {
+    auto rating = rFactor();
+
+    if (rating < 0) {
+        return -1;
+    }
+
+    return 1.0 + 0.035 * rating + rating * ( rating - 60.0 ) * ( 100.0 - rating ) * 7.0e-6;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_LINKQUALITY_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_LINKQUALITY_H
+
+#include "RouteAnalyserSpec.h"
+
+#include <QMap>
+#include <cstdint>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The LinkQuality class estimates the voice call quality of the path to a hop.
+     *
+     * @details     Calculates the RFC 3550 interarrival jitter and the distribution of loss burst lengths from the
+     *              stream of results, these are combined with the mean round trip time to estimate the ITU-T G.107
+     *              E-model transmission rating (R-factor) and the corresponding mean opinion score (MOS).
+     *
+     *              Probes are sent at a fixed interval, so the difference in transit time of consecutive probes is
+     *              the difference in their round trip times.  Results are added in the order that they arrive.
+     *
+     * @class       Nedrysoft::RouteAnalyser::LinkQuality LinkQuality.h <LinkQuality>
+     */
+    class NEDRYSOFT_ROUTEANALYSER_DLLSPEC LinkQuality {
+        public:
+            /**
+             * @brief       Constructs a LinkQuality.
+             */
+            LinkQuality();
+
+            /**
+             * @brief       Adds a reply to the quality calculation.
+             *
+             * @param[in]   roundTripTime the round trip time in seconds.
+             */
+            auto addReply(double roundTripTime) -> void;
+
+            /**
+             * @brief       Adds a lost request to the quality calculation.
+             */
+            auto addLoss() -> void;
+
+            /**
+             * @brief       Returns the RFC 3550 interarrival jitter.
+             *
+             * @returns     the jitter in seconds if at least two replies have been received; otherwise -1.
+             */
+            auto jitter() const -> double;
+
+            /**
+             * @brief       Returns the distribution of loss burst lengths.
+             *
+             * @note        A burst is only counted once it has ended (i.e a reply has been received).
+             *
+             * @returns     a map of burst length to the number of bursts of that length.
+             */
+            auto lossBursts() const -> QMap<int, uint64_t>;
+
+            /**
+             * @brief       Returns the mean length of the loss bursts.
+             *
+             * @returns     the mean burst length if any bursts have occurred; otherwise 0.
+             */
+            auto meanLossBurst() const -> double;
+
+            /**
+             * @brief       Returns the length of the longest loss burst, including any burst in progress.
+             *
+             * @returns     the longest burst length.
+             */
+            auto maximumLossBurst() const -> int;
+
+            /**
+             * @brief       Returns the estimated E-model transmission rating.
+             *
+             * @details     The mouth to ear delay is taken to be half the mean round trip time plus a jitter buffer
+             *              of twice the jitter and a packetisation delay, the equipment impairment is that of G.711
+             *              with packet loss concealment, adjusted for the burstiness of the loss.
+             *
+             * @returns     the R-factor (0 to 100) if any replies have been received; otherwise -1.
+             */
+            auto rFactor() const -> double;
+
+            /**
+             * @brief       Returns the estimated mean opinion score.
+             *
+             * @returns     the MOS (1 to 4.5) if any replies have been received; otherwise -1.
+             */
+            auto meanOpinionScore() const -> double;
+
+        private:
+            //! @cond
+
+            uint64_t m_replyCount;
+            uint64_t m_lostCount;
+            double m_meanRoundTripTime;
+            double m_previousRoundTripTime;
+            double m_jitter;
+            int m_currentBurst;
+            int m_maximumBurst;
+            QMap<int, uint64_t> m_lossBursts;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_LINKQUALITY_H
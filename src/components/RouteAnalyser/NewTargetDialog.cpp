@@ -155,6 +155,8 @@ Nedrysoft::RouteAnalyser::NewTargetDialog::NewTargetDialog(QWidget *parent) :
         ui->ipV6RadioButton->setChecked(true);
     }
 
+    ui->pathMTUCheckBox->setChecked(targetSettings->defaultPathMTUDiscoveryEnabled());
+
     connect(ui->ipv4RadioButton, &QRadioButton::toggled, [=](bool checked) {
         m_targetHighlighter->rehighlight();
         updateButtonBoxState();
@@ -234,6 +236,10 @@ auto Nedrysoft::RouteAnalyser::NewTargetDialog::interval() -> double {
     return intervalTime;
 }
 
+auto Nedrysoft::RouteAnalyser::NewTargetDialog::pathMTUDiscoveryEnabled() -> bool {
+    return ui->pathMTUCheckBox->isChecked();
+}
+
 auto Nedrysoft::RouteAnalyser::NewTargetDialog::checkFieldsValid(QString &string) -> QWidget * {
     double intervalValue;
     QWidget *returnWidget = nullptr;
@@ -94,6 +94,13 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto interval() -> double;
 
+            /**
+             * @brief       Returns whether the path MTU to each hop should be discovered.
+             *
+             * @returns     true if path MTU discovery is enabled; otherwise false.
+             */
+            auto pathMTUDiscoveryEnabled() -> bool;
+
             /**
              * @brief       Updates the button box according to the target text + radio buttons.
              */
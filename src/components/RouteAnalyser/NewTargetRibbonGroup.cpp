@@ -465,6 +465,10 @@ void Nedrysoft::RouteAnalyser::NewTargetRibbonGroup::openTarget(
         editor->setIPVersion(ipVersion);
         editor->setInterval(intervalTime);
 
+        if (parameters.contains("payloadsize")) {
+            editor->setPayload(Nedrysoft::RouteAnalyser::PingPayload::fromVariantMap(parameters));
+        }
+
         editorManager->openEditor(editor);
     }
 }
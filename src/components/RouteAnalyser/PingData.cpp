@@ -26,6 +26,8 @@
 #include "IPlot.h"
 #include "IPlotFactory.h"
 #include "RouteTableItemDelegate.h"
+#include "TableUpdateScheduler.h"
+#include "Utils.h"
 
 #include <IComponentManager>
 #include <IHostMasker>
@@ -34,55 +36,120 @@
 #include <QStandardItemModel>
 #include <QTableWidget>
 
-Nedrysoft::RouteAnalyser::PingData::PingData(QStandardItemModel *tableModel, int hop, bool hopValid) :
+constexpr auto OneMinute = 60.0;
+constexpr auto FifteenMinutes = 15.0*60.0;
+constexpr auto OneHour = 60.0*60.0;
+constexpr auto NanosecondsPerSecond = 1000000000.0;
+
+Nedrysoft::RouteAnalyser::PingData::PingData(
+        QStandardItemModel *tableModel,
+        Nedrysoft::RouteAnalyser::TableUpdateScheduler *tableUpdateScheduler,
+        int hop,
+        bool hopValid) :
+
         m_tableModel(tableModel),
+        m_tableUpdateScheduler(tableUpdateScheduler),
         m_customPlot(nullptr),
         m_jitterPlot(nullptr),
         m_replyPacketCount(0),
         m_timeoutPacketCount(0),
         m_hop(hop),
+        m_pathMTU(-1),
+        m_bandwidth(-1),
+        m_echoReply(false),
         m_hopValid(hopValid),
         m_count(0),
+        m_maskedHostValid(false),
         m_currentLatency(-1),
         m_maximumLatency(-1),
         m_minimumLatency(-1),
         m_averageLatency(-1),
-        m_historicalLatency(-1) {
-}
+        m_historicalLatency(-1),
+        m_statisticsWindow(StatisticsWindow::Session),
+        m_viewportSummary({0, -1, -1, -1, 0, 0}) {
 
-auto Nedrysoft::RouteAnalyser::PingData::runningAverage(double previousAverage, double value, double n) -> double {
-    return (previousAverage*(n-1)+value)/n;
+    m_windowedStatistics[StatisticsWindow::OneMinute] = WindowedStatistics(OneMinute);
+    m_windowedStatistics[StatisticsWindow::FifteenMinutes] = WindowedStatistics(FifteenMinutes);
+    m_windowedStatistics[StatisticsWindow::OneHour] = WindowedStatistics(OneHour);
 }
 
-auto Nedrysoft::RouteAnalyser::PingData::updateModel() -> void {
+auto Nedrysoft::RouteAnalyser::PingData::updateMaskedHost() -> void {
+    if (m_maskedHostValid) {
+        return;
+    }
+
     auto hostMaskerManager = Nedrysoft::Core::IHostMaskerManager::getInstance();
 
+    m_maskedHostName = m_hostName;
+    m_maskedHostAddress = m_hostAddress;
+
     if (hostMaskerManager) {
         for (auto masker : hostMaskerManager->maskers()) {
-            QString maskedHostName;
-            QString maskedHostAddress;
-
             if (masker->mask(m_hop, m_hostName, m_hostAddress, m_maskedHostName, m_maskedHostAddress)) {
                 break;
             }
         }
     }
 
-    if (m_tableModel) {
-        auto topLeft = m_tableModel->index(0, 0);
-        auto bottomRight = topLeft.sibling(m_tableModel->rowCount() - 1, m_tableModel->columnCount() - 1);
+    m_maskedHostValid = true;
+}
 
-        m_tableModel->dataChanged(topLeft, bottomRight);
+auto Nedrysoft::RouteAnalyser::PingData::updateModel() -> void {
+    m_maskedHostValid = false;
+
+    if (m_tableUpdateScheduler) {
+        m_tableUpdateScheduler->invalidate(m_hop - 1);
     }
 }
 
+auto Nedrysoft::RouteAnalyser::PingData::invalidate(Nedrysoft::RouteAnalyser::PingData::Fields field) -> void {
+    if (!m_tableUpdateScheduler) {
+        return;
+    }
+
+    auto row = m_hop - 1;
+
+    switch (field) {
+        case Fields::Graph: {
+            // the graph of a row is joined to the graphs of the rows either side of it.
+
+            m_tableUpdateScheduler->invalidate(row - 1, row + 1, static_cast<int>(Fields::Graph));
+
+            break;
+        }
+
+        default: {
+            m_tableUpdateScheduler->invalidate(row, static_cast<int>(field));
+
+            break;
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::invalidate(
+        Nedrysoft::RouteAnalyser::PingData::Fields firstField,
+        Nedrysoft::RouteAnalyser::PingData::Fields lastField ) -> void {
+
+    if (!m_tableUpdateScheduler) {
+        return;
+    }
+
+    m_tableUpdateScheduler->invalidate(m_hop - 1, m_hop - 1, static_cast<int>(firstField), static_cast<int>(lastField));
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::invalidateStatistics() -> void {
+    invalidate(Fields::Count);
+    invalidate(Fields::AverageLatency, Fields::MeanOpinionScore);
+}
+
 auto Nedrysoft::RouteAnalyser::PingData::plotTitle() -> QString {
     auto hostMaskerManager = Nedrysoft::Core::IHostMaskerManager::getInstance();
 
     QString titleString;
 
     if ((hostMaskerManager) && (hostMaskerManager->enabled(Nedrysoft::Core::HostMask::HostMaskType::Screen))) {
-        titleString = QString(QObject::tr("Hop %1")).arg(m_hop) + " " + m_maskedHostName + " (" + m_maskedHostAddress + ")";
+        titleString = QString(QObject::tr("Hop %1")).arg(m_hop) + " " +
+                      maskedHostName() + " (" + maskedHostAddress() + ")";
     } else {
         titleString = QString(QObject::tr("Hop %1")).arg(m_hop) + " " + m_hostName + " (" + m_hostAddress + ")";
     }
@@ -127,6 +194,19 @@ auto Nedrysoft::RouteAnalyser::PingData::hostName() -> QString {
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::packetLoss() -> double {
+    if (m_statisticsWindow == StatisticsWindow::Viewport) {
+        if (m_viewportSummary.replies + m_viewportSummary.lost == 0) {
+            return -1;
+        }
+
+        return (static_cast<double>(m_viewportSummary.lost)/
+                static_cast<double>(m_viewportSummary.replies + m_viewportSummary.lost))*100.0;
+    }
+
+    if (m_statisticsWindow != StatisticsWindow::Session) {
+        return m_windowedStatistics[m_statisticsWindow].packetLoss();
+    }
+
     if (m_replyPacketCount+m_timeoutPacketCount==0) {
         return -1;
     }
@@ -136,19 +216,41 @@ auto Nedrysoft::RouteAnalyser::PingData::packetLoss() -> double {
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::updateItem(Nedrysoft::RouteAnalyser::PingResult result) -> void {
+    auto requestTime = static_cast<double>(result.requestTimestamp()) / NanosecondsPerSecond;
+
     m_count = result.sampleNumber();
 
+    for (auto window = m_windowedStatistics.begin(); window != m_windowedStatistics.end(); window++) {
+        if (result.code() == Nedrysoft::RouteAnalyser::PingResult::ResultCode::NoReply) {
+            window->add(requestTime, -1);
+        } else {
+            window->add(requestTime, result.roundTripTime());
+        }
+    }
+
     if (result.code() == Nedrysoft::RouteAnalyser::PingResult::ResultCode::NoReply) {
         m_timeoutPacketCount++;
 
-        if (m_tableModel) {
-            updateModel();
-        }
+        m_linkQuality.addLoss();
+
+        invalidateStatistics();
 
         return;
     }
 
     m_currentLatency = result.roundTripTime();
+    m_echoReply = (result.code() == Nedrysoft::RouteAnalyser::PingResult::ResultCode::Ok);
+
+    if (result.payloadSize() >= 0) {
+        auto payloadSize = result.payloadSize();
+        auto &minimumLatencyBySize = m_echoReply ? m_minimumEchoLatencyBySize : m_minimumErrorLatencyBySize;
+
+        if ((!minimumLatencyBySize.contains(payloadSize)) ||
+            (m_currentLatency < minimumLatencyBySize[payloadSize])) {
+
+            minimumLatencyBySize[payloadSize] = m_currentLatency;
+        }
+    }
 
     if (m_minimumLatency < 0) {
         m_minimumLatency = m_currentLatency;
@@ -166,11 +268,15 @@ auto Nedrysoft::RouteAnalyser::PingData::updateItem(Nedrysoft::RouteAnalyser::Pi
         m_maximumLatency = m_currentLatency;
     }
 
+    auto graphScaleChanged = false;
+
     if (m_maximumLatency > m_tableModel->property("graphMaxLatency").toDouble()) {
         if (m_tableModel) {
             m_tableModel->setProperty("graphMaxLatency", QVariant(m_maximumLatency));
         }
 
+        graphScaleChanged = true;
+
         auto headerItem = m_tableModel->horizontalHeaderItem(static_cast<int>(Fields::Graph));
 
         if (headerItem) {
@@ -184,29 +290,34 @@ auto Nedrysoft::RouteAnalyser::PingData::updateItem(Nedrysoft::RouteAnalyser::Pi
         if (m_tableModel) {
             m_tableModel->setProperty("graphMinLatency", QVariant(m_minimumLatency));
         }
-    }
 
-    if (m_averageLatency < 0) {
-        m_averageLatency = m_currentLatency;
-    } else {
-        m_averageLatency = runningAverage(
-                m_averageLatency,
-                m_currentLatency,
-                static_cast<double>(m_replyPacketCount) + 1.0
-        );
+        graphScaleChanged = true;
     }
 
+    m_latencySketch.add(m_currentLatency);
+    m_linkQuality.addReply(m_currentLatency);
+
+    m_averageLatency = m_latencySketch.mean();
+
     m_replyPacketCount++;
 
     /*auto packetLoss = (static_cast<double>(m_timeoutPacketCount)/
                 static_cast<double>(m_replyPacketCount+m_timeoutPacketCount))*100.0;*/
 
     for (auto plot : m_plots) {
-        plot->update(result.requestTime().toMSecsSinceEpoch(), result.roundTripTime());
+        plot->update(requestTime, result.roundTripTime());
     }
 
-    if (m_tableModel) {
-        updateModel();
+    invalidateStatistics();
+
+    if (m_tableUpdateScheduler) {
+        if (graphScaleChanged) {
+            // the scale is shared by every row, so the whole graph column is redrawn.
+
+            m_tableUpdateScheduler->invalidate(0, m_tableModel->rowCount() - 1, static_cast<int>(Fields::Graph));
+        } else {
+            invalidate(Fields::Graph);
+        }
     }
 }
 
@@ -225,9 +336,7 @@ auto Nedrysoft::RouteAnalyser::PingData::location() -> QString {
 auto Nedrysoft::RouteAnalyser::PingData::setLocation(const QString &location) -> void {
     m_location = location;
 
-    if (m_tableModel) {
-        updateModel();
-    }
+    invalidate(Fields::Location);
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::hopValid() -> bool {
@@ -237,20 +346,58 @@ auto Nedrysoft::RouteAnalyser::PingData::hopValid() -> bool {
 auto Nedrysoft::RouteAnalyser::PingData::setHopValid(bool hopValid) -> void {
     m_hopValid = hopValid;
 
-    if (m_tableModel) {
-        updateModel();
+    if (m_tableUpdateScheduler) {
+        m_tableUpdateScheduler->invalidate(m_hop - 1);
     }
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::setHistoricalLatency(double latency) -> void {
     m_historicalLatency = latency;
 
-    if (m_tableModel) {
-        updateModel();
-    }
+    invalidate(Fields::Graph);
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::latency(int field) -> double {
+    if (m_statisticsWindow == StatisticsWindow::Viewport) {
+        switch (static_cast<Fields>(field)) {
+            case Fields::MinimumLatency: {
+                return m_viewportSummary.minimum;
+            }
+
+            case Fields::MaximumLatency: {
+                return m_viewportSummary.maximum;
+            }
+
+            case Fields::AverageLatency: {
+                return m_viewportSummary.mean;
+            }
+
+            default: {
+                break;
+            }
+        }
+    } else if (m_statisticsWindow != StatisticsWindow::Session) {
+        auto &statistics = m_windowedStatistics[m_statisticsWindow];
+
+        switch (static_cast<Fields>(field)) {
+            case Fields::MinimumLatency: {
+                return statistics.minimum();
+            }
+
+            case Fields::MaximumLatency: {
+                return statistics.maximum();
+            }
+
+            case Fields::AverageLatency: {
+                return statistics.average();
+            }
+
+            default: {
+                break;
+            }
+        }
+    }
+
     switch (static_cast<Fields>(field)) {
         case Fields::MinimumLatency: {
             return m_minimumLatency;
@@ -272,6 +419,26 @@ auto Nedrysoft::RouteAnalyser::PingData::latency(int field) -> double {
             return m_historicalLatency;
         }
 
+        case Fields::Percentile50: {
+            return m_latencySketch.quantile(0.50);
+        }
+
+        case Fields::Percentile95: {
+            return m_latencySketch.quantile(0.95);
+        }
+
+        case Fields::Percentile99: {
+            return m_latencySketch.quantile(0.99);
+        }
+
+        case Fields::StandardDeviation: {
+            return m_latencySketch.standardDeviation();
+        }
+
+        case Fields::Jitter: {
+            return m_linkQuality.jitter();
+        }
+
         default: {
             break;
         }
@@ -280,53 +447,225 @@ auto Nedrysoft::RouteAnalyser::PingData::latency(int field) -> double {
     return 0;
 }
 
-auto Nedrysoft::RouteAnalyser::PingData::tableModel() -> QStandardItemModel * {
-    return m_tableModel;
+auto Nedrysoft::RouteAnalyser::PingData::setStatisticsWindow(
+        Nedrysoft::RouteAnalyser::PingData::StatisticsWindow window) -> void {
+
+    m_statisticsWindow = window;
+
+    invalidate(Fields::AverageLatency, Fields::MeanOpinionScore);
 }
 
-auto Nedrysoft::RouteAnalyser::PingData::count() -> unsigned long  {
-    return m_count;
+auto Nedrysoft::RouteAnalyser::PingData::statisticsWindow() -> Nedrysoft::RouteAnalyser::PingData::StatisticsWindow {
+    return m_statisticsWindow;
 }
 
-auto Nedrysoft::RouteAnalyser::PingData::setPlots(QList<Nedrysoft::RouteAnalyser::IPlot *> plots) -> void {
-    m_plots = plots;
+auto Nedrysoft::RouteAnalyser::PingData::setViewportSummary(
+        const Nedrysoft::RouteAnalyser::SampleStore::Rollup &summary) -> void {
+
+    if ((summary.minimum == m_viewportSummary.minimum) &&
+        (summary.maximum == m_viewportSummary.maximum) &&
+        (summary.mean == m_viewportSummary.mean) &&
+        (summary.replies == m_viewportSummary.replies) &&
+        (summary.lost == m_viewportSummary.lost)) {
+
+        return;
+    }
+
+    m_viewportSummary = summary;
+
+    if (m_statisticsWindow == StatisticsWindow::Viewport) {
+        invalidate(Fields::MinimumLatency);
+        invalidate(Fields::MaximumLatency);
+        invalidate(Fields::AverageLatency);
+        invalidate(Fields::PacketLoss);
+    }
 }
 
-auto Nedrysoft::RouteAnalyser::PingData::setMaximum(
+auto Nedrysoft::RouteAnalyser::PingData::linkQuality() const -> const Nedrysoft::RouteAnalyser::LinkQuality & {
+    return m_linkQuality;
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::text(
         Nedrysoft::RouteAnalyser::PingData::Fields field,
-        bool isMaximum ) -> void {
+        Nedrysoft::Core::HostMask::HostMaskType maskType) -> QString {
+
+    auto hostMaskerManager = Nedrysoft::Core::IHostMaskerManager::getInstance();
+    auto masked = (hostMaskerManager) && (hostMaskerManager->enabled(maskType));
+
+    switch (field) {
+        case Fields::Hop: {
+            return QString::number(m_hop);
+        }
+
+        case Fields::Count: {
+            return m_count ? QString::number(m_count) : QString();
+        }
+
+        case Fields::IP: {
+            return masked ? maskedHostAddress() : m_hostAddress;
+        }
+
+        case Fields::HostName: {
+            return masked ? maskedHostName() : m_hostName;
+        }
+
+        case Fields::Location: {
+            return m_location;
+        }
+
+        case Fields::PacketLoss: {
+            auto loss = packetLoss();
+
+            return (loss < 0) ? QString() : QString("%1").arg(loss, 0, 'f', 2);
+        }
+
+        case Fields::LossBurst: {
+            if (m_linkQuality.maximumLossBurst() == 0) {
+                return QString();
+            }
+
+            return QString("%1/%2")
+                .arg(m_linkQuality.meanLossBurst(), 0, 'f', 1)
+                .arg(m_linkQuality.maximumLossBurst());
+        }
+
+        case Fields::RFactor: {
+            auto rating = m_linkQuality.rFactor();
+
+            return (rating < 0) ? QString() : QString("%1").arg(rating, 0, 'f', 1);
+        }
+
+        case Fields::MeanOpinionScore: {
+            auto score = m_linkQuality.meanOpinionScore();
+
+            return (score < 0) ? QString() : QString("%1").arg(score, 0, 'f', 2);
+        }
+
+        case Fields::PathMTU: {
+            return (m_pathMTU < 0) ? QString() : QString::number(m_pathMTU);
+        }
+
+        case Fields::Bandwidth: {
+            return (m_bandwidth <= 0) ? QString() : Nedrysoft::Utils::bandwidthToString(m_bandwidth);
+        }
+
+        case Fields::Graph: {
+            return QString();
+        }
+
+        default: {
+            break;
+        }
+    }
+
+    // the remaining fields are latencies, which are shown in milliseconds.
 
-    m_isMaximum[field] = isMaximum;
+    auto value = latency(static_cast<int>(field));
+
+    if (value < 0) {
+        return QString();
+    }
+
+    return QString("%1").arg(value*1000.0, 0, 'f', 2);
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::latencySketch() const -> const Nedrysoft::RouteAnalyser::LatencySketch & {
+    return m_latencySketch;
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::setPathMTU(int mtu) -> void {
+    m_pathMTU = mtu;
+
+    invalidate(Fields::PathMTU);
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::pathMTU() -> int {
+    return m_pathMTU;
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::serialisationDelay(int smallSize, int largeSize) -> double {
+    if (largeSize <= smallSize) {
+        return -1;
+    }
+
+    auto hasPair = [smallSize, largeSize](const QMap<int, double> &minimumLatencyBySize) -> bool {
+        return minimumLatencyBySize.contains(smallSize) && minimumLatencyBySize.contains(largeSize);
+    };
+
+    // the pair that matches the most recent type of reply is preferred, as it reflects the current route.
+
+    auto echoReply = m_echoReply;
+
+    if (!hasPair(echoReply ? m_minimumEchoLatencyBySize : m_minimumErrorLatencyBySize)) {
+        echoReply = !echoReply;
+
+        if (!hasPair(echoReply ? m_minimumEchoLatencyBySize : m_minimumErrorLatencyBySize)) {
+            return -1;
+        }
+    }
+
+    auto &minimumLatencyBySize = echoReply ? m_minimumEchoLatencyBySize : m_minimumErrorLatencyBySize;
+
+    auto delay = (minimumLatencyBySize[largeSize] - minimumLatencyBySize[smallSize]) /
+                 static_cast<double>(largeSize - smallSize);
+
+    if (echoReply) {
+        delay /= 2.0;
+    }
+
+    return delay;
 }
 
-auto Nedrysoft::RouteAnalyser::PingData::isMaximum(Nedrysoft::RouteAnalyser::PingData::Fields field) -> bool {
-    if (m_isMaximum.contains(field)) {
-        return m_isMaximum[field];
+auto Nedrysoft::RouteAnalyser::PingData::setBandwidth(double bandwidth) -> void {
+    if (m_bandwidth == bandwidth) {
+        return;
     }
 
-    return false;
+    m_bandwidth = bandwidth;
+
+    invalidate(Fields::Bandwidth);
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::bandwidth() -> double {
+    return m_bandwidth;
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::tableModel() -> QStandardItemModel * {
+    return m_tableModel;
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::count() -> unsigned long  {
+    return m_count;
+}
+
+auto Nedrysoft::RouteAnalyser::PingData::setPlots(QList<Nedrysoft::RouteAnalyser::IPlot *> plots) -> void {
+    m_plots = plots;
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::setMaskedHostAddress(const QString &maskedHostAddress) -> void {
+    updateMaskedHost();
+
     m_maskedHostAddress = maskedHostAddress;
 
-    if (m_tableModel) {
-        updateModel();
-    }
+    invalidate(Fields::IP);
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::maskedHostAddress() -> QString {
+    updateMaskedHost();
+
     return m_maskedHostAddress;
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::setMaskedHostName(const QString &maskedHostName) -> void {
+    updateMaskedHost();
+
     m_maskedHostName = maskedHostName;
 
-    if (m_tableModel) {
-        updateModel();
-    }
+    invalidate(Fields::HostName);
 }
 
 auto Nedrysoft::RouteAnalyser::PingData::maskedHostName() -> QString {
+    updateMaskedHost();
+
     return m_maskedHostName;
 }
@@ -24,8 +24,13 @@
 #ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_PINGDATA_H
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_PINGDATA_H
 
+#include "LatencySketch.h"
+#include "LinkQuality.h"
 #include "PingResult.h"
+#include "SampleStore.h"
+#include "WindowedStatistics.h"
 
+#include <IHostMaskerManager>
 #include <QPersistentModelIndex>
 #include <QString>
 #include <QVariant>
@@ -39,12 +44,19 @@ class QStandardItemModel;
 
 namespace Nedrysoft { namespace RouteAnalyser {
     class RouteItemTableDelegate;
+    class TableUpdateScheduler;
     class IPlot;
 
     /**
      * @brief       The PingData class is used to store data for a table model.
      *
      * @details     Holds data about each hop and updates the route table when the object is updated.
+     *
+     *              The samples themselves are held in the SampleStore, the viewport statistics are read from it so
+     *              that they cover whatever range is visible.  The session totals, the percentiles, the jitter and
+     *              the fixed statistics windows are running summaries that are updated as each result arrives, they
+     *              are kept here because they describe the whole session while the store only holds the samples
+     *              within its retention period.
      */
     class PingData {
         public:
@@ -61,12 +73,33 @@ namespace Nedrysoft { namespace RouteAnalyser {
                 MinimumLatency,
                 MaximumLatency,
                 CurrentLatency,
+                Percentile50,
+                Percentile95,
+                Percentile99,
+                StandardDeviation,
                 PacketLoss,
+                Jitter,
+                LossBurst,
+                RFactor,
+                MeanOpinionScore,
+                PathMTU,
+                Bandwidth,
                 Graph,
 
                 HistoricalLatency = 100
             };
 
+            /**
+             * @brief       The window over which the minimum, maximum, average and packet loss are calculated.
+             */
+            enum class StatisticsWindow {
+                Session,
+                OneMinute,
+                FifteenMinutes,
+                OneHour,
+                Viewport
+            };
+
         public:
             /**
              * @brief       Constructs a new PingData instance.
@@ -95,10 +128,16 @@ namespace Nedrysoft { namespace RouteAnalyser {
              *              with default information.
              *
              * @param[in]   tableModel the table model.
+             * @param[in]   tableUpdateScheduler the scheduler that notifies views of changes to the table.
              * @param[in]   hop the hop number of this item.
              * @param[in]   hopValid true if the hop responds to ping; otherwise false.
              */
-            PingData(QStandardItemModel *tableModel, int hop, bool hopValid);
+            PingData(
+                QStandardItemModel *tableModel,
+                Nedrysoft::RouteAnalyser::TableUpdateScheduler *tableUpdateScheduler,
+                int hop,
+                bool hopValid
+            );
 
             /**
              * @brief       Sets the historical latency for this point.
@@ -238,6 +277,59 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto latency(int field) -> double;
 
+            /**
+             * @brief       Sets the window used for the minimum, maximum, average and packet loss values.
+             *
+             * @note        The current latency and the percentiles are not affected by the window.
+             *
+             * @param[in]   window the statistics window.
+             */
+            auto setStatisticsWindow(Nedrysoft::RouteAnalyser::PingData::StatisticsWindow window) -> void;
+
+            /**
+             * @brief       Returns the window used for the minimum, maximum, average and packet loss values.
+             *
+             * @returns     the statistics window.
+             */
+            auto statisticsWindow() -> Nedrysoft::RouteAnalyser::PingData::StatisticsWindow;
+
+            /**
+             * @brief       Sets the summary of the samples within the viewport.
+             *
+             * @details     The summary is read from the sample store by the owner of the viewport whenever the
+             *              visible range changes, the viewport statistics window is taken from it.
+             *
+             * @param[in]   summary the summary of the samples within the viewport.
+             */
+            auto setViewportSummary(const Nedrysoft::RouteAnalyser::SampleStore::Rollup &summary) -> void;
+
+            /**
+             * @brief       Returns the voice quality metrics for this hop.
+             *
+             * @returns     the link quality.
+             */
+            auto linkQuality() const -> const Nedrysoft::RouteAnalyser::LinkQuality &;
+
+            /**
+             * @brief       Returns the text representation of a field, as used when the table is exported.
+             *
+             * @param[in]   field the field.
+             * @param[in]   maskType the host masking mode which applies to the output.
+             *
+             * @returns     the text; an empty string if the field has no value.
+             */
+            auto text(
+                Nedrysoft::RouteAnalyser::PingData::Fields field,
+                Nedrysoft::Core::HostMask::HostMaskType maskType
+            ) -> QString;
+
+            /**
+             * @brief       Returns the latency distribution for this hop.
+             *
+             * @returns     the latency sketch.
+             */
+            auto latencySketch() const -> const Nedrysoft::RouteAnalyser::LatencySketch &;
+
             /**
              * @brief       Returns the packet loss %.
              *
@@ -246,53 +338,72 @@ namespace Nedrysoft { namespace RouteAnalyser {
             auto packetLoss() -> double;
 
             /**
-             * @brief       Sets the plots associated with this.
+             * @brief       Sets the path MTU to this hop.
              *
-             * @param[in]   plots the plots.
+             * @param[in]   mtu the path MTU in bytes; -1 if unknown.
              */
-            auto setPlots(QList<Nedrysoft::RouteAnalyser::IPlot *> plots) -> void;
+            auto setPathMTU(int mtu) -> void;
 
             /**
-             * @brief       Returns whether this item for the given field is the maximum value.
+             * @brief       Returns the path MTU to this hop.
              *
-             * @returns     true if the field is maximum; otherwise false.
+             * @returns     the path MTU in bytes if discovered; otherwise -1.
              */
-            auto isMaximum(Nedrysoft::RouteAnalyser::PingData::Fields field) -> bool;
+            auto pathMTU() -> int;
 
             /**
-             * @brief       Sets whether this item the given field is the maximum value.
+             * @brief       Returns the serialisation delay per byte to this hop.
+             *
+             * @details     The delay is calculated from the difference between the minimum round trip times of
+             *              the small and large probes, the minimum is used as it contains the least queuing delay.
+             *              Echo replies carry the payload back to us while ICMP errors do not, so the minimums are
+             *              kept separately for each type of reply and a delay is only calculated from a pair of the
+             *              same type, the delay from echo replies is halved.
              *
-             * @param[in]   field the field to set.
-             * @param[in]   isMaximum true if the field is maximum; otherwise false.
+             * @param[in]   smallSize the payload size of the small probes.
+             * @param[in]   largeSize the payload size of the large probes.
+             *
+             * @returns     the delay in seconds per byte if available; otherwise -1.
              */
-            auto setMaximum(Nedrysoft::RouteAnalyser::PingData::Fields field, bool isMaximum) -> void;
+            auto serialisationDelay(int smallSize, int largeSize) -> double;
 
             /**
-             * @brief       Updates the model so that views refresh.
+             * @brief       Sets the estimated bandwidth of the link to this hop.
+             *
+             * @param[in]   bandwidth the bandwidth in bits per second; -1 if unknown.
              */
-            auto updateModel() -> void;
+            auto setBandwidth(double bandwidth) -> void;
 
             /**
-             * @brief       Returns the title string of the associated plot.
+             * @brief       Returns the estimated bandwidth of the link to this hop.
              *
-             * @returns     the plot title.
+             * @returns     the bandwidth in bits per second if available; otherwise -1.
              */
-            auto plotTitle() -> QString;
+            auto bandwidth() -> double;
 
-        protected:
             /**
-             * @brief       Calculates a running average.
+             * @brief       Sets the plots associated with this.
              *
-             * @details     Used to calculate the running average of the latency, does not store previous values.
+             * @param[in]   plots the plots.
+             */
+            auto setPlots(QList<Nedrysoft::RouteAnalyser::IPlot *> plots) -> void;
+
+            /**
+             * @brief       Discards the cached masked host strings and marks the row as changed so that views refresh.
              *
-             * @param[in]   previousAverage the current average.
-             * @param[in]   value the new value to add to the average.
-             * @param[in]   n the number of values (including the new one) used.
+             * @details     Called when the state of the host maskers has changed, the maskers are applied again
+             *              the next time a masked string is required.
+             */
+            auto updateModel() -> void;
+
+            /**
+             * @brief       Returns the title string of the associated plot.
              *
-             * @returns     the average.
+             * @returns     the plot title.
              */
-            static auto runningAverage(double previousAverage, double value, double n) -> double;
+            auto plotTitle() -> QString;
 
+        protected:
             /**
              * @brief       Returns the table model associated with this item.
              *
@@ -309,10 +420,43 @@ namespace Nedrysoft { namespace RouteAnalyser {
 
             friend class RouteTableItemDelegate;
 
+        private:
+            /**
+             * @brief       Applies the host maskers to the host name and address if the cached results are stale.
+             *
+             * @details     The masked strings only depend on the hop, host name and host address, so the maskers
+             *              are run once when one of those changes rather than each time the row is drawn.
+             */
+            auto updateMaskedHost() -> void;
+
+            /**
+             * @brief       Marks the cell of a field in this row as changed.
+             *
+             * @param[in]   field the field that has changed.
+             */
+            auto invalidate(Nedrysoft::RouteAnalyser::PingData::Fields field) -> void;
+
+            /**
+             * @brief       Marks the cells of a range of fields in this row as changed.
+             *
+             * @param[in]   firstField the first field that has changed.
+             * @param[in]   lastField the last field that has changed.
+             */
+            auto invalidate(
+                Nedrysoft::RouteAnalyser::PingData::Fields firstField,
+                Nedrysoft::RouteAnalyser::PingData::Fields lastField
+            ) -> void;
+
+            /**
+             * @brief       Marks the cells of the fields that are calculated from the results as changed.
+             */
+            auto invalidateStatistics() -> void;
+
         private:
             //! @cond
 
             QStandardItemModel *m_tableModel;
+            Nedrysoft::RouteAnalyser::TableUpdateScheduler *m_tableUpdateScheduler;
             QCustomPlot *m_customPlot;
             QCustomPlot *m_jitterPlot;
             QPersistentModelIndex m_modelIndex;
@@ -321,6 +465,9 @@ namespace Nedrysoft { namespace RouteAnalyser {
             unsigned long m_timeoutPacketCount;
 
             int m_hop;
+            int m_pathMTU;
+            double m_bandwidth;
+            bool m_echoReply;
             bool m_hopValid;
             unsigned long m_count;
 
@@ -328,6 +475,7 @@ namespace Nedrysoft { namespace RouteAnalyser {
             QString m_hostName;
             QString m_maskedHostAddress;
             QString m_maskedHostName;
+            bool m_maskedHostValid;
             QString m_location;
 
             double m_currentLatency;
@@ -336,7 +484,15 @@ namespace Nedrysoft { namespace RouteAnalyser {
             double m_averageLatency;
             double m_historicalLatency;
 
-            QMap<Fields, bool> m_isMaximum;
+            Nedrysoft::RouteAnalyser::LatencySketch m_latencySketch;
+            Nedrysoft::RouteAnalyser::LinkQuality m_linkQuality;
+
+            StatisticsWindow m_statisticsWindow;
+            QMap<StatisticsWindow, Nedrysoft::RouteAnalyser::WindowedStatistics> m_windowedStatistics;
+            Nedrysoft::RouteAnalyser::SampleStore::Rollup m_viewportSummary;
+
+            QMap<int, double> m_minimumEchoLatencyBySize;
+            QMap<int, double> m_minimumErrorLatencyBySize;
 
             QList<Nedrysoft::RouteAnalyser::IPlot *> m_plots;
 
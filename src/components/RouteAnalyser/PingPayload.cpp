@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PingPayload.h"
+
+#include "RouteAnalyserConstants.h"
+
+#include <QRandomGenerator>
+
+constexpr auto PayloadSizeKey = "payloadsize";
+constexpr auto PayloadPatternKey = "payloadpattern";
+constexpr auto PayloadSweepSizeKey = "sweepsize";
+
+constexpr auto ZerosPatternName = "zeros";
+constexpr auto RandomPatternName = "random";
+constexpr auto IncrementingPatternName = "incrementing";
+
+Nedrysoft::RouteAnalyser::PingPayload::PingPayload() :
+        m_size(Nedrysoft::RouteAnalyser::Constants::DefaultPayloadSize),
+        m_pattern(Pattern::Zeros),
+        m_sweepSize(0) {
+
+}
+
+Nedrysoft::RouteAnalyser::PingPayload::PingPayload(int size, Pattern pattern, int sweepSize) :
+        m_size(0),
+        m_pattern(pattern),
+        m_sweepSize(0) {
+
+    setSize(size);
+    setSweepSize(sweepSize);
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::size() const -> int {
+    return m_size;
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::setSize(int size) -> void {
+    m_size = qBound(0, size, Nedrysoft::RouteAnalyser::Constants::MaximumPayloadSize);
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::pattern() const -> Pattern {
+    return m_pattern;
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::setPattern(Pattern pattern) -> void {
+    m_pattern = pattern;
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::sweepSize() const -> int {
+    return m_sweepSize;
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::setSweepSize(int sweepSize) -> void {
+    m_sweepSize = qBound(0, sweepSize, Nedrysoft::RouteAnalyser::Constants::MaximumPayloadSize);
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::isSweep() const -> bool {
+    return (m_sweepSize > 0) && (m_sweepSize != m_size);
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::smallSize() const -> int {
+    if (!isSweep()) {
+        return m_size;
+    }
+
+    return qMin(m_size, m_sweepSize);
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::largeSize() const -> int {
+    if (!isSweep()) {
+        return m_size;
+    }
+
+    return qMax(m_size, m_sweepSize);
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::sizeForSample(unsigned long sampleNumber) const -> int {
+    if (!isSweep()) {
+        return m_size;
+    }
+
+    return (sampleNumber & 1) ? largeSize() : smallSize();
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::data(int size) const -> QByteArray {
+    QByteArray payload(qMax(size, 0), 0);
+
+    switch(m_pattern) {
+        case Pattern::Zeros: {
+            break;
+        }
+
+        case Pattern::Random: {
+            auto generator = QRandomGenerator::global();
+
+            for (auto &byte : payload) {
+                byte = static_cast<char>(generator->bounded(256));
+            }
+
+            break;
+        }
+
+        case Pattern::Incrementing: {
+            for (auto index = 0; index < payload.size(); index++) {
+                payload[index] = static_cast<char>(index & 0xFF);
+            }
+
+            break;
+        }
+    }
+
+    return payload;
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::toVariantMap(QVariantMap &parameters) const -> void {
+    parameters[PayloadSizeKey] = m_size;
+    parameters[PayloadPatternKey] = patternName(m_pattern);
+    parameters[PayloadSweepSizeKey] = m_sweepSize;
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::fromVariantMap(
+        const QVariantMap &parameters) -> Nedrysoft::RouteAnalyser::PingPayload {
+
+    return PingPayload(
+        parameters.value(PayloadSizeKey, Nedrysoft::RouteAnalyser::Constants::DefaultPayloadSize).toInt(),
+        patternFromName(parameters.value(PayloadPatternKey).toString()),
+        parameters.value(PayloadSweepSizeKey, 0).toInt()
+    );
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::patternName(Pattern pattern) -> QString {
+    switch(pattern) {
+        case Pattern::Random: {
+            return RandomPatternName;
+        }
+
+        case Pattern::Incrementing: {
+            return IncrementingPatternName;
+        }
+
+        default: {
+            return ZerosPatternName;
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::patternFromName(const QString &name) -> Pattern {
+    if (name == RandomPatternName) {
+        return Pattern::Random;
+    }
+
+    if (name == IncrementingPatternName) {
+        return Pattern::Incrementing;
+    }
+
+    return Pattern::Zeros;
+}
+
+auto Nedrysoft::RouteAnalyser::PingPayload::operator==(const PingPayload &other) const -> bool {
+    return (m_size == other.m_size) && (m_pattern == other.m_pattern) && (m_sweepSize == other.m_sweepSize);
+}
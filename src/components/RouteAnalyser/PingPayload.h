@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_PINGPAYLOAD_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_PINGPAYLOAD_H
+
+#include "RouteAnalyserSpec.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVariantMap>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The PingPayload class describes the payload that is carried by each probe sent to a target.
+     *
+     * @details     The payload has a size and a fill pattern, if a sweep size is set then the probes alternate
+     *              between the payload size and the sweep size, comparing the round trip times of the small and
+     *              large probes allows the serialisation delay (and therefore the bandwidth) of a hop to be
+     *              estimated.
+     *
+     * @class       Nedrysoft::RouteAnalyser::PingPayload PingPayload.h <PingPayload>
+     */
+    class NEDRYSOFT_ROUTEANALYSER_DLLSPEC PingPayload {
+
+        public:
+            /**
+             * @brief       The fill pattern used for the payload.
+             */
+            enum class Pattern {
+                Zeros,
+                Random,
+                Incrementing
+            };
+
+            /**
+             * @brief       Constructs a PingPayload with the default size and pattern.
+             */
+            PingPayload();
+
+            /**
+             * @brief       Constructs a PingPayload with parameters.
+             *
+             * @param[in]   size the size of the payload in bytes.
+             * @param[in]   pattern the fill pattern of the payload.
+             * @param[in]   sweepSize the size of the alternate probe in bytes; 0 to disable the size sweep.
+             */
+            PingPayload(int size, Pattern pattern, int sweepSize = 0);
+
+            /**
+             * @brief       Returns the size of the payload.
+             *
+             * @returns     the size in bytes.
+             */
+            auto size() const -> int;
+
+            /**
+             * @brief       Sets the size of the payload.
+             *
+             * @note        The size is clamped between 0 and Constants::MaximumPayloadSize.
+             *
+             * @param[in]   size the size in bytes.
+             */
+            auto setSize(int size) -> void;
+
+            /**
+             * @brief       Returns the fill pattern of the payload.
+             *
+             * @returns     the pattern.
+             */
+            auto pattern() const -> Pattern;
+
+            /**
+             * @brief       Sets the fill pattern of the payload.
+             *
+             * @param[in]   pattern the pattern.
+             */
+            auto setPattern(Pattern pattern) -> void;
+
+            /**
+             * @brief       Returns the size of the alternate probe used in size sweep mode.
+             *
+             * @returns     the size in bytes; 0 if size sweep is disabled.
+             */
+            auto sweepSize() const -> int;
+
+            /**
+             * @brief       Sets the size of the alternate probe used in size sweep mode.
+             *
+             * @param[in]   sweepSize the size in bytes; 0 to disable the size sweep.
+             */
+            auto setSweepSize(int sweepSize) -> void;
+
+            /**
+             * @brief       Returns whether size sweep mode is enabled.
+             *
+             * @returns     true if probes alternate between two sizes; otherwise false.
+             */
+            auto isSweep() const -> bool;
+
+            /**
+             * @brief       Returns the smaller of the two probe sizes.
+             *
+             * @returns     the size in bytes.
+             */
+            auto smallSize() const -> int;
+
+            /**
+             * @brief       Returns the larger of the two probe sizes.
+             *
+             * @returns     the size in bytes.
+             */
+            auto largeSize() const -> int;
+
+            /**
+             * @brief       Returns the payload size to be used for the given sample.
+             *
+             * @details     In size sweep mode even samples use the small size and odd samples use the large size,
+             *              otherwise the payload size is always returned.
+             *
+             * @param[in]   sampleNumber the sample number of the probe.
+             *
+             * @returns     the size in bytes.
+             */
+            auto sizeForSample(unsigned long sampleNumber) const -> int;
+
+            /**
+             * @brief       Generates the payload data.
+             *
+             * @param[in]   size the number of bytes to generate.
+             *
+             * @returns     the payload filled with the pattern.
+             */
+            auto data(int size) const -> QByteArray;
+
+            /**
+             * @brief       Adds the payload parameters to a target parameter map.
+             *
+             * @param[in,out]   parameters the map to add the parameters to.
+             */
+            auto toVariantMap(QVariantMap &parameters) const -> void;
+
+            /**
+             * @brief       Creates a payload from a target parameter map.
+             *
+             * @note        Missing parameters are set to their defaults.
+             *
+             * @param[in]   parameters the map containing the parameters.
+             *
+             * @returns     the payload.
+             */
+            static auto fromVariantMap(const QVariantMap &parameters) -> PingPayload;
+
+            /**
+             * @brief       Returns the name of a pattern, the name is used when saving configurations.
+             *
+             * @param[in]   pattern the pattern.
+             *
+             * @returns     the name of the pattern.
+             */
+            static auto patternName(Pattern pattern) -> QString;
+
+            /**
+             * @brief       Returns the pattern for a pattern name.
+             *
+             * @param[in]   name the name of the pattern.
+             *
+             * @returns     the pattern; Pattern::Zeros if the name is not recognised.
+             */
+            static auto patternFromName(const QString &name) -> Pattern;
+
+            /**
+             * @brief       Compares two payloads for equality.
+             *
+             * @param[in]   other the payload to compare with.
+             *
+             * @returns     true if the payloads are the same; otherwise false.
+             */
+            auto operator==(const PingPayload &other) const -> bool;
+
+        private:
+            //! @cond
+
+            int m_size;
+            Pattern m_pattern;
+            int m_sweepSize;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_PINGPAYLOAD_H
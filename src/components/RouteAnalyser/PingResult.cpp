@@ -23,13 +23,17 @@
 
 #include "PingResult.h"
 
+constexpr auto NanosecondsPerMillisecond = 1000000LL;
+
 Nedrysoft::RouteAnalyser::PingResult::PingResult() :
     m_sampleNumber(0),
     m_code(PingResult::ResultCode::NoReply),
     m_hostAddress(QHostAddress()),
     m_target(nullptr),
     m_roundTripTime(-1),
-    m_hops(-1) {
+    m_requestTimestamp(0),
+    m_hops(-1),
+    m_payloadSize(-1) {
 
 }
 
@@ -42,15 +46,18 @@ Nedrysoft::RouteAnalyser::PingResult::PingResult(
         QDateTime requestTime,
         double roundTripTime,
         Nedrysoft::RouteAnalyser::IPingTarget *target,
-        int hops) :
+        int hops,
+        int payloadSize) :
 
             m_sampleNumber(sampleNumber),
             m_code(code),
             m_hostAddress(hostAddress),
             m_roundTripTime(roundTripTime),
             m_requestTime(requestTime),
+            m_requestTimestamp(requestTime.isValid() ? requestTime.toMSecsSinceEpoch() * NanosecondsPerMillisecond : 0),
             m_target(target),
-            m_hops(hops) {
+            m_hops(hops),
+            m_payloadSize(payloadSize) {
 
 }
 
@@ -62,6 +69,27 @@ auto Nedrysoft::RouteAnalyser::PingResult::requestTime() -> QDateTime {
     return m_requestTime;
 }
 
+auto Nedrysoft::RouteAnalyser::PingResult::setRequestTimestamp(qint64 requestTimestamp) -> void {
+    m_requestTimestamp = requestTimestamp;
+}
+
+auto Nedrysoft::RouteAnalyser::PingResult::requestTimestamp() -> qint64 {
+    return m_requestTimestamp;
+}
+
+auto Nedrysoft::RouteAnalyser::PingResult::timestamp() -> qint64 {
+    static const auto epochTimestamp = QDateTime::currentMSecsSinceEpoch() * NanosecondsPerMillisecond;
+    static const auto monotonicTimer = []() {
+        QElapsedTimer timer;
+
+        timer.start();
+
+        return timer;
+    }();
+
+    return epochTimestamp + monotonicTimer.nsecsElapsed();
+}
+
 auto Nedrysoft::RouteAnalyser::PingResult::code() -> Nedrysoft::RouteAnalyser::PingResult::ResultCode {
     return m_code;
 }
@@ -80,4 +108,8 @@ auto Nedrysoft::RouteAnalyser::PingResult::target() -> Nedrysoft::RouteAnalyser:
 
 auto Nedrysoft::RouteAnalyser::PingResult::hops() -> int {
     return m_hops;
-}
\ No newline at end of file
+}
+
+auto Nedrysoft::RouteAnalyser::PingResult::payloadSize() -> int {
+    return m_payloadSize;
+}
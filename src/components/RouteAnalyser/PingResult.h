@@ -74,6 +74,7 @@ namespace Nedrysoft { namespace RouteAnalyser {
              * @param[in]   roundTripTime the time taken for the hop to respond.
              * @param[in]   target the target that was pinged.
              * @param[in]   hops the number of hops to the target if available; otherwise false.
+             * @param[in]   payloadSize the size of the payload carried by the request; -1 if not known.
              */
             PingResult(
                 unsigned long sampleNumber,
@@ -82,7 +83,8 @@ namespace Nedrysoft { namespace RouteAnalyser {
                 QDateTime requestTime,
                 double roundTripTime,
                 Nedrysoft::RouteAnalyser::IPingTarget *target,
-                int hops
+                int hops,
+                int payloadSize = -1
             );
 
         public:
@@ -101,6 +103,33 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto requestTime() -> QDateTime;
 
+            /**
+             * @brief       Sets the time that the request was transmitted at with nanosecond resolution.
+             *
+             * @param[in]   requestTimestamp the time in nanoseconds since the unix epoch, see timestamp().
+             */
+            auto setRequestTimestamp(qint64 requestTimestamp) -> void;
+
+            /**
+             * @brief       Returns the time that the request was transmitted at with nanosecond resolution.
+             *
+             * @details     If the engine did not supply a timestamp then it is taken from the request time, which
+             *              only has millisecond resolution.
+             *
+             * @returns     the time in nanoseconds since the unix epoch.
+             */
+            auto requestTimestamp() -> qint64;
+
+            /**
+             * @brief       Returns the current time as a monotonic timestamp.
+             *
+             * @details     The wall clock is read once and the timestamp is then advanced by a monotonic timer, so
+             *              timestamps never go backwards when the system clock is adjusted during a session.
+             *
+             * @returns     the time in nanoseconds since the unix epoch.
+             */
+            static auto timestamp() -> qint64;
+
             /**
              * @brief       The result code for the request (Echo Reply, Timeout).
              *
@@ -142,6 +171,12 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto hops() -> int;
 
+            /**
+             * @brief       The size of the payload that was carried by the request.
+             * @returns     The payload size in bytes if available; otherwise -1.
+             */
+            auto payloadSize() -> int;
+
         protected:
             //! @cond
 
@@ -150,8 +185,10 @@ namespace Nedrysoft { namespace RouteAnalyser {
             QHostAddress m_hostAddress;
             double m_roundTripTime;
             QDateTime m_requestTime;
+            qint64 m_requestTimestamp;
             Nedrysoft::RouteAnalyser::IPingTarget *m_target;
             int m_hops;
+            int m_payloadSize;
 
             //! @endcond
     };
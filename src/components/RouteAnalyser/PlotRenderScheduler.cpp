@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlotRenderScheduler.h"
+
+#include "QCustomPlot/qcustomplot.h"
+
+#include <QTimer>
+#include <algorithm>
+
+constexpr auto DefaultFrameRate = 60;
+constexpr auto MillisecondsPerSecond = 1000;
+
+Nedrysoft::RouteAnalyser::PlotRenderScheduler::PlotRenderScheduler(QObject *parent) :
+        QObject(parent),
+        m_frameTimer(new QTimer(this)),
+        m_rangesInvalid(false),
+        m_frameTime(0) {
+
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+
+    setFrameRate(DefaultFrameRate);
+
+    connect(m_frameTimer, &QTimer::timeout, this, &PlotRenderScheduler::renderFrame);
+}
+
+Nedrysoft::RouteAnalyser::PlotRenderScheduler::~PlotRenderScheduler() {
+
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::setFrameRate(int framesPerSecond) -> void {
+    m_frameTimer->setInterval(MillisecondsPerSecond / std::max(framesPerSecond, 1));
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::frameRate() const -> int {
+    return MillisecondsPerSecond / std::max(m_frameTimer->interval(), 1);
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::setRangeUpdater(std::function<void()> rangeUpdater) -> void {
+    m_rangeUpdater = rangeUpdater;
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::addPlot(QCustomPlot *plot) -> void {
+    if (m_plots.contains(plot)) {
+        return;
+    }
+
+    m_plots.insert(plot);
+
+    connect(plot, &QObject::destroyed, this, [this, plot](QObject *) {
+        m_plots.remove(plot);
+        m_dirtyPlots.remove(plot);
+    });
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::invalidateRanges() -> void {
+    m_rangesInvalid = true;
+
+    requestFrame();
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::invalidate(QCustomPlot *plot) -> void {
+    if (!m_plots.contains(plot)) {
+        return;
+    }
+
+    m_dirtyPlots.insert(plot);
+
+    requestFrame();
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::requestFrame() -> void {
+    if (!m_frameTimer->isActive()) {
+        m_frameTimer->start();
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::frameTime() const -> qint64 {
+    return m_frameTime;
+}
+
+auto Nedrysoft::RouteAnalyser::PlotRenderScheduler::renderFrame() -> void {
+    QElapsedTimer frameTimer;
+
+    frameTimer.start();
+
+    if (m_rangesInvalid) {
+        m_rangesInvalid = false;
+
+        if (m_rangeUpdater) {
+            m_rangeUpdater();
+        }
+    }
+
+    auto plotCount = 0;
+
+    for (auto plotIterator = m_dirtyPlots.begin(); plotIterator != m_dirtyPlots.end();) {
+        auto plot = *plotIterator;
+
+        // plots that cannot be seen keep their changes until they are scrolled into view.
+
+        if ((!plot->isVisible()) || (plot->visibleRegion().isEmpty())) {
+            plotIterator++;
+
+            continue;
+        }
+
+        plot->replot();
+
+        plotCount++;
+
+        plotIterator = m_dirtyPlots.erase(plotIterator);
+    }
+
+    // the plots that were changed while updating the ranges have been drawn, so no further frame is required.
+
+    m_frameTimer->stop();
+
+    if (!plotCount) {
+        return;
+    }
+
+    m_frameTime = frameTimer.nsecsElapsed();
+
+    Q_EMIT frameRendered(m_frameTime, plotCount);
+}
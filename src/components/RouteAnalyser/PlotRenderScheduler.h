@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_PLOTRENDERSCHEDULER_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_PLOTRENDERSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSet>
+#include <functional>
+
+class QCustomPlot;
+class QTimer;
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The PlotRenderScheduler class paces the redrawing of the plots of a route analyser.
+     *
+     * @details     Plots and the viewport ranges are marked as changed as results arrive, once per frame the ranges
+     *              are updated and each changed plot that can be seen is redrawn.  Plots that are scrolled out of
+     *              view are left marked as changed and are drawn when they are next visible.
+     */
+    class PlotRenderScheduler :
+            public QObject {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       Constructs a new PlotRenderScheduler.
+             *
+             * @param[in]   parent the parent object.
+             */
+            explicit PlotRenderScheduler(QObject *parent = nullptr);
+
+            /**
+             * @brief       Destroys the PlotRenderScheduler.
+             */
+            ~PlotRenderScheduler();
+
+            /**
+             * @brief       Sets the maximum rate that frames are drawn at.
+             *
+             * @param[in]   framesPerSecond the number of frames per second.
+             */
+            auto setFrameRate(int framesPerSecond) -> void;
+
+            /**
+             * @brief       Returns the maximum rate that frames are drawn at.
+             *
+             * @returns     the number of frames per second.
+             */
+            auto frameRate() const -> int;
+
+            /**
+             * @brief       Sets the function that updates the ranges of the plots.
+             *
+             * @details     The function is called at the start of a frame when the ranges have been invalidated,
+             *              it is expected to mark any plots that it changes.
+             *
+             * @param[in]   rangeUpdater the function.
+             */
+            auto setRangeUpdater(std::function<void()> rangeUpdater) -> void;
+
+            /**
+             * @brief       Adds a plot to the scheduler.
+             *
+             * @param[in]   plot the plot.
+             */
+            auto addPlot(QCustomPlot *plot) -> void;
+
+            /**
+             * @brief       Marks the ranges of the plots as changed.
+             */
+            auto invalidateRanges() -> void;
+
+            /**
+             * @brief       Marks a plot as changed.
+             *
+             * @param[in]   plot the plot.
+             */
+            auto invalidate(QCustomPlot *plot) -> void;
+
+            /**
+             * @brief       Requests a frame so that any changed plots that have become visible are drawn.
+             */
+            auto requestFrame() -> void;
+
+            /**
+             * @brief       Returns the time taken to draw the last frame.
+             *
+             * @returns     the time in nanoseconds.
+             */
+            auto frameTime() const -> qint64;
+
+            /**
+             * @brief       This signal is emitted when a frame has been drawn.
+             *
+             * @param[in]   frameTime the time taken to draw the frame in nanoseconds.
+             * @param[in]   plotCount the number of plots that were drawn.
+             */
+            Q_SIGNAL void frameRendered(qint64 frameTime, int plotCount);
+
+        private:
+            /**
+             * @brief       Updates the ranges if required and draws the changed plots that are visible.
+             */
+            auto renderFrame() -> void;
+
+        private:
+            //! @cond
+
+            QTimer *m_frameTimer;
+            QSet<QCustomPlot *> m_plots;
+            QSet<QCustomPlot *> m_dirtyPlots;
+            std::function<void()> m_rangeUpdater;
+            bool m_rangesInvalid;
+            qint64 m_frameTime;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_PLOTRENDERSCHEDULER_H
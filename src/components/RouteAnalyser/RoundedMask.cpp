@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RoundedMask.h"
+
+#include <QPainter>
+#include <QPainterPath>
+
+Nedrysoft::RouteAnalyser::RoundedMask::RoundedMask(int radius) :
+        m_radius(radius) {
+
+}
+
+auto Nedrysoft::RouteAnalyser::RoundedMask::apply(QPixmap &pixmap) -> void {
+    QPainter painter(&pixmap);
+
+    painter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+    painter.drawImage(0, 0, mask(pixmap.size()));
+}
+
+auto Nedrysoft::RouteAnalyser::RoundedMask::drawCorners(
+        QPainter *painter,
+        const QRect &rect,
+        const QColor &colour,
+        Qt::Edges edges) -> void {
+
+    auto &cornerPieces = corners(colour);
+    auto right = rect.left() + rect.width() - m_radius;
+    auto bottom = rect.top() + rect.height() - m_radius;
+
+    if (edges & Qt::LeftEdge) {
+        painter->drawPixmap(rect.left(), rect.top(), cornerPieces, 0, 0, m_radius, m_radius);
+        painter->drawPixmap(rect.left(), bottom, cornerPieces, 0, m_radius, m_radius, m_radius);
+    }
+
+    if (edges & Qt::RightEdge) {
+        painter->drawPixmap(right, rect.top(), cornerPieces, m_radius, 0, m_radius, m_radius);
+        painter->drawPixmap(right, bottom, cornerPieces, m_radius, m_radius, m_radius, m_radius);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RoundedMask::radius() const -> int {
+    return m_radius;
+}
+
+auto Nedrysoft::RouteAnalyser::RoundedMask::mask(const QSize &size) -> const QImage & {
+    if (m_mask.size() == size) {
+        return m_mask;
+    }
+
+    m_mask = QImage(size, QImage::Format_ARGB32_Premultiplied);
+
+    m_mask.fill(Qt::transparent);
+
+    QPainter painter(&m_mask);
+    QPainterPath roundedPath;
+
+    roundedPath.addRoundedRect(QRectF(QPointF(0, 0), QSizeF(size)), m_radius, m_radius);
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillPath(roundedPath, Qt::black);
+
+    return m_mask;
+}
+
+auto Nedrysoft::RouteAnalyser::RoundedMask::corners(const QColor &colour) -> const QPixmap & {
+    if (( !m_corners.isNull() ) && ( colour == m_cornerColour )) {
+        return m_corners;
+    }
+
+    m_cornerColour = colour;
+    m_corners = QPixmap(m_radius * 2, m_radius * 2);
+
+    // the pixmap is filled with a transparent colour first so that it has an alpha channel, the circle that is
+    // then cut out of the square leaves the four corner pieces in its quadrants.
+
+    m_corners.fill(Qt::transparent);
+
+    QPainter painter(&m_corners);
+
+    painter.fillRect(m_corners.rect(), colour);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setCompositionMode(QPainter::CompositionMode_DestinationOut);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::black);
+    painter.drawEllipse(m_corners.rect());
+
+    return m_corners;
+}
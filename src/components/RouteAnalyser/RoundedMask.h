@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_ROUNDEDMASK_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_ROUNDEDMASK_H
+
+#include "RouteAnalyserSpec.h"
+
+#include <QColor>
+#include <QImage>
+#include <QPixmap>
+
+class QPainter;
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The RoundedMask class rounds the corners of the plot areas without clipping to a path.
+     *
+     * @details     Setting a rounded rectangle as the clip path means that every paint operation is clipped against
+     *              a path, which is one of the slowest operations of the raster engine.  Instead a mask is rendered
+     *              once for each size and composited into the pixmaps of the background layers as they are
+     *              rendered, and anything drawn on top of the background has its corners covered by pre-rendered
+     *              corner pieces.
+     *
+     * @class       Nedrysoft::RouteAnalyser::RoundedMask RoundedMask.h <RoundedMask>
+     */
+    class NEDRYSOFT_ROUTEANALYSER_DLLSPEC RoundedMask {
+        public:
+            /**
+             * @brief       Constructs a new RoundedMask.
+             *
+             * @param[in]   radius the radius of the corners in pixels.
+             */
+            explicit RoundedMask(int radius);
+
+            /**
+             * @brief       Makes the pixels outside of the rounded rectangle of a pixmap transparent.
+             *
+             * @param[in,out]   pixmap the pixmap, which must have an alpha channel.
+             */
+            auto apply(QPixmap &pixmap) -> void;
+
+            /**
+             * @brief       Draws the area outside of the rounded rectangle in a colour.
+             *
+             * @param[in]   painter the painter to draw with.
+             * @param[in]   rect the rectangle whose corners are covered.
+             * @param[in]   colour the colour of the area behind the rectangle.
+             * @param[in]   edges the left and/or right edges whose corners are covered.
+             */
+            auto drawCorners(
+                    QPainter *painter,
+                    const QRect &rect,
+                    const QColor &colour,
+                    Qt::Edges edges = Qt::LeftEdge | Qt::RightEdge) -> void;
+
+            /**
+             * @brief       Returns the radius of the corners.
+             *
+             * @returns     the radius in pixels.
+             */
+            auto radius() const -> int;
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       Returns the mask for a size, rendering it if the size has changed.
+             *
+             * @param[in]   size the size of the mask.
+             *
+             * @returns     the mask.
+             */
+            auto mask(const QSize &size) -> const QImage &;
+
+            /**
+             * @brief       Returns the corner pieces for a colour, rendering them if the colour has changed.
+             *
+             * @details     The pieces are held in a single square pixmap twice the radius in size, each quadrant
+             *              holds the piece for the matching corner.
+             *
+             * @param[in]   colour the colour of the pieces.
+             *
+             * @returns     the corner pieces.
+             */
+            auto corners(const QColor &colour) -> const QPixmap &;
+
+            int m_radius;
+
+            QImage m_mask;
+            QPixmap m_corners;
+            QColor m_cornerColour;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_ROUNDEDMASK_H
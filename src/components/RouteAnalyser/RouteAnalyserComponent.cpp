@@ -27,6 +27,7 @@
 
 #include "ColourDialog.h"
 #include "IRouteEngine.h"
+#include "LatencyBackgroundCache.h"
 #include "LatencyRibbonGroup.h"
 #include "LatencySettings.h"
 #include "LatencySettingsPage.h"
@@ -58,6 +59,7 @@
 #endif
 #include <QDir>
 #include <QDirIterator>
+#include <QFileDialog>
 #if !defined(Q_OS_MACOS)
 #include <QGuiApplication>
 #include <QScreen>
@@ -81,7 +83,9 @@ RouteAnalyserComponent::RouteAnalyserComponent() :
         m_latencySettingsPage(nullptr),
         m_targetSettingsPage(nullptr),
         m_newTargetAction(nullptr),
-        m_latencySettings(nullptr) {
+        m_openRecordingAction(nullptr),
+        m_latencySettings(nullptr),
+        m_latencyBackgroundCache(nullptr) {
 
 }
 
@@ -114,6 +118,12 @@ auto RouteAnalyserComponent::finaliseEvent() -> void {
         delete m_targetSettingsPage;
     }
 
+    if (m_latencyBackgroundCache) {
+        Nedrysoft::ComponentSystem::removeObject(m_latencyBackgroundCache);
+
+        delete m_latencyBackgroundCache;
+    }
+
     if (m_latencySettings) {
         Nedrysoft::ComponentSystem::removeObject(m_latencySettings);
 
@@ -138,6 +148,10 @@ auto RouteAnalyserComponent::finaliseEvent() -> void {
         delete m_newTargetAction;
     }
 
+    if (m_openRecordingAction) {
+        delete m_openRecordingAction;
+    }
+
     delete Nedrysoft::RouteAnalyser::TargetManager::getInstance();
 }
 
@@ -183,6 +197,7 @@ auto RouteAnalyserComponent::initialisationFinishedEvent() -> void {
                             editor->setTarget(newTargetDialog.pingTarget());
                             editor->setIPVersion(newTargetDialog.ipVersion());
                             editor->setInterval(newTargetDialog.interval());
+                            editor->setPathMTUDiscoveryEnabled(newTargetDialog.pathMTUDiscoveryEnabled());
 
                             editorManager->openEditor(editor);
                         }
@@ -200,6 +215,37 @@ auto RouteAnalyserComponent::initialisationFinishedEvent() -> void {
 
                 menu->appendCommand(command, Nedrysoft::Core::Constants::MenuGroups::FileNew);
 
+                // register the File/Open... action, which replays a recorded session.
+
+                m_openRecordingAction = new QAction(tr("Open..."));
+
+                connect(m_openRecordingAction, &QAction::triggered, [=]() {
+                    auto filename = QFileDialog::getOpenFileName(
+                        Nedrysoft::Core::mainWindow(),
+                        tr("Open Recording"),
+                        QString(),
+                        tr("Pingnoo Recordings (*.%1)").arg(Nedrysoft::RouteAnalyser::Constants::RecordingFileExtension)
+                    );
+
+                    if (filename.isEmpty()) {
+                        return;
+                    }
+
+                    auto editorManager = Nedrysoft::Core::IEditorManager::getInstance();
+
+                    if (editorManager) {
+                        auto editor = new Nedrysoft::RouteAnalyser::RouteAnalyserEditor;
+
+                        if (editor->openRecording(filename)) {
+                            editorManager->openEditor(editor);
+                        } else {
+                            delete editor;
+                        }
+                    }
+                });
+
+                commandManager->registerAction(m_openRecordingAction, Nedrysoft::Core::Constants::Commands::Open);
+
                 auto ribbonBarManager = Nedrysoft::Core::IRibbonBarManager::getInstance();
 
                 if (ribbonBarManager) {
@@ -244,6 +290,27 @@ auto RouteAnalyserComponent::initialisationFinishedEvent() -> void {
 
         m_latencySettings->loadFromFile();
 
+        // the rendered graph backgrounds are shared by every editor, the cache is emptied when the colours that
+        // they were rendered with change.
+
+        m_latencyBackgroundCache = new Nedrysoft::RouteAnalyser::LatencyBackgroundCache;
+
+        Nedrysoft::ComponentSystem::addObject(m_latencyBackgroundCache);
+
+        connect(
+            m_latencySettings,
+            &Nedrysoft::RouteAnalyser::LatencySettings::coloursChanged,
+            m_latencyBackgroundCache,
+            &Nedrysoft::RouteAnalyser::LatencyBackgroundCache::clear
+        );
+
+        connect(
+            m_latencySettings,
+            &Nedrysoft::RouteAnalyser::LatencySettings::gradientChanged,
+            m_latencyBackgroundCache,
+            &Nedrysoft::RouteAnalyser::LatencyBackgroundCache::clear
+        );
+
         auto ribbonBarManager = Nedrysoft::Core::IRibbonBarManager::getInstance();
 
         if (ribbonBarManager) {
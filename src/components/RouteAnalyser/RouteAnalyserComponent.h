@@ -31,6 +31,7 @@
 
 namespace Nedrysoft { namespace RouteAnalyser {
     class NewTargetRibbonGroup;
+    class LatencyBackgroundCache;
     class LatencyRibbonGroup;
     class LatencySettings;
     class LatencySettingsPage;
@@ -122,8 +123,10 @@ class NEDRYSOFT_ROUTEANALYSER_DLLSPEC RouteAnalyserComponent :
 
         Nedrysoft::RouteAnalyser::LatencySettings *m_latencySettings;
         Nedrysoft::RouteAnalyser::TargetSettings *m_targetSettings;
+        Nedrysoft::RouteAnalyser::LatencyBackgroundCache *m_latencyBackgroundCache;
 
         QAction *m_newTargetAction;
+        QAction *m_openRecordingAction;
 
         //! @endcond
 };
@@ -28,6 +28,10 @@ namespace Nedrysoft { namespace RouteAnalyser { namespace Constants {
     namespace Commands {
         constexpr auto NewTarget = "RouteAnalyser.NewTarget";
     };
+
+    constexpr auto DefaultPayloadSize = 52;
+    constexpr auto RecordingFileExtension = "pingnoo";
+    constexpr auto MaximumPayloadSize = 65507;
 }}};
 
 #endif //PINGNOO_ROUTEANALYSERCONSTANTS_H
@@ -26,20 +26,78 @@
 #include "LatencyRibbonGroup.h"
 #include "PlotScrollArea.h"
 #include "RouteAnalyser.h"
+#include "RouteAnalyserConstants.h"
 #include "RouteAnalyserWidget.h"
+#include "SessionRecording.h"
 #include "TargetManager.h"
+#include "TargetSettings.h"
 #include "ViewportRibbonGroup.h"
 
 #include <IContextManager>
+#include <QClipboard>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QGuiApplication>
 #include <QObject>
+#include <QRegularExpression>
 
 constexpr auto DefaultWindowSize = 10.0*60.0;
 constexpr auto ViewportSize = 0.5;
+constexpr auto RecordingPath = "Nedrysoft/Pingnoo/Components/RouteAnalyser/Recordings";
+constexpr auto RecordingTimeFormat = "yyyyMMdd-HHmmss";
+constexpr auto BytesPerMegabyte = 1024LL*1024;
+
+/**
+ * @brief       Removes the oldest recordings in a folder until the recordings fit within a size limit.
+ *
+ * @details     The recordings are ordered by the time they were last written to, a session that is still being
+ *              recorded is written to continuously so it is the last to be removed.  A recording that cannot be
+ *              removed, because it is open on a platform that does not allow it, is skipped.
+ *
+ * @param[in]   path the folder that holds the recordings.
+ * @param[in]   limit the maximum size of the recordings in bytes.
+ */
+static auto pruneRecordings(const QString &path, qint64 limit) -> void {
+    auto recordings = QDir(path).entryInfoList(
+        QStringList() << QString("*.%1").arg(Nedrysoft::RouteAnalyser::Constants::RecordingFileExtension),
+        QDir::Files,
+        QDir::Time | QDir::Reversed
+    );
+
+    qint64 size = 0;
+
+    for (auto &recording : recordings) {
+        size += recording.size();
+    }
+
+    for (auto &recording : recordings) {
+        if (size <= limit) {
+            break;
+        }
+
+        if (QFile::remove(recording.filePath())) {
+            size -= recording.size();
+        }
+    }
+}
 
 Nedrysoft::RouteAnalyser::RouteAnalyserEditor::RouteAnalyserEditor() :
+        m_pingEngineFactory(nullptr),
+        m_pathMTUDiscoveryEnabled(false),
         m_editorWidget(nullptr),
         m_viewportStart(0),
-        m_viewportEnd(1) {
+        m_viewportEnd(1),
+        m_replay(false) {
+
+    auto targetSettings = Nedrysoft::ComponentSystem::getObject<TargetSettings>();
+
+    if (targetSettings) {
+        m_pathMTUDiscoveryEnabled = targetSettings->defaultPathMTUDiscoveryEnabled();
+        m_payload = targetSettings->defaultPayload();
+    }
 
     auto contextManager = Nedrysoft::Core::IContextManager::getInstance();
 
@@ -55,13 +113,78 @@ Nedrysoft::RouteAnalyser::RouteAnalyserEditor::~RouteAnalyserEditor() {
 }
 
 auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::saveConfiguration() -> QJsonObject {
-    return QJsonObject();
+    auto rootObject = QJsonObject();
+
+    rootObject.insert("id", this->metaObject()->className());
+
+    QJsonObject targetObject;
+    QVariantMap payloadParameters;
+
+    m_payload.toVariantMap(payloadParameters);
+
+    targetObject.insert("host", m_pingTarget);
+    targetObject.insert("ipVersion", static_cast<int>(m_ipVersion));
+    targetObject.insert("interval", m_interval);
+    targetObject.insert("pathMTUDiscovery", m_pathMTUDiscoveryEnabled);
+    targetObject.insert("payload", QJsonObject::fromVariantMap(payloadParameters));
+
+    rootObject.insert("target", targetObject);
+
+    if (!m_recordingFilename.isEmpty()) {
+        rootObject.insert("recording", m_recordingFilename);
+    }
+
+    return rootObject;
 }
 
 auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::loadConfiguration(QJsonObject configuration) -> bool {
-    Q_UNUSED(configuration)
+    if (configuration["id"] != this->metaObject()->className()) {
+        return false;
+    }
+
+    if (configuration.contains("target")) {
+        auto targetObject = configuration["target"].toObject();
+
+        if (targetObject.contains("host")) {
+            m_pingTarget = targetObject["host"].toString();
+        }
+
+        if (targetObject.contains("ipVersion")) {
+            m_ipVersion = static_cast<Nedrysoft::Core::IPVersion>(targetObject["ipVersion"].toInt());
+        }
+
+        if (targetObject.contains("interval")) {
+            m_interval = targetObject["interval"].toDouble();
+        }
 
-    return false;
+        if (targetObject.contains("pathMTUDiscovery")) {
+            m_pathMTUDiscoveryEnabled = targetObject["pathMTUDiscovery"].toBool();
+        }
+
+        if (targetObject.contains("payload")) {
+            m_payload = PingPayload::fromVariantMap(targetObject["payload"].toObject().toVariantMap());
+        }
+    }
+
+    // the recording in a configuration is not replayed, loading a configuration starts a new session with the same
+    // settings and a recording is only replayed when the user opens it with openRecording().
+
+    return true;
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::openRecording(const QString &filename) -> bool {
+    Nedrysoft::RouteAnalyser::SessionRecording recording;
+
+    if (!recording.open(filename)) {
+        return false;
+    }
+
+    loadConfiguration(recording.session());
+
+    m_recordingFilename = filename;
+    m_replay = true;
+
+    return true;
 }
 
 auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::widget() -> QWidget * {
@@ -70,7 +193,9 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::widget() -> QWidget * {
             m_pingTarget,
             m_ipVersion,
             m_interval,
-            m_pingEngineFactory
+            m_replay ? nullptr : m_pingEngineFactory,
+            m_pathMTUDiscoveryEnabled,
+            m_payload
         );
 
         auto viewportWidget = ComponentSystem::getObject<ViewportRibbonGroup>();
@@ -82,9 +207,60 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::widget() -> QWidget * {
 
         m_editorWidget->setViewportSize(newViewportSize);
 
-        auto favouritesManager = Nedrysoft::RouteAnalyser::TargetManager::getInstance();
+        if (viewportWidget) {
+            m_editorWidget->setStatisticsWindow(viewportWidget->statisticsWindow());
+        }
+
+        if (m_replay) {
+            m_editorWidget->replay(m_recordingFilename);
+        } else {
+            auto targetSettings = Nedrysoft::ComponentSystem::getObject<TargetSettings>();
+
+            if ((!targetSettings) || (targetSettings->recordingEnabled())) {
+                auto recordingPath = QString("%1/%2")
+                        .arg(Nedrysoft::Core::ICore::getInstance()->storageFolder())
+                        .arg(RecordingPath);
+
+                QDir dir(recordingPath);
+
+                if (!dir.exists()) {
+                    dir.mkpath(dir.path());
+                }
+
+                if ((targetSettings) && (targetSettings->recordingLimit() > 0)) {
+                    pruneRecordings(recordingPath, targetSettings->recordingLimit() * BytesPerMegabyte);
+                }
+
+                auto session = saveConfiguration();
+
+                auto recordingName = QDir::cleanPath(QString("%1/%2-%3")
+                        .arg(recordingPath)
+                        .arg(QString(m_pingTarget).replace(QRegularExpression("[^A-Za-z0-9.-]"), "_"))
+                        .arg(QDateTime::currentDateTime().toString(RecordingTimeFormat)));
+
+                /**
+                 * the name only has a resolution of one second and creating a recording truncates an existing
+                 * file, so a counter is appended until the name does not clash with an earlier recording.
+                 */
+
+                m_recordingFilename = QString("%1.%2")
+                        .arg(recordingName)
+                        .arg(Nedrysoft::RouteAnalyser::Constants::RecordingFileExtension);
+
+                for (auto counter = 2; QFile::exists(m_recordingFilename); counter++) {
+                    m_recordingFilename = QString("%1-%2.%3")
+                            .arg(recordingName)
+                            .arg(counter)
+                            .arg(Nedrysoft::RouteAnalyser::Constants::RecordingFileExtension);
+                }
 
-        favouritesManager->addRecent(m_pingTarget, m_pingTarget, m_pingTarget, m_ipVersion);
+                m_editorWidget->startRecording(m_recordingFilename, session);
+            }
+
+            auto favouritesManager = Nedrysoft::RouteAnalyser::TargetManager::getInstance();
+
+            favouritesManager->addRecent(m_pingTarget, m_pingTarget, m_pingTarget, m_ipVersion, m_payload);
+        }
     }
 
     return m_editorWidget;
@@ -112,6 +288,16 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::setInterval(double interval)
     m_interval = interval;
 }
 
+auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::setPathMTUDiscoveryEnabled(bool enabled) -> void {
+    m_pathMTUDiscoveryEnabled = enabled;
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::setPayload(
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void {
+
+    m_payload = payload;
+}
+
 auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::activated() -> void {
     auto viewportWidget = ComponentSystem::getObject<ViewportRibbonGroup>();
     auto latencyWidget = ComponentSystem::getObject<LatencyRibbonGroup>();
@@ -149,6 +335,15 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::activated() -> void {
             this,
             &Nedrysoft::RouteAnalyser::RouteAnalyserEditor::onViewportWindowChanged
         );
+
+        connect(
+            viewportWidget,
+            &ViewportRibbonGroup::statisticsWindowChanged,
+            this,
+            &Nedrysoft::RouteAnalyser::RouteAnalyserEditor::onStatisticsWindowChanged
+        );
+
+        m_editorWidget->setStatisticsWindow(viewportWidget->statisticsWindow());
     }
 
     if (latencyWidget)  {
@@ -189,6 +384,13 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::deactivated() -> void {
             &Nedrysoft::RouteAnalyser::RouteAnalyserEditor::onViewportWindowChanged
 
         );
+
+        disconnect(
+            viewportWidget,
+            &ViewportRibbonGroup::statisticsWindowChanged,
+            this,
+            &Nedrysoft::RouteAnalyser::RouteAnalyserEditor::onStatisticsWindowChanged
+        );
     }
 
     disconnect(
@@ -251,6 +453,14 @@ void Nedrysoft::RouteAnalyser::RouteAnalyserEditor::onViewportWindowChanged(doub
     }
 }
 
+void Nedrysoft::RouteAnalyser::RouteAnalyserEditor::onStatisticsWindowChanged(
+        Nedrysoft::RouteAnalyser::PingData::StatisticsWindow window) {
+
+    if (m_editorWidget) {
+        m_editorWidget->setStatisticsWindow(window);
+    }
+}
+
 void Nedrysoft::RouteAnalyser::RouteAnalyserEditor::onLatencyValueChanged(
         LatencyRibbonGroup::LatencyType type,
         double value) {
@@ -265,10 +475,39 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserEditor::generateOutput(
         Nedrysoft::RouteAnalyser::OutputType type,
         Nedrysoft::RouteAnalyser::OutputTarget target ) -> void {
 
-    if (type==Nedrysoft::RouteAnalyser::OutputType::TableAsText) {
+    if ( (type==Nedrysoft::RouteAnalyser::OutputType::TableAsText) ||
+         (type==Nedrysoft::RouteAnalyser::OutputType::TableAsCSV) ) {
+
+        auto csv = (type==Nedrysoft::RouteAnalyser::OutputType::TableAsCSV);
+
+        if (!m_editorWidget) {
+            return;
+        }
+
+        if (target==Nedrysoft::RouteAnalyser::OutputTarget::Clipboard) {
+            QGuiApplication::clipboard()->setText(
+                m_editorWidget->tableText(csv, Nedrysoft::Core::HostMask::HostMaskType::Clipboard)
+            );
+        } else {
+            auto filename = QFileDialog::getSaveFileName(
+                Nedrysoft::Core::mainWindow(),
+                tr("Export Table"),
+                QString(),
+                csv ? tr("CSV Files (*.csv)") : tr("Text Files (*.txt)")
+            );
+
+            if (!filename.isEmpty()) {
+                QFile file(filename);
+
+                if (file.open(QFile::WriteOnly | QFile::Truncate)) {
+                    auto text = m_editorWidget->tableText(csv, Nedrysoft::Core::HostMask::HostMaskType::Output);
+
+                    file.write(text.toUtf8());
+                }
+            }
+        }
     } else if (type==Nedrysoft::RouteAnalyser::OutputType::TableAsPDF) {
     } else if (type==Nedrysoft::RouteAnalyser::OutputType::TableAsImage) {
-    } else if (type==Nedrysoft::RouteAnalyser::OutputType::TableAsCSV) {
     } else if (type==Nedrysoft::RouteAnalyser::OutputType::GraphsAsImage) {
     } else if (type==Nedrysoft::RouteAnalyser::OutputType::GraphsAsPDF) {
     } else if (type==Nedrysoft::RouteAnalyser::OutputType::TableAndGraphsAsImage) {
@@ -26,6 +26,8 @@
 
 #include "LatencyRibbonGroup.h"
 #include "IPingEngineFactory.h"
+#include "PingData.h"
+#include "PingPayload.h"
 
 #include <IConfiguration>
 #include <ICore>
@@ -110,6 +112,32 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto setInterval(double interval) -> void;
 
+            /**
+             * @brief       Sets whether the path MTU to each hop is discovered for this ping target.
+             *
+             * @param[in]   enabled true if path MTU discovery is enabled; otherwise false.
+             */
+            auto setPathMTUDiscoveryEnabled(bool enabled) -> void;
+
+            /**
+             * @brief       Sets the payload carried by the probes for this ping target.
+             *
+             * @param[in]   payload the payload size, pattern and sweep size.
+             */
+            auto setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void;
+
+            /**
+             * @brief       Sets the editor to replay a recorded session.
+             *
+             * @details     The target and probe settings are read from the recording, the recording is replayed
+             *              when the widget is created rather than a new session being started.
+             *
+             * @param[in]   filename the filename of the recording.
+             *
+             * @returns     true if the recording could be opened; otherwise false.
+             */
+            auto openRecording(const QString &filename) -> bool;
+
             /**
              * @brief       Generates an output to the given destination.
              * @param[in]   type the type of the output.
@@ -208,6 +236,13 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             void onViewportWindowChanged(double size);
 
+            /**
+             * @brief       Called when the window for the table statistics has changed.
+             *
+             * @param[in]   window the new statistics window.
+             */
+            void onStatisticsWindowChanged(Nedrysoft::RouteAnalyser::PingData::StatisticsWindow window);
+
             /**
              * @brief       Called when one of the latency values has been changed.
              *
@@ -224,9 +259,13 @@ namespace Nedrysoft { namespace RouteAnalyser {
             QString m_pingTarget;
             Nedrysoft::Core::IPVersion m_ipVersion;
             double m_interval;
+            bool m_pathMTUDiscoveryEnabled;
+            Nedrysoft::RouteAnalyser::PingPayload m_payload;
             Nedrysoft::RouteAnalyser::RouteAnalyserWidget *m_editorWidget;
             double m_viewportStart;
             double m_viewportEnd;
+            bool m_replay;
+            QString m_recordingFilename;
             QMetaObject::Connection m_dataChangedConnection;
 
             //! @endcond
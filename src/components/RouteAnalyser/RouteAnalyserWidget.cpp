@@ -26,17 +26,23 @@
 #include "BarChart.h"
 #include "CPAxisTickerMS.h"
 #include "GraphLatencyLayer.h"
+#include "HopGraphList.h"
 #include "IPingEngine.h"
 #include "IPingEngineFactory.h"
 #include "IPingTarget.h"
 #include "IPlot.h"
 #include "IPlotFactory.h"
 #include "IRouteEngineFactory.h"
+#include "LatencyBackgroundCache.h"
+#include "LatencyHeatmap.h"
 #include "LatencySettings.h"
+#include "PlotRenderScheduler.h"
 #include "PlotScrollArea.h"
 #include "RouteAnalyser.h"
 #include "RouteDiscoveryWidget.h"
 #include "RouteTableItemDelegate.h"
+#include "TableUpdateScheduler.h"
+#include "TargetSettings.h"
 
 #include <CoreConstants>
 #include <ICommand>
@@ -46,19 +52,39 @@
 #include <IHostMasker>
 #include "IHostMaskerManager"
 #include <QDateTime>
+#include <QGuiApplication>
 #include <QHostAddress>
 #include <QHostInfo>
+#include <QJsonObject>
 #include <QTimer>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <spdlog/spdlog.h>
+#include <vector>
 
 constexpr auto RoundTripGraph = 0;
+constexpr auto LargeProbeGraph = 1;
+constexpr auto LargeProbeColour = qRgb(255,128,0);
+constexpr auto BitsPerByte = 8.0;
 constexpr auto DefaultMaxLatency = 0.01;
 constexpr auto DefaultTimeWindow = 60.0*10;
 constexpr auto DefaultGraphHeight = 300;
 constexpr auto TableRowHeight = 20;
 constexpr auto NoReplyColour = qRgb(255,0,0);
+constexpr auto NoReplyBarWidth = 0.75;
+constexpr auto ReplayChunkSize = 10000;
+constexpr auto MillisecondsPerHour = 60LL*60*1000;
+constexpr auto MillisecondsPerDay = MillisecondsPerHour*24;
 constexpr auto PlotMargins = QMargins(80, 20, 40, 40);
+constexpr auto FrameTimeLabelMargin = 4;
+constexpr auto NanosecondsPerMillisecond = 1000000.0;
+constexpr auto BytesPerKilobyte = 1024;
+constexpr auto CrosshairLayer = "crosshair";
+constexpr auto MillisecondsPerSecond = 1000;
+constexpr auto NanosecondsPerSecond = 1000000000.0;
+constexpr auto HeatmapPeriod = 60.0*60;
+constexpr auto RecordingCheckpointInterval = 30*MillisecondsPerSecond;
 
 QMap< Nedrysoft::RouteAnalyser::PingData::Fields, QPair<QString, QString> > &Nedrysoft::RouteAnalyser::RouteAnalyserWidget::headerMap() {
     static QMap<Nedrysoft::RouteAnalyser::PingData::Fields, QPair<QString, QString> > map = QMap<Nedrysoft::RouteAnalyser::PingData::Fields, QPair<QString, QString> >
@@ -72,7 +98,17 @@ QMap< Nedrysoft::RouteAnalyser::PingData::Fields, QPair<QString, QString> > &Ned
                     {PingData::Fields::CurrentLatency, {tr("Cur"),      "8888.888"}},
                     {PingData::Fields::MinimumLatency, {tr("Min"),      "8888.888"}},
                     {PingData::Fields::MaximumLatency, {tr("Max"),      "8888.888"}},
+                    {PingData::Fields::Percentile50,   {tr("p50"),      "8888.888"}},
+                    {PingData::Fields::Percentile95,   {tr("p95"),      "8888.888"}},
+                    {PingData::Fields::Percentile99,   {tr("p99"),      "8888.888"}},
+                    {PingData::Fields::StandardDeviation, {tr("StdDev"), "8888.888"}},
                     {PingData::Fields::PacketLoss,     {tr("Loss %"),   "8888.888"}},
+                    {PingData::Fields::Jitter,         {tr("Jitter"),   "8888.888"}},
+                    {PingData::Fields::LossBurst,      {tr("Burst"),    "888.8/888"}},
+                    {PingData::Fields::RFactor,        {tr("R"),        "888.8"}},
+                    {PingData::Fields::MeanOpinionScore, {tr("MOS"),    "8.88"}},
+                    {PingData::Fields::PathMTU,        {tr("MTU"),      "88888"}},
+                    {PingData::Fields::Bandwidth,      {tr("BW"),       "8888.8 Mb/s"}},
                     {PingData::Fields::Graph,          {"",             ""}}
             };
 
@@ -84,6 +120,8 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::RouteAnalyserWidget(
         Nedrysoft::Core::IPVersion ipVersion,
         int interval,
         Nedrysoft::RouteAnalyser::IPingEngineFactory *pingEngineFactory,
+        bool pathMTUDiscoveryEnabled,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload,
         QWidget *parent) :
 
             QWidget(parent),
@@ -93,13 +131,33 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::RouteAnalyserWidget(
             m_viewportPosition(1),
             m_startPoint(-1),
             m_endPoint(0),
+            m_viewportMinimum(0),
+            m_viewportMaximum(0),
+            m_viewportDataInvalid(false),
+            m_viewportResolution(0),
+            m_decimationWidth(0),
+            m_statisticsWindow(PingData::StatisticsWindow::Session),
             m_interval(1000),
-            m_routeDiscoveryWidget(new Nedrysoft::RouteAnalyser::RouteDiscoveryWidget) {
+            m_payload(payload),
+            m_routeDiscoveryWidget(new Nedrysoft::RouteAnalyser::RouteDiscoveryWidget),
+            m_replay(false),
+            m_replayTimer(nullptr),
+            m_replayHop(0),
+            m_replayOffset(0) {
 
     auto latencySettings = Nedrysoft::RouteAnalyser::LatencySettings::getInstance();
 
     assert(latencySettings!=nullptr);
 
+    auto targetSettings = Nedrysoft::ComponentSystem::getObject<Nedrysoft::RouteAnalyser::TargetSettings>();
+
+    if (targetSettings) {
+        m_sampleStore.setRetention(
+            targetSettings->rawRetention() * MillisecondsPerHour,
+            targetSettings->rollupRetention() * MillisecondsPerDay
+        );
+    }
+
     auto routeEngines = Nedrysoft::ComponentSystem::getObjects<Nedrysoft::RouteAnalyser::IRouteEngineFactory>();
 
     if (routeEngines.empty()) {
@@ -112,7 +170,11 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::RouteAnalyserWidget(
         sortedRouteEngines.insert(1-routeEngine->priority(), routeEngine);
     }
 
-    auto routeEngine = sortedRouteEngines.first()->createEngine();
+    Nedrysoft::RouteAnalyser::IRouteEngine *routeEngine = nullptr;
+
+    if (pingEngineFactory) {
+        routeEngine = sortedRouteEngines.first()->createEngine();
+    }
 
     if (routeEngine) {
         connect(
@@ -122,13 +184,25 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::RouteAnalyserWidget(
             &RouteAnalyserWidget::onRouteResult
         );
 
+        connect(
+            routeEngine,
+            &Nedrysoft::RouteAnalyser::IRouteEngine::pathMTUResult,
+            this,
+            &RouteAnalyserWidget::onPathMTUResult
+        );
+
         m_routeDiscoveryWidget->setTarget(targetHost);
 
+        routeEngine->setPathMTUDiscoveryEnabled(pathMTUDiscoveryEnabled);
+        routeEngine->setPayload(m_payload);
+
         routeEngine->findRoute(pingEngineFactory, targetHost, ipVersion);
     }
 
     m_routeGraphDelegate = new RouteTableItemDelegate;
 
+    m_routeGraphDelegate->setLatencyRanking(&m_latencyRanking);
+
     connect(latencySettings, &Nedrysoft::RouteAnalyser::LatencySettings::gradientChanged, [=](bool useGradient) {
 #pragma message("Handle gradiant changed, update anything that uses the graient fills.")
     });
@@ -146,23 +220,134 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::RouteAnalyserWidget(
 
     m_scrollArea->setWidgetResizable(true);
 
-    m_scrollArea->setWidget(new QWidget());
-    m_scrollArea->widget()->setBackgroundRole(QPalette::Base);
+    m_graphList = new Nedrysoft::RouteAnalyser::HopGraphList;
 
-    connect(m_scrollArea, &PlotScrollArea::didScroll, [=](void) {
-        for (auto plot : m_plotList) {
-            if (plot->isVisible()) {
-                if (!plot->visibleRegion().isEmpty()) {
-                    plot->replot();
+    m_graphList->setBackgroundRole(QPalette::Base);
+
+    m_graphList->setSurfaceFactory([this]() {
+        return createGraphSurface();
+    });
+
+    m_graphList->setSurfaceBinder([this](QWidget *surface, int row) {
+        bindGraphSurface(surface, m_graphHops.at(row));
+    });
+
+    m_graphList->setSurfaceUnbinder([this](QWidget *surface, int row) {
+        unbindGraphSurface(surface);
+    });
+
+    m_scrollArea->setWidget(m_graphList);
+
+    // the heatmap shows every hop at once, so a hop that has gone bad can be found without scrolling the graphs.
+
+    m_heatmap = new Nedrysoft::RouteAnalyser::LatencyHeatmap;
+
+    m_heatmap->setSampleStore(&m_sampleStore);
+
+    connect(
+        latencySettings,
+        &Nedrysoft::RouteAnalyser::LatencySettings::coloursChanged,
+        m_heatmap,
+        &Nedrysoft::RouteAnalyser::LatencyHeatmap::invalidate
+    );
+
+    connect(
+        latencySettings,
+        &Nedrysoft::RouteAnalyser::LatencySettings::thresholdsChanged,
+        m_heatmap,
+        &Nedrysoft::RouteAnalyser::LatencyHeatmap::invalidate
+    );
+
+    m_renderScheduler = new Nedrysoft::RouteAnalyser::PlotRenderScheduler(this);
+
+    m_renderScheduler->setRangeUpdater([this]() {
+        updateRanges();
+    });
+
+    m_frameTimeLabel = new QLabel(m_scrollArea);
+
+    m_frameTimeLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+    m_frameTimeLabel->move(FrameTimeLabelMargin, FrameTimeLabelMargin);
+    m_frameTimeLabel->setVisible(false);
+
+    m_openGLEnabled = false;
+
+    if (targetSettings) {
+        m_renderScheduler->setFrameRate(targetSettings->frameRate());
+
+        m_openGLEnabled = targetSettings->openGLEnabled() && openGLAvailable();
+
+        // the setting is checked on every frame so that turning it on or off takes effect immediately.
+
+        connect(
+            m_renderScheduler,
+            &Nedrysoft::RouteAnalyser::PlotRenderScheduler::frameRendered,
+            [this, targetSettings](qint64 frameTime, int plotCount) {
+                if (!targetSettings->showFrameTime()) {
+                    return;
                 }
-            }
-        }
+
+                auto frameTimeText = QString(tr("%1 ms (%2 plots)"))
+                        .arg(static_cast<double>(frameTime) / NanosecondsPerMillisecond, 0, 'f', 2)
+                        .arg(plotCount);
+
+                auto backgroundCache = Nedrysoft::RouteAnalyser::LatencyBackgroundCache::getInstance();
+
+                if (backgroundCache) {
+                    frameTimeText += QString(tr(", backgrounds %1 hits / %2 misses, %3 KB"))
+                            .arg(backgroundCache->hits())
+                            .arg(backgroundCache->misses())
+                            .arg(backgroundCache->cost() / BytesPerKilobyte);
+                }
+
+                m_frameTimeLabel->setText(frameTimeText);
+
+                m_frameTimeLabel->adjustSize();
+                m_frameTimeLabel->raise();
+                m_frameTimeLabel->setVisible(true);
+        });
+
+        connect(
+            targetSettings,
+            &Nedrysoft::RouteAnalyser::TargetSettings::showFrameTimeChanged,
+            [this](bool show) {
+                if (!show) {
+                    m_frameTimeLabel->setVisible(false);
+                }
+        });
+    }
+
+    // plots that were changed while they were scrolled out of view are drawn once they become visible.
+
+    connect(m_scrollArea, &PlotScrollArea::didScroll, [=](void) {
+        m_renderScheduler->requestFrame();
+    });
+
+    m_crosshairTime = 0;
+    m_crosshairTimer = new QTimer(this);
+
+    m_crosshairTimer->setSingleShot(true);
+    m_crosshairTimer->setInterval(MillisecondsPerSecond / m_renderScheduler->frameRate());
+
+    connect(m_crosshairTimer, &QTimer::timeout, this, &RouteAnalyserWidget::updateCrosshair);
+
+    // the incomplete blocks are written to the recording periodically, so that little is lost if the application
+    // exits without finishing the recording.
+
+    m_checkpointTimer = new QTimer(this);
+
+    m_checkpointTimer->setInterval(RecordingCheckpointInterval);
+
+    connect(m_checkpointTimer, &QTimer::timeout, [=]() {
+        m_sampleStore.checkpointRecording();
     });
 
     m_tableModel = new QStandardItemModel();
 
     m_tableModel->setColumnCount(headerMap().count());
 
+    m_tableUpdateScheduler = new Nedrysoft::RouteAnalyser::TableUpdateScheduler(m_tableModel, this);
+
     m_tableView = new QTableView();
 
     m_tableView->setModel(m_tableModel);
@@ -205,13 +390,15 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::RouteAnalyserWidget(
     m_tableView->setFrameStyle(QFrame::NoFrame);
 
     m_splitter->addWidget(m_tableView);
+    m_splitter->addWidget(m_heatmap);
     m_splitter->addWidget(m_scrollArea);
     m_splitter->addWidget(m_routeDiscoveryWidget);
 
     m_routeDiscoveryWidget->setVisible(true);
+    m_heatmap->setVisible(false);
     m_scrollArea->setVisible(false);
 
-    m_splitter->setStretchFactor(1, 2);
+    m_splitter->setStretchFactor(2, 2);
 
     auto verticalLayout = new QVBoxLayout();
 
@@ -220,22 +407,25 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::RouteAnalyserWidget(
 #else
     verticalLayout->setMargin(0);
 #endif
-    verticalLayout->addWidget(m_splitter);
-
-    this->setLayout(verticalLayout);
+    // the recording label is only shown if the recording of the session has failed.
 
-    m_layerCleanupTimer = new QTimer();
+    m_recordingLabel = new QLabel;
 
-    m_layerCleanupTimer->setInterval(1000);
+    m_recordingLabel->setVisible(false);
+    m_recordingLabel->setWordWrap(true);
 
-    connect(m_layerCleanupTimer, &QTimer::timeout, [=]() {
-        GraphLatencyLayer::removeUnused();
-    });
+    verticalLayout->addWidget(m_recordingLabel);
+    verticalLayout->addWidget(m_splitter);
 
-    m_layerCleanupTimer->start();
+    this->setLayout(verticalLayout);
 }
 
 Nedrysoft::RouteAnalyser::RouteAnalyserWidget::~RouteAnalyserWidget() {
+    m_checkpointTimer->stop();
+
+    m_sampleStore.finishRecording();
+    m_recording.close();
+
     if (m_tableView) {
         delete m_tableView;
     }
@@ -243,34 +433,48 @@ Nedrysoft::RouteAnalyser::RouteAnalyserWidget::~RouteAnalyserWidget() {
     if (m_tableModel) {
         delete m_tableModel;
     }
-
-    if (m_layerCleanupTimer) {
-        delete m_layerCleanupTimer;
-    }
 }
 
 auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onPingResult(Nedrysoft::RouteAnalyser::PingResult result) -> void {
     auto pingData = static_cast<PingData *>(result.target()->userData());
 
-    static QMap<Nedrysoft::RouteAnalyser::PingData::Fields, PingData *> m_maximumMap;
-
     if (!pingData) {
         return;
     }
 
+    // only the hops that are in view have a graph, the results of other hops are recorded in the store.
+
     auto customPlot = pingData->customPlot();
 
-    if (!customPlot) {
-        return;
-    }
+    auto isLargeProbe = (m_payload.isSweep()) && (result.payloadSize() == m_payload.largeSize());
+
+    auto isNoReply = (result.code() == Nedrysoft::RouteAnalyser::PingResult::ResultCode::NoReply);
+
+    m_sampleStore.append(
+        pingData->hop()-1,
+        result.requestTimestamp() / static_cast<qint64>(NanosecondsPerMillisecond),
+        isNoReply ? -1 : result.roundTripTime(),
+        isLargeProbe
+    );
+
+    // the plots only hold the samples in the viewport, when the viewport has been moved away from the most recent
+    // results the sample is only recorded in the store.
+
+    auto isFollowing = (m_viewportPosition == 1);
 
     switch (result.code()) {
         case Nedrysoft::RouteAnalyser::PingResult::ResultCode::Ok:
         case Nedrysoft::RouteAnalyser::PingResult::ResultCode::TimeExceeded: {
-            QCPRange graphRange = customPlot->yAxis->range();
-            auto requestTime = static_cast<double>(result.requestTime().toSecsSinceEpoch());
+            auto requestTime = static_cast<double>(result.requestTimestamp()) / NanosecondsPerSecond;
+            auto graphIndex = isLargeProbe ? LargeProbeGraph : RoundTripGraph;
 
-            customPlot->graph(RoundTripGraph)->addData(requestTime, result.roundTripTime());
+            if ((isFollowing) && (customPlot)) {
+                if (m_viewportResolution) {
+                    addViewportRollups(pingData, requestTime, requestTime);
+                } else {
+                    addDecimatedData(customPlot->graph(graphIndex), requestTime, result.roundTripTime());
+                }
+            }
 
             if (m_startPoint == -1) {
                 m_startPoint = requestTime;
@@ -284,15 +488,19 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onPingResult(Nedrysoft::Rout
                 m_endPoint = requestTime;
             }
 
-            updateRanges();
+            m_renderScheduler->invalidateRanges();
 
             Q_EMIT datasetChanged(m_startPoint, m_endPoint);
 
             pingData->updateItem(result);
 
+            if (m_payload.isSweep()) {
+                updateBandwidth();
+            }
+
             switch(m_graphScaleMode) {
                 case ScaleMode::None: {
-                    if (result.roundTripTime()> graphRange.upper) {
+                    if ((customPlot) && (result.roundTripTime() > customPlot->yAxis->range().upper)) {
                         customPlot->yAxis->setRange(0, result.roundTripTime());
                     }
 
@@ -302,7 +510,7 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onPingResult(Nedrysoft::Rout
                 case ScaleMode::Normalised:  {
                     auto graphMaxLatency = m_tableView->property("graphMaxLatency").toDouble();
 
-                    if (graphMaxLatency>graphRange.upper) {
+                    if ((customPlot) && (graphMaxLatency > customPlot->yAxis->range().upper)) {
                         for (QCustomPlot *currentPlot : m_plotList) {
                             currentPlot->yAxis->setRange(0, graphMaxLatency);
                         }
@@ -317,45 +525,28 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onPingResult(Nedrysoft::Rout
                 }
             }
 
-            auto fields = QList<PingData::Fields>() <<
-                PingData::Fields::MinimumLatency <<
-                PingData::Fields::MaximumLatency <<
-                PingData::Fields::AverageLatency <<
-                PingData::Fields::CurrentLatency;
-
-            for (auto field : fields) {
-                if (m_maximumMap.contains(field)) {
-                    auto currentMax = m_maximumMap[field];
-
-                    if (pingData->latency(static_cast<int>(field)) >
-                        currentMax->latency(static_cast<int>(field)) ) {
-                        currentMax->setMaximum(field, false);
-
-                        m_maximumMap[field] = pingData;
-
-                        pingData->setMaximum(field, true);
-                    }
-                } else {
-                    m_maximumMap[field] = pingData;
-
-                    pingData->setMaximum(field, true);
-                }
-            }
-
-            m_tableView->viewport()->update();
+            updateLatencyRanking(pingData);
 
             break;
         }
 
         case Nedrysoft::RouteAnalyser::PingResult::ResultCode::NoReply: {
-            auto requestTime = static_cast<double>(result.requestTime().toSecsSinceEpoch());
+            auto requestTime = static_cast<double>(result.requestTimestamp()) / NanosecondsPerSecond;
 
-            QCPBars *barChart = m_barCharts[customPlot];
+            if ((isFollowing) && (customPlot)) {
+                if (m_viewportResolution) {
+                    addViewportRollups(pingData, requestTime, requestTime);
+                } else {
+                    m_barCharts[customPlot]->addData(requestTime, 1);
+                }
 
-            barChart->addData(requestTime, 1);
+                m_renderScheduler->invalidate(customPlot);
+            }
 
             pingData->updateItem(result);
 
+            updateLatencyRanking(pingData);
+
             break;
         }
     }
@@ -389,28 +580,38 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onRouteResult(
         );
     }
 
-    if (!m_pingEngineFactory) {
+    if ((!m_pingEngineFactory) && (!m_replay)) {
         return;
     }
 
+    // when replaying a recording the host names are taken from the recording rather than looked up.
+
+    auto lookupHostName = [this](int hop, const QHostAddress &host) {
+        if (m_replay) {
+            return m_replayHops.value(hop)["hostName"].toString();
+        }
+
+        return QHostInfo::fromName(host.toString()).hostName();
+    };
+
     if (!completed) {
         for (int hop=m_tableModel->rowCount();hop<route.count();hop++) {
             auto host = route.at(hop);
 
             auto hostAddress = host.toString();
-            auto hostName = QHostInfo::fromName(host.toString()).hostName();
+            auto hostName = lookupHostName(hop+1, host);
 
-            auto maskedHostName = hostName;
-            auto maskedHostAddress = hostAddress;
+            auto pingData = new Nedrysoft::RouteAnalyser::PingData(
+                m_tableModel,
+                m_tableUpdateScheduler,
+                hop+1,
+                !host.isNull()
+            );
 
-            auto pingData = new Nedrysoft::RouteAnalyser::PingData(m_tableModel, hop+1, !host.isNull());
+            pingData->setStatisticsWindow(m_statisticsWindow);
 
             m_pingData.append(pingData);
 
-            for (auto masker : Nedrysoft::ComponentSystem::getObjects<Nedrysoft::Core::IHostMasker>()) {
-                masker->mask(hop, hostName, hostAddress, maskedHostName, maskedHostAddress);
-            }
-
             auto tableItem = new QStandardItem(1, headerMap().count());
 
             tableItem->setData(QVariant::fromValue<Nedrysoft::RouteAnalyser::PingData *>(pingData));
@@ -423,8 +624,6 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onRouteResult(
             } else {
                 pingData->setHostName(hostName);
                 pingData->setHostAddress(hostAddress);
-                pingData->setMaskedHostName(maskedHostName);
-                pingData->setMaskedHostAddress(maskedHostAddress);
             }
 
             if (geoIP) {
@@ -448,26 +647,40 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onRouteResult(
         return;
     }
 
-    if (routeHostAddress.protocol() == QAbstractSocket::IPv4Protocol) {
-        m_pingEngine = m_pingEngineFactory->createEngine(Nedrysoft::Core::IPVersion::V4);
-    } else if (routeHostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
-        m_pingEngine = m_pingEngineFactory->createEngine(Nedrysoft::Core::IPVersion::V6);
-    } else {
-        return;
+    if (!m_replay) {
+        if (routeHostAddress.protocol() == QAbstractSocket::IPv4Protocol) {
+            m_pingEngine = m_pingEngineFactory->createEngine(Nedrysoft::Core::IPVersion::V4);
+        } else if (routeHostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
+            m_pingEngine = m_pingEngineFactory->createEngine(Nedrysoft::Core::IPVersion::V6);
+        } else {
+            return;
+        }
+
+        m_pingEngine->setInterval(m_interval);
+
+        connect(
+            m_pingEngine,
+            &Nedrysoft::RouteAnalyser::IPingEngine::result,
+            this,
+            &RouteAnalyserWidget::onPingResult
+        );
     }
 
-    m_pingEngine->setInterval(m_interval);
+    if (m_recording.isWritable()) {
+        for (auto pingData : m_pingData) {
+            auto hopObject = QJsonObject();
 
-    connect(
-        m_pingEngine,
-        &Nedrysoft::RouteAnalyser::IPingEngine::result,
-        this,
-        &RouteAnalyserWidget::onPingResult
-    );
+            hopObject.insert("address", pingData->hostAddress());
+            hopObject.insert("hostName", pingData->hostName());
 
-    auto verticalLayout = new QVBoxLayout();
+            m_recording.writeHop(pingData->hop(), hopObject);
+        }
+    }
+
+    // the graphs are only created for the hops that are in view, each hop with a host is a row of the graph list.
+
+    m_graphHops.clear();
 
-    //for (const QHostAddress &host : route) {
     for (auto hop=1;hop<=route.count();hop++) {
         auto host = route.at(hop-1);
 
@@ -476,332 +689,304 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onRouteResult(
         }
 
         auto hostAddress = host.toString();
-        auto hostName = QHostInfo::fromName(host.toString()).hostName();
+        auto pingData = m_pingData.at(hop-1);
 
-        auto maskedHostName = hostName;
-        auto maskedHostAddress = hostAddress;
+        pingData->setHopValid(true);
 
-        for (auto masker : Nedrysoft::ComponentSystem::getObjects<Nedrysoft::Core::IHostMasker>()) {
-            masker->mask(hop, hostName, hostAddress, maskedHostName, maskedHostAddress);
-        }
+        m_graphHops.append(hop);
 
-        auto customPlot = new QCustomPlot();
+        if (m_pingEngine) {
+            auto pingTarget = m_pingEngine->addTarget(routeHostAddress, hop, m_payload);
 
-        customPlot->addLayer("newBackground", customPlot->layer("grid"), QCustomPlot::limBelow);
+            pingTarget->setUserData(pingData);
+        }
 
-        auto latencyLayer = new GraphLatencyLayer(customPlot);
+        if (geoIP) {
+            geoIP->lookup(hostAddress, [pingData](const QString &, const QVariantMap &result) mutable {
+                pingData->setLocation(result["country"].toString());
+            });
+        }
 
-        m_backgroundLayers.append(latencyLayer);
+        auto hostMaskerManager = Nedrysoft::Core::IHostMaskerManager::getInstance();
 
-        connect(
-            latencySettings,
-            &Nedrysoft::RouteAnalyser::LatencySettings::gradientChanged,
-            [=](bool /*useGradient*/) {
-                latencyLayer->invalidate();
-            }
-        );
+        if (hostMaskerManager) {
+            connect(
+                hostMaskerManager,
+                &Nedrysoft::Core::IHostMaskerManager::maskStateChanged,
+                this,
+                [pingData](Nedrysoft::Core::HostMask::HostMaskType type, bool state) {
+                    pingData->updateModel();
+            });
+        }
+    }
 
-        customPlot->setCurrentLayer("main");
+    m_graphList->setRowCount(m_graphHops.count());
 
-        customPlot->setMinimumHeight(DefaultGraphHeight);
+    connect(
+        this,
+        &Nedrysoft::RouteAnalyser::RouteAnalyserWidget::filteredEvent,
+        [=](QObject *watched, QEvent *event) {
 
-        customPlot->addGraph();
+            auto customPlot = qobject_cast<QCustomPlot *>(watched);
 
-        // the timeout bar chart uses axis 2 which is a unit axis.  This means it will always draw to the top
-        // of the axis independently of the main axis which may scale up/down depending on latency.
+            auto line = m_graphLines[customPlot];
 
-        customPlot->yAxis2->setRange(0,1);
-        customPlot->yAxis2->setVisible(true);
+            if (event->type() == QEvent::PaletteChange) {
+                customPlot->setBackground(this->palette().brush(QPalette::Base));
 
-        auto barChart = new BarChart(customPlot->xAxis, customPlot->yAxis2);
+                customPlot->xAxis->setLabelColor(this->palette().color(QPalette::Text));
+                customPlot->yAxis->setLabelColor(this->palette().color(QPalette::Text));
+                customPlot->xAxis->setTickLabelColor(this->palette().color(QPalette::Text));
+                customPlot->yAxis->setTickLabelColor(this->palette().color(QPalette::Text));
 
-        barChart->setWidthType(QCPBars::wtPlotCoords);
-        barChart->setBrush(QColor(NoReplyColour));
-        barChart->setPen(QPen(QColor(NoReplyColour)));
+                QCPTextElement *textElement = qobject_cast<QCPTextElement *>(
+                        customPlot->plotLayout()->element(0, 0));
 
-        m_barCharts[customPlot] = barChart;
+                if (textElement) {
+                    textElement->setTextColor(this->palette().color(QPalette::Text));
+                }
+            }
 
-        customPlot->yAxis->ticker()->setTickCount(1);
+            if ((event->type() == QEvent::Enter) ||
+                (event->type() == QEvent::Leave)) {
 
-        QSharedPointer<CPAxisTickerMS> msTicker(new CPAxisTickerMS);
+                /*m_pointInfoLabel->setText("");
+                m_hopInfoLabel->setText("");
+                m_hostInfoLabel->setText("");
+                m_timeInfoLabel->setText("");*/
 
-        customPlot->yAxis->setTicker(msTicker);
-        customPlot->yAxis->setLabel(tr("Latency (ms)"));
-        customPlot->yAxis->setRange(0, DefaultMaxLatency);
+                line->setVisible(event->type() == QEvent::Enter);
 
-        QSharedPointer<QCPAxisTickerDateTime> dateTicker(new QCPAxisTickerDateTime);
+                customPlot->layer(CrosshairLayer)->replot();
 
-        auto locale = QLocale::system();
+                if (event->type() == QEvent::Leave) {
+                    m_crosshairTimer->stop();
+                    m_crosshairPlot = nullptr;
+                }
 
-        dateTicker->setDateTimeFormat(
-            locale.timeFormat(QLocale::LongFormat).remove("t").trimmed() +
-            "\n" +
-            locale.dateFormat(QLocale::ShortFormat)
-        );
+                this->m_tableModel->setProperty("showHistorical", false);
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
-        auto secondsSinceEpoch = QDateTime::currentSecsSinceEpoch();
-#else
-        auto secondsSinceEpoch = abs(QDateTime::currentDateTime().secsTo(QDateTime(QDate(1970,1,1), QTime(0, 0))));
-#endif
+                m_tableUpdateScheduler->invalidate(
+                        0,
+                        m_tableModel->rowCount() - 1,
+                        static_cast<int>(Nedrysoft::RouteAnalyser::PingData::Fields::Graph) );
+            }
+        }
+    );
 
-        customPlot->xAxis->setTicker(dateTicker);
-        customPlot->xAxis->setRange(
-            static_cast<double>(secondsSinceEpoch),
-            static_cast<double>(secondsSinceEpoch + m_viewportSize)
-        );
+    m_heatmap->setHops(m_graphHops);
 
-        customPlot->graph(RoundTripGraph)->setLineStyle(QCPGraph::lsStepCenter);
+    m_routeDiscoveryWidget->setVisible(false);
+    m_heatmap->setVisible(true);
+    m_scrollArea->setVisible(true);
 
-        customPlot->setBackground(this->palette().brush(QPalette::Base));
-        customPlot->xAxis->setLabelColor(this->palette().color(QPalette::Text));
-        customPlot->yAxis->setLabelColor(this->palette().color(QPalette::Text));
-        customPlot->xAxis->setTickLabelColor(this->palette().color(QPalette::Text));
-        customPlot->yAxis->setTickLabelColor(this->palette().color(QPalette::Text));
+    update();
 
-        customPlot->replot();
+    if (m_pingEngine) {
+        m_pingEngine->start();
+    }
+}
 
-        /**
-         * scroll wheel events, by default QCustomPlot does not propagate these so this code ensures that they cause
-         * the scroll area to scroll.
-         */
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::startRecording(
+        const QString &filename,
+        const QJsonObject &session) -> bool {
 
-        connect(customPlot, &QCustomPlot::mouseWheel, [this](QWheelEvent *event) {
-            m_scrollArea->verticalScrollBar()->setValue(
-                m_scrollArea->verticalScrollBar()->value() - event->angleDelta().y()
-            );
-        });
+    if (!m_recording.create(filename, session)) {
+        SPDLOG_ERROR(QString("Unable to create the recording %1.").arg(filename).toStdString());
 
-        /**
-         *  mouse over event
-         */
+        return false;
+    }
 
-        auto graphLine = new QCPItemStraightLine(customPlot);
+    m_recording.setErrorHandler([this](const QString &reason) {
+        SPDLOG_ERROR(QString("The recording %1 was stopped, %2").arg(m_recording.fileName()).arg(reason).toStdString());
 
-        graphLine->setPen(QPen(Qt::darkGray, 2, Qt::DotLine));
+        m_recordingLabel->setText(QString(tr("Recording stopped: %1")).arg(reason));
+        m_recordingLabel->setVisible(true);
 
-        m_graphLines[customPlot] = graphLine;
+        m_checkpointTimer->stop();
+    });
 
-        connect(
-            customPlot,
-            &QCustomPlot::mouseMove,
-            [this, customPlot, graphLine, maskedHostName](QMouseEvent *event) {
-                auto x = customPlot->xAxis->pixelToCoord(event->pos().x());
-                auto foundRange = false;
+    m_sampleStore.setRecording(&m_recording);
 
-                auto data = customPlot->graph(RoundTripGraph)->data();
+    m_checkpointTimer->start();
 
-                if (!data) {
-                    return;
-                }
+    return true;
+}
 
-                auto dataRange = data->keyRange(foundRange);
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::replay(const QString &filename) -> bool {
+    Nedrysoft::RouteAnalyser::RouteList route;
 
-                graphLine->point1->setCoords(x, 0);
-                graphLine->point2->setCoords(x, 1);
+    // the recording is kept open, the samples that are outside the retention period are read from it when needed.
 
-                customPlot->replot();
+    if (!m_recording.open(filename)) {
+        return false;
+    }
 
-                if (( foundRange ) &&
-                    ( x >= dataRange.lower ) &&
-                    ( x <= dataRange.upper )) {
-                    auto valueString = QString();
-                    /*auto valueResultRange = customPlot->graph(RoundTripGraph)->data()->valueRange(
-                            foundRange,
-                            QCP::sdBoth,
-                            QCPRange(x - 1, x +1) );*/
+    m_replay = true;
+    m_replayHops = m_recording.hops();
 
-                    for (auto currentItem = 0; currentItem < m_tableModel->rowCount(); currentItem++) {
-                        auto pingData = m_tableModel->item(
-                                currentItem,
-                                0
-                        )->data().value<Nedrysoft::RouteAnalyser::PingData *>();
+    if (m_replayHops.isEmpty()) {
+        return false;
+    }
 
-                        auto valueRange = QCPRange(x - 1, x + 1);
+    for (auto hop = 1; hop <= m_replayHops.lastKey(); hop++) {
+        route.append(QHostAddress(m_replayHops.value(hop)["address"].toString()));
+    }
 
-                        if (pingData->customPlot()) {
-                            auto tempResultRange = pingData->customPlot()->graph(
-                                    RoundTripGraph)->data()->valueRange(foundRange, QCP::sdBoth, valueRange);
+    onRouteResult(route.last(), route, false, route.count(), route.count());
+    onRouteResult(route.last(), route, true, route.count(), route.count());
 
-                            pingData->setHistoricalLatency(tempResultRange.upper);
-                        } else {
-                            pingData->setHistoricalLatency(-1);
+    m_sampleStore.setRecording(&m_recording);
 
-                            auto topLeft = m_tableModel->index(0, 0);
-                            auto bottomRight = topLeft.sibling(m_tableModel->rowCount() - 1,
-                                                               m_tableModel->columnCount() - 1);
+    if (!m_sampleStore.load(m_recording)) {
+        return false;
+    }
 
-                            m_tableModel->dataChanged(topLeft, bottomRight);
-                        }
-                    }
+    qint64 start, end;
 
-                    this->m_tableModel->setProperty("showHistorical", true);
+    if (m_sampleStore.timeRange(start, end)) {
+        m_startPoint = static_cast<double>(start) / MillisecondsPerSecond;
+        m_endPoint = static_cast<double>(end) / MillisecondsPerSecond;
+    }
 
-                    /*
-                    auto seconds = std::chrono::duration<double>(valueResultRange.upper);
+    m_viewportDataInvalid = true;
 
-                    if (seconds < std::chrono::seconds(1)) {
-                        auto milliseconds =
-                            std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(seconds);
+    updateRanges();
 
-                        valueString = QString(tr("%1ms")).arg(milliseconds.count(), 0, 'f', 2);
-                    } else {
-                        valueString = QString(tr("%1s")).arg(seconds.count(), 0, 'f', 2);
-                    }
+    Q_EMIT datasetChanged(m_startPoint, m_endPoint);
 
-                    auto dateTime = QDateTime::fromSecsSinceEpoch(static_cast<qint64>(x));
+    // the table statistics require every sample, so they are calculated in chunks to keep the ui responsive.
 
-                    m_pointInfoLabel->setText(FontAwesome::richText(QString("[fas fa-stopwatch] %1").arg(valueString)));
-                    m_hopInfoLabel->setText(FontAwesome::richText(QString("[fas fa-project-diagram] %1 %2").arg(tr("hop")).arg(hop)));
-                    m_hostInfoLabel->setText(FontAwesome::richText(QString("[fas fa-server] %1").arg(maskedHostName)));
-                    m_timeInfoLabel->setText(FontAwesome::richText(QString("[far fa-calendar-alt] %1").arg(dateTime.toString())));
-                    */
-                } else {
-                    /*
-                    m_pointInfoLabel->setText("");
-                    m_hopInfoLabel->setText("");
-                    m_hostInfoLabel->setText("");
-                    m_timeInfoLabel->setText("");
-                    */
+    m_replayTimer = new QTimer(this);
 
-                    this->m_tableModel->setProperty("showHistorical", false);
+    connect(m_replayTimer, &QTimer::timeout, this, &RouteAnalyserWidget::replayNextChunk);
 
-                    auto topLeft = m_tableModel->index(0, 0);
-                    auto bottomRight = topLeft.sibling(
-                            m_tableModel->rowCount() - 1,
-                            m_tableModel->columnCount() - 1 );
+    m_replayTimer->start(0);
 
-                    m_tableModel->dataChanged(topLeft, bottomRight);
-                }
-            }
-        );
+    return true;
+}
 
-        customPlot->installEventFilter(this);
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateLatencyRanking(
+        Nedrysoft::RouteAnalyser::PingData *pingData) -> void {
 
-        m_plotList.append(customPlot);
+    static const auto fields = QList<PingData::Fields>() <<
+        PingData::Fields::MinimumLatency <<
+        PingData::Fields::MaximumLatency <<
+        PingData::Fields::AverageLatency <<
+        PingData::Fields::CurrentLatency;
 
-        auto plotTitleLabel = new QLabel;
+    for (auto field : fields) {
+        auto &ranking = m_latencyRanking[field];
+        auto previousMaximum = ranking.maximum();
 
-        QFont labelFont = plotTitleLabel->font();
+        ranking.update(pingData->hop(), pingData->latency(static_cast<int>(field)));
 
-        labelFont.setPointSize(16);
+        auto maximum = ranking.maximum();
 
-        plotTitleLabel->setFont(labelFont);
+        if (maximum != previousMaximum) {
+            m_tableUpdateScheduler->invalidate(previousMaximum - 1, static_cast<int>(field));
+            m_tableUpdateScheduler->invalidate(maximum - 1, static_cast<int>(field));
+        }
+    }
+}
 
-        plotTitleLabel->setAlignment(Qt::AlignHCenter);
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::replayNextChunk() -> void {
+    auto remaining = ReplayChunkSize;
 
-        verticalLayout->addWidget(plotTitleLabel);
+    while (remaining) {
+        if (m_replayOffset >= m_replaySamples.count()) {
+            if (m_replayHop >= m_pingData.count()) {
+                m_replayTimer->stop();
+                m_replaySamples.clear();
 
-        // add any pre-plots.
+                updateViewportStatistics();
 
-        auto plotFactories = ComponentSystem::getObjects<Nedrysoft::RouteAnalyser::IPlotFactory>();
+                return;
+            }
 
-        QList<Nedrysoft::RouteAnalyser::IPlot *> plots;
+            // the samples are replayed in the order that they arrived, so that the jitter and the loss bursts
+            // match those of the live session.
 
-        for (auto plotFactory : plotFactories) {
-            auto plot = plotFactory->createPlot(PlotMargins);
+            m_replaySamples = m_sampleStore.samples(m_replayHop, m_startPoint, m_endPoint + 1);
+            m_replayOffset = 0;
+            m_replayHop++;
 
-            m_extraPlots.append(plot);
+            continue;
+        }
 
-            plots.append(plot);
+        auto pingData = m_pingData.at(m_replayHop-1);
+        auto sample = m_replaySamples.at(m_replayOffset++);
+        auto code = Nedrysoft::RouteAnalyser::PingResult::ResultCode::TimeExceeded;
+        auto payloadSize = m_payload.size();
 
-            verticalLayout->addWidget(plot->widget());
+        if (sample.roundTripTime < 0) {
+            code = Nedrysoft::RouteAnalyser::PingResult::ResultCode::NoReply;
+        } else if (m_replayHop == m_pingData.count()) {
+            code = Nedrysoft::RouteAnalyser::PingResult::ResultCode::Ok;
         }
 
-        customPlot->axisRect()->setAutoMargins(QCP::msNone);
-        customPlot->axisRect()->setMargins(PlotMargins);
-
-        // add the main plot
+        if (m_payload.isSweep()) {
+            payloadSize = sample.alternate ? m_payload.largeSize() : m_payload.smallSize();
+        }
 
-        verticalLayout->addWidget(customPlot);
+        auto result = Nedrysoft::RouteAnalyser::PingResult(
+            static_cast<unsigned long>(m_replayOffset),
+            code,
+            QHostAddress(pingData->hostAddress()),
+            QDateTime::fromMSecsSinceEpoch(qRound64(sample.time * 1000.0)),
+            sample.roundTripTime,
+            nullptr,
+            m_replayHop,
+            payloadSize
+        );
 
-        auto pingTarget = m_pingEngine->addTarget(routeHostAddress, hop);
+        result.setRequestTimestamp(qRound64(sample.time * NanosecondsPerSecond));
 
-        auto pingData = m_pingData.at(hop-1);
+        pingData->updateItem(result);
 
-        pingData->setHopValid(true);
-        pingData->setPlots(plots);
-        pingData->setCustomPlot(customPlot);
+        updateLatencyRanking(pingData);
 
-        pingTarget->setUserData(pingData);
+        remaining--;
+    }
 
-        if (geoIP) {
-            geoIP->lookup(hostAddress, [pingData](const QString &, const QVariantMap &result) mutable {
-                pingData->setLocation(result["country"].toString());
-            });
-        }
+    if (m_payload.isSweep()) {
+        updateBandwidth();
+    }
+}
 
-        auto hostMaskerManager = Nedrysoft::Core::IHostMaskerManager::getInstance();
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::onPathMTUResult(
+        const QHostAddress routeHostAddress,
+        const QList<int> pathMTU ) -> void {
 
-        if (hostMaskerManager) {
-            connect(
-                hostMaskerManager,
-                &Nedrysoft::Core::IHostMaskerManager::maskStateChanged,
-                [pingData, plotTitleLabel](Nedrysoft::Core::HostMask::HostMaskType type, bool state) {
-                    pingData->updateModel();
-                    plotTitleLabel->setText(pingData->plotTitle());
-            });
-        }
+    Q_UNUSED(routeHostAddress)
 
-        plotTitleLabel->setText(pingData->plotTitle());
+    for (auto hop=0;hop<qMin(pathMTU.count(), m_pingData.count());hop++) {
+        m_pingData.at(hop)->setPathMTU(pathMTU.at(hop));
     }
+}
 
-    connect(
-        this,
-        &Nedrysoft::RouteAnalyser::RouteAnalyserWidget::filteredEvent,
-        [=](QObject *watched, QEvent *event) {
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateBandwidth() -> void {
+    auto previousDelay = 0.0;
 
-            auto customPlot = qobject_cast<QCustomPlot *>(watched);
+    for (auto pingData : m_pingData) {
+        auto delay = pingData->serialisationDelay(m_payload.smallSize(), m_payload.largeSize());
 
-            auto line = m_graphLines[customPlot];
+        if (delay < 0) {
+            pingData->setBandwidth(-1);
 
-            if (event->type() == QEvent::PaletteChange) {
-                customPlot->setBackground(this->palette().brush(QPalette::Base));
+            continue;
+        }
 
-                customPlot->xAxis->setLabelColor(this->palette().color(QPalette::Text));
-                customPlot->yAxis->setLabelColor(this->palette().color(QPalette::Text));
-                customPlot->xAxis->setTickLabelColor(this->palette().color(QPalette::Text));
-                customPlot->yAxis->setTickLabelColor(this->palette().color(QPalette::Text));
-
-                QCPTextElement *textElement = qobject_cast<QCPTextElement *>(
-                        customPlot->plotLayout()->element(0, 0));
-
-                if (textElement) {
-                    textElement->setTextColor(this->palette().color(QPalette::Text));
-                }
-            }
-
-            if ((event->type() == QEvent::Enter) ||
-                (event->type() == QEvent::Leave)) {
-
-                /*m_pointInfoLabel->setText("");
-                m_hopInfoLabel->setText("");
-                m_hostInfoLabel->setText("");
-                m_timeInfoLabel->setText("");*/
-
-                line->setVisible(event->type() == QEvent::Enter);
-
-                customPlot->replot();
-
-                this->m_tableModel->setProperty("showHistorical", false);
-
-                auto topLeft = m_tableModel->index(0, 0);
-                auto bottomRight = topLeft.sibling(m_tableModel->rowCount() - 1,
-                                                   m_tableModel->columnCount() - 1);
+        auto linkDelay = delay - previousDelay;
 
-                m_tableModel->dataChanged(topLeft, bottomRight);
-            }
+        if (linkDelay > 0) {
+            pingData->setBandwidth(BitsPerByte / linkDelay);
+        } else {
+            pingData->setBandwidth(-1);
         }
-    );
-
-    m_scrollArea->widget()->setLayout(verticalLayout);
 
-    m_routeDiscoveryWidget->setVisible(false);
-    m_scrollArea->setVisible(true);
-
-    update();
-
-    m_pingEngine->start();
+        previousDelay = delay;
+    }
 }
 
 auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::eventFilter(QObject *watched, QEvent *event) -> bool {
@@ -826,6 +1011,7 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::setGradientEnabled(bool smoo
 
 auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::setViewportSize(double viewportSize) -> void {
     m_viewportSize = viewportSize;
+    m_viewportDataInvalid = true;
 
     updateRanges();
 }
@@ -840,10 +1026,554 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::datasetSize(void) -> double
 
 auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::setViewportPosition(double position) -> void {
     m_viewportPosition = qMin(qMax(0.0, position), 1.0);
+    m_viewportDataInvalid = true;
 
     updateRanges();
 }
 
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::setStatisticsWindow(
+        Nedrysoft::RouteAnalyser::PingData::StatisticsWindow window) -> void {
+
+    m_statisticsWindow = window;
+
+    for (auto pingData : m_pingData) {
+        pingData->setStatisticsWindow(window);
+
+        updateLatencyRanking(pingData);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateViewportData() -> void {
+    for (auto pingData : m_pingData) {
+        updateViewportData(pingData);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateViewportData(
+        Nedrysoft::RouteAnalyser::PingData *pingData) -> void {
+
+    auto customPlot = pingData->customPlot();
+
+    if (!customPlot) {
+        return;
+    }
+
+    QVector<QCPBarsData> noReplyData;
+
+    if (m_barCharts.contains(customPlot)) {
+        m_barCharts[customPlot]->setWidth(NoReplyBarWidth * qMax(m_viewportResolution, 1));
+    }
+
+    for (auto graphIndex = 0; graphIndex < customPlot->graphCount(); graphIndex++) {
+        auto &decimator = m_graphDecimators[customPlot->graph(graphIndex)];
+
+        decimator.setColumnWidth(m_decimationWidth);
+        decimator.clear();
+
+        customPlot->graph(graphIndex)->data()->clear();
+    }
+
+    if (m_viewportResolution) {
+        if (m_barCharts.contains(customPlot)) {
+            m_barCharts[customPlot]->data()->clear();
+        }
+
+        addViewportRollups(pingData, m_viewportMinimum, m_viewportMaximum);
+
+        return;
+    }
+
+    auto largeProbeGraph = (customPlot->graphCount() > LargeProbeGraph) ? customPlot->graph(LargeProbeGraph) : nullptr;
+    auto &roundTripDecimator = m_graphDecimators[customPlot->graph(RoundTripGraph)];
+
+    for (auto sample : m_sampleStore.samples(pingData->hop()-1, m_viewportMinimum, m_viewportMaximum)) {
+        auto key = sample.time;
+
+        if (sample.roundTripTime < 0) {
+            noReplyData.append(QCPBarsData(key, 1));
+        } else if (sample.alternate) {
+            if (largeProbeGraph) {
+                m_graphDecimators[largeProbeGraph].append(key, sample.roundTripTime);
+            }
+        } else {
+            roundTripDecimator.append(key, sample.roundTripTime);
+        }
+    }
+
+    for (auto graphIndex = 0; graphIndex < customPlot->graphCount(); graphIndex++) {
+        updateDecimatedData(customPlot->graph(graphIndex), m_viewportMinimum, m_viewportMaximum);
+    }
+
+    if (m_barCharts.contains(customPlot)) {
+        m_barCharts[customPlot]->data()->set(noReplyData);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::createGraphSurface() -> QWidget * {
+    auto latencySettings = Nedrysoft::RouteAnalyser::LatencySettings::getInstance();
+    auto surface = new QWidget;
+    auto verticalLayout = new QVBoxLayout(surface);
+
+    auto customPlot = new QCustomPlot();
+
+    setPlotAcceleration(customPlot);
+
+    customPlot->addLayer("newBackground", customPlot->layer("grid"), QCustomPlot::limBelow);
+
+    auto latencyLayer = new GraphLatencyLayer(customPlot);
+
+    m_backgroundLayers.append(latencyLayer);
+
+    connect(
+        latencySettings,
+        &Nedrysoft::RouteAnalyser::LatencySettings::gradientChanged,
+        [=](bool /*useGradient*/) {
+            latencyLayer->invalidate();
+        }
+    );
+
+    connect(
+        latencySettings,
+        &Nedrysoft::RouteAnalyser::LatencySettings::thresholdsChanged,
+        latencyLayer,
+        [=]() {
+            latencyLayer->invalidate();
+        }
+    );
+
+    customPlot->setCurrentLayer("main");
+
+    customPlot->setMinimumHeight(DefaultGraphHeight);
+
+    customPlot->addGraph();
+
+    // the timeout bar chart uses axis 2 which is a unit axis.  This means it will always draw to the top
+    // of the axis independently of the main axis which may scale up/down depending on latency.
+
+    customPlot->yAxis2->setRange(0,1);
+    customPlot->yAxis2->setVisible(true);
+
+    auto barChart = new BarChart(customPlot->xAxis, customPlot->yAxis2);
+
+    barChart->setWidthType(QCPBars::wtPlotCoords);
+    barChart->setBrush(QColor(NoReplyColour));
+    barChart->setPen(QPen(QColor(NoReplyColour)));
+
+    m_barCharts[customPlot] = barChart;
+
+    customPlot->yAxis->ticker()->setTickCount(1);
+
+    QSharedPointer<CPAxisTickerMS> msTicker(new CPAxisTickerMS);
+
+    customPlot->yAxis->setTicker(msTicker);
+    customPlot->yAxis->setLabel(tr("Latency (ms)"));
+    customPlot->yAxis->setRange(0, DefaultMaxLatency);
+
+    QSharedPointer<QCPAxisTickerDateTime> dateTicker(new QCPAxisTickerDateTime);
+
+    auto locale = QLocale::system();
+
+    dateTicker->setDateTimeFormat(
+        locale.timeFormat(QLocale::LongFormat).remove("t").trimmed() +
+        "\n" +
+        locale.dateFormat(QLocale::ShortFormat)
+    );
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+    auto secondsSinceEpoch = QDateTime::currentSecsSinceEpoch();
+#else
+    auto secondsSinceEpoch = abs(QDateTime::currentDateTime().secsTo(QDateTime(QDate(1970,1,1), QTime(0, 0))));
+#endif
+
+    customPlot->xAxis->setTicker(dateTicker);
+    customPlot->xAxis->setRange(
+        static_cast<double>(secondsSinceEpoch),
+        static_cast<double>(secondsSinceEpoch + m_viewportSize)
+    );
+
+    customPlot->graph(RoundTripGraph)->setLineStyle(QCPGraph::lsStepCenter);
+
+    if (m_payload.isSweep()) {
+        // in size sweep mode the small probes are plotted on the round trip graph and the large probes
+        // are plotted on a second graph so that the serialisation delay is visible.
+
+        customPlot->addGraph();
+
+        customPlot->graph(LargeProbeGraph)->setLineStyle(QCPGraph::lsStepCenter);
+        customPlot->graph(LargeProbeGraph)->setPen(QPen(QColor(LargeProbeColour)));
+    }
+
+    customPlot->setBackground(this->palette().brush(QPalette::Base));
+    customPlot->xAxis->setLabelColor(this->palette().color(QPalette::Text));
+    customPlot->yAxis->setLabelColor(this->palette().color(QPalette::Text));
+    customPlot->xAxis->setTickLabelColor(this->palette().color(QPalette::Text));
+    customPlot->yAxis->setTickLabelColor(this->palette().color(QPalette::Text));
+
+    m_renderScheduler->addPlot(customPlot);
+    m_renderScheduler->invalidate(customPlot);
+
+    /**
+     * scroll wheel events, by default QCustomPlot does not propagate these so this code ensures that they cause
+     * the scroll area to scroll.
+     */
+
+    connect(customPlot, &QCustomPlot::mouseWheel, [this](QWheelEvent *event) {
+        m_scrollArea->verticalScrollBar()->setValue(
+            m_scrollArea->verticalScrollBar()->value() - event->angleDelta().y()
+        );
+    });
+
+    /**
+     *  mouse over event
+     */
+
+    // the crosshair is drawn on a buffered layer of its own, so moving it redraws only that layer.
+
+    customPlot->addLayer(CrosshairLayer, customPlot->layer("main"), QCustomPlot::limAbove);
+    customPlot->layer(CrosshairLayer)->setMode(QCPLayer::lmBuffered);
+
+    auto graphLine = new QCPItemStraightLine(customPlot);
+
+    graphLine->setLayer(CrosshairLayer);
+    graphLine->setPen(QPen(Qt::darkGray, 2, Qt::DotLine));
+
+    m_graphLines[customPlot] = graphLine;
+
+    connect(
+        customPlot,
+        &QCustomPlot::mouseMove,
+        [this, customPlot](QMouseEvent *event) {
+            // the mouse position is recorded and the crosshair and table are updated once per frame.
+
+            m_crosshairPlot = customPlot;
+            m_crosshairTime = customPlot->xAxis->pixelToCoord(event->pos().x());
+
+            if (!m_crosshairTimer->isActive()) {
+                m_crosshairTimer->start();
+            }
+        }
+    );
+
+    customPlot->installEventFilter(this);
+
+    m_plotList.append(customPlot);
+
+    auto plotTitleLabel = new QLabel;
+
+    QFont labelFont = plotTitleLabel->font();
+
+    labelFont.setPointSize(16);
+
+    plotTitleLabel->setFont(labelFont);
+
+    plotTitleLabel->setAlignment(Qt::AlignHCenter);
+
+    verticalLayout->addWidget(plotTitleLabel);
+
+    // add any pre-plots.
+
+    auto plotFactories = ComponentSystem::getObjects<Nedrysoft::RouteAnalyser::IPlotFactory>();
+
+    QList<Nedrysoft::RouteAnalyser::IPlot *> plots;
+    QList<QCustomPlot *> plotWidgets;
+
+    for (auto plotFactory : plotFactories) {
+        auto plot = plotFactory->createPlot(PlotMargins);
+
+        m_extraPlots.append(plot);
+
+        plots.append(plot);
+
+        // the widget is created by the call, so it is only requested once.
+
+        auto plotWidget = plot->widget();
+        auto extraPlot = qobject_cast<QCustomPlot *>(plotWidget);
+
+        if (extraPlot) {
+            setPlotAcceleration(extraPlot);
+
+            m_renderScheduler->addPlot(extraPlot);
+
+            plotWidgets.append(extraPlot);
+        }
+
+        verticalLayout->addWidget(plotWidget);
+    }
+
+    customPlot->axisRect()->setAutoMargins(QCP::msNone);
+    customPlot->axisRect()->setMargins(PlotMargins);
+
+    // add the main plot
+
+    verticalLayout->addWidget(customPlot);
+
+    auto hostMaskerManager = Nedrysoft::Core::IHostMaskerManager::getInstance();
+
+    if (hostMaskerManager) {
+        connect(
+            hostMaskerManager,
+            &Nedrysoft::Core::IHostMaskerManager::maskStateChanged,
+            surface,
+            [this, surface](Nedrysoft::Core::HostMask::HostMaskType type, bool state) {
+                auto &graphSurface = m_graphSurfaces[surface];
+
+                if (graphSurface.pingData) {
+                    graphSurface.titleLabel->setText(graphSurface.pingData->plotTitle());
+                }
+        });
+    }
+
+    m_graphSurfaces[surface] = GraphSurface{customPlot, plotTitleLabel, plots, plotWidgets, nullptr};
+
+    return surface;
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::bindGraphSurface(QWidget *surface, int hop) -> void {
+    auto &graphSurface = m_graphSurfaces[surface];
+    auto pingData = m_pingData.at(hop-1);
+    auto customPlot = graphSurface.customPlot;
+
+    graphSurface.pingData = pingData;
+    graphSurface.titleLabel->setText(pingData->plotTitle());
+
+    pingData->setCustomPlot(customPlot);
+    pingData->setPlots(graphSurface.plots);
+
+    updateViewportData(pingData);
+
+    if (m_viewportMaximum > m_viewportMinimum) {
+        customPlot->xAxis->setRange(m_viewportMinimum, m_viewportMaximum);
+    }
+
+    if (m_graphScaleMode == ScaleMode::None) {
+        auto foundRange = false;
+        auto valueRange = customPlot->graph(RoundTripGraph)->getValueRange(
+            foundRange,
+            QCP::sdBoth,
+            customPlot->xAxis->range()
+        );
+
+        customPlot->yAxis->setRange(0, foundRange ? std::max(valueRange.upper, DefaultMaxLatency) : DefaultMaxLatency);
+    }
+
+    // the additional plots are derived from the replies, so they are rebuilt from the samples in the viewport.
+
+    auto samples = m_sampleStore.samples(hop-1, m_viewportMinimum, m_viewportMaximum);
+
+    for (auto plot : graphSurface.plots) {
+        plot->clear();
+
+        for (auto sample : samples) {
+            if ((sample.roundTripTime >= 0) && (!sample.alternate)) {
+                plot->update(sample.time, sample.roundTripTime);
+            }
+        }
+
+        if (m_viewportMaximum > m_viewportMinimum) {
+            plot->updateRange(m_viewportMinimum, m_viewportMaximum);
+        }
+    }
+
+    for (auto plotWidget : graphSurface.plotWidgets) {
+        m_renderScheduler->invalidate(plotWidget);
+    }
+
+    m_renderScheduler->invalidate(customPlot);
+    m_renderScheduler->invalidateRanges();
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::unbindGraphSurface(QWidget *surface) -> void {
+    auto &graphSurface = m_graphSurfaces[surface];
+    auto customPlot = graphSurface.customPlot;
+
+    if (graphSurface.pingData) {
+        graphSurface.pingData->setCustomPlot(nullptr);
+        graphSurface.pingData->setPlots(QList<Nedrysoft::RouteAnalyser::IPlot *>());
+    }
+
+    graphSurface.pingData = nullptr;
+
+    // the data is released so that the memory held by the graphs does not depend on the number of hops.
+
+    for (auto graphIndex = 0; graphIndex < customPlot->graphCount(); graphIndex++) {
+        customPlot->graph(graphIndex)->data()->clear();
+
+        m_graphDecimators.remove(customPlot->graph(graphIndex));
+    }
+
+    if (m_barCharts.contains(customPlot)) {
+        m_barCharts[customPlot]->data()->clear();
+    }
+
+    for (auto plot : graphSurface.plots) {
+        plot->clear();
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::addViewportRollups(
+        Nedrysoft::RouteAnalyser::PingData *pingData,
+        double start,
+        double end) -> void {
+
+    auto customPlot = pingData->customPlot();
+
+    if ((!customPlot) || (!m_viewportResolution)) {
+        return;
+    }
+
+    auto resolution = static_cast<double>(m_viewportResolution);
+
+    start = std::floor(start / resolution) * resolution;
+    end = std::floor(end / resolution) * resolution;
+
+    // the intervals are replaced, as an interval that is already plotted may have been updated.  The end of the
+    // removed range is exclusive, so it is extended to the end of the last interval.
+
+    if (m_barCharts.contains(customPlot)) {
+        m_barCharts[customPlot]->data()->remove(start, end + resolution);
+    }
+
+    // an interval with lost requests in either series has a single no reply bar.
+
+    std::vector<double> lostIntervals;
+
+    for (auto graphIndex : {RoundTripGraph, LargeProbeGraph}) {
+        if (graphIndex >= customPlot->graphCount()) {
+            continue;
+        }
+
+        auto graph = customPlot->graph(graphIndex);
+        auto rollups = m_sampleStore.rollups(
+            pingData->hop()-1,
+            m_viewportResolution,
+            start,
+            end,
+            graphIndex == LargeProbeGraph
+        );
+
+        // an interval that has been updated only widens its envelope, so the rollups can be added again.
+
+        auto &decimator = m_graphDecimators[graph];
+
+        for (auto rollup : rollups) {
+            if (rollup.replies) {
+                decimator.append(rollup.time, rollup.maximum);
+                decimator.append(rollup.time + (resolution / 2), rollup.minimum);
+            }
+
+            if (rollup.lost) {
+                lostIntervals.push_back(rollup.time);
+            }
+        }
+
+        updateDecimatedData(graph, start, end + (resolution / 2));
+    }
+
+    if (m_barCharts.contains(customPlot)) {
+        std::sort(lostIntervals.begin(), lostIntervals.end());
+
+        lostIntervals.erase(std::unique(lostIntervals.begin(), lostIntervals.end()), lostIntervals.end());
+
+        for (auto time : lostIntervals) {
+            m_barCharts[customPlot]->addData(time, 1);
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::addDecimatedData(
+        QCPGraph *graph,
+        double time,
+        double value) -> void {
+
+    m_graphDecimators[graph].append(time, value);
+
+    updateDecimatedData(graph, time, time);
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateDecimatedData(
+        QCPGraph *graph,
+        double start,
+        double end) -> void {
+
+    auto &decimator = m_graphDecimators[graph];
+    auto firstColumn = decimator.columnStart(start);
+    auto lastColumn = decimator.columnStart(end);
+
+    // the points of a column lie before the start of the next column.
+
+    graph->data()->remove(firstColumn, std::nextafter(decimator.columnEnd(end), firstColumn));
+
+    QVector<QCPGraphData> graphData;
+
+    for (auto point : decimator.points(firstColumn, lastColumn)) {
+        graphData.append(QCPGraphData(point.time, point.value));
+    }
+
+    graph->data()->add(graphData, true);
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateViewportStatistics() -> void {
+    // the summary is taken from the rollups, so a long viewport or one whose samples have expired is not decoded.
+
+    for (auto pingData : m_pingData) {
+        pingData->setViewportSummary(
+            m_sampleStore.aggregate(pingData->hop()-1, m_viewportMinimum, m_viewportMaximum)
+        );
+
+        updateLatencyRanking(pingData);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::tableText(
+        bool csv,
+        Nedrysoft::Core::HostMask::HostMaskType maskType) -> QString {
+
+    auto separator = csv ? QString(",") : QString("\t");
+    auto fields = headerMap().keys();
+    QStringList lines;
+    QStringList columns;
+
+    fields.removeAll(PingData::Fields::Graph);
+
+    auto formatColumn = [csv](const QString &text) {
+        if (!csv) {
+            return text;
+        }
+
+        return QString("\"%1\"").arg(QString(text).replace("\"", "\"\""));
+    };
+
+    for (auto field : fields) {
+        columns.append(formatColumn(headerMap()[field].first));
+    }
+
+    columns.append(formatColumn(tr("Loss Bursts")));
+
+    lines.append(columns.join(separator));
+
+    for (auto pingData : m_pingData) {
+        QStringList bursts;
+
+        columns.clear();
+
+        for (auto field : fields) {
+            columns.append(formatColumn(pingData->text(field, maskType)));
+        }
+
+        auto lossBursts = pingData->linkQuality().lossBursts();
+
+        for (auto it = lossBursts.constBegin(); it != lossBursts.constEnd(); it++) {
+            bursts.append(QString("%1:%2").arg(it.key()).arg(it.value()));
+        }
+
+        columns.append(formatColumn(bursts.join(" ")));
+
+        lines.append(columns.join(separator));
+    }
+
+    return lines.join("\n") + "\n";
+}
+
 auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::viewportPosition() -> double {
     return m_viewportPosition;
 }
@@ -872,17 +1602,77 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateRanges() -> void {
         }
     }
 
-    for (auto plot : m_plotList) {
-        bool foundRange;
+    m_viewportMinimum = min;
+    m_viewportMaximum = max;
+
+    updateViewportStatistics();
+
+    // the heatmap ends with the viewport and covers at least an hour, it only renders the columns that have moved.
+
+    m_heatmap->setRange(max - std::max(m_viewportSize, HeatmapPeriod), max);
+
+    // the resolution is chosen so that there are no more points than the plot has pixels.
+
+    auto resolution = 0;
+
+    if (!m_plotList.isEmpty() && (m_plotList.first()->axisRect()->width() > 0)) {
+        resolution = SampleStore::resolutionFor((max - min) / m_plotList.first()->axisRect()->width());
+    }
+
+    // data that has passed the retention period and was not recorded is only available at a coarser resolution.
+
+    resolution = std::max(resolution, m_sampleStore.retainedResolution(min));
+
+    if (resolution != m_viewportResolution) {
+        m_viewportResolution = resolution;
+        m_viewportDataInvalid = true;
+    }
+
+    // the graphs are decimated to pixel columns, so the number of points drawn depends on the width of the plot
+    // rather than the number of samples in the viewport.
+
+    auto decimationWidth = 0.0;
+
+    if (!m_plotList.isEmpty() && (m_plotList.first()->axisRect()->width() > 0)) {
+        decimationWidth = (max - min) / m_plotList.first()->axisRect()->width();
+    }
+
+    if (decimationWidth != m_decimationWidth) {
+        m_decimationWidth = decimationWidth;
+        m_viewportDataInvalid = true;
+    }
+
+    if (m_viewportDataInvalid) {
+        m_viewportDataInvalid = false;
+
+        updateViewportData();
+    } else if (m_viewportPosition == 1) {
+        for (auto plot : m_plotList) {
+            for (auto graphIndex = 0; graphIndex < plot->graphCount(); graphIndex++) {
+                plot->graph(graphIndex)->data()->removeBefore(min);
+
+                if (m_graphDecimators.contains(plot->graph(graphIndex))) {
+                    m_graphDecimators[plot->graph(graphIndex)].removeBefore(min);
+                }
+            }
+
+            if (m_barCharts.contains(plot)) {
+                m_barCharts[plot]->data()->removeBefore(min);
+            }
+        }
+    }
 
+    for (auto plot : m_plotList) {
         plot->xAxis->setRange(min, max);
+    }
 
-        QCPRange visibleKeyRange = plot->xAxis->range();
+    // the normalised scale covers every hop, including those that are scrolled out of view and have no graph.
 
-        QCPRange valueRange = plot->graph()->getValueRange(foundRange, QCP::sdBoth, visibleKeyRange);
+    if (m_graphScaleMode == ScaleMode::Normalised) {
+        for (auto pingData : m_pingData) {
+            auto aggregate = m_sampleStore.aggregate(pingData->hop()-1, min, max);
 
-        if (valueRange.upper>maxVisibleLatency) {
-            maxVisibleLatency = valueRange.upper;
+            maxVisibleLatency = std::max(maxVisibleLatency, aggregate.maximum);
         }
     }
 
@@ -890,6 +1680,14 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateRanges() -> void {
         plot->updateRange(min, max);
     }
 
+    // the additional plots do not redraw themselves, they are drawn with the frame like the main plots.
+
+    for (auto &graphSurface : m_graphSurfaces) {
+        for (auto plotWidget : graphSurface.plotWidgets) {
+            m_renderScheduler->invalidate(plotWidget);
+        }
+    }
+
     // TODO: go through the bar charts and set to maximum as well.
 
     for (auto plot : m_plotList) {
@@ -897,10 +1695,93 @@ auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateRanges() -> void {
             plot->graph(0)->valueAxis()->setRangeUpper(maxVisibleLatency);
         }
 
-        if (plot->isVisible()) {
-            if (!plot->visibleRegion().isEmpty()) {
-                plot->replot(QCustomPlot::rpQueuedReplot);
+        m_renderScheduler->invalidate(plot);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::openGLAvailable() -> bool {
+#if defined(QCUSTOMPLOT_USE_OPENGL)
+    // the offscreen and minimal platforms are used for headless operation and have no GPU, software OpenGL is
+    // slower than the raster engine so it is not used either.
+
+    auto platformName = QGuiApplication::platformName();
+
+    if (( platformName == "offscreen" ) || ( platformName == "minimal" )) {
+        return false;
+    }
+
+    if (QCoreApplication::testAttribute(Qt::AA_UseSoftwareOpenGL)) {
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::setPlotAcceleration(QCustomPlot *customPlot) -> void {
+    if (!m_openGLEnabled) {
+        return;
+    }
+
+    // QCustomPlot reverts to the raster engine if the OpenGL context or framebuffer cannot be created, in which
+    // case the remaining plots are not attempted.
+
+    customPlot->setOpenGl(true);
+
+    if (!customPlot->openGl()) {
+        SPDLOG_WARN("OpenGL is not available, the graphs will be drawn in software.");
+
+        m_openGLEnabled = false;
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::RouteAnalyserWidget::updateCrosshair() -> void {
+    auto customPlot = m_crosshairPlot.data();
+
+    if ((!customPlot) || (!m_graphLines.contains(customPlot))) {
+        return;
+    }
+
+    auto x = m_crosshairTime;
+    auto graphLine = m_graphLines[customPlot];
+
+    graphLine->point1->setCoords(x, 0);
+    graphLine->point2->setCoords(x, 1);
+
+    customPlot->layer(CrosshairLayer)->replot();
+
+    if (( m_startPoint >= 0 ) && ( x >= m_startPoint ) && ( x <= m_endPoint )) {
+        // only the hops in view have a graph, so the latencies at this point are read from the store, the replies
+        // either side of the crosshair are interpolated so the value follows the line drawn by the graph.
+
+        auto tolerance = static_cast<double>(m_interval) / MillisecondsPerSecond;
+
+        for (auto pingData : m_pingData) {
+            Nedrysoft::RouteAnalyser::SampleStore::Sample sample;
+            auto latency = -1.0;
+
+            if (m_sampleStore.valueAt(
+                    pingData->hop()-1,
+                    x,
+                    tolerance,
+                    sample,
+                    Nedrysoft::RouteAnalyser::SampleStore::Lookup::Interpolate )) {
+
+                latency = sample.roundTripTime;
             }
+
+            pingData->setHistoricalLatency(latency);
         }
+
+        this->m_tableModel->setProperty("showHistorical", true);
+    } else {
+        this->m_tableModel->setProperty("showHistorical", false);
+
+        m_tableUpdateScheduler->invalidate(
+                0,
+                m_tableModel->rowCount() - 1,
+                static_cast<int>(Nedrysoft::RouteAnalyser::PingData::Fields::Graph) );
     }
 }
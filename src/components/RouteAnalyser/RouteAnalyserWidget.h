@@ -27,13 +27,19 @@
 #pragma warning(push)
 #pragma warning(disable : 4996)
 
+#include "EnvelopeDecimator.h"
 #include "IRouteEngine.h"
+#include "LatencyRanking.h"
 #include "PingData.h"
+#include "PingPayload.h"
 #include "PingResult.h"
+#include "SampleStore.h"
+#include "SessionRecording.h"
 #include "QCustomPlot/qcustomplot.h"
 
 #include <QMap>
 #include <QPair>
+#include <QPointer>
 #include <QWidget>
 
 #pragma warning(pop)
@@ -42,6 +48,7 @@ namespace Nedrysoft { namespace Core {
     class IHostMasker;
 }}
 
+class QLabel;
 class QTableView;
 class QStandardItemModel;
 class QSplitter;
@@ -50,12 +57,16 @@ class Timer;
 
 namespace Nedrysoft { namespace RouteAnalyser {
     class GraphLatencyLayer;
+    class HopGraphList;
+    class LatencyHeatmap;
     class IPingEngine;
     class IPingEngineFactory;
+    class PlotRenderScheduler;
     class PlotScrollArea;
     class RouteTableItemDelegate;
     class RouteDiscoveryWidget;
     class RouteAnalyserEditor;
+    class TableUpdateScheduler;
 
     /**
      * @brief       The RouteAnalyserWidget class provides the main widget for a route analyser.
@@ -80,10 +91,15 @@ namespace Nedrysoft { namespace RouteAnalyser {
             /**
              * @brief       Constructs a new RouteAnalyserWidget with the given information.
              *
+             * @note        If the ping engine factory is nullptr then no route is discovered, this is used when a
+             *              recorded session is to be replayed.
+             *
              * @param[in]   targetHost the host being analysed. (ip address or hostname)
              * @param[in]   ipVersion the version of ip to be used.
              * @param[in]   interval the interval between pings.
              * @param[in]   pingEngineFactory the ping engine factory to use.
+             * @param[in]   pathMTUDiscoveryEnabled true if the path MTU to each hop should be discovered.
+             * @param[in]   payload the payload carried by the probes.
              * @param[in]   parent the parent widget.
              */
             explicit RouteAnalyserWidget(
@@ -91,6 +107,8 @@ namespace Nedrysoft { namespace RouteAnalyser {
                 Nedrysoft::Core::IPVersion ipVersion,
                 int interval,
                 Nedrysoft::RouteAnalyser::IPingEngineFactory *pingEngineFactory,
+                bool pathMTUDiscoveryEnabled = false,
+                const Nedrysoft::RouteAnalyser::PingPayload &payload = Nedrysoft::RouteAnalyser::PingPayload(),
                 QWidget *parent = nullptr
             );
 
@@ -126,6 +144,14 @@ namespace Nedrysoft { namespace RouteAnalyser {
                 const int maximumHops
             );
 
+            /**
+             * @brief       Called when the path MTU to each hop has been discovered.
+             *
+             * @param[in]   routeHostAddress the intended target of the route analysis.
+             * @param[in]   pathMTU the path MTU to each hop, -1 if the MTU could not be determined.
+             */
+            Q_SLOT void onPathMTUResult(const QHostAddress routeHostAddress, const QList<int> pathMTU);
+
             /**
              * @brief       This signal is emitted when a watched event on a child fires.
              *
@@ -145,6 +171,32 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             Q_SIGNAL void datasetChanged(double start, double end);
 
+            /**
+             * @brief       Records the session to a file.
+             *
+             * @details     The hops are written when the route has been discovered and the samples are written as
+             *              they are collected, the recording is finished when the widget is destroyed.
+             *
+             * @param[in]   filename the filename of the recording.
+             * @param[in]   session the session settings to store in the recording.
+             *
+             * @returns     true if the recording was created; otherwise false.
+             */
+            auto startRecording(const QString &filename, const QJsonObject &session) -> bool;
+
+            /**
+             * @brief       Replays a recorded session.
+             *
+             * @details     The hops and plots are created from the recording and the samples are copied into the
+             *              sample store so that the plots can be drawn immediately, the table statistics are then
+             *              calculated from the samples in the background.
+             *
+             * @param[in]   filename the filename of the recording.
+             *
+             * @returns     true if the recording was loaded; otherwise false.
+             */
+            auto replay(const QString &filename) -> bool;
+
             /**
              * @brief       Sets whether this instance draws with solid or gradient backgrounds on graphs.
              *
@@ -166,6 +218,26 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto setViewportPosition(double position) -> void;
 
+            /**
+             * @brief       Sets the window used for the minimum, maximum, average and packet loss in the table.
+             *
+             * @param[in]   window the statistics window.
+             */
+            auto setStatisticsWindow(Nedrysoft::RouteAnalyser::PingData::StatisticsWindow window) -> void;
+
+            /**
+             * @brief       Returns the contents of the route table as text.
+             *
+             * @details     Each hop is written as a row with the visible columns followed by the loss burst
+             *              distribution (burst length:count), latencies are in milliseconds.
+             *
+             * @param[in]   csv true if the output is comma separated values; otherwise tab separated.
+             * @param[in]   maskType the host masking mode which applies to the output.
+             *
+             * @returns     the table text.
+             */
+            auto tableText(bool csv, Nedrysoft::Core::HostMask::HostMaskType maskType) -> QString;
+
             /**
              * @brief       Gets the current position of the viewport
              *
@@ -209,9 +281,147 @@ namespace Nedrysoft { namespace RouteAnalyser {
 
             /**
              * @brief       Updates the ranges on the plots to match the viewport.
+             *
+             * @details     The plots are marked as changed with the render scheduler, they are redrawn in the next
+             *              frame rather than immediately.
              */
             auto updateRanges() -> void;
 
+            /**
+             * @brief       Refills the plots of each hop from the sample store with the samples in the viewport.
+             *
+             * @details     The plots only hold the samples that fall within the viewport, while the viewport follows
+             *              the most recent results older samples are discarded as they scroll out of view.
+             */
+            auto updateViewportData() -> void;
+
+            /**
+             * @brief       Refills the plots of a hop from the sample store with the samples in the viewport.
+             *
+             * @note        Hops that are not in view have no plots and are ignored.
+             *
+             * @param[in]   pingData the hop.
+             */
+            auto updateViewportData(Nedrysoft::RouteAnalyser::PingData *pingData) -> void;
+
+            /**
+             * @brief       Creates a graph surface for the graph list.
+             *
+             * @details     A surface holds the title, the additional plots and the latency plot of a hop, surfaces
+             *              are only created for the hops in view and are reused as the list is scrolled.
+             *
+             * @returns     the surface.
+             */
+            auto createGraphSurface() -> QWidget *;
+
+            /**
+             * @brief       Binds a graph surface to a hop and fills its plots from the sample store.
+             *
+             * @param[in]   surface the surface.
+             * @param[in]   hop the hop number.
+             */
+            auto bindGraphSurface(QWidget *surface, int hop) -> void;
+
+            /**
+             * @brief       Releases a graph surface from its hop and discards the data held by its plots.
+             *
+             * @param[in]   surface the surface.
+             */
+            auto unbindGraphSurface(QWidget *surface) -> void;
+
+            /**
+             * @brief       Returns whether the graphs can be drawn with OpenGL on this platform.
+             *
+             * @details     OpenGL is not used if support was not compiled in, if the application is running
+             *              headless or if only software OpenGL is available.
+             *
+             * @returns     true if OpenGL can be used; otherwise false.
+             */
+            auto openGLAvailable() -> bool;
+
+            /**
+             * @brief       Enables OpenGL rendering for a plot if it has been enabled in the settings.
+             *
+             * @note        The plot is left using the raster engine if the OpenGL context cannot be created.
+             *
+             * @param[in]   customPlot the plot.
+             */
+            auto setPlotAcceleration(QCustomPlot *customPlot) -> void;
+
+            /**
+             * @brief       Moves the crosshair to the last recorded mouse position and updates the table with the
+             *              latencies at that time.
+             *
+             * @details     Called once per frame while the mouse is moving over a graph, only the crosshair layer of
+             *              the graph is redrawn and the latencies are looked up in the sample store.
+             */
+            auto updateCrosshair() -> void;
+
+            /**
+             * @brief       Adds the rollups of a hop within a time range to its plots.
+             *
+             * @details     When the viewport covers more time than the plot has pixels, the plots are drawn from the
+             *              rollups of the sample store, each interval is plotted as its maximum followed by its
+             *              minimum so that spikes remain visible.
+             *
+             * @param[in]   pingData the hop.
+             * @param[in]   start the start of the range in seconds since the unix epoch.
+             * @param[in]   end the end of the range in seconds since the unix epoch.
+             */
+            auto addViewportRollups(Nedrysoft::RouteAnalyser::PingData *pingData, double start, double end) -> void;
+
+            /**
+             * @brief       Adds a point to a graph through its decimator.
+             *
+             * @details     Only the pixel column that the point falls in is replaced in the graph, so the cost of
+             *              adding a point does not depend on the number of points already plotted.
+             *
+             * @param[in]   graph the graph.
+             * @param[in]   time the time of the point in seconds since the unix epoch.
+             * @param[in]   value the value of the point.
+             */
+            auto addDecimatedData(QCPGraph *graph, double time, double value) -> void;
+
+            /**
+             * @brief       Replaces the points of a graph within a time range with the points of its decimator.
+             *
+             * @param[in]   graph the graph.
+             * @param[in]   start the start of the range in seconds since the unix epoch.
+             * @param[in]   end the end of the range in seconds since the unix epoch.
+             */
+            auto updateDecimatedData(QCPGraph *graph, double start, double end) -> void;
+
+            /**
+             * @brief       Updates the viewport statistics of each hop from the sample store.
+             *
+             * @details     Called whenever the ranges are updated, only the rows whose statistics have changed are
+             *              redrawn.
+             */
+            auto updateViewportStatistics() -> void;
+
+            /**
+             * @brief       Updates the rankings of the latency fields that are highlighted in the table for a hop.
+             *
+             * @details     When the hop holding the highest value of a field changes, the cells of the previous and
+             *              new hops are marked as changed so that the highlight moves.
+             *
+             * @param[in]   pingData the hop that has changed.
+             */
+            auto updateLatencyRanking(Nedrysoft::RouteAnalyser::PingData *pingData) -> void;
+
+            /**
+             * @brief       Adds the next chunk of replayed samples to the table statistics.
+             */
+            auto replayNextChunk() -> void;
+
+            /**
+             * @brief       Updates the estimated bandwidth of each hop from the size sweep results.
+             *
+             * @details     The serialisation delay of a hop includes the delay of every link before it, the
+             *              bandwidth of a link is estimated from the increase in delay over the previous hop.
+             */
+            auto updateBandwidth() -> void;
+
             /**
              * @brief       A map containing the fields that are displayed on the list.
              *
@@ -223,22 +433,45 @@ namespace Nedrysoft { namespace RouteAnalyser {
         private:
             //! @cond
 
+            struct GraphSurface {
+                QCustomPlot *customPlot;
+                QLabel *titleLabel;
+                QList<Nedrysoft::RouteAnalyser::IPlot *> plots;
+                QList<QCustomPlot *> plotWidgets;
+                Nedrysoft::RouteAnalyser::PingData *pingData;
+            };
+
             QMap<Nedrysoft::RouteAnalyser::IPingTarget *, int> m_targetMap;
             QList<QCustomPlot *> m_plotList;
             QMap<QCustomPlot *, QCPItemStraightLine *> m_graphLines;
+            QTimer *m_crosshairTimer;
+            QTimer *m_checkpointTimer;
+            QPointer<QCustomPlot> m_crosshairPlot;
+            double m_crosshairTime;
             QMap<QCustomPlot *, QCPBars *> m_barCharts;
+            QMap<QCPGraph *, Nedrysoft::RouteAnalyser::EnvelopeDecimator> m_graphDecimators;
+            QMap<Nedrysoft::RouteAnalyser::PingData::Fields, Nedrysoft::RouteAnalyser::LatencyRanking> m_latencyRanking;
             Nedrysoft::RouteAnalyser::IPingEngine *m_pingEngine = {};
             QStandardItemModel *m_tableModel;
+            Nedrysoft::RouteAnalyser::TableUpdateScheduler *m_tableUpdateScheduler;
             QTableView *m_tableView;
             QSplitter *m_splitter;
             PlotScrollArea *m_scrollArea;
+            Nedrysoft::RouteAnalyser::LatencyHeatmap *m_heatmap;
+            Nedrysoft::RouteAnalyser::HopGraphList *m_graphList;
+            QMap<QWidget *, GraphSurface> m_graphSurfaces;
+            QList<int> m_graphHops;
+            Nedrysoft::RouteAnalyser::PlotRenderScheduler *m_renderScheduler;
+            QLabel *m_frameTimeLabel;
+            QLabel *m_recordingLabel;
+            bool m_openGLEnabled;
             Nedrysoft::RouteAnalyser::RouteDiscoveryWidget *m_routeDiscoveryWidget;
             Nedrysoft::RouteAnalyser::IPingEngineFactory *m_pingEngineFactory;
             int m_interval;
+            Nedrysoft::RouteAnalyser::PingPayload m_payload;
             QList<Nedrysoft::RouteAnalyser::GraphLatencyLayer *> m_backgroundLayers;
             Nedrysoft::RouteAnalyser::RouteTableItemDelegate *m_routeGraphDelegate;
             ScaleMode m_graphScaleMode;
-            QTimer *m_layerCleanupTimer;
             QList<PingData *> m_pingData;
 
             QList<Nedrysoft::RouteAnalyser::IPlot *> m_extraPlots;
@@ -248,6 +481,24 @@ namespace Nedrysoft { namespace RouteAnalyser {
             double m_startPoint;
             double m_endPoint;
             double m_savedDiff;
+            double m_viewportMinimum;
+            double m_viewportMaximum;
+
+            bool m_viewportDataInvalid;
+            int m_viewportResolution;
+            double m_decimationWidth;
+
+            PingData::StatisticsWindow m_statisticsWindow;
+
+            Nedrysoft::RouteAnalyser::SampleStore m_sampleStore;
+            Nedrysoft::RouteAnalyser::SessionRecording m_recording;
+
+            bool m_replay;
+            QMap<int, QJsonObject> m_replayHops;
+            QTimer *m_replayTimer;
+            int m_replayHop;
+            int m_replayOffset;
+            QVector<Nedrysoft::RouteAnalyser::SampleStore::Sample> m_replaySamples;
 
             //! @endcond
     };
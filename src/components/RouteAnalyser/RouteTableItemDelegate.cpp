@@ -26,6 +26,7 @@
 #include "ColourManager.h"
 #include "LatencySettings.h"
 #include "PingData.h"
+#include "Utils.h"
 
 #include <IHostMaskerManager>
 #include <QHeaderView>
@@ -65,10 +66,35 @@ constexpr auto LatencyLineBorderAlphaLevel = 32;
 constexpr auto DiscoveryBubbleColour = qRgb(0x80, 0x80, 0x80);
 
 Nedrysoft::RouteAnalyser::RouteTableItemDelegate::RouteTableItemDelegate(QWidget *parent) :
-        QStyledItemDelegate(parent) {
+        QStyledItemDelegate(parent),
+        m_latencyRanking(nullptr) {
 
 }
 
+auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::setLatencyRanking(
+        const QMap<Nedrysoft::RouteAnalyser::PingData::Fields,
+                   Nedrysoft::RouteAnalyser::LatencyRanking> *latencyRanking) -> void {
+
+    m_latencyRanking = latencyRanking;
+}
+
+auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::isMaximum(
+        Nedrysoft::RouteAnalyser::PingData *pingData,
+        Nedrysoft::RouteAnalyser::PingData::Fields field) const -> bool {
+
+    if (!m_latencyRanking) {
+        return false;
+    }
+
+    auto ranking = m_latencyRanking->constFind(field);
+
+    if (ranking == m_latencyRanking->constEnd()) {
+        return false;
+    }
+
+    return ranking->isMaximum(pingData->hop());
+}
+
 auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::paint(
         QPainter *painter,
         const QStyleOptionViewItem &option,
@@ -148,17 +174,19 @@ auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::paint(
         }
 
         case PingData::Fields::MinimumLatency: {
+            auto latency = pingData->latency(static_cast<int>(PingData::Fields::MinimumLatency));
+
             paintBackground(pingData, painter, option, index);
 
-            if (pingData->m_minimumLatency==-1) {
+            if (latency==-1) {
                 paintBubble(pingData, painter, option, index, DiscoveryBubbleColour, InvalidHopLineWidth);
             } else {
                 paintText(QString("%1").arg(
-                    pingData->m_minimumLatency*1000.0, 2, 'f', 2),
+                    latency*1000.0, 2, 'f', 2),
                     painter,
                     option,
                     index,
-                    pingData->isMaximum(PingData::Fields::MinimumLatency),
+                    isMaximum(pingData, PingData::Fields::MinimumLatency),
                     Qt::AlignRight | Qt::AlignVCenter
                 );
             }
@@ -167,17 +195,19 @@ auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::paint(
         }
 
         case PingData::Fields::MaximumLatency: {
-            if (pingData->m_maximumLatency==-1) {
+            auto latency = pingData->latency(static_cast<int>(PingData::Fields::MaximumLatency));
+
+            if (latency==-1) {
                 paintBubble(pingData, painter, option, index, DiscoveryBubbleColour, InvalidHopLineWidth);
             } else {
                 paintBackground(pingData, painter, option, index);
 
                 paintText(QString("%1").arg(
-                    pingData->m_maximumLatency*1000.0, 0, 'f', 2),
+                    latency*1000.0, 0, 'f', 2),
                     painter,
                     option,
                     index,
-                    pingData->isMaximum(PingData::Fields::MaximumLatency),
+                    isMaximum(pingData, PingData::Fields::MaximumLatency),
                     Qt::AlignRight | Qt::AlignVCenter
                 );
             }
@@ -186,17 +216,19 @@ auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::paint(
         }
 
         case PingData::Fields::AverageLatency: {
+            auto latency = pingData->latency(static_cast<int>(PingData::Fields::AverageLatency));
+
             paintBackground(pingData, painter, option, index);
 
-            if (pingData->m_averageLatency==-1) {
+            if (latency==-1) {
                 paintBubble(pingData, painter, option, index, DiscoveryBubbleColour, InvalidHopLineWidth);
             } else {
                 paintText(QString("%1").arg(
-                    pingData->m_averageLatency*1000.0, 0, 'f', 2),
+                    latency*1000.0, 0, 'f', 2),
                     painter,
                     option,
                     index,
-                    pingData->isMaximum(PingData::Fields::AverageLatency),
+                    isMaximum(pingData, PingData::Fields::AverageLatency),
                     Qt::AlignRight | Qt::AlignVCenter
                 );
             }
@@ -215,7 +247,32 @@ auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::paint(
                     painter,
                     option,
                     index,
-                    pingData->isMaximum(PingData::Fields::CurrentLatency),
+                    isMaximum(pingData, PingData::Fields::CurrentLatency),
+                    Qt::AlignRight | Qt::AlignVCenter
+                );
+            }
+
+            break;
+        }
+
+        case PingData::Fields::Percentile50:
+        case PingData::Fields::Percentile95:
+        case PingData::Fields::Percentile99:
+        case PingData::Fields::StandardDeviation:
+        case PingData::Fields::Jitter: {
+            auto value = pingData->latency(index.column());
+
+            paintBackground(pingData, painter, option, index);
+
+            if (value==-1) {
+                paintBubble(pingData, painter, option, index, DiscoveryBubbleColour, InvalidHopLineWidth);
+            } else {
+                paintText(QString("%1").arg(
+                    value*1000.0, 0, 'f', 2),
+                    painter,
+                    option,
+                    index,
+                    false,
                     Qt::AlignRight | Qt::AlignVCenter
                 );
             }
@@ -242,6 +299,60 @@ auto Nedrysoft::RouteAnalyser::RouteTableItemDelegate::paint(
             break;
         }
 
+        case PingData::Fields::LossBurst:
+        case PingData::Fields::RFactor:
+        case PingData::Fields::MeanOpinionScore: {
+            paintBackground(pingData, painter, option, index);
+
+            paintText(
+                pingData->text(
+                    static_cast<PingData::Fields>(index.column()),
+                    Nedrysoft::Core::HostMask::HostMaskType::Screen
+                ),
+                painter,
+                option,
+                index,
+                false,
+                Qt::AlignRight | Qt::AlignVCenter
+            );
+
+            break;
+        }
+
+        case PingData::Fields::PathMTU: {
+            paintBackground(pingData, painter, option, index);
+
+            if (pingData->pathMTU()!=-1) {
+                paintText(
+                    QString("%1").arg(pingData->pathMTU()),
+                    painter,
+                    option,
+                    index,
+                    false,
+                    Qt::AlignRight | Qt::AlignVCenter
+                );
+            }
+
+            break;
+        }
+
+        case PingData::Fields::Bandwidth: {
+            paintBackground(pingData, painter, option, index);
+
+            if (pingData->bandwidth() > 0) {
+                paintText(
+                    Nedrysoft::Utils::bandwidthToString(pingData->bandwidth()),
+                    painter,
+                    option,
+                    index,
+                    false,
+                    Qt::AlignRight | Qt::AlignVCenter
+                );
+            }
+
+            break;
+        }
+
         case PingData::Fields::Count: {
             paintBackground(pingData, painter, option, index);
 
@@ -24,7 +24,9 @@
 #ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_ROUTETABLEITEMDELEGATE_H
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_ROUTETABLEITEMDELEGATE_H
 
+#include "LatencyRanking.h"
 #include "PingData.h"
+
 #include <QMap>
 #include <QStyledItemDelegate>
 #include <cmath>
@@ -41,13 +43,6 @@ namespace Nedrysoft { namespace RouteAnalyser {
     class RouteTableItemDelegate :
             public QStyledItemDelegate {
 
-        private:
-            class MaximumValue {
-                public:
-                    PingData *m_currentData;
-            };
-
-
         public:
             /**
              * @brief       Constructs a new RouteTableItemDelegate instance which is a child of the parent.
@@ -65,6 +60,15 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const -> void;
 
+            /**
+             * @brief       Sets the rankings used to highlight the hop with the largest value of each latency field.
+             *
+             * @param[in]   latencyRanking the map of field to ranking; nullptr to disable highlighting.
+             */
+            auto setLatencyRanking(
+                    const QMap<Nedrysoft::RouteAnalyser::PingData::Fields,
+                               Nedrysoft::RouteAnalyser::LatencyRanking> *latencyRanking) -> void;
+
         private:
 
             /**
@@ -206,6 +210,18 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto getInterpolatedColour(const QMap<double, QRgb> &keyFrames, double value) const -> QRgb;
 
+            /**
+             * @brief       Returns whether a hop has the largest value of a latency field.
+             *
+             * @param[in]   pingData the data for the item.
+             * @param[in]   field the latency field.
+             *
+             * @returns     true if the value should be highlighted; otherwise false.
+             */
+            auto isMaximum(
+                    Nedrysoft::RouteAnalyser::PingData *pingData,
+                    Nedrysoft::RouteAnalyser::PingData::Fields field) const -> bool;
+
             /**
              * @brief       Paints text in a cell.
              *
@@ -245,7 +261,8 @@ namespace Nedrysoft { namespace RouteAnalyser {
             ) const -> void;
 
         private:
-            QMap<Nedrysoft::RouteAnalyser::PingData::Fields, QPersistentModelIndex *> m_maximumMap;
+            const QMap<Nedrysoft::RouteAnalyser::PingData::Fields,
+                       Nedrysoft::RouteAnalyser::LatencyRanking> *m_latencyRanking;
 
     };
 }}
@@ -0,0 +1,1482 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SampleStore.h"
+
+#include "SessionRecording.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+constexpr auto BlockSize = 128;
+constexpr auto BitsPerWord = 64;
+constexpr auto MicrosecondsPerSecond = 1000000.0;
+constexpr auto MillisecondsPerSecond = 1000.0;
+constexpr auto VarIntDataBits = 7;
+constexpr auto VarIntDataMask = 0x7f;
+constexpr auto VarIntContinuation = 0x80;
+constexpr int RollupResolutions[] = {10, 60, 600, 3600};
+constexpr auto RollupLevelCount = static_cast<int>(sizeof(RollupResolutions) / sizeof(RollupResolutions[0]));
+constexpr auto SeriesCount = 2;
+constexpr auto RetentionBatchBlocks = 16;
+constexpr auto RollupPageSize = 64;
+
+/**
+ * @brief       The header of a block record, followed by the loss and alternate bitmaps, the round trip times and
+ *              the time deltas of the block.
+ */
+struct BlockRecord {
+    int32_t hop;
+    int32_t count;
+    int64_t firstTime;
+    int64_t minimumTime;
+    int64_t maximumTime;
+    int64_t lastTime;
+    uint32_t deltaSize;
+    uint32_t reserved;
+};
+
+/**
+ * @brief       The header of a rollups record, followed by the intervals of the rollup level.
+ */
+struct RollupRecord {
+    int32_t hop;
+    int32_t level;
+    int64_t firstBucket;
+    uint64_t count;
+};
+
+/**
+ * @brief       Appends a signed value to a buffer as a zigzag encoded variable length integer.
+ *
+ * @param[in]   buffer the buffer.
+ * @param[in]   value the value.
+ */
+static auto encodeDelta(std::vector<uint8_t> &buffer, qint64 value) -> void {
+    auto encoded = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+
+    while (encoded > VarIntDataMask) {
+        buffer.push_back(static_cast<uint8_t>((encoded & VarIntDataMask) | VarIntContinuation));
+
+        encoded >>= VarIntDataBits;
+    }
+
+    buffer.push_back(static_cast<uint8_t>(encoded));
+}
+
+/**
+ * @brief       Decodes a zigzag encoded variable length integer from a buffer.
+ *
+ * @param[in]       buffer the buffer.
+ * @param[in]       size the size of the buffer.
+ * @param[in,out]   offset the offset to decode from, updated to the offset of the next value.
+ *
+ * @returns     the value.
+ */
+static auto decodeDelta(const uint8_t *buffer, size_t size, size_t &offset) -> qint64 {
+    uint64_t encoded = 0;
+    auto shift = 0;
+
+    while (offset < size) {
+        auto byte = buffer[offset++];
+
+        encoded |= static_cast<uint64_t>(byte & VarIntDataMask) << shift;
+
+        if (!(byte & VarIntContinuation)) {
+            break;
+        }
+
+        shift += VarIntDataBits;
+    }
+
+    return static_cast<qint64>(encoded >> 1) ^ -static_cast<qint64>(encoded & 1);
+}
+
+/**
+ * @brief       Checks that a block record is consistent with the size of its payload.
+ *
+ * @param[in]   header the header of the block record.
+ * @param[in]   size the size of the payload in bytes.
+ *
+ * @returns     true if the block record is valid; otherwise false.
+ */
+static auto isValidBlock(const BlockRecord &header, size_t size) -> bool {
+    auto words = static_cast<size_t>((header.count + BitsPerWord - 1) / BitsPerWord);
+
+    return (header.hop >= 0) && (header.count > 0) && (header.count <= BlockSize) &&
+           (size >= sizeof(header) + (words * sizeof(uint64_t) * 2) +
+                    (static_cast<size_t>(header.count) * sizeof(uint32_t)) + header.deltaSize);
+}
+
+/**
+ * @brief       Calls a function for each sample of a block record.
+ *
+ * @param[in]   data the payload of the block record.
+ * @param[in]   size the size of the payload in bytes.
+ * @param[in]   function the function, called with the time in milliseconds, the round trip time in microseconds
+ *              and whether the sample was lost and is from a large (size sweep) probe.
+ *
+ * @returns     true if the block record was valid; otherwise false.
+ */
+template <typename Function>
+static auto forEachSample(const uint8_t *data, size_t size, Function function) -> bool {
+    BlockRecord header;
+
+    if (size < sizeof(header)) {
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if (!isValidBlock(header, size)) {
+        return false;
+    }
+
+    auto words = static_cast<size_t>((header.count + BitsPerWord - 1) / BitsPerWord);
+    auto lossBitmap = data + sizeof(header);
+    auto alternateBitmap = lossBitmap + (words * sizeof(uint64_t));
+    auto roundTripTimes = alternateBitmap + (words * sizeof(uint64_t));
+    auto timeDeltas = roundTripTimes + (static_cast<size_t>(header.count) * sizeof(uint32_t));
+    auto time = header.firstTime;
+    size_t offset = 0;
+
+    for (auto index = 0; index < header.count; index++) {
+        uint64_t lossWord, alternateWord;
+        uint32_t roundTripTime;
+
+        if (index) {
+            time += decodeDelta(timeDeltas, header.deltaSize, offset);
+        }
+
+        memcpy(&lossWord, lossBitmap + (index / BitsPerWord) * sizeof(uint64_t), sizeof(lossWord));
+        memcpy(&alternateWord, alternateBitmap + (index / BitsPerWord) * sizeof(uint64_t), sizeof(alternateWord));
+        memcpy(&roundTripTime, roundTripTimes + index * sizeof(uint32_t), sizeof(roundTripTime));
+
+        auto bit = static_cast<uint64_t>(1) << (index % BitsPerWord);
+
+        function(time, roundTripTime, (lossWord & bit) != 0, (alternateWord & bit) != 0);
+    }
+
+    return true;
+}
+
+/**
+ * @brief       Returns the index of the first block that may hold samples at or after a time.
+ *
+ * @param[in]   blocks the blocks of a hop.
+ * @param[in]   time the time in milliseconds since the unix epoch.
+ *
+ * @returns     the index of the block; the number of blocks if no block can hold such samples.
+ */
+template <typename BlockType>
+static auto firstBlock(const std::vector<BlockType> &blocks, qint64 time) -> size_t {
+    auto blockIterator = std::partition_point(blocks.begin(), blocks.end(), [time](const BlockType &block) {
+        return std::max(block.precedingTime, block.maximumTime) < time;
+    });
+
+    return static_cast<size_t>(blockIterator - blocks.begin());
+}
+
+Nedrysoft::RouteAnalyser::SampleStore::SampleStore() :
+        m_recording(nullptr),
+        m_rawRetention(0),
+        m_rollupRetention(0),
+        m_discardedTime(RollupLevelCount + 1, std::numeric_limits<qint64>::min()) {
+
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::append(
+        int hop,
+        qint64 time,
+        double roundTripTime,
+        bool alternate) -> void {
+
+    if (hop < 0) {
+        return;
+    }
+
+    if (hop >= static_cast<int>(m_hops.size())) {
+        m_hops.resize(static_cast<size_t>(hop) + 1);
+    }
+
+    auto &columns = m_hops[static_cast<size_t>(hop)];
+    auto index = columns.count;
+
+    // the first sample of a block holds its time in the block, so blocks can be decoded independently.
+
+    if (index % BlockSize == 0) {
+        columns.blocks.push_back(Block {
+            time,
+            time,
+            time,
+            static_cast<uint32_t>(columns.timeDeltas.size()),
+            index,
+            -1,
+            0,
+            columns.latestTime
+        });
+    } else {
+        auto &block = columns.blocks.back();
+
+        encodeDelta(columns.timeDeltas, time - columns.lastTime);
+
+        block.minimumTime = std::min(block.minimumTime, time);
+        block.maximumTime = std::max(block.maximumTime, time);
+    }
+
+    if (index % BitsPerWord == 0) {
+        columns.lossBitmap.push_back(0);
+        columns.alternateBitmap.push_back(0);
+    }
+
+    auto bit = static_cast<uint64_t>(1) << (index % BitsPerWord);
+
+    uint32_t quantisedRoundTripTime = 0;
+
+    if (roundTripTime < 0) {
+        columns.lossBitmap.back() |= bit;
+    } else {
+        quantisedRoundTripTime = static_cast<uint32_t>(std::llround(roundTripTime * MicrosecondsPerSecond));
+    }
+
+    columns.roundTripTimes.push_back(quantisedRoundTripTime);
+
+    if (alternate) {
+        columns.alternateBitmap.back() |= bit;
+    }
+
+    addToRollups(columns, time, quantisedRoundTripTime, roundTripTime < 0, alternate);
+
+    if (time < columns.latestTime) {
+        columns.lateness = std::max(columns.lateness, columns.latestTime - time);
+    }
+
+    columns.latestTime = std::max(columns.latestTime, time);
+    columns.lastTime = time;
+    columns.count++;
+    columns.lastBlockRecorded = false;
+
+    if (columns.count % BlockSize == 0) {
+        if (m_recording) {
+            writeLastBlock(hop);
+        }
+
+        enforceRetention(hop, false);
+    }
+}
+
+template <typename Function>
+auto Nedrysoft::RouteAnalyser::SampleStore::forEachSampleInRange(
+        const HopColumns &columns,
+        qint64 startTime,
+        qint64 endTime,
+        Function function) const -> void {
+
+    // blocks that have expired are read back from the recording.
+
+    for (auto index = firstBlock(columns.spilledBlocks, startTime); index < columns.spilledBlocks.size(); index++) {
+        auto &spilledBlock = columns.spilledBlocks[index];
+
+        if (spilledBlock.precedingTime > endTime + columns.lateness) {
+            break;
+        }
+
+        if ((!m_recording) || (spilledBlock.maximumTime < startTime) || (spilledBlock.minimumTime > endTime)) {
+            continue;
+        }
+
+        auto data = m_recording->read(spilledBlock.offset, spilledBlock.size);
+
+        forEachSample(
+            reinterpret_cast<const uint8_t *>(data.constData()),
+            static_cast<size_t>(data.size()),
+            [&function, startTime, endTime](qint64 time, uint32_t roundTripTime, bool lost, bool alternate) {
+                if ((time < startTime) || (time > endTime)) {
+                    return;
+                }
+
+                function(time, roundTripTime, lost, alternate);
+            }
+        );
+    }
+
+    for (auto blockIndex = firstBlock(columns.blocks, startTime); blockIndex < columns.blocks.size(); blockIndex++) {
+        auto &block = columns.blocks[blockIndex];
+
+        if (block.precedingTime > endTime + columns.lateness) {
+            break;
+        }
+
+        if ((block.maximumTime < startTime) || (block.minimumTime > endTime)) {
+            continue;
+        }
+
+        auto time = block.firstTime;
+        auto offset = static_cast<size_t>(block.offset);
+        auto lastSample = std::min(block.firstSample + BlockSize, columns.count);
+
+        for (auto index = block.firstSample; index < lastSample; index++) {
+            if (index != block.firstSample) {
+                time += decodeDelta(columns.timeDeltas.data(), columns.timeDeltas.size(), offset);
+            }
+
+            if ((time < startTime) || (time > endTime)) {
+                continue;
+            }
+
+            auto word = static_cast<size_t>(index / BitsPerWord);
+            auto bit = static_cast<uint64_t>(1) << (index % BitsPerWord);
+
+            function(
+                time,
+                columns.roundTripTimes[static_cast<size_t>(index)],
+                (columns.lossBitmap[word] & bit) != 0,
+                (columns.alternateBitmap[word] & bit) != 0
+            );
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::samples(
+        int hop,
+        double start,
+        double end) const -> QVector<Nedrysoft::RouteAnalyser::SampleStore::Sample> {
+
+    QVector<Sample> samples;
+
+    if ((hop < 0) || (hop >= static_cast<int>(m_hops.size()))) {
+        return samples;
+    }
+
+    auto startTime = static_cast<qint64>(std::floor(start * MillisecondsPerSecond));
+    auto endTime = static_cast<qint64>(std::ceil(end * MillisecondsPerSecond));
+
+    forEachSampleInRange(
+        m_hops[static_cast<size_t>(hop)],
+        startTime,
+        endTime,
+        [&samples](qint64 time, uint32_t roundTripTime, bool lost, bool alternate) {
+            samples.append(Sample {
+                static_cast<double>(time) / MillisecondsPerSecond,
+                lost ? -1 : (roundTripTime / MicrosecondsPerSecond),
+                alternate
+            });
+        }
+    );
+
+    return samples;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::valueAt(
+        int hop,
+        double time,
+        double tolerance,
+        Sample &sample,
+        Lookup lookup,
+        bool alternate) const -> bool {
+
+    if ((hop < 0) || (hop >= static_cast<int>(m_hops.size()))) {
+        return false;
+    }
+
+    auto targetTime = static_cast<qint64>(std::llround(time * MillisecondsPerSecond));
+    auto toleranceTime = static_cast<qint64>(std::llround(std::max(tolerance, 0.0) * MillisecondsPerSecond));
+    auto nearestDistance = std::numeric_limits<qint64>::max();
+    auto previousTime = std::numeric_limits<qint64>::min();
+    auto nextTime = std::numeric_limits<qint64>::max();
+    uint32_t previousRoundTripTime = 0, nextRoundTripTime = 0;
+    auto found = false;
+
+    forEachSampleInRange(
+        m_hops[static_cast<size_t>(hop)],
+        targetTime - toleranceTime,
+        targetTime + toleranceTime,
+        [&](qint64 sampleTime, uint32_t roundTripTime, bool lost, bool sampleAlternate) {
+            if (sampleAlternate != alternate) {
+                return;
+            }
+
+            if (lookup == Lookup::Nearest) {
+                auto distance = std::abs(sampleTime - targetTime);
+
+                // samples are not in strict time order, so an equidistant earlier sample replaces a later one.
+
+                if ((distance < nearestDistance) || ((distance == nearestDistance) && (sampleTime < targetTime))) {
+                    nearestDistance = distance;
+
+                    sample = Sample {
+                        static_cast<double>(sampleTime) / MillisecondsPerSecond,
+                        lost ? -1 : (roundTripTime / MicrosecondsPerSecond),
+                        sampleAlternate
+                    };
+
+                    found = true;
+                }
+
+                return;
+            }
+
+            if (lost) {
+                return;
+            }
+
+            if ((sampleTime <= targetTime) && (sampleTime > previousTime)) {
+                previousTime = sampleTime;
+                previousRoundTripTime = roundTripTime;
+            }
+
+            if ((sampleTime >= targetTime) && (sampleTime < nextTime)) {
+                nextTime = sampleTime;
+                nextRoundTripTime = roundTripTime;
+            }
+        }
+    );
+
+    if (lookup == Lookup::Nearest) {
+        return found;
+    }
+
+    auto hasPrevious = (previousTime != std::numeric_limits<qint64>::min());
+    auto hasNext = (nextTime != std::numeric_limits<qint64>::max());
+
+    if ((!hasPrevious) && (!hasNext)) {
+        return false;
+    }
+
+    double roundTripTime;
+
+    if ((!hasNext) || (hasPrevious && (previousTime == nextTime))) {
+        roundTripTime = previousRoundTripTime;
+    } else if (!hasPrevious) {
+        roundTripTime = nextRoundTripTime;
+    } else {
+        auto fraction = static_cast<double>(targetTime - previousTime) /
+                        static_cast<double>(nextTime - previousTime);
+
+        roundTripTime = previousRoundTripTime +
+                        (static_cast<double>(nextRoundTripTime) - previousRoundTripTime) * fraction;
+    }
+
+    sample = Sample {time, roundTripTime / MicrosecondsPerSecond, alternate};
+
+    return true;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::aggregate(
+        int hop,
+        double start,
+        double end,
+        bool alternate) const -> Nedrysoft::RouteAnalyser::SampleStore::Rollup {
+
+    auto total = Bucket {UINT32_MAX, 0, 0, 0, 0};
+
+    if ((hop >= 0) && (hop < static_cast<int>(m_hops.size())) && (end >= start)) {
+        accumulate(
+            m_hops[static_cast<size_t>(hop)],
+            RollupLevelCount - 1,
+            static_cast<qint64>(std::floor(start * MillisecondsPerSecond)),
+            static_cast<qint64>(std::ceil(end * MillisecondsPerSecond)) + 1,
+            alternate,
+            total
+        );
+    }
+
+    return toRollup(total, start);
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::accumulate(
+        const HopColumns &columns,
+        int level,
+        qint64 startTime,
+        qint64 endTime,
+        bool alternate,
+        Bucket &total) const -> void {
+
+    if (startTime >= endTime) {
+        return;
+    }
+
+    if ((level < 0) || columns.rollups.empty()) {
+        forEachSampleInRange(
+            columns,
+            startTime,
+            endTime - 1,
+            [&total, alternate](qint64, uint32_t roundTripTime, bool lost, bool sampleAlternate) {
+                if (sampleAlternate == alternate) {
+                    addToBucket(total, roundTripTime, lost);
+                }
+            }
+        );
+
+        return;
+    }
+
+    // the whole intervals of this level are read from the rollups, each resolution divides the next so the
+    // partial intervals at either end are covered by whole intervals of the finer levels.
+
+    auto interval = static_cast<qint64>(RollupResolutions[level]) * static_cast<qint64>(MillisecondsPerSecond);
+    auto firstBucket = (startTime + interval - 1) / interval;
+    auto endBucket = endTime / interval;
+
+    if (firstBucket >= endBucket) {
+        accumulate(columns, level - 1, startTime, endTime, alternate, total);
+
+        return;
+    }
+
+    forEachBucket(
+        columns,
+        (alternate ? 1 : 0) * RollupLevelCount + level,
+        firstBucket,
+        endBucket - 1,
+        [&total](const Bucket &bucket, qint64) {
+            mergeBucket(total, bucket);
+        }
+    );
+
+    accumulate(columns, level - 1, startTime, firstBucket * interval, alternate, total);
+    accumulate(columns, level - 1, endBucket * interval, endTime, alternate, total);
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::addToRollups(
+        HopColumns &columns,
+        qint64 time,
+        uint32_t roundTripTime,
+        bool lost,
+        bool alternate) -> void {
+
+    if (columns.rollups.empty()) {
+        columns.rollups.resize(SeriesCount * RollupLevelCount);
+    }
+
+    auto series = alternate ? 1 : 0;
+
+    for (auto level = 0; level < RollupLevelCount; level++) {
+        auto &rollupLevel = columns.rollups[static_cast<size_t>(series * RollupLevelCount + level)];
+        auto interval = static_cast<qint64>(RollupResolutions[level]) * static_cast<qint64>(MillisecondsPerSecond);
+        auto bucketIndex = time / interval;
+        auto pageIndex = bucketIndex / RollupPageSize;
+
+        // timeouts are reported after later replies, so a sample can fall before the first page.
+
+        if (rollupLevel.pages.empty()) {
+            rollupLevel.firstPage = pageIndex;
+        } else if (pageIndex < rollupLevel.firstPage) {
+            rollupLevel.pages.insert(
+                rollupLevel.pages.begin(),
+                static_cast<size_t>(rollupLevel.firstPage - pageIndex),
+                RollupPage()
+            );
+
+            rollupLevel.firstPage = pageIndex;
+        }
+
+        auto position = static_cast<size_t>(pageIndex - rollupLevel.firstPage);
+
+        if (position >= rollupLevel.pages.size()) {
+            rollupLevel.pages.resize(position + 1);
+        }
+
+        auto &rollupPage = rollupLevel.pages[position];
+
+        if (rollupPage.buckets.empty()) {
+            rollupPage.buckets.resize(RollupPageSize, Bucket {UINT32_MAX, 0, 0, 0, 0});
+        }
+
+        // the page no longer matches the copy in the recording that it was loaded from.
+
+        rollupPage.fileOffset = -1;
+
+        addToBucket(rollupPage.buckets[static_cast<size_t>(bucketIndex % RollupPageSize)], roundTripTime, lost);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::addToBucket(Bucket &bucket, uint32_t roundTripTime, bool lost) -> void {
+    if (lost) {
+        bucket.lost++;
+    } else {
+        bucket.minimum = std::min(bucket.minimum, roundTripTime);
+        bucket.maximum = std::max(bucket.maximum, roundTripTime);
+        bucket.sum += roundTripTime;
+        bucket.replies++;
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::mergeBucket(Bucket &bucket, const Bucket &other) -> void {
+    bucket.minimum = std::min(bucket.minimum, other.minimum);
+    bucket.maximum = std::max(bucket.maximum, other.maximum);
+    bucket.sum += other.sum;
+    bucket.replies += other.replies;
+    bucket.lost += other.lost;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::toRollup(
+        const Bucket &bucket,
+        double time) -> Nedrysoft::RouteAnalyser::SampleStore::Rollup {
+
+    auto rollup = Rollup {time, -1, -1, -1, 0, 0};
+
+    if (bucket.replies) {
+        rollup.minimum = bucket.minimum / MicrosecondsPerSecond;
+        rollup.maximum = bucket.maximum / MicrosecondsPerSecond;
+        rollup.mean = (static_cast<double>(bucket.sum) / bucket.replies) / MicrosecondsPerSecond;
+    }
+
+    rollup.replies = static_cast<int>(bucket.replies);
+    rollup.lost = static_cast<int>(bucket.lost);
+
+    return rollup;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::rollups(
+        int hop,
+        int resolution,
+        double start,
+        double end,
+        bool alternate) const -> QVector<Nedrysoft::RouteAnalyser::SampleStore::Rollup> {
+
+    QVector<Rollup> rollups;
+
+    if ((hop < 0) || (hop >= static_cast<int>(m_hops.size()))) {
+        return rollups;
+    }
+
+    auto &columns = m_hops[static_cast<size_t>(hop)];
+    auto level = static_cast<int>(
+        std::find(RollupResolutions, RollupResolutions + RollupLevelCount, resolution) - RollupResolutions
+    );
+
+    if ((level == RollupLevelCount) || columns.rollups.empty()) {
+        return rollups;
+    }
+
+    forEachBucket(
+        columns,
+        (alternate ? 1 : 0) * RollupLevelCount + level,
+        static_cast<qint64>(std::floor(start / resolution)),
+        static_cast<qint64>(std::floor(end / resolution)),
+        [&rollups, resolution](const Bucket &bucket, qint64 bucketIndex) {
+            if (bucket.replies || bucket.lost) {
+                rollups.append(toRollup(bucket, static_cast<double>(bucketIndex * resolution)));
+            }
+        }
+    );
+
+    return rollups;
+}
+
+template <typename Function>
+auto Nedrysoft::RouteAnalyser::SampleStore::forEachBucket(
+        const HopColumns &columns,
+        int levelIndex,
+        qint64 startBucket,
+        qint64 endBucket,
+        Function function) const -> void {
+
+    auto &rollupLevel = columns.rollups[static_cast<size_t>(levelIndex)];
+
+    // intervals that have expired are read back from the recording, they precede the intervals held in memory.
+
+    for (auto &spilledRollups : columns.spilledRollups) {
+        if ((!m_recording) || (spilledRollups.level != levelIndex)) {
+            continue;
+        }
+
+        auto firstBucket = std::max(startBucket, spilledRollups.firstBucket);
+        auto lastBucket = std::min(endBucket, spilledRollups.firstBucket + spilledRollups.count - 1);
+
+        if (!rollupLevel.pages.empty()) {
+            lastBucket = std::min(lastBucket, rollupLevel.firstPage * RollupPageSize - 1);
+        }
+
+        if (firstBucket > lastBucket) {
+            continue;
+        }
+
+        auto data = m_recording->read(
+            spilledRollups.offset + (firstBucket - spilledRollups.firstBucket) * static_cast<qint64>(sizeof(Bucket)),
+            (lastBucket - firstBucket + 1) * static_cast<qint64>(sizeof(Bucket))
+        );
+
+        for (auto index = 0; index < data.size() / static_cast<int>(sizeof(Bucket)); index++) {
+            Bucket bucket;
+
+            memcpy(&bucket, data.constData() + index * static_cast<int>(sizeof(Bucket)), sizeof(bucket));
+
+            function(bucket, firstBucket + index);
+        }
+    }
+
+    auto levelStart = rollupLevel.firstPage * RollupPageSize;
+    auto firstBucket = std::max(startBucket - levelStart, static_cast<qint64>(0));
+    auto lastBucket = std::min(
+        endBucket - levelStart,
+        static_cast<qint64>(rollupLevel.pages.size()) * RollupPageSize - 1
+    );
+
+    // pages that no sample has fallen in are not allocated and are skipped as a whole.
+
+    for (auto index = firstBucket; index <= lastBucket;) {
+        auto &rollupPage = rollupLevel.pages[static_cast<size_t>(index / RollupPageSize)];
+        auto pageEnd = std::min((index / RollupPageSize + 1) * RollupPageSize - 1, lastBucket);
+
+        if (!rollupPage.buckets.empty()) {
+            for (auto bucketIndex = index; bucketIndex <= pageEnd; bucketIndex++) {
+                function(
+                    rollupPage.buckets[static_cast<size_t>(bucketIndex % RollupPageSize)],
+                    levelStart + bucketIndex
+                );
+            }
+        }
+
+        index = pageEnd + 1;
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::resolutions() -> QVector<int> {
+    QVector<int> resolutions;
+
+    for (auto resolution : RollupResolutions) {
+        resolutions.append(resolution);
+    }
+
+    return resolutions;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::resolutionFor(double interval) -> int {
+    auto resolution = 0;
+
+    for (auto level = 0; level < RollupLevelCount; level++) {
+        if (RollupResolutions[level] <= interval) {
+            resolution = RollupResolutions[level];
+        }
+    }
+
+    return resolution;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::setRetention(qint64 rawRetention, qint64 rollupRetention) -> void {
+    m_rawRetention = std::max(rawRetention, static_cast<qint64>(0));
+    m_rollupRetention = std::max(rollupRetention, static_cast<qint64>(0));
+
+    for (auto hop = 0; hop < static_cast<int>(m_hops.size()); hop++) {
+        enforceRetention(hop, true);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::rawRetention() const -> qint64 {
+    return m_rawRetention;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::rollupRetention() const -> qint64 {
+    return m_rollupRetention;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::retainedResolution(double time) const -> int {
+    auto milliseconds = static_cast<qint64>(std::floor(time * MillisecondsPerSecond));
+
+    if (milliseconds >= m_discardedTime[0]) {
+        return 0;
+    }
+
+    for (auto level = 0; level < RollupLevelCount; level++) {
+        if (milliseconds >= m_discardedTime[static_cast<size_t>(level) + 1]) {
+            return RollupResolutions[level];
+        }
+    }
+
+    return RollupResolutions[RollupLevelCount - 1];
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::enforceRetention(int hop, bool force) -> void {
+    auto &columns = m_hops[static_cast<size_t>(hop)];
+
+    if (columns.blocks.empty()) {
+        return;
+    }
+
+    auto latestTime = columns.blocks.back().maximumTime;
+
+    if (m_rawRetention > 0) {
+        auto cutoffTime = latestTime - m_rawRetention;
+        size_t expired = 0;
+
+        // every block other than the last is full, the last block is always kept.
+
+        while ((expired + 1 < columns.blocks.size()) && (columns.blocks[expired].maximumTime < cutoffTime)) {
+            expired++;
+        }
+
+        if (expired && (force || (expired >= RetentionBatchBlocks))) {
+            auto removedSamples = static_cast<int>(expired) * BlockSize;
+            auto removedWords = static_cast<std::ptrdiff_t>(removedSamples / BitsPerWord);
+            auto removedBytes = columns.blocks[expired].offset;
+
+            for (size_t index = 0; index < expired; index++) {
+                auto &block = columns.blocks[index];
+
+                if (block.recordOffset >= 0) {
+                    columns.spilledBlocks.push_back(SpilledBlock {
+                        block.minimumTime,
+                        block.maximumTime,
+                        block.recordOffset,
+                        block.recordSize,
+                        block.precedingTime
+                    });
+                } else {
+                    m_discardedTime[0] = std::max(m_discardedTime[0], block.maximumTime + 1);
+                }
+            }
+
+            columns.timeDeltas.erase(columns.timeDeltas.begin(), columns.timeDeltas.begin() + removedBytes);
+            columns.roundTripTimes.erase(
+                columns.roundTripTimes.begin(),
+                columns.roundTripTimes.begin() + removedSamples
+            );
+            columns.lossBitmap.erase(columns.lossBitmap.begin(), columns.lossBitmap.begin() + removedWords);
+            columns.alternateBitmap.erase(
+                columns.alternateBitmap.begin(),
+                columns.alternateBitmap.begin() + removedWords
+            );
+            columns.blocks.erase(columns.blocks.begin(), columns.blocks.begin() + static_cast<std::ptrdiff_t>(expired));
+
+            for (auto &block : columns.blocks) {
+                block.offset -= removedBytes;
+                block.firstSample -= removedSamples;
+            }
+
+            columns.count -= removedSamples;
+        }
+    }
+
+    // rollups are removed a page at a time, so a page expires once its last interval has passed the retention period.
+
+    for (auto index = 0; index < static_cast<int>(columns.rollups.size()); index++) {
+        auto level = index % RollupLevelCount;
+        auto &rollupLevel = columns.rollups[static_cast<size_t>(index)];
+
+        if ((m_rollupRetention <= 0) || rollupLevel.pages.empty()) {
+            continue;
+        }
+
+        auto interval = static_cast<qint64>(RollupResolutions[level]) * static_cast<qint64>(MillisecondsPerSecond);
+        auto expired = std::min(
+            (latestTime - m_rollupRetention) / interval / RollupPageSize - rollupLevel.firstPage,
+            static_cast<qint64>(rollupLevel.pages.size())
+        );
+
+        if (expired <= 0) {
+            continue;
+        }
+
+        for (qint64 page = 0; page < expired; page++) {
+            auto &rollupPage = rollupLevel.pages[static_cast<size_t>(page)];
+            auto firstBucket = (rollupLevel.firstPage + page) * RollupPageSize;
+            qint64 offset = -1;
+
+            if (rollupPage.buckets.empty()) {
+                continue;
+            }
+
+            if (rollupPage.fileOffset >= 0) {
+                // the page was loaded from a recording, so the expired intervals are already in the file.
+
+                offset = rollupPage.fileOffset;
+            } else if (m_recording) {
+                auto size = rollupPage.buckets.size() * sizeof(Bucket);
+                auto header = RollupRecord {hop, index, firstBucket, rollupPage.buckets.size()};
+
+                std::vector<uint8_t> buffer(sizeof(header) + size);
+
+                memcpy(buffer.data(), &header, sizeof(header));
+                memcpy(buffer.data() + sizeof(header), rollupPage.buckets.data(), size);
+
+                offset = m_recording->writeRecord(
+                    Nedrysoft::RouteAnalyser::SessionRecording::RecordType::SpilledRollups,
+                    buffer.data(),
+                    static_cast<uint32_t>(buffer.size())
+                );
+
+                if (offset >= 0) {
+                    offset += static_cast<qint64>(sizeof(header));
+                }
+            }
+
+            if (offset >= 0) {
+                columns.spilledRollups.push_back(SpilledRollups {index, firstBucket, RollupPageSize, offset});
+            } else {
+                m_discardedTime[static_cast<size_t>(level) + 1] = std::max(
+                    m_discardedTime[static_cast<size_t>(level) + 1],
+                    (firstBucket + RollupPageSize) * interval
+                );
+            }
+        }
+
+        rollupLevel.pages.erase(
+            rollupLevel.pages.begin(),
+            rollupLevel.pages.begin() + static_cast<std::ptrdiff_t>(expired)
+        );
+
+        rollupLevel.firstPage += expired;
+    }
+
+    // a forced removal follows a load or a change of policy, so the memory that was in use before is released.
+
+    if (force) {
+        columns.timeDeltas.shrink_to_fit();
+        columns.roundTripTimes.shrink_to_fit();
+        columns.lossBitmap.shrink_to_fit();
+        columns.alternateBitmap.shrink_to_fit();
+        columns.blocks.shrink_to_fit();
+
+        for (auto &rollupLevel : columns.rollups) {
+            rollupLevel.pages.shrink_to_fit();
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::timeRange(qint64 &start, qint64 &end) const -> bool {
+    auto found = false;
+
+    auto addRange = [&found, &start, &end](qint64 minimumTime, qint64 maximumTime) {
+        if (!found) {
+            start = minimumTime;
+            end = maximumTime;
+            found = true;
+        } else {
+            start = std::min(start, minimumTime);
+            end = std::max(end, maximumTime);
+        }
+    };
+
+    for (auto &columns : m_hops) {
+        for (auto &spilledBlock : columns.spilledBlocks) {
+            addRange(spilledBlock.minimumTime, spilledBlock.maximumTime);
+        }
+
+        for (auto &block : columns.blocks) {
+            addRange(block.minimumTime, block.maximumTime);
+        }
+    }
+
+    return found;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::setRecording(
+        Nedrysoft::RouteAnalyser::SessionRecording *recording) -> void {
+
+    m_recording = recording;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::writeLastBlock(int hop) -> void {
+    auto &columns = m_hops[static_cast<size_t>(hop)];
+
+    if (columns.blocks.empty()) {
+        return;
+    }
+
+    auto &block = columns.blocks.back();
+    auto count = columns.count - block.firstSample;
+    auto words = static_cast<size_t>((count + BitsPerWord - 1) / BitsPerWord);
+    auto firstWord = static_cast<size_t>(block.firstSample / BitsPerWord);
+    auto deltaSize = columns.timeDeltas.size() - block.offset;
+
+    auto header = BlockRecord {
+        hop,
+        count,
+        block.firstTime,
+        block.minimumTime,
+        block.maximumTime,
+        columns.lastTime,
+        static_cast<uint32_t>(deltaSize),
+        0
+    };
+
+    std::vector<uint8_t> buffer(
+        sizeof(header) +
+        (words * sizeof(uint64_t) * 2) +
+        (static_cast<size_t>(count) * sizeof(uint32_t)) +
+        deltaSize
+    );
+
+    auto cursor = buffer.data();
+
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    memcpy(cursor, columns.lossBitmap.data() + firstWord, words * sizeof(uint64_t));
+    cursor += words * sizeof(uint64_t);
+
+    memcpy(cursor, columns.alternateBitmap.data() + firstWord, words * sizeof(uint64_t));
+    cursor += words * sizeof(uint64_t);
+
+    memcpy(cursor, columns.roundTripTimes.data() + block.firstSample, static_cast<size_t>(count) * sizeof(uint32_t));
+    cursor += static_cast<size_t>(count) * sizeof(uint32_t);
+
+    memcpy(cursor, columns.timeDeltas.data() + block.offset, deltaSize);
+
+    block.recordOffset = m_recording->writeRecord(
+        Nedrysoft::RouteAnalyser::SessionRecording::RecordType::Block,
+        buffer.data(),
+        static_cast<uint32_t>(buffer.size())
+    );
+
+    block.recordSize = static_cast<uint32_t>(buffer.size());
+
+    columns.lastBlockRecorded = true;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::checkpointRecording() -> void {
+    if (!m_recording) {
+        return;
+    }
+
+    for (auto hop = 0; hop < static_cast<int>(m_hops.size()); hop++) {
+        auto &columns = m_hops[static_cast<size_t>(hop)];
+
+        if ((columns.count % BlockSize) && (!columns.lastBlockRecorded)) {
+            writeLastBlock(hop);
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::finishRecording() -> void {
+    if (!m_recording) {
+        return;
+    }
+
+    checkpointRecording();
+
+    auto writeRollups = [this](int hop, int level, qint64 firstBucket, const std::vector<Bucket> &buckets) {
+        auto header = RollupRecord {hop, level, firstBucket, buckets.size()};
+        auto bucketsSize = buckets.size() * sizeof(Bucket);
+
+        std::vector<uint8_t> buffer(sizeof(header) + bucketsSize);
+
+        memcpy(buffer.data(), &header, sizeof(header));
+        memcpy(buffer.data() + sizeof(header), buckets.data(), bucketsSize);
+
+        m_recording->writeRecord(
+            Nedrysoft::RouteAnalyser::SessionRecording::RecordType::Rollups,
+            buffer.data(),
+            static_cast<uint32_t>(buffer.size())
+        );
+    };
+
+    for (auto hop = 0; hop < static_cast<int>(m_hops.size()); hop++) {
+        auto &columns = m_hops[static_cast<size_t>(hop)];
+
+        for (auto level = 0; level < static_cast<int>(columns.rollups.size()); level++) {
+            auto &rollupLevel = columns.rollups[static_cast<size_t>(level)];
+            auto written = false;
+
+            for (size_t page = 0; page < rollupLevel.pages.size(); page++) {
+                if (rollupLevel.pages[page].buckets.empty()) {
+                    continue;
+                }
+
+                writeRollups(
+                    hop,
+                    level,
+                    (rollupLevel.firstPage + static_cast<qint64>(page)) * RollupPageSize,
+                    rollupLevel.pages[page].buckets
+                );
+
+                written = true;
+            }
+
+            // a level without any pages is written as an empty record so that the loader can tell that the
+            // rollups of the hop are complete.
+
+            if (!written) {
+                writeRollups(hop, level, 0, std::vector<Bucket>());
+            }
+        }
+    }
+
+    m_recording = nullptr;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::load(const Nedrysoft::RouteAnalyser::SessionRecording &recording) -> bool {
+    auto &records = recording.records();
+    std::vector<bool> loadedRollups;
+    std::vector<bool> superseded(static_cast<size_t>(records.size()), false);
+    std::vector<int> incompleteBlocks;
+    std::vector<qint64> cutoffTimes;
+
+    clear();
+
+    // the retention period is measured back from the latest sample of each hop, which is found first so that the
+    // blocks that have expired can be left in the recording.  An incomplete block is only ever followed by a later
+    // copy of the same block, so any block of the hop that follows it replaces it.
+
+    for (auto index = 0; index < records.size(); index++) {
+        auto &record = records[index];
+        BlockRecord header;
+
+        if ((record.type != Nedrysoft::RouteAnalyser::SessionRecording::RecordType::Block) ||
+            (record.size < sizeof(header))) {
+
+            continue;
+        }
+
+        memcpy(&header, record.data, sizeof(header));
+
+        if (header.hop < 0) {
+            continue;
+        }
+
+        if (header.hop >= static_cast<int>(incompleteBlocks.size())) {
+            incompleteBlocks.resize(static_cast<size_t>(header.hop) + 1, -1);
+        }
+
+        auto &incompleteBlock = incompleteBlocks[static_cast<size_t>(header.hop)];
+
+        if (incompleteBlock >= 0) {
+            superseded[static_cast<size_t>(incompleteBlock)] = true;
+        }
+
+        incompleteBlock = (header.count < BlockSize) ? index : -1;
+
+        if (m_rawRetention <= 0) {
+            continue;
+        }
+
+        if (header.hop >= static_cast<int>(cutoffTimes.size())) {
+            cutoffTimes.resize(static_cast<size_t>(header.hop) + 1, std::numeric_limits<qint64>::min());
+        }
+
+        cutoffTimes[static_cast<size_t>(header.hop)] = std::max(
+            cutoffTimes[static_cast<size_t>(header.hop)],
+            header.maximumTime - m_rawRetention
+        );
+    }
+
+    auto readRollupHeader = [this](
+            const Nedrysoft::RouteAnalyser::SessionRecording::Record &record,
+            RollupRecord &header) -> bool {
+
+        if (record.size < sizeof(header)) {
+            return false;
+        }
+
+        memcpy(&header, record.data, sizeof(header));
+
+        return (header.hop >= 0) && (header.hop < static_cast<int>(m_hops.size())) &&
+               (header.level >= 0) && (header.level < SeriesCount * RollupLevelCount) &&
+               (header.count <= (record.size - sizeof(header)) / sizeof(Bucket)) &&
+               ((header.count == 0) || (header.count == RollupPageSize)) &&
+               (header.firstBucket % RollupPageSize == 0);
+    };
+
+    for (auto index = 0; index < records.size(); index++) {
+        auto &record = records[index];
+
+        switch(record.type) {
+            case Nedrysoft::RouteAnalyser::SessionRecording::RecordType::Block: {
+                if (superseded[static_cast<size_t>(index)]) {
+                    break;
+                }
+
+                if (!loadBlock(record.data, record.size, record.offset, cutoffTimes)) {
+                    return false;
+                }
+
+                break;
+            }
+
+            case Nedrysoft::RouteAnalyser::SessionRecording::RecordType::Rollups: {
+                RollupRecord header;
+
+                if (!readRollupHeader(record, header)) {
+                    return false;
+                }
+
+                auto &columns = m_hops[static_cast<size_t>(header.hop)];
+
+                if (columns.rollups.empty()) {
+                    columns.rollups.resize(SeriesCount * RollupLevelCount);
+                }
+
+                loadedRollups.resize(m_hops.size(), false);
+                loadedRollups[static_cast<size_t>(header.hop)] = true;
+
+                if (header.count == 0) {
+                    break;
+                }
+
+                auto &rollupLevel = columns.rollups[static_cast<size_t>(header.level)];
+                auto pageIndex = header.firstBucket / RollupPageSize;
+
+                if (rollupLevel.pages.empty()) {
+                    rollupLevel.firstPage = pageIndex;
+                } else if (pageIndex < rollupLevel.firstPage) {
+                    return false;
+                }
+
+                auto position = static_cast<size_t>(pageIndex - rollupLevel.firstPage);
+
+                if (position >= rollupLevel.pages.size()) {
+                    rollupLevel.pages.resize(position + 1);
+                }
+
+                auto &rollupPage = rollupLevel.pages[position];
+
+                rollupPage.fileOffset = record.offset + static_cast<qint64>(sizeof(header));
+                rollupPage.buckets.resize(static_cast<size_t>(header.count));
+
+                memcpy(rollupPage.buckets.data(), record.data + sizeof(header), header.count * sizeof(Bucket));
+
+                break;
+            }
+
+            case Nedrysoft::RouteAnalyser::SessionRecording::RecordType::SpilledRollups: {
+                RollupRecord header;
+
+                if (!readRollupHeader(record, header)) {
+                    return false;
+                }
+
+                m_hops[static_cast<size_t>(header.hop)].spilledRollups.push_back(SpilledRollups {
+                    header.level,
+                    header.firstBucket,
+                    static_cast<qint64>(header.count),
+                    record.offset + static_cast<qint64>(sizeof(header))
+                });
+
+                break;
+            }
+
+            default: {
+                break;
+            }
+        }
+    }
+
+    // a recording that was not finished has no rollups, so they are rebuilt from the samples.
+
+    loadedRollups.resize(m_hops.size(), false);
+
+    for (size_t hop = 0; hop < m_hops.size(); hop++) {
+        if (!loadedRollups[hop]) {
+            rebuildRollups(m_hops[hop], recording);
+        }
+
+        enforceRetention(static_cast<int>(hop), true);
+    }
+
+    return true;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::loadBlock(
+        const uint8_t *data,
+        uint32_t size,
+        qint64 recordOffset,
+        const std::vector<qint64> &cutoffTimes) -> bool {
+
+    BlockRecord header;
+
+    if (size < sizeof(header)) {
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if (!isValidBlock(header, size)) {
+        return false;
+    }
+
+    auto words = static_cast<size_t>((header.count + BitsPerWord - 1) / BitsPerWord);
+    auto lossBitmap = data + sizeof(header);
+    auto alternateBitmap = lossBitmap + (words * sizeof(uint64_t));
+    auto roundTripTimes = alternateBitmap + (words * sizeof(uint64_t));
+    auto timeDeltas = roundTripTimes + (static_cast<size_t>(header.count) * sizeof(uint32_t));
+
+    if (header.hop >= static_cast<int>(m_hops.size())) {
+        m_hops.resize(static_cast<size_t>(header.hop) + 1);
+    }
+
+    auto &columns = m_hops[static_cast<size_t>(header.hop)];
+
+    // full blocks that have expired before any block is held in memory are left in the recording.
+
+    if ((header.hop < static_cast<int>(cutoffTimes.size())) &&
+        (header.maximumTime < cutoffTimes[static_cast<size_t>(header.hop)]) &&
+        (header.count == BlockSize) &&
+        columns.blocks.empty()) {
+
+        columns.spilledBlocks.push_back(SpilledBlock {
+            header.minimumTime,
+            header.maximumTime,
+            recordOffset,
+            size,
+            columns.latestTime
+        });
+
+        if (header.minimumTime < columns.latestTime) {
+            columns.lateness = std::max(columns.lateness, columns.latestTime - header.minimumTime);
+        }
+
+        columns.latestTime = std::max(columns.latestTime, static_cast<qint64>(header.maximumTime));
+
+        return true;
+    }
+
+    if (columns.count % BlockSize) {
+        // the previous block was incomplete, so the columns cannot be copied and the samples are added instead.
+
+        auto hop = header.hop;
+
+        return forEachSample(data, size, [this, hop](qint64 time, uint32_t roundTripTime, bool lost, bool alternate) {
+            append(hop, time, lost ? -1 : (roundTripTime / MicrosecondsPerSecond), alternate);
+        });
+    }
+
+    columns.blocks.push_back(Block {
+        header.firstTime,
+        header.minimumTime,
+        header.maximumTime,
+        static_cast<uint32_t>(columns.timeDeltas.size()),
+        columns.count,
+        recordOffset,
+        size,
+        columns.latestTime
+    });
+
+    if (header.minimumTime < columns.latestTime) {
+        columns.lateness = std::max(columns.lateness, columns.latestTime - header.minimumTime);
+    }
+
+    columns.latestTime = std::max(columns.latestTime, static_cast<qint64>(header.maximumTime));
+
+    columns.timeDeltas.insert(columns.timeDeltas.end(), timeDeltas, timeDeltas + header.deltaSize);
+
+    auto firstWord = columns.lossBitmap.size();
+
+    columns.lossBitmap.resize(firstWord + words);
+    columns.alternateBitmap.resize(firstWord + words);
+
+    memcpy(columns.lossBitmap.data() + firstWord, lossBitmap, words * sizeof(uint64_t));
+    memcpy(columns.alternateBitmap.data() + firstWord, alternateBitmap, words * sizeof(uint64_t));
+
+    auto firstSample = columns.roundTripTimes.size();
+
+    columns.roundTripTimes.resize(firstSample + static_cast<size_t>(header.count));
+
+    memcpy(
+        columns.roundTripTimes.data() + firstSample,
+        roundTripTimes,
+        static_cast<size_t>(header.count) * sizeof(uint32_t)
+    );
+
+    columns.count += header.count;
+    columns.lastTime = header.lastTime;
+
+    return true;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::rebuildRollups(
+        HopColumns &columns,
+        const Nedrysoft::RouteAnalyser::SessionRecording &recording) -> void {
+
+    columns.rollups.clear();
+
+    for (auto &spilledBlock : columns.spilledBlocks) {
+        auto data = recording.read(spilledBlock.offset, spilledBlock.size);
+
+        forEachSample(
+            reinterpret_cast<const uint8_t *>(data.constData()),
+            static_cast<size_t>(data.size()),
+            [&columns](qint64 time, uint32_t roundTripTime, bool lost, bool alternate) {
+                addToRollups(columns, time, roundTripTime, lost, alternate);
+            }
+        );
+    }
+
+    for (auto &block : columns.blocks) {
+        auto time = block.firstTime;
+        auto offset = static_cast<size_t>(block.offset);
+        auto lastSample = std::min(block.firstSample + BlockSize, columns.count);
+
+        for (auto index = block.firstSample; index < lastSample; index++) {
+            if (index != block.firstSample) {
+                time += decodeDelta(columns.timeDeltas.data(), columns.timeDeltas.size(), offset);
+            }
+
+            auto word = static_cast<size_t>(index / BitsPerWord);
+            auto bit = static_cast<uint64_t>(1) << (index % BitsPerWord);
+
+            addToRollups(
+                columns,
+                time,
+                columns.roundTripTimes[static_cast<size_t>(index)],
+                (columns.lossBitmap[word] & bit) != 0,
+                (columns.alternateBitmap[word] & bit) != 0
+            );
+        }
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::count(int hop) const -> int {
+    if ((hop < 0) || (hop >= static_cast<int>(m_hops.size()))) {
+        return 0;
+    }
+
+    return m_hops[static_cast<size_t>(hop)].count;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::hopCount() const -> int {
+    return static_cast<int>(m_hops.size());
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::memoryUsage() const -> qint64 {
+    qint64 size = 0;
+
+    for (auto &columns : m_hops) {
+        size += static_cast<qint64>(columns.timeDeltas.capacity() * sizeof(uint8_t));
+        size += static_cast<qint64>(columns.roundTripTimes.capacity() * sizeof(uint32_t));
+        size += static_cast<qint64>(columns.lossBitmap.capacity() * sizeof(uint64_t));
+        size += static_cast<qint64>(columns.alternateBitmap.capacity() * sizeof(uint64_t));
+        size += static_cast<qint64>(columns.blocks.capacity() * sizeof(Block));
+        size += static_cast<qint64>(columns.spilledBlocks.capacity() * sizeof(SpilledBlock));
+        size += static_cast<qint64>(columns.spilledRollups.capacity() * sizeof(SpilledRollups));
+
+        for (auto &rollupLevel : columns.rollups) {
+            size += static_cast<qint64>(rollupLevel.pages.capacity() * sizeof(RollupPage));
+
+            for (auto &rollupPage : rollupLevel.pages) {
+                size += static_cast<qint64>(rollupPage.buckets.capacity() * sizeof(Bucket));
+            }
+        }
+    }
+
+    return size;
+}
+
+auto Nedrysoft::RouteAnalyser::SampleStore::clear() -> void {
+    m_hops.clear();
+    m_discardedTime.assign(RollupLevelCount + 1, std::numeric_limits<qint64>::min());
+}
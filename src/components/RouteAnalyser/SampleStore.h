@@ -0,0 +1,552 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_SAMPLESTORE_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_SAMPLESTORE_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    class SessionRecording;
+
+    /**
+     * @brief       The SampleStore class holds the samples collected for each hop of a route analysis session.
+     *
+     * @details     Samples are stored in columns, timestamps are delta encoded as variable length integers, round
+     *              trip times are quantised to whole microseconds and lost requests and large (size sweep) probes
+     *              are held in bitmaps, so each sample costs around 6 bytes rather than the 16 bytes of a
+     *              QCPGraphData plus the 16 bytes of a QCPBarsData for every timeout.
+     *
+     *              Samples are appended in the order that results arrive, which is not strictly time order as
+     *              timeouts are reported after later replies, so the samples are grouped into blocks which record
+     *              their time span and any block overlapping a queried range is decoded.
+     *
+     *              Each hop also holds minimum, maximum and mean rollups at resolutions of 10 seconds, 1 minute,
+     *              10 minutes and 1 hour which are updated as samples are appended, so a long session can be drawn
+     *              from a number of points that depends on the width of the plot rather than the length of the
+     *              session.  A rollup interval costs 24 bytes against around 6 bytes for a sample, so there is no
+     *              rollup finer than 10 seconds, shorter intervals are decoded from the samples.
+     *
+     *              If a recording is attached then each block is written to it once it is full, when the
+     *              recording is finished the incomplete blocks and the rollups are written so that a recording can
+     *              be loaded by copying the columns rather than adding each sample.
+     *
+     *              The memory used by a long session is bounded by a retention policy, raw samples are kept for
+     *              the raw retention period and the rollups for the rollup retention period.  Expired data is
+     *              dropped in batches, blocks that have been written to the recording and rollups that are spilled
+     *              to it can still be read back from the file, without a recording expired data is discarded.
+     */
+    class SampleStore {
+        public:
+            /**
+             * @brief       A decoded sample.
+             */
+            struct Sample {
+                double time;                            //! time of the request in seconds since the unix epoch.
+                double roundTripTime;                   //! round trip time in seconds; -1 if no reply was received.
+                bool alternate;                         //! true if the sample is from a large (size sweep) probe.
+            };
+
+            /**
+             * @brief       A summary of the samples that fall within a rollup interval.
+             */
+            struct Rollup {
+                double time;                            //! start of the interval in seconds since the unix epoch.
+                double minimum;                         //! minimum round trip time in seconds.
+                double maximum;                         //! maximum round trip time in seconds.
+                double mean;                            //! mean round trip time in seconds.
+                int replies;                            //! number of replies received in the interval.
+                int lost;                               //! number of requests that received no reply.
+            };
+
+            /**
+             * @brief       The policy used to find the value of a hop at a point in time.
+             */
+            enum class Lookup {
+                Nearest,                                //! the sample closest to the time, lost requests included.
+                Interpolate                             //! interpolated between the replies either side of the time.
+            };
+
+        public:
+            /**
+             * @brief       Constructs an empty SampleStore.
+             */
+            SampleStore();
+
+            /**
+             * @brief       Appends a sample.
+             *
+             * @param[in]   hop the hop index (0 based).
+             * @param[in]   time the time of the request in milliseconds since the unix epoch.
+             * @param[in]   roundTripTime the round trip time in seconds; -1 if no reply was received.
+             * @param[in]   alternate true if the sample is from a large (size sweep) probe; otherwise false.
+             */
+            auto append(int hop, qint64 time, double roundTripTime, bool alternate = false) -> void;
+
+            /**
+             * @brief       Returns the samples for a hop which fall within a time range.
+             *
+             * @param[in]   hop the hop index (0 based).
+             * @param[in]   start the start of the range in seconds since the unix epoch.
+             * @param[in]   end the end of the range in seconds since the unix epoch.
+             *
+             * @returns     the samples in the order they were appended.
+             */
+            auto samples(int hop, double start, double end) const -> QVector<Sample>;
+
+            /**
+             * @brief       Returns the value of a hop at a point in time.
+             *
+             * @details     The samples within the tolerance of the time are decoded, the blocks that hold them are
+             *              found with a binary search so the cost does not depend on the length of the session.
+             *
+             *              Lost requests are skipped when interpolating, if there is a reply on only one side of the
+             *              time then that reply is returned.
+             *
+             * @param[in]   hop the hop index (0 based).
+             * @param[in]   time the time in seconds since the unix epoch.
+             * @param[in]   tolerance the distance in seconds either side of the time that samples are taken from.
+             * @param[out]  sample the sample; for an interpolated value the time is the requested time.
+             * @param[in]   lookup the lookup policy.
+             * @param[in]   alternate true to use the large (size sweep) probes; otherwise false.
+             *
+             * @returns     true if a value was found; otherwise false.
+             */
+            auto valueAt(
+                    int hop,
+                    double time,
+                    double tolerance,
+                    Sample &sample,
+                    Lookup lookup = Lookup::Nearest,
+                    bool alternate = false) const -> bool;
+
+            /**
+             * @brief       Returns the summary of the samples of a hop which fall within a time range.
+             *
+             * @details     The whole intervals of the coarsest rollups that fit in the range are used, the partial
+             *              intervals at either end are filled from the finer rollups and only the parts of the range
+             *              shorter than the finest rollup are decoded from the samples.
+             *
+             * @note        Data that has been discarded by the retention policy is not included.
+             *
+             * @param[in]   hop the hop index (0 based).
+             * @param[in]   start the start of the range in seconds since the unix epoch.
+             * @param[in]   end the end of the range in seconds since the unix epoch.
+             * @param[in]   alternate true to summarise the large (size sweep) probes; otherwise false.
+             *
+             * @returns     the summary, the time is the start of the range and the round trip times are -1 if no
+             *              replies were received.
+             */
+            auto aggregate(int hop, double start, double end, bool alternate = false) const -> Rollup;
+
+            /**
+             * @brief       Returns the rollups for a hop which fall within a time range.
+             *
+             * @note        Intervals that contain no samples are omitted.
+             *
+             * @param[in]   hop the hop index (0 based).
+             * @param[in]   resolution the resolution of the rollups in seconds, one of resolutions().
+             * @param[in]   start the start of the range in seconds since the unix epoch.
+             * @param[in]   end the end of the range in seconds since the unix epoch.
+             * @param[in]   alternate true to return the rollups of large (size sweep) probes; otherwise false.
+             *
+             * @returns     the rollups in time order.
+             */
+            auto rollups(int hop, int resolution, double start, double end, bool alternate = false) const ->
+                    QVector<Rollup>;
+
+            /**
+             * @brief       Returns the resolutions that rollups are held at.
+             *
+             * @returns     the resolutions in seconds from finest to coarsest.
+             */
+            static auto resolutions() -> QVector<int>;
+
+            /**
+             * @brief       Returns the coarsest rollup resolution that does not exceed the given interval.
+             *
+             * @details     Used to pick the resolution that matches the width of a plot, the interval is the time
+             *              covered by a single pixel.
+             *
+             * @param[in]   interval the interval in seconds.
+             *
+             * @returns     the resolution in seconds; 0 if the raw samples should be used.
+             */
+            static auto resolutionFor(double interval) -> int;
+
+            /**
+             * @brief       Sets the retention policy.
+             *
+             * @details     The periods are measured back from the latest sample of each hop, data that has expired
+             *              is removed immediately.
+             *
+             * @param[in]   rawRetention the time in milliseconds that raw samples are kept for; 0 to keep them.
+             * @param[in]   rollupRetention the time in milliseconds that rollups are kept for; 0 to keep them.
+             */
+            auto setRetention(qint64 rawRetention, qint64 rollupRetention) -> void;
+
+            /**
+             * @brief       Returns the time that raw samples are kept for.
+             *
+             * @returns     the time in milliseconds; 0 if raw samples are not removed.
+             */
+            auto rawRetention() const -> qint64;
+
+            /**
+             * @brief       Returns the time that rollups are kept for.
+             *
+             * @returns     the time in milliseconds; 0 if rollups are not removed.
+             */
+            auto rollupRetention() const -> qint64;
+
+            /**
+             * @brief       Returns the finest resolution that is still held for a point in time.
+             *
+             * @details     Data that has expired and was not written to a recording is discarded, a plot of an
+             *              older range must use a coarser resolution.
+             *
+             * @param[in]   time the time in seconds since the unix epoch.
+             *
+             * @returns     the resolution in seconds; 0 if the raw samples are held.
+             */
+            auto retainedResolution(double time) const -> int;
+
+            /**
+             * @brief       Returns the time span of the samples in the store.
+             *
+             * @param[out]  start the time of the earliest sample in milliseconds since the unix epoch.
+             * @param[out]  end the time of the latest sample in milliseconds since the unix epoch.
+             *
+             * @returns     true if the store contains samples; otherwise false.
+             */
+            auto timeRange(qint64 &start, qint64 &end) const -> bool;
+
+            /**
+             * @brief       Attaches a recording that samples are written to as they are added.
+             *
+             * @param[in]   recording the recording; nullptr to detach the current recording.
+             */
+            auto setRecording(Nedrysoft::RouteAnalyser::SessionRecording *recording) -> void;
+
+            /**
+             * @brief       Writes the incomplete blocks that have changed since they were last written to the recording.
+             *
+             * @details     An incomplete block is written again each time that it changes, the latest copy of a block
+             *              replaces the earlier copies when the recording is loaded.  This is called periodically so
+             *              that a recording which is not finished (for example if the application exits unexpectedly)
+             *              only loses the samples that were added since the last call.
+             */
+            auto checkpointRecording() -> void;
+
+            /**
+             * @brief       Writes the incomplete blocks and the rollups to the recording and detaches it.
+             */
+            auto finishRecording() -> void;
+
+            /**
+             * @brief       Replaces the contents of the store with the samples from a recording.
+             *
+             * @details     The retention policy is applied as the recording is loaded, expired data is not copied
+             *              into memory and is read from the recording when required, so the recording must be
+             *              attached with setRecording() and remain open while the store is used.
+             *
+             * @param[in]   recording the opened recording.
+             *
+             * @returns     true if the samples were loaded; otherwise false.
+             */
+            auto load(const Nedrysoft::RouteAnalyser::SessionRecording &recording) -> bool;
+
+            /**
+             * @brief       Returns the number of samples held in memory for a hop.
+             *
+             * @param[in]   hop the hop index (0 based).
+             *
+             * @returns     the number of samples.
+             */
+            auto count(int hop) const -> int;
+
+            /**
+             * @brief       Returns the number of hops that the store holds samples for.
+             *
+             * @returns     the number of hops.
+             */
+            auto hopCount() const -> int;
+
+            /**
+             * @brief       Returns the memory allocated by the store.
+             *
+             * @returns     the size in bytes.
+             */
+            auto memoryUsage() const -> qint64;
+
+            /**
+             * @brief       Removes all samples.
+             */
+            auto clear() -> void;
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       A block of consecutive samples.
+             */
+            struct Block {
+                qint64 firstTime;
+                qint64 minimumTime;
+                qint64 maximumTime;
+                uint32_t offset;
+                int firstSample;
+                qint64 recordOffset;
+                uint32_t recordSize;
+                qint64 precedingTime;
+            };
+
+            /**
+             * @brief       A block that has been removed from memory and is held in the recording.
+             */
+            struct SpilledBlock {
+                qint64 minimumTime;
+                qint64 maximumTime;
+                qint64 offset;
+                uint32_t size;
+                qint64 precedingTime;
+            };
+
+            /**
+             * @brief       A run of rollup intervals that has been removed from memory and is held in the recording.
+             */
+            struct SpilledRollups {
+                int level;
+                qint64 firstBucket;
+                qint64 count;
+                qint64 offset;
+            };
+
+            /**
+             * @brief       The summary of a rollup interval, round trip times are in microseconds.
+             */
+            struct Bucket {
+                uint32_t minimum;
+                uint32_t maximum;
+                uint64_t sum;
+                uint32_t replies;
+                uint32_t lost;
+            };
+
+            /**
+             * @brief       A page of consecutive rollup intervals.
+             *
+             * @details     The buckets are only allocated once a sample falls within the page, the file offset is
+             *              set if the page was loaded from a recording and has not changed since.
+             */
+            struct RollupPage {
+                std::vector<Bucket> buckets;
+                qint64 fileOffset = -1;
+            };
+
+            /**
+             * @brief       The rollup intervals of a series at one resolution.
+             *
+             * @details     The intervals are held in pages so that a gap in the samples costs no more than the
+             *              empty pages that span it, expired intervals are removed a page at a time.
+             */
+            struct RollupLevel {
+                std::vector<RollupPage> pages;
+                qint64 firstPage = 0;
+            };
+
+            /**
+             * @brief       The sample columns for a hop.
+             *
+             * @details     Each block records the latest time of the samples before it, the latest time up to and
+             *              including a block never decreases so the first block of a range is found with a binary
+             *              search.  Samples arrive late by at most the lateness of the hop, so once the preceding
+             *              time of a block is beyond the end of a range plus the lateness no later block can hold
+             *              samples in the range.
+             */
+            struct HopColumns {
+                std::vector<uint8_t> timeDeltas;
+                std::vector<uint32_t> roundTripTimes;
+                std::vector<uint64_t> lossBitmap;
+                std::vector<uint64_t> alternateBitmap;
+                std::vector<Block> blocks;
+                std::vector<RollupLevel> rollups;
+                std::vector<SpilledBlock> spilledBlocks;
+                std::vector<SpilledRollups> spilledRollups;
+                qint64 lastTime = 0;
+                qint64 latestTime = std::numeric_limits<qint64>::min();
+                qint64 lateness = 0;
+                int count = 0;
+                bool lastBlockRecorded = false;
+            };
+
+            /**
+             * @brief       Adds a sample to the rollups of a hop.
+             *
+             * @param[in]   columns the hop columns.
+             * @param[in]   time the time of the request in milliseconds since the unix epoch.
+             * @param[in]   roundTripTime the round trip time in microseconds.
+             * @param[in]   lost true if no reply was received; otherwise false.
+             * @param[in]   alternate true if the sample is from a large (size sweep) probe; otherwise false.
+             */
+            static auto addToRollups(
+                    HopColumns &columns,
+                    qint64 time,
+                    uint32_t roundTripTime,
+                    bool lost,
+                    bool alternate) -> void;
+
+            /**
+             * @brief       Writes the most recent block of a hop to the recording.
+             *
+             * @param[in]   hop the hop index (0 based).
+             */
+            auto writeLastBlock(int hop) -> void;
+
+            /**
+             * @brief       Adds a block read from a recording to a hop.
+             *
+             * @param[in]   data the payload of the block record.
+             * @param[in]   size the size of the payload in bytes.
+             * @param[in]   recordOffset the offset of the payload in the recording.
+             * @param[in]   cutoffTimes the time for each hop before which full blocks are left in the recording.
+             *
+             * @returns     true if the block was valid; otherwise false.
+             */
+            auto loadBlock(
+                    const uint8_t *data,
+                    uint32_t size,
+                    qint64 recordOffset,
+                    const std::vector<qint64> &cutoffTimes) -> bool;
+
+            /**
+             * @brief       Rebuilds the rollups of a hop from its samples.
+             *
+             * @param[in]   columns the hop columns.
+             * @param[in]   recording the recording that holds the spilled blocks of the hop.
+             */
+            static auto rebuildRollups(
+                    HopColumns &columns,
+                    const Nedrysoft::RouteAnalyser::SessionRecording &recording) -> void;
+
+            /**
+             * @brief       Removes the samples and rollups of a hop that have expired.
+             *
+             * @param[in]   hop the hop index (0 based).
+             * @param[in]   force true to remove expired data immediately; false to wait for a batch to expire.
+             */
+            auto enforceRetention(int hop, bool force) -> void;
+
+            /**
+             * @brief       Calls a function for each sample of a hop which falls within a time range.
+             *
+             * @param[in]   columns the hop columns.
+             * @param[in]   startTime the start of the range in milliseconds since the unix epoch.
+             * @param[in]   endTime the end of the range (inclusive) in milliseconds since the unix epoch.
+             * @param[in]   function the function, called with the time in milliseconds, the round trip time in
+             *              microseconds and whether the sample was lost and is from a large (size sweep) probe.
+             */
+            template <typename Function>
+            auto forEachSampleInRange(
+                    const HopColumns &columns,
+                    qint64 startTime,
+                    qint64 endTime,
+                    Function function) const -> void;
+
+            /**
+             * @brief       Calls a function for each interval of a rollup level which falls within a range.
+             *
+             * @param[in]   columns the hop columns.
+             * @param[in]   levelIndex the index of the rollup level.
+             * @param[in]   startBucket the first interval.
+             * @param[in]   endBucket the last interval.
+             * @param[in]   function the function, called with the bucket and the index of the interval.
+             */
+            template <typename Function>
+            auto forEachBucket(
+                    const HopColumns &columns,
+                    int levelIndex,
+                    qint64 startBucket,
+                    qint64 endBucket,
+                    Function function) const -> void;
+
+            /**
+             * @brief       Adds the samples of a hop which fall within a time range to a bucket.
+             *
+             * @param[in]       columns the hop columns.
+             * @param[in]       level the coarsest rollup level to use; -1 to use the samples.
+             * @param[in]       startTime the start of the range in milliseconds since the unix epoch.
+             * @param[in]       endTime the end of the range (exclusive) in milliseconds since the unix epoch.
+             * @param[in]       alternate true to use the large (size sweep) probes; otherwise false.
+             * @param[in,out]   total the bucket.
+             */
+            auto accumulate(
+                    const HopColumns &columns,
+                    int level,
+                    qint64 startTime,
+                    qint64 endTime,
+                    bool alternate,
+                    Bucket &total) const -> void;
+
+            /**
+             * @brief       Adds a sample to a bucket.
+             *
+             * @param[in,out]   bucket the bucket.
+             * @param[in]       roundTripTime the round trip time in microseconds.
+             * @param[in]       lost true if no reply was received; otherwise false.
+             */
+            static auto addToBucket(Bucket &bucket, uint32_t roundTripTime, bool lost) -> void;
+
+            /**
+             * @brief       Adds the summary of one bucket to another.
+             *
+             * @param[in,out]   bucket the bucket that is added to.
+             * @param[in]       other the bucket to add.
+             */
+            static auto mergeBucket(Bucket &bucket, const Bucket &other) -> void;
+
+            /**
+             * @brief       Converts a bucket to a rollup.
+             *
+             * @param[in]   bucket the bucket.
+             * @param[in]   time the time of the rollup in seconds since the unix epoch.
+             *
+             * @returns     the rollup.
+             */
+            static auto toRollup(const Bucket &bucket, double time) -> Rollup;
+
+            std::vector<HopColumns> m_hops;
+            Nedrysoft::RouteAnalyser::SessionRecording *m_recording;
+            qint64 m_rawRetention;
+            qint64 m_rollupRetention;
+            std::vector<qint64> m_discardedTime;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_SAMPLESTORE_H
@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SessionRecording.h"
+
+#include <QJsonDocument>
+#include <QObject>
+
+constexpr uint32_t RecordingMagic = 0x52474e50;
+constexpr uint32_t RecordingVersion = 2;
+constexpr auto RecordAlignment = 8;
+
+/**
+ * @brief       The header at the start of a recording.
+ */
+struct RecordingHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+
+/**
+ * @brief       The header at the start of each record.
+ */
+struct RecordHeader {
+    uint32_t type;
+    uint32_t size;
+};
+
+Nedrysoft::RouteAnalyser::SessionRecording::SessionRecording() :
+        m_map(nullptr),
+        m_mapSize(0) {
+
+}
+
+Nedrysoft::RouteAnalyser::SessionRecording::~SessionRecording() {
+    close();
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::create(const QString &filename, const QJsonObject &session) -> bool {
+    close();
+
+    m_file.setFileName(filename);
+
+    if (!m_file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
+
+    auto header = RecordingHeader {RecordingMagic, RecordingVersion};
+
+    if (m_file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != static_cast<qint64>(sizeof(header))) {
+        close();
+
+        return false;
+    }
+
+    auto json = QJsonDocument(session).toJson(QJsonDocument::Compact);
+
+    if (writeRecord(RecordType::Session, json.constData(), static_cast<uint32_t>(json.size())) < 0) {
+        close();
+
+        return false;
+    }
+
+    m_session = session;
+
+    return true;
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::open(const QString &filename) -> bool {
+    close();
+
+    m_file.setFileName(filename);
+
+    if (!m_file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    auto fileSize = m_file.size();
+
+    if (fileSize < static_cast<qint64>(sizeof(RecordingHeader))) {
+        close();
+
+        return false;
+    }
+
+    m_map = m_file.map(0, fileSize);
+
+    if (!m_map) {
+        close();
+
+        return false;
+    }
+
+    m_mapSize = fileSize;
+
+    auto header = reinterpret_cast<const RecordingHeader *>(m_map);
+
+    if ((header->magic != RecordingMagic) || (header->version != RecordingVersion)) {
+        close();
+
+        return false;
+    }
+
+    auto offset = static_cast<qint64>(sizeof(RecordingHeader));
+
+    // a recording that was not closed cleanly may end with a partially written record, which is ignored.
+
+    while (offset + static_cast<qint64>(sizeof(RecordHeader)) <= fileSize) {
+        auto recordHeader = reinterpret_cast<const RecordHeader *>(m_map + offset);
+        auto data = m_map + offset + sizeof(RecordHeader);
+
+        if (offset + static_cast<qint64>(sizeof(RecordHeader)) + recordHeader->size > fileSize) {
+            break;
+        }
+
+        auto record = Record {
+            static_cast<RecordType>(recordHeader->type),
+            data,
+            recordHeader->size,
+            offset + static_cast<qint64>(sizeof(RecordHeader))
+        };
+
+        switch(record.type) {
+            case RecordType::Session: {
+                auto json = QByteArray::fromRawData(reinterpret_cast<const char *>(data), record.size);
+
+                m_session = QJsonDocument::fromJson(json).object();
+
+                break;
+            }
+
+            case RecordType::Hop: {
+                auto json = QByteArray::fromRawData(reinterpret_cast<const char *>(data), record.size);
+                auto hopObject = QJsonDocument::fromJson(json).object();
+
+                m_hops[hopObject["hop"].toInt()] = hopObject;
+
+                break;
+            }
+
+            default: {
+                m_records.append(record);
+
+                break;
+            }
+        }
+
+        offset += sizeof(RecordHeader) + ((recordHeader->size + RecordAlignment - 1) & ~(RecordAlignment - 1));
+    }
+
+    return true;
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::close() -> void {
+    if (m_map) {
+        m_file.unmap(m_map);
+
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    if (m_reader.isOpen()) {
+        m_reader.close();
+    }
+
+    m_records.clear();
+    m_hops.clear();
+    m_session = QJsonObject();
+    m_errorString.clear();
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::isWritable() const -> bool {
+    return m_file.isOpen() && m_file.isWritable() && m_errorString.isEmpty();
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::setErrorHandler(
+        std::function<void(const QString &)> errorHandler) -> void {
+
+    m_errorHandler = errorHandler;
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::errorString() const -> QString {
+    return m_errorString;
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::fileName() const -> QString {
+    return m_file.fileName();
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::writeHop(int hop, const QJsonObject &hopObject) -> void {
+    auto object = hopObject;
+
+    object.insert("hop", hop);
+
+    auto json = QJsonDocument(object).toJson(QJsonDocument::Compact);
+
+    writeRecord(RecordType::Hop, json.constData(), static_cast<uint32_t>(json.size()));
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::writeRecord(
+        RecordType type,
+        const void *data,
+        uint32_t size) -> qint64 {
+
+    static const char padding[RecordAlignment] = {};
+
+    if (!isWritable()) {
+        return -1;
+    }
+
+    auto start = m_file.pos();
+    auto header = RecordHeader {static_cast<uint32_t>(type), size};
+    auto paddedSize = (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+
+    // the records are flushed as they are written, so that a session is not lost if the application exits.
+
+    auto written =
+        (m_file.write(reinterpret_cast<const char *>(&header), sizeof(header)) ==
+                static_cast<qint64>(sizeof(header))) &&
+        (m_file.write(reinterpret_cast<const char *>(data), size) == size) &&
+        (m_file.write(padding, paddedSize - size) == paddedSize - size) &&
+        (m_file.flush());
+
+    if (!written) {
+        // the partial record is removed so that the recording can still be opened, once a write has failed (for
+        // example if the disk is full) the recording is stopped rather than leaving gaps in it.
+
+        m_errorString = m_file.errorString();
+
+        if (m_errorString.isEmpty()) {
+            m_errorString = QObject::tr("The recording could not be written.");
+        }
+
+        m_file.resize(start);
+        m_file.seek(start);
+
+        if (m_errorHandler) {
+            m_errorHandler(m_errorString);
+        }
+
+        return -1;
+    }
+
+    return start + static_cast<qint64>(sizeof(RecordHeader));
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::read(qint64 offset, qint64 size) const -> QByteArray {
+    if ((offset < 0) || (size <= 0)) {
+        return QByteArray();
+    }
+
+    if (m_map) {
+        if (offset + size > m_mapSize) {
+            return QByteArray();
+        }
+
+        return QByteArray(reinterpret_cast<const char *>(m_map + offset), static_cast<int>(size));
+    }
+
+    // the records that were written before a failure can still be read back.
+
+    if ((!m_file.isOpen()) || (!m_file.isWritable())) {
+        return QByteArray();
+    }
+
+    // the file being written is opened a second time, so reading does not move the write position.
+
+    if (!m_reader.isOpen()) {
+        m_reader.setFileName(m_file.fileName());
+
+        if (!m_reader.open(QFile::ReadOnly)) {
+            return QByteArray();
+        }
+    }
+
+    if (!m_reader.seek(offset)) {
+        return QByteArray();
+    }
+
+    auto data = m_reader.read(size);
+
+    if (data.size() != size) {
+        return QByteArray();
+    }
+
+    return data;
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::session() const -> QJsonObject {
+    return m_session;
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::hops() const -> QMap<int, QJsonObject> {
+    return m_hops;
+}
+
+auto Nedrysoft::RouteAnalyser::SessionRecording::records() const ->
+        const QVector<Nedrysoft::RouteAnalyser::SessionRecording::Record> & {
+
+    return m_records;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_SESSIONRECORDING_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_SESSIONRECORDING_H
+
+#include <QFile>
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include <functional>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The SessionRecording class reads and writes the recording file of a route analysis session.
+     *
+     * @details     A recording is a header followed by records which are only ever appended to the end of the
+     *              file, each record has a type, a size and a payload which is padded so that every record starts
+     *              on an 8 byte boundary.  The session (target and probe settings) and the hops of the route are
+     *              stored as JSON, the samples are stored as the columns of the sample store so that a recording
+     *              can be memory mapped and the columns copied into a store without decoding each sample.
+     *              Rollup intervals that are dropped from memory by the retention policy of the store are
+     *              appended as spilled rollup records so that they can be read back when a plot needs them.
+     *
+     *              Values are stored in the byte order of the machine that made the recording.
+     */
+    class SessionRecording {
+        public:
+            /**
+             * @brief       The type of a record.
+             */
+            enum class RecordType {
+                Session = 1,
+                Hop = 2,
+                Block = 3,
+                Rollups = 4,
+                SpilledRollups = 5
+            };
+
+            /**
+             * @brief       A record in a mapped recording.
+             */
+            struct Record {
+                RecordType type;                        //! the type of the record.
+                const uint8_t *data;                    //! the payload of the record.
+                uint32_t size;                          //! the size of the payload in bytes.
+                qint64 offset;                          //! the offset of the payload in the file.
+            };
+
+        public:
+            /**
+             * @brief       Constructs a SessionRecording.
+             */
+            SessionRecording();
+
+            /**
+             * @brief       Destroys the SessionRecording.
+             */
+            ~SessionRecording();
+
+            /**
+             * @brief       Creates a new recording, overwriting any existing file.
+             *
+             * @param[in]   filename the filename of the recording.
+             * @param[in]   session the session settings.
+             *
+             * @returns     true if the recording was created; otherwise false.
+             */
+            auto create(const QString &filename, const QJsonObject &session) -> bool;
+
+            /**
+             * @brief       Opens and maps an existing recording.
+             *
+             * @param[in]   filename the filename of the recording.
+             *
+             * @returns     true if the file is a valid recording; otherwise false.
+             */
+            auto open(const QString &filename) -> bool;
+
+            /**
+             * @brief       Closes the recording.
+             */
+            auto close() -> void;
+
+            /**
+             * @brief       Returns whether the recording is open for writing.
+             *
+             * @returns     true if records can be written; otherwise false.
+             */
+            auto isWritable() const -> bool;
+
+            /**
+             * @brief       Sets the function that is called if the recording fails.
+             *
+             * @details     If a record cannot be written then the partial record is removed and no further records
+             *              are written, the records that were already written can still be read back.
+             *
+             * @param[in]   errorHandler the function, called with the reason that the recording failed.
+             */
+            auto setErrorHandler(std::function<void(const QString &)> errorHandler) -> void;
+
+            /**
+             * @brief       Returns the reason that the recording failed.
+             *
+             * @returns     the reason; an empty string if the recording has not failed.
+             */
+            auto errorString() const -> QString;
+
+            /**
+             * @brief       Returns the filename of the recording.
+             *
+             * @returns     the filename.
+             */
+            auto fileName() const -> QString;
+
+            /**
+             * @brief       Appends a hop record.
+             *
+             * @param[in]   hop the hop number.
+             * @param[in]   hopObject the hop metadata.
+             */
+            auto writeHop(int hop, const QJsonObject &hopObject) -> void;
+
+            /**
+             * @brief       Appends a record.
+             *
+             * @param[in]   type the type of the record.
+             * @param[in]   data the payload.
+             * @param[in]   size the size of the payload in bytes.
+             *
+             * @returns     the offset of the payload in the file; -1 if the record could not be written.
+             */
+            auto writeRecord(RecordType type, const void *data, uint32_t size) -> qint64;
+
+            /**
+             * @brief       Reads part of the recording.
+             *
+             * @details     Used to read back data that has been spilled from memory, the data is read from the map
+             *              of an opened recording or from the file of a recording that is being written.
+             *
+             * @param[in]   offset the offset in the file.
+             * @param[in]   size the number of bytes to read.
+             *
+             * @returns     the data; an empty array if it could not be read.
+             */
+            auto read(qint64 offset, qint64 size) const -> QByteArray;
+
+            /**
+             * @brief       Returns the session settings of an opened recording.
+             *
+             * @returns     the session settings.
+             */
+            auto session() const -> QJsonObject;
+
+            /**
+             * @brief       Returns the hop metadata of an opened recording.
+             *
+             * @returns     the map of hop number to hop metadata.
+             */
+            auto hops() const -> QMap<int, QJsonObject>;
+
+            /**
+             * @brief       Returns the records of an opened recording.
+             *
+             * @note        The records point into the mapped file and are valid until the recording is closed.
+             *
+             * @returns     the records in the order they were written.
+             */
+            auto records() const -> const QVector<Record> &;
+
+        private:
+            //! @cond
+
+            QFile m_file;
+            mutable QFile m_reader;
+            uchar *m_map;
+            qint64 m_mapSize;
+            QVector<Record> m_records;
+            QJsonObject m_session;
+            QMap<int, QJsonObject> m_hops;
+            QString m_errorString;
+            std::function<void(const QString &)> m_errorHandler;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_SESSIONRECORDING_H
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TableUpdateScheduler.h"
+
+#include <QStandardItemModel>
+#include <QTimer>
+#include <algorithm>
+
+constexpr auto FrameInterval = 16;
+constexpr auto BitsPerWord = 64;
+constexpr auto AllColumnsMask = ~static_cast<uint64_t>(0);
+
+Nedrysoft::RouteAnalyser::TableUpdateScheduler::TableUpdateScheduler(QStandardItemModel *model, QObject *parent) :
+        QObject(parent),
+        m_model(model),
+        m_frameTimer(new QTimer(this)) {
+
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setInterval(FrameInterval);
+
+    connect(m_frameTimer, &QTimer::timeout, this, &TableUpdateScheduler::flush);
+}
+
+Nedrysoft::RouteAnalyser::TableUpdateScheduler::~TableUpdateScheduler() {
+
+}
+
+auto Nedrysoft::RouteAnalyser::TableUpdateScheduler::invalidate(int row, int column) -> void {
+    invalidate(row, row, column);
+}
+
+auto Nedrysoft::RouteAnalyser::TableUpdateScheduler::invalidate(int firstRow, int lastRow, int column) -> void {
+    if (column == AllColumns) {
+        invalidate(firstRow, lastRow, 0, BitsPerWord - 1);
+    } else {
+        invalidate(firstRow, lastRow, column, column);
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::TableUpdateScheduler::invalidate(
+        int firstRow,
+        int lastRow,
+        int firstColumn,
+        int lastColumn ) -> void {
+
+    if (!m_model) {
+        return;
+    }
+
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min(lastRow, m_model->rowCount() - 1);
+
+    if (firstRow > lastRow) {
+        return;
+    }
+
+    if (lastRow >= static_cast<int>(m_dirtyColumns.size())) {
+        m_dirtyColumns.resize(static_cast<size_t>(lastRow) + 1, 0);
+    }
+
+    firstColumn = std::max(firstColumn, 0);
+
+    if (firstColumn > lastColumn) {
+        return;
+    }
+
+    // columns beyond the width of the mask are rare, they are treated as the whole row.
+
+    auto mask = AllColumnsMask;
+
+    if (lastColumn < BitsPerWord) {
+        mask = (AllColumnsMask >> (BitsPerWord - 1 - lastColumn + firstColumn)) << firstColumn;
+    }
+
+    for (auto row = firstRow; row <= lastRow; row++) {
+        m_dirtyColumns[static_cast<size_t>(row)] |= mask;
+    }
+
+    if (!m_frameTimer->isActive()) {
+        m_frameTimer->start();
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::TableUpdateScheduler::invalidateAll() -> void {
+    if (!m_model) {
+        return;
+    }
+
+    invalidate(0, m_model->rowCount() - 1, AllColumns);
+}
+
+auto Nedrysoft::RouteAnalyser::TableUpdateScheduler::flush() -> void {
+    m_frameTimer->stop();
+
+    if (!m_model) {
+        m_dirtyColumns.clear();
+
+        return;
+    }
+
+    auto firstRow = -1, lastRow = -1;
+    uint64_t columns = 0;
+
+    for (auto row = 0; row < static_cast<int>(m_dirtyColumns.size()); row++) {
+        if (!m_dirtyColumns[static_cast<size_t>(row)]) {
+            continue;
+        }
+
+        if (firstRow < 0) {
+            firstRow = row;
+        }
+
+        lastRow = row;
+        columns |= m_dirtyColumns[static_cast<size_t>(row)];
+    }
+
+    std::fill(m_dirtyColumns.begin(), m_dirtyColumns.end(), 0);
+
+    auto columnCount = m_model->columnCount();
+
+    lastRow = std::min(lastRow, m_model->rowCount() - 1);
+
+    if ((firstRow < 0) || (firstRow > lastRow) || (columnCount == 0)) {
+        return;
+    }
+
+    // each contiguous run of dirty columns is notified separately so that unchanged columns between them are not
+    // repainted.
+
+    auto lastColumn = std::min(columnCount, BitsPerWord) - 1;
+
+    if (columns == AllColumnsMask) {
+        lastColumn = columnCount - 1;
+    }
+
+    auto firstColumn = -1;
+
+    for (auto column = 0; column <= lastColumn + 1; column++) {
+        auto isDirty = (column <= lastColumn) &&
+                       ((column >= BitsPerWord) || (columns & (static_cast<uint64_t>(1) << column)));
+
+        if (isDirty && (firstColumn < 0)) {
+            firstColumn = column;
+        } else if (!isDirty && (firstColumn >= 0)) {
+            Q_EMIT m_model->dataChanged(m_model->index(firstRow, firstColumn), m_model->index(lastRow, column - 1));
+
+            firstColumn = -1;
+        }
+    }
+}
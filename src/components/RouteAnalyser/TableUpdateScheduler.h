@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_TABLEUPDATESCHEDULER_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_TABLEUPDATESCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <cstdint>
+#include <vector>
+
+class QStandardItemModel;
+class QTimer;
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The TableUpdateScheduler class coalesces the change notifications of the route table.
+     *
+     * @details     Cells are marked dirty as the data behind them changes, once per frame the dirty rows are
+     *              combined into a single range and one dataChanged signal is emitted for each contiguous run of
+     *              dirty columns, so any number of changes between frames costs one repaint of the affected cells
+     *              rather than a repaint of the whole table for every change.
+     */
+    class TableUpdateScheduler :
+            public QObject {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       Marks every column of a row.
+             */
+            static constexpr int AllColumns = -1;
+
+        public:
+            /**
+             * @brief       Constructs a new TableUpdateScheduler for a model.
+             *
+             * @param[in]   model the model that the notifications are emitted for.
+             * @param[in]   parent the parent object.
+             */
+            explicit TableUpdateScheduler(QStandardItemModel *model, QObject *parent = nullptr);
+
+            /**
+             * @brief       Destroys the TableUpdateScheduler.
+             */
+            ~TableUpdateScheduler();
+
+            /**
+             * @brief       Marks a cell as changed.
+             *
+             * @param[in]   row the row.
+             * @param[in]   column the column; AllColumns for the whole row.
+             */
+            auto invalidate(int row, int column = AllColumns) -> void;
+
+            /**
+             * @brief       Marks a range of rows as changed.
+             *
+             * @note        The range is clamped to the rows of the model.
+             *
+             * @param[in]   firstRow the first row.
+             * @param[in]   lastRow the last row.
+             * @param[in]   column the column; AllColumns for the whole of each row.
+             */
+            auto invalidate(int firstRow, int lastRow, int column) -> void;
+
+            /**
+             * @brief       Marks a range of columns in a range of rows as changed.
+             *
+             * @note        The range is clamped to the rows of the model.
+             *
+             * @param[in]   firstRow the first row.
+             * @param[in]   lastRow the last row.
+             * @param[in]   firstColumn the first column.
+             * @param[in]   lastColumn the last column.
+             */
+            auto invalidate(int firstRow, int lastRow, int firstColumn, int lastColumn) -> void;
+
+            /**
+             * @brief       Marks every cell in the model as changed.
+             */
+            auto invalidateAll() -> void;
+
+            /**
+             * @brief       Emits the notification for the cells that have changed since the last frame.
+             */
+            auto flush() -> void;
+
+        private:
+            //! @cond
+
+            QPointer<QStandardItemModel> m_model;
+            QTimer *m_frameTimer;
+            std::vector<uint64_t> m_dirtyColumns;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_TABLEUPDATESCHEDULER_H
@@ -110,7 +110,8 @@ auto Nedrysoft::RouteAnalyser::TargetManager::addRecent(
         QString host,
         QString name,
         QString description,
-        Nedrysoft::Core::IPVersion ipVersion ) -> void {
+        Nedrysoft::Core::IPVersion ipVersion,
+        const Nedrysoft::RouteAnalyser::PingPayload &payload ) -> void {
 
     QVariantMap newRecent;
 
@@ -122,6 +123,8 @@ auto Nedrysoft::RouteAnalyser::TargetManager::addRecent(
 #else
     newRecent["ipversion"].setValue<Nedrysoft::Core::IPVersion>(ipVersion);
 #endif
+    payload.toVariantMap(newRecent);
+
     addRecent(newRecent);
 }
 
@@ -149,6 +152,13 @@ auto Nedrysoft::RouteAnalyser::TargetManager::saveConfiguration() -> QJsonObject
         favouriteObject["interval"] = favourite["interval"].toInt();
         favouriteObject["ipversion"] = favourite["ipversion"].toInt();
 
+        auto favouritePayload = Nedrysoft::RouteAnalyser::PingPayload::fromVariantMap(favourite);
+
+        favouriteObject["payloadsize"] = favouritePayload.size();
+        favouriteObject["payloadpattern"] =
+                Nedrysoft::RouteAnalyser::PingPayload::patternName(favouritePayload.pattern());
+        favouriteObject["sweepsize"] = favouritePayload.sweepSize();
+
         favouritesArray.append(favouriteObject);
     }
 
@@ -165,6 +175,13 @@ auto Nedrysoft::RouteAnalyser::TargetManager::saveConfiguration() -> QJsonObject
         recentObject["interval"] = recent["interval"].toInt();
         recentObject["ipversion"] = recent["ipversion"].toInt();
 
+        auto recentPayload = Nedrysoft::RouteAnalyser::PingPayload::fromVariantMap(recent);
+
+        recentObject["payloadsize"] = recentPayload.size();
+        recentObject["payloadpattern"] =
+                Nedrysoft::RouteAnalyser::PingPayload::patternName(recentPayload.pattern());
+        recentObject["sweepsize"] = recentPayload.sweepSize();
+
         recentsArray.append(recentObject);
     }
 
@@ -192,6 +209,9 @@ auto Nedrysoft::RouteAnalyser::TargetManager::loadConfiguration(QJsonObject conf
             favouriteMap["ipversion"].setValue<Nedrysoft::Core::IPVersion>(
                     favouriteObject["ipversion"].toVariant().value<Nedrysoft::Core::IPVersion>());
 
+            Nedrysoft::RouteAnalyser::PingPayload::fromVariantMap(
+                    favouriteObject.toVariantMap()).toVariantMap(favouriteMap);
+
             m_favouriteList.append(favouriteMap);
         }
     }
@@ -210,6 +230,9 @@ auto Nedrysoft::RouteAnalyser::TargetManager::loadConfiguration(QJsonObject conf
             recentMap["ipversion"].setValue<Nedrysoft::Core::IPVersion>(
                     recentObject["ipversion"].toVariant().value<Nedrysoft::Core::IPVersion>());
 
+            Nedrysoft::RouteAnalyser::PingPayload::fromVariantMap(
+                    recentObject.toVariantMap()).toVariantMap(recentMap);
+
              m_recentsList.append(recentMap);
         }
     }
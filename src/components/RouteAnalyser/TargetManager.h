@@ -24,6 +24,8 @@
 #ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_TARGETMANAGER_H
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_TARGETMANAGER_H
 
+#include "PingPayload.h"
+
 #include <ICore>
 
 #include <QJsonObject>
@@ -78,12 +80,15 @@ namespace Nedrysoft { namespace RouteAnalyser {
              * @param[in]   name the user friendly name assigned to this facourite.
              * @param[in]   description the descriptive name of the favourite.
              * @param[in]   ipVersion the IP version to use for this favourite.
+             * @param[in]   payload the probe payload used for this target.
              */
             auto addRecent(
                     QString host,
                     QString name,
                     QString description,
-                    Nedrysoft::Core::IPVersion ipVersion ) -> void;
+                    Nedrysoft::Core::IPVersion ipVersion,
+                    const Nedrysoft::RouteAnalyser::PingPayload &payload =
+                            Nedrysoft::RouteAnalyser::PingPayload() ) -> void;
 
             /**
              * @brief       Adds a target to recent list.
@@ -36,12 +36,28 @@ constexpr auto ConfigurationFilename = "TargetSettings.json";
 constexpr auto DefaultHostTarget = "1.1.1.1";
 constexpr auto DefaultIPVersion = Nedrysoft::Core::IPVersion::V4;
 constexpr auto DefaultPingInterval = 2.5;
+constexpr auto DefaultPathMTUDiscoveryEnabled = false;
+constexpr auto DefaultRawRetention = 6;
+constexpr auto DefaultRollupRetention = 7;
+constexpr auto DefaultRecordingEnabled = true;
+constexpr auto DefaultRecordingLimit = 1024;
+constexpr auto DefaultFrameRate = 60;
+constexpr auto DefaultShowFrameTime = false;
+constexpr auto DefaultOpenGLEnabled = false;
 
 Nedrysoft::RouteAnalyser::TargetSettings::TargetSettings() :
         m_defaultPingEngine(QString()),
         m_defaultHostTarget(DefaultHostTarget),
         m_defaultPingInterval(DefaultPingInterval),
-        m_defaultIPVersion(DefaultIPVersion) {
+        m_defaultIPVersion(DefaultIPVersion),
+        m_defaultPathMTUDiscoveryEnabled(DefaultPathMTUDiscoveryEnabled),
+        m_rawRetention(DefaultRawRetention),
+        m_rollupRetention(DefaultRollupRetention),
+        m_recordingEnabled(DefaultRecordingEnabled),
+        m_recordingLimit(DefaultRecordingLimit),
+        m_frameRate(DefaultFrameRate),
+        m_showFrameTime(DefaultShowFrameTime),
+        m_openGLEnabled(DefaultOpenGLEnabled) {
 
 }
 
@@ -60,6 +76,17 @@ auto Nedrysoft::RouteAnalyser::TargetSettings::saveConfiguration() -> QJsonObjec
     targetObject.insert("defaultPingEngine", m_defaultPingEngine);
     targetObject.insert("pingInterval", m_defaultPingInterval);
     targetObject.insert("ipVersion", static_cast<int>(m_defaultIPVersion));
+    targetObject.insert("pathMTUDiscovery", m_defaultPathMTUDiscoveryEnabled);
+    targetObject.insert("payloadSize", m_defaultPayload.size());
+    targetObject.insert("payloadPattern", PingPayload::patternName(m_defaultPayload.pattern()));
+    targetObject.insert("sweepSize", m_defaultPayload.sweepSize());
+    targetObject.insert("rawRetention", m_rawRetention);
+    targetObject.insert("rollupRetention", m_rollupRetention);
+    targetObject.insert("recording", m_recordingEnabled);
+    targetObject.insert("recordingLimit", m_recordingLimit);
+    targetObject.insert("frameRate", m_frameRate);
+    targetObject.insert("showFrameTime", m_showFrameTime);
+    targetObject.insert("openGL", m_openGLEnabled);
 
     rootObject.insert("target", targetObject);
 
@@ -89,6 +116,50 @@ auto Nedrysoft::RouteAnalyser::TargetSettings::loadConfiguration(QJsonObject con
         if (targetObject.contains("ipVersion")) {
             m_defaultIPVersion = static_cast<Nedrysoft::Core::IPVersion>(targetObject["ipVersion"].toInt());
         }
+
+        if (targetObject.contains("pathMTUDiscovery")) {
+            m_defaultPathMTUDiscoveryEnabled = targetObject["pathMTUDiscovery"].toBool();
+        }
+
+        if (targetObject.contains("payloadSize")) {
+            m_defaultPayload.setSize(targetObject["payloadSize"].toInt());
+        }
+
+        if (targetObject.contains("payloadPattern")) {
+            m_defaultPayload.setPattern(PingPayload::patternFromName(targetObject["payloadPattern"].toString()));
+        }
+
+        if (targetObject.contains("sweepSize")) {
+            m_defaultPayload.setSweepSize(targetObject["sweepSize"].toInt());
+        }
+
+        if (targetObject.contains("rawRetention")) {
+            m_rawRetention = targetObject["rawRetention"].toInt();
+        }
+
+        if (targetObject.contains("rollupRetention")) {
+            m_rollupRetention = targetObject["rollupRetention"].toInt();
+        }
+
+        if (targetObject.contains("recording")) {
+            m_recordingEnabled = targetObject["recording"].toBool();
+        }
+
+        if (targetObject.contains("recordingLimit")) {
+            m_recordingLimit = targetObject["recordingLimit"].toInt();
+        }
+
+        if (targetObject.contains("frameRate")) {
+            m_frameRate = targetObject["frameRate"].toInt();
+        }
+
+        if (targetObject.contains("showFrameTime")) {
+            m_showFrameTime = targetObject["showFrameTime"].toBool();
+        }
+
+        if (targetObject.contains("openGL")) {
+            m_openGLEnabled = targetObject["openGL"].toBool();
+        }
     }
 
     return true;
@@ -222,3 +293,83 @@ auto Nedrysoft::RouteAnalyser::TargetSettings::setDefaultIPVersion(Nedrysoft::Co
 auto Nedrysoft::RouteAnalyser::TargetSettings::defaultIPVersion() -> Nedrysoft::Core::IPVersion {
     return m_defaultIPVersion;
 }
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setDefaultPathMTUDiscoveryEnabled(bool enabled) -> void {
+    m_defaultPathMTUDiscoveryEnabled = enabled;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::defaultPathMTUDiscoveryEnabled() -> bool {
+    return m_defaultPathMTUDiscoveryEnabled;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setDefaultPayload(
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void {
+
+    m_defaultPayload = payload;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::defaultPayload() -> Nedrysoft::RouteAnalyser::PingPayload {
+    return m_defaultPayload;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setRawRetention(int hours) -> void {
+    m_rawRetention = hours;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::rawRetention() -> int {
+    return m_rawRetention;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setRollupRetention(int days) -> void {
+    m_rollupRetention = days;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::rollupRetention() -> int {
+    return m_rollupRetention;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setRecordingEnabled(bool enabled) -> void {
+    m_recordingEnabled = enabled;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::recordingEnabled() -> bool {
+    return m_recordingEnabled;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setRecordingLimit(int megabytes) -> void {
+    m_recordingLimit = megabytes;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::recordingLimit() -> int {
+    return m_recordingLimit;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setFrameRate(int framesPerSecond) -> void {
+    m_frameRate = framesPerSecond;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::frameRate() -> int {
+    return m_frameRate;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setShowFrameTime(bool show) -> void {
+    if (m_showFrameTime == show) {
+        return;
+    }
+
+    m_showFrameTime = show;
+
+    Q_EMIT showFrameTimeChanged(show);
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::showFrameTime() -> bool {
+    return m_showFrameTime;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::setOpenGLEnabled(bool enabled) -> void {
+    m_openGLEnabled = enabled;
+}
+
+auto Nedrysoft::RouteAnalyser::TargetSettings::openGLEnabled() -> bool {
+    return m_openGLEnabled;
+}
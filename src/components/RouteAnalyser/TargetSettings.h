@@ -24,6 +24,8 @@
 #ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_TARGETSETTINGS_H
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_TARGETSETTINGS_H
 
+#include "PingPayload.h"
+
 #include <ICore>
 #include <IConfiguration>
 
@@ -129,6 +131,144 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
              auto defaultIPVersion() -> Nedrysoft::Core::IPVersion;
 
+            /**
+             * @brief       Sets whether path MTU discovery is enabled for new targets.
+             *
+             * @param[in]   enabled true if path MTU discovery is enabled; otherwise false.
+             */
+            auto setDefaultPathMTUDiscoveryEnabled(bool enabled) -> void;
+
+            /**
+             * @brief       Returns whether path MTU discovery is enabled for new targets.
+             *
+             * @returns     true if path MTU discovery is enabled; otherwise false.
+             */
+            auto defaultPathMTUDiscoveryEnabled() -> bool;
+
+            /**
+             * @brief       Sets the default probe payload for new targets.
+             *
+             * @param[in]   payload the payload size, pattern and sweep size.
+             */
+            auto setDefaultPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void;
+
+            /**
+             * @brief       Returns the default probe payload for new targets.
+             *
+             * @returns     the payload size, pattern and sweep size.
+             */
+            auto defaultPayload() -> Nedrysoft::RouteAnalyser::PingPayload;
+
+            /**
+             * @brief       Sets the time that the raw samples of a session are kept in memory for.
+             *
+             * @param[in]   hours the time in hours; 0 to keep every sample.
+             */
+            auto setRawRetention(int hours) -> void;
+
+            /**
+             * @brief       Returns the time that the raw samples of a session are kept in memory for.
+             *
+             * @returns     the time in hours; 0 if every sample is kept.
+             */
+            auto rawRetention() -> int;
+
+            /**
+             * @brief       Sets the time that the rollups of a session are kept in memory for.
+             *
+             * @param[in]   days the time in days; 0 to keep every rollup.
+             */
+            auto setRollupRetention(int days) -> void;
+
+            /**
+             * @brief       Returns the time that the rollups of a session are kept in memory for.
+             *
+             * @returns     the time in days; 0 if every rollup is kept.
+             */
+            auto rollupRetention() -> int;
+
+            /**
+             * @brief       Sets whether the samples of new sessions are written to a recording.
+             *
+             * @param[in]   enabled true if sessions are recorded; otherwise false.
+             */
+            auto setRecordingEnabled(bool enabled) -> void;
+
+            /**
+             * @brief       Returns whether the samples of new sessions are written to a recording.
+             *
+             * @returns     true if sessions are recorded; otherwise false.
+             */
+            auto recordingEnabled() -> bool;
+
+            /**
+             * @brief       Sets the space that the recordings may use.
+             *
+             * @details     When a session is started the oldest recordings are removed until the recordings fit
+             *              within the limit.
+             *
+             * @param[in]   megabytes the size in megabytes; 0 to keep every recording.
+             */
+            auto setRecordingLimit(int megabytes) -> void;
+
+            /**
+             * @brief       Returns the space that the recordings may use.
+             *
+             * @returns     the size in megabytes; 0 if every recording is kept.
+             */
+            auto recordingLimit() -> int;
+
+            /**
+             * @brief       Sets the maximum rate that the plots are redrawn at.
+             *
+             * @param[in]   framesPerSecond the number of frames per second.
+             */
+            auto setFrameRate(int framesPerSecond) -> void;
+
+            /**
+             * @brief       Returns the maximum rate that the plots are redrawn at.
+             *
+             * @returns     the number of frames per second.
+             */
+            auto frameRate() -> int;
+
+            /**
+             * @brief       Sets whether the time taken to draw each frame of the plots is shown.
+             *
+             * @param[in]   show true if the frame time is shown; otherwise false.
+             */
+            auto setShowFrameTime(bool show) -> void;
+
+            /**
+             * @brief       Returns whether the time taken to draw each frame of the plots is shown.
+             *
+             * @returns     true if the frame time is shown; otherwise false.
+             */
+            auto showFrameTime() -> bool;
+
+            /**
+             * @brief       This signal is emitted when the frame time display is turned on or off.
+             *
+             * @param[in]   show true if the frame time is shown; otherwise false.
+             */
+            Q_SIGNAL void showFrameTimeChanged(bool show);
+
+            /**
+             * @brief       Sets whether the plots are drawn with OpenGL.
+             *
+             * @note        The plots fall back to the raster engine if OpenGL is not available.
+             *
+             * @param[in]   enabled true if OpenGL is used; otherwise false.
+             */
+            auto setOpenGLEnabled(bool enabled) -> void;
+
+            /**
+             * @brief       Returns whether the plots are drawn with OpenGL.
+             *
+             * @returns     true if OpenGL is used; otherwise false.
+             */
+            auto openGLEnabled() -> bool;
+
         public:
             /**
               * @brief       Saves the configuration to a JSON object.
@@ -153,6 +293,15 @@ namespace Nedrysoft { namespace RouteAnalyser {
             QString m_defaultHostTarget;
             double m_defaultPingInterval;
             Nedrysoft::Core::IPVersion m_defaultIPVersion;
+            bool m_defaultPathMTUDiscoveryEnabled;
+            Nedrysoft::RouteAnalyser::PingPayload m_defaultPayload;
+            int m_rawRetention;
+            int m_rollupRetention;
+            bool m_recordingEnabled;
+            int m_recordingLimit;
+            int m_frameRate;
+            bool m_showFrameTime;
+            bool m_openGLEnabled;
 
             //! @endcond
 
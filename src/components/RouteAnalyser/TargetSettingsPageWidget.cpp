@@ -50,6 +50,10 @@ Nedrysoft::RouteAnalyser::TargetSettingsPageWidget::TargetSettingsPageWidget(QWi
         sortedPingEngines.insert(1-factory->priority(), factory);
     }
 
+    ui->payloadPatternComboBox->addItem(tr("Zeros"), static_cast<int>(PingPayload::Pattern::Zeros));
+    ui->payloadPatternComboBox->addItem(tr("Random"), static_cast<int>(PingPayload::Pattern::Random));
+    ui->payloadPatternComboBox->addItem(tr("Incrementing"), static_cast<int>(PingPayload::Pattern::Incrementing));
+
     if (targetSettings) {
         ui->defaultTargetLineEdit->setText(targetSettings->defaultHost());
         ui->defaultIntervalLineEdit->setText(Nedrysoft::Utils::intervalToString(targetSettings->defaultPingInterval()));
@@ -71,6 +75,23 @@ Nedrysoft::RouteAnalyser::TargetSettingsPageWidget::TargetSettingsPageWidget(QWi
         }
 
         ui->defaultEngineComboBox->setCurrentIndex(selectionIndex);
+
+        ui->pathMTUCheckBox->setChecked(targetSettings->defaultPathMTUDiscoveryEnabled());
+
+        auto payload = targetSettings->defaultPayload();
+
+        ui->payloadSizeSpinBox->setValue(payload.size());
+        ui->payloadPatternComboBox->setCurrentIndex(
+                ui->payloadPatternComboBox->findData(static_cast<int>(payload.pattern())) );
+        ui->sweepSizeSpinBox->setValue(payload.sweepSize());
+
+        ui->rawRetentionSpinBox->setValue(targetSettings->rawRetention());
+        ui->rollupRetentionSpinBox->setValue(targetSettings->rollupRetention());
+        ui->recordingCheckBox->setChecked(targetSettings->recordingEnabled());
+        ui->recordingLimitSpinBox->setValue(targetSettings->recordingLimit());
+        ui->frameRateSpinBox->setValue(targetSettings->frameRate());
+        ui->showFrameTimeCheckBox->setChecked(targetSettings->showFrameTime());
+        ui->openGLCheckBox->setChecked(targetSettings->openGLEnabled());
     }
 }
 
@@ -96,6 +117,18 @@ auto Nedrysoft::RouteAnalyser::TargetSettingsPageWidget::acceptSettings() -> voi
     targetSettings->setDefaultPingEngine(ui->defaultEngineComboBox->currentData().toString());
     targetSettings->setDefaultIPVersion(
             ui->ipV4RadioButton->isChecked() ? Nedrysoft::Core::IPVersion::V4 : Nedrysoft::Core::IPVersion::V6);
+    targetSettings->setDefaultPathMTUDiscoveryEnabled(ui->pathMTUCheckBox->isChecked());
+    targetSettings->setDefaultPayload(PingPayload(
+            ui->payloadSizeSpinBox->value(),
+            static_cast<PingPayload::Pattern>(ui->payloadPatternComboBox->currentData().toInt()),
+            ui->sweepSizeSpinBox->value() ));
+    targetSettings->setRawRetention(ui->rawRetentionSpinBox->value());
+    targetSettings->setRollupRetention(ui->rollupRetentionSpinBox->value());
+    targetSettings->setRecordingEnabled(ui->recordingCheckBox->isChecked());
+    targetSettings->setRecordingLimit(ui->recordingLimitSpinBox->value());
+    targetSettings->setFrameRate(ui->frameRateSpinBox->value());
+    targetSettings->setShowFrameTime(ui->showFrameTimeCheckBox->isChecked());
+    targetSettings->setOpenGLEnabled(ui->openGLCheckBox->isChecked());
 
     targetSettings->saveToFile();
 }
@@ -31,6 +31,9 @@ constexpr auto MillisecondsInSecond = 1000.0;
 constexpr auto SecondsInMinute = 60.0;
 constexpr auto SecondsInInHour = SecondsInMinute*60.0;
 constexpr auto SecondsInDay = SecondsInInHour*24.0;
+constexpr auto BitsInKilobit = 1.0e3;
+constexpr auto BitsInMegabit = 1.0e6;
+constexpr auto BitsInGigabit = 1.0e9;
 
 constexpr auto timeIntervalRegularExpression =
         R"(^\s*(?<number>(\d*(\.\d+|\d*)))(\s*(?<units>ms|s|m|h|d|sec(s?)|second(s?)|min(s?)|minute(s?)|hour(s?)|day(s?))\s*)?$)";
@@ -122,3 +125,15 @@ auto Nedrysoft::Utils::intervalToString(double value) -> QString {
         return QString(QObject::tr("%1 ms")).arg(value*MillisecondsInSecond, 1, 'f', 0, '0');
     }
 }
+
+auto Nedrysoft::Utils::bandwidthToString(double value) -> QString {
+    if (value>=BitsInGigabit) {
+        return QString(QObject::tr("%1 Gb/s")).arg(value/BitsInGigabit, 0, 'f', 1);
+    } else if (value>=BitsInMegabit) {
+        return QString(QObject::tr("%1 Mb/s")).arg(value/BitsInMegabit, 0, 'f', 1);
+    } else if (value>=BitsInKilobit) {
+        return QString(QObject::tr("%1 kb/s")).arg(value/BitsInKilobit, 0, 'f', 1);
+    }
+
+    return QString(QObject::tr("%1 b/s")).arg(value, 0, 'f', 0);
+}
@@ -87,6 +87,15 @@ namespace Nedrysoft { namespace Utils {
      * @returns     the interval as a string
      */
     auto intervalToString(double value) -> QString;
+
+    /**
+     * @brief       Converts a bandwidth to a string with units.
+     *
+     * @param[in]   value the bandwidth in bits per second.
+     *
+     * @returns     the bandwidth as a string.
+     */
+    auto bandwidthToString(double value) -> QString;
 }}
 
 #endif // PINGNOO_COMPONENTS_ROUTEANALYSER_UTILS_H
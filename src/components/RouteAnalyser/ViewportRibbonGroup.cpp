@@ -62,6 +62,18 @@ Nedrysoft::RouteAnalyser::ViewportRibbonGroup::ViewportRibbonGroup(QWidget *pare
         }
     });
 
+    ui->statisticsComboBox->addItem(tr("Session"), static_cast<int>(PingData::StatisticsWindow::Session));
+    ui->statisticsComboBox->addItem(tr("1 Minute"), static_cast<int>(PingData::StatisticsWindow::OneMinute));
+    ui->statisticsComboBox->addItem(tr("15 Minutes"), static_cast<int>(PingData::StatisticsWindow::FifteenMinutes));
+    ui->statisticsComboBox->addItem(tr("1 Hour"), static_cast<int>(PingData::StatisticsWindow::OneHour));
+    ui->statisticsComboBox->addItem(tr("Viewport"), static_cast<int>(PingData::StatisticsWindow::Viewport));
+
+    connect(ui->statisticsComboBox, &QComboBox::currentTextChanged, [=](QString text) {
+        Q_UNUSED(text)
+
+        Q_EMIT statisticsWindowChanged(statisticsWindow());
+    });
+
     ui->trimmerWidget->setViewport(0, 1);
     ui->trimmerWidget->setEnabled(false);
 }
@@ -101,3 +113,9 @@ auto Nedrysoft::RouteAnalyser::ViewportRibbonGroup::viewportSize() -> double {
 
     return DefaultViewportSize;
 }
+
+auto Nedrysoft::RouteAnalyser::ViewportRibbonGroup::statisticsWindow() ->
+        Nedrysoft::RouteAnalyser::PingData::StatisticsWindow {
+
+    return static_cast<PingData::StatisticsWindow>(ui->statisticsComboBox->currentData().toInt());
+}
@@ -24,6 +24,8 @@
 #ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_VIEWPORTRIBBONGROUP_H
 #define PINGNOO_COMPONENTS_ROUTEANALYSER_VIEWPORTRIBBONGROUP_H
 
+#include "PingData.h"
+
 #include <QWidget>
 
 namespace Nedrysoft { namespace RouteAnalyser {
@@ -90,6 +92,13 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             auto viewportSize() -> double;
 
+            /**
+             * @brief       Returns the window selected for the table statistics.
+             *
+             * @returns     the statistics window.
+             */
+            auto statisticsWindow() -> Nedrysoft::RouteAnalyser::PingData::StatisticsWindow;
+
         public:
             /**
              * @brief       This signal is emitted when the viewport start and/or end has been modified.
@@ -106,6 +115,13 @@ namespace Nedrysoft { namespace RouteAnalyser {
              */
             Q_SIGNAL void viewportWindowChanged(double size);
 
+            /**
+             * @brief       This signal is emitted when the window for the table statistics has been changed.
+             *
+             * @param[in]   window the new statistics window.
+             */
+            Q_SIGNAL void statisticsWindowChanged(Nedrysoft::RouteAnalyser::PingData::StatisticsWindow window);
+
         private:
             //! @cond
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WindowedStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr auto MicrosecondsPerSecond = 1000000.0;
+constexpr auto NoReply = -1;
+
+Nedrysoft::RouteAnalyser::WindowedStatistics::WindowedStatistics(double windowSize) :
+        m_windowSize(windowSize),
+        m_latestTime(0),
+        m_sequence(0),
+        m_replyCount(0),
+        m_lostCount(0),
+        m_latencySum(0) {
+
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::setWindowSize(double windowSize) -> void {
+    m_windowSize = windowSize;
+
+    evict();
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::windowSize() const -> double {
+    return m_windowSize;
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::add(double time, double latency) -> void {
+    Sample sample = {m_sequence++, time, NoReply};
+
+    // a timeout is reported after later replies, so a late sample must not move the window back.
+
+    m_latestTime = std::max(m_latestTime, time);
+
+    if (latency < 0) {
+        m_lostCount++;
+    } else {
+        sample.latency = static_cast<int64_t>(std::llround(latency * MicrosecondsPerSecond));
+
+        // samples which can never be the minimum (or maximum) while the new sample is in the window are discarded.
+
+        while ((!m_minimumQueue.empty()) && (m_minimumQueue.back().latency >= sample.latency)) {
+            m_minimumQueue.pop_back();
+        }
+
+        while ((!m_maximumQueue.empty()) && (m_maximumQueue.back().latency <= sample.latency)) {
+            m_maximumQueue.pop_back();
+        }
+
+        m_minimumQueue.push_back(sample);
+        m_maximumQueue.push_back(sample);
+
+        m_replyCount++;
+        m_latencySum += sample.latency;
+    }
+
+    m_samples.push_back(sample);
+
+    evict();
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::evict() -> void {
+    while ((!m_samples.empty()) && (m_samples.front().time < m_latestTime - m_windowSize)) {
+        auto sample = m_samples.front();
+
+        if (sample.latency == NoReply) {
+            m_lostCount--;
+        } else {
+            m_replyCount--;
+            m_latencySum -= sample.latency;
+
+            if ((!m_minimumQueue.empty()) && (m_minimumQueue.front().sequence == sample.sequence)) {
+                m_minimumQueue.pop_front();
+            }
+
+            if ((!m_maximumQueue.empty()) && (m_maximumQueue.front().sequence == sample.sequence)) {
+                m_maximumQueue.pop_front();
+            }
+        }
+
+        m_samples.pop_front();
+    }
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::clear() -> void {
+    m_samples.clear();
+    m_minimumQueue.clear();
+    m_maximumQueue.clear();
+
+    m_latestTime = 0;
+    m_replyCount = 0;
+    m_lostCount = 0;
+    m_latencySum = 0;
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::minimum() const -> double {
+    if (m_minimumQueue.empty()) {
+        return -1;
+    }
+
+    return static_cast<double>(m_minimumQueue.front().latency) / MicrosecondsPerSecond;
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::maximum() const -> double {
+    if (m_maximumQueue.empty()) {
+        return -1;
+    }
+
+    return static_cast<double>(m_maximumQueue.front().latency) / MicrosecondsPerSecond;
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::average() const -> double {
+    if (m_replyCount == 0) {
+        return -1;
+    }
+
+    return static_cast<double>(m_latencySum) / static_cast<double>(m_replyCount) / MicrosecondsPerSecond;
+}
+
+auto Nedrysoft::RouteAnalyser::WindowedStatistics::packetLoss() const -> double {
+    if (m_replyCount + m_lostCount == 0) {
+        return -1;
+    }
+
+    return (static_cast<double>(m_lostCount) / static_cast<double>(m_replyCount + m_lostCount)) * 100.0;
+}
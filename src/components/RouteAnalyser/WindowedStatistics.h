@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PINGNOO_COMPONENTS_ROUTEANALYSER_WINDOWEDSTATISTICS_H
+#define PINGNOO_COMPONENTS_ROUTEANALYSER_WINDOWEDSTATISTICS_H
+
+#include <cstdint>
+#include <deque>
+
+namespace Nedrysoft { namespace RouteAnalyser {
+    /**
+     * @brief       The WindowedStatistics class maintains latency statistics over a sliding time window.
+     *
+     * @details     Samples are held in a queue ordered by time and are evicted once they fall outside the window.
+     *              The minimum and maximum are tracked with monotonic queues, the sum of the latencies is held in
+     *              whole microseconds so that evicting a sample subtracts exactly what was added, so adding a sample
+     *              is O(1) amortised and the statistics can be read at any time without scanning the window.
+     */
+    class WindowedStatistics {
+        public:
+            /**
+             * @brief       Constructs a WindowedStatistics.
+             *
+             * @param[in]   windowSize the size of the window in seconds.
+             */
+            explicit WindowedStatistics(double windowSize = 60);
+
+            /**
+             * @brief       Sets the size of the window.
+             *
+             * @note        Reducing the size evicts samples immediately, increasing the size does not restore samples
+             *              that have already been evicted.
+             *
+             * @param[in]   windowSize the size of the window in seconds.
+             */
+            auto setWindowSize(double windowSize) -> void;
+
+            /**
+             * @brief       Returns the size of the window.
+             *
+             * @returns     the size of the window in seconds.
+             */
+            auto windowSize() const -> double;
+
+            /**
+             * @brief       Adds a sample to the window.
+             *
+             * @note        Samples are expected in time order, a sample that arrives late does not move the window
+             *              back and is evicted once the samples that were added before it have been evicted.
+             *
+             * @param[in]   time the time of the sample in seconds.
+             * @param[in]   latency the round trip time in seconds; -1 if the request was not replied to.
+             */
+            auto add(double time, double latency) -> void;
+
+            /**
+             * @brief       Removes all samples from the window.
+             */
+            auto clear() -> void;
+
+            /**
+             * @brief       Returns the minimum latency in the window.
+             *
+             * @returns     the latency in seconds if any replies are in the window; otherwise -1.
+             */
+            auto minimum() const -> double;
+
+            /**
+             * @brief       Returns the maximum latency in the window.
+             *
+             * @returns     the latency in seconds if any replies are in the window; otherwise -1.
+             */
+            auto maximum() const -> double;
+
+            /**
+             * @brief       Returns the average latency in the window.
+             *
+             * @returns     the latency in seconds if any replies are in the window; otherwise -1.
+             */
+            auto average() const -> double;
+
+            /**
+             * @brief       Returns the packet loss % in the window.
+             *
+             * @returns     the packet loss if any samples are in the window; otherwise -1.
+             */
+            auto packetLoss() const -> double;
+
+        private:
+            /**
+             * @brief       Evicts samples which are outside of the window.
+             */
+            auto evict() -> void;
+
+        private:
+            //! @cond
+
+            /**
+             * @brief       A sample in the window.
+             */
+            struct Sample {
+                uint64_t sequence;
+                double time;
+                int64_t latency;
+            };
+
+            std::deque<Sample> m_samples;
+            std::deque<Sample> m_minimumQueue;
+            std::deque<Sample> m_maximumQueue;
+
+            double m_windowSize;
+            double m_latestTime;
+            uint64_t m_sequence;
+            uint64_t m_replyCount;
+            uint64_t m_lostCount;
+            int64_t m_latencySum;
+
+            //! @endcond
+    };
+}}
+
+#endif // PINGNOO_COMPONENTS_ROUTEANALYSER_WINDOWEDSTATISTICS_H
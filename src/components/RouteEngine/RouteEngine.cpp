@@ -35,10 +35,19 @@
 
 Nedrysoft::RouteEngine::RouteEngine::RouteEngine() :
         m_routeWorkerThread(nullptr),
-        m_routeWorker(nullptr) {
+        m_routeWorker(nullptr),
+        m_pathMTUDiscoveryEnabled(false) {
 
 }
 
+auto Nedrysoft::RouteEngine::RouteEngine::setPathMTUDiscoveryEnabled(bool enabled) -> void {
+    m_pathMTUDiscoveryEnabled = enabled;
+}
+
+auto Nedrysoft::RouteEngine::RouteEngine::setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void {
+    m_payload = payload;
+}
+
 auto Nedrysoft::RouteEngine::RouteEngine::findRoute(
         Nedrysoft::RouteAnalyser::IPingEngineFactory *engineFactory,
         QString host,
@@ -46,6 +55,9 @@ auto Nedrysoft::RouteEngine::RouteEngine::findRoute(
 
     m_routeWorker = new Nedrysoft::RouteEngine::RouteEngineWorker(host, engineFactory, ipVersion);
 
+    m_routeWorker->setPathMTUDiscoveryEnabled(m_pathMTUDiscoveryEnabled);
+    m_routeWorker->setPayload(m_payload);
+
     m_routeWorkerThread = new QThread();
 
     m_routeWorker->moveToThread(m_routeWorkerThread);
@@ -68,5 +80,10 @@ auto Nedrysoft::RouteEngine::RouteEngine::findRoute(
             this,
             &Nedrysoft::RouteEngine::RouteEngine::result );
 
+    connect(m_routeWorker,
+            &Nedrysoft::RouteEngine::RouteEngineWorker::pathMTUResult,
+            this,
+            &Nedrysoft::RouteEngine::RouteEngine::pathMTUResult );
+
     m_routeWorkerThread->start();
 }
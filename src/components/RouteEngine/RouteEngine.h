@@ -78,11 +78,31 @@ namespace Nedrysoft { namespace RouteEngine {
                     Nedrysoft::Core::IPVersion ipVersion = Nedrysoft::Core::IPVersion::V4
             ) -> void override;
 
+            /**
+             * @brief       Sets whether the path MTU to each hop is discovered once the route has been found.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IRouteEngine::setPathMTUDiscoveryEnabled
+             *
+             * @param[in]   enabled true if path MTU discovery is enabled; otherwise false.
+             */
+            auto setPathMTUDiscoveryEnabled(bool enabled) -> void override;
+
+            /**
+             * @brief       Sets the payload carried by the probes that discover the route.
+             *
+             * @see         Nedrysoft::RouteAnalyser::IRouteEngine::setPayload
+             *
+             * @param[in]   payload the payload.
+             */
+            auto setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void override;
+
         private:
             //! @cond
 
             Nedrysoft::RouteEngine::RouteEngineWorker *m_routeWorker;
             QThread *m_routeWorkerThread;
+            bool m_pathMTUDiscoveryEnabled;
+            Nedrysoft::RouteAnalyser::PingPayload m_payload;
 
             //! @endcond
     };
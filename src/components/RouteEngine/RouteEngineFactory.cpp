@@ -86,6 +86,12 @@ auto Nedrysoft::RouteEngine::RouteEngineFactory::description() -> QString {
 
 auto Nedrysoft::RouteEngine::RouteEngineFactory::priority() -> double {
 #if defined(Q_OS_LINUX)
+    // route discovery can use unprivileged datagram sockets, which also report time exceeded errors.
+
+    if (Nedrysoft::ICMPSocket::ICMPSocket::datagramSocketsAvailable()) {
+        return 1;
+    }
+
     auto socket = Nedrysoft::ICMPSocket::ICMPSocket::createReadSocket(Nedrysoft::ICMPSocket::V4);
 
     if (socket) {
@@ -40,10 +40,21 @@ Nedrysoft::RouteEngine::RouteEngineWorker::RouteEngineWorker(
             m_ipVersion(ipVersion),
             m_pingEngineFactory(pingEngineFactory),
             m_isRunning(false),
-            m_maximumHops(MaxRouteHops) {
+            m_maximumHops(MaxRouteHops),
+            m_pathMTUDiscoveryEnabled(false) {
 
 }
 
+auto Nedrysoft::RouteEngine::RouteEngineWorker::setPathMTUDiscoveryEnabled(bool enabled) -> void {
+    m_pathMTUDiscoveryEnabled = enabled;
+}
+
+auto Nedrysoft::RouteEngine::RouteEngineWorker::setPayload(
+        const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void {
+
+    m_payload = payload;
+}
+
 Nedrysoft::RouteEngine::RouteEngineWorker::~RouteEngineWorker() {
     if (m_isRunning) {
         m_isRunning = false;
@@ -58,6 +69,8 @@ auto Nedrysoft::RouteEngine::RouteEngineWorker::doWork() -> void {
 
     auto pingEngine = m_pingEngineFactory->createEngine(m_ipVersion);
 
+    pingEngine->setPayload(m_payload);
+
     auto targetAddresses = QHostInfo::fromName(m_host).addresses();
 
     if (!targetAddresses.count()) {
@@ -118,6 +131,17 @@ auto Nedrysoft::RouteEngine::RouteEngineWorker::doWork() -> void {
     Q_EMIT result(targetAddresses[0], route, false, totalHops, m_maximumHops);
     Q_EMIT result(targetAddresses[0], route, true, totalHops, m_maximumHops);
 
+    if ((m_pathMTUDiscoveryEnabled) && (m_isRunning)) {
+        auto pathMTU = pingEngine->discoverPathMTU(targetAddresses[0], route, DefaultDiscoveryTimeout);
+
+        if (!pathMTU.isEmpty()) {
+            Q_EMIT pathMTUResult(targetAddresses[0], pathMTU);
+        } else {
+            SPDLOG_WARN(QString("Path MTU discovery to %1 could not be performed by the ping engine.")
+                .arg(targetAddresses[0].toString()).toStdString());
+        }
+    }
+
     m_pingEngineFactory->deleteEngine(pingEngine);
 
     this->deleteLater();
@@ -63,6 +63,20 @@ namespace Nedrysoft { namespace RouteEngine {
          */
         auto doWork() -> void;
 
+        /**
+         * @brief       Sets whether the path MTU to each hop is discovered once the route has been found.
+         *
+         * @param[in]   enabled true if path MTU discovery is enabled; otherwise false.
+         */
+        auto setPathMTUDiscoveryEnabled(bool enabled) -> void;
+
+        /**
+         * @brief       Sets the payload carried by the probes that discover the route.
+         *
+         * @param[in]   payload the payload.
+         */
+        auto setPayload(const Nedrysoft::RouteAnalyser::PingPayload &payload) -> void;
+
         /**
          * @brief       This signal is emitted when a route has finished discovery.
          *
@@ -81,6 +95,14 @@ namespace Nedrysoft { namespace RouteEngine {
             const int maximumHops
         );
 
+        /**
+         * @brief       This signal is emitted when path MTU discovery has completed.
+         *
+         * @param[in]   hostAddress the target that was requested.
+         * @param[in]   pathMTU the path MTU to each hop, -1 if the MTU could not be determined.
+         */
+        Q_SIGNAL void pathMTUResult(const QHostAddress hostAddress, const QList<int> pathMTU);
+
     private:
         //! @cond
 
@@ -90,6 +112,8 @@ namespace Nedrysoft { namespace RouteEngine {
 
         int m_maximumHops;
         bool m_isRunning;
+        bool m_pathMTUDiscoveryEnabled;
+        Nedrysoft::RouteAnalyser::PingPayload m_payload;
 
         //! @endcond
     };
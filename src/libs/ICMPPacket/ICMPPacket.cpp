@@ -87,15 +87,129 @@ struct icmp_v6 {
     struct icmp icmp;
 };
 
+/**
+ * @private
+ */
+struct ipv4_pseudo_header {
+    uint32_t sourceAddress;
+    uint32_t destinationAddress;
+    uint8_t zero;
+    uint8_t protocol;
+    uint16_t length;
+};
+
+/**
+ * @private
+ */
+struct tcp_header {
+    uint16_t sourcePort;
+    uint16_t destinationPort;
+    uint32_t sequenceNumber;
+    uint32_t acknowledgementNumber;
+    uint8_t dataOffset;
+    uint8_t flags;
+    uint16_t window;
+    uint16_t checksum;
+    uint16_t urgentPointer;
+};
+
 constexpr auto ICMP6_ECHO = 128;
 constexpr auto ICMP6_ECHO_REPLY = 129;
+constexpr auto ICMP6_PACKET_TOO_BIG = 2;
+constexpr auto ICMP6_TIME_EXCEEDED = 3;
+
+constexpr auto ICMP_DESTINATION_UNREACHABLE = 3;
+constexpr auto ICMP_PORT_UNREACHABLE = 3;
+constexpr auto ICMP_FRAGMENTATION_NEEDED = 4;
+
+constexpr auto TCP_SYN = 0x02;
+constexpr auto TCP_RST = 0x04;
+constexpr auto TCP_ACK = 0x10;
+constexpr auto TCP_DATA_OFFSET_SHIFT = 4;
+constexpr auto TCP_WINDOW_SIZE = 64240;
+
+constexpr unsigned int IP_HEADER_LENGTH_MASK = 0x0F;
+
+/**
+ * @private
+ *
+ * @brief       Decodes the probe quoted by an ICMPv4 error message.
+ *
+ * @details     ICMP error messages quote the ip header and at least the first 8 bytes of the probe, this is enough
+ *              to recover the id and sequence of an echo request, the ports of a UDP datagram or the sequence number
+ *              of a TCP segment.
+ *
+ * @param[in]   quoteSpan the data starting at the quoted ip header.
+ * @param[out]  protocol the protocol of the quoted probe.
+ * @param[out]  id the id of the quoted probe.
+ * @param[out]  sequence the sequence of the quoted probe.
+ *
+ * @returns     true if the quote was decoded; otherwise false.
+ */
+static auto decodeQuotedProbe_v4(
+        gsl::span<const unsigned char> quoteSpan,
+        Nedrysoft::ICMPPacket::Protocol &protocol,
+        uint16_t &id,
+        uint16_t &sequence) -> bool {
+
+    constexpr unsigned int IP_PROTOCOL_OFFSET = 9;
+    constexpr unsigned int MINIMUM_IP_HEADER_SIZE = 20;
+    constexpr unsigned int QUOTED_PROBE_SIZE = 8;
+    constexpr unsigned int UDP_SOURCE_PORT_OFFSET = 0;
+    constexpr unsigned int UDP_DESTINATION_PORT_OFFSET = 2;
+    constexpr unsigned int SEQUENCE_HIGH_OFFSET = 4;
+    constexpr unsigned int SEQUENCE_LOW_OFFSET = 6;
+
+    if (quoteSpan.size() < MINIMUM_IP_HEADER_SIZE) {
+        return false;
+    }
+
+    unsigned int ip_header_size = ( quoteSpan[0] & IP_HEADER_LENGTH_MASK ) * sizeof(uint32_t);
+
+    if (quoteSpan.size() < ip_header_size + QUOTED_PROBE_SIZE) {
+        return false;
+    }
+
+    auto probe = quoteSpan.subspan(ip_header_size).data();
+
+    switch(quoteSpan[IP_PROTOCOL_OFFSET]) {
+        case Nedrysoft::ICMPPacket::UDP: {
+            // the source port identifies the target and the destination port identifies the sequence
+
+            id = qFromBigEndian<uint16_t>(probe + UDP_SOURCE_PORT_OFFSET);
+            sequence = qFromBigEndian<uint16_t>(probe + UDP_DESTINATION_PORT_OFFSET);
+
+            protocol = Nedrysoft::ICMPPacket::UDP;
+
+            return true;
+        }
+
+        case Nedrysoft::ICMPPacket::TCP:
+        case Nedrysoft::ICMPPacket::ICMP: {
+            // the tcp sequence number and the icmp id/sequence fields occupy the same bytes of the quote
+
+            id = qFromBigEndian<uint16_t>(probe + SEQUENCE_HIGH_OFFSET);
+            sequence = qFromBigEndian<uint16_t>(probe + SEQUENCE_LOW_OFFSET);
+
+            protocol = static_cast<Nedrysoft::ICMPPacket::Protocol>(quoteSpan[IP_PROTOCOL_OFFSET]);
+
+            return true;
+        }
+
+        default: {
+            return false;
+        }
+    }
+}
 
 Nedrysoft::ICMPPacket::ICMPPacket::ICMPPacket() :
         m_resultCode(Invalid),
         m_id(0),
         m_sequence(0),
         m_ipVersion(Unknown),
-        m_ttl(-1) {
+        m_ttl(-1),
+        m_mtu(-1),
+        m_protocol(ICMP) {
 
 }
 
@@ -104,12 +218,16 @@ Nedrysoft::ICMPPacket::ICMPPacket::ICMPPacket(
         uint16_t sequence,
         ResultCode resultCode,
         IPVersion ipVersion,
-        int ttl ) :
+        int ttl,
+        int mtu,
+        Protocol protocol ) :
             m_resultCode(resultCode),
             m_id(id),
             m_sequence(sequence),
             m_ipVersion(ipVersion),
-            m_ttl(ttl) {
+            m_ttl(ttl),
+            m_mtu(mtu),
+            m_protocol(protocol) {
 
 }
 
@@ -128,12 +246,11 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::fromData(
 
 auto Nedrysoft::ICMPPacket::ICMPPacket::fromData_v4(const QByteArray &dataBuffer) -> Nedrysoft::ICMPPacket::ICMPPacket {
     unsigned char ip_vhl;
-    unsigned char ip_vhl_tx;
     unsigned char ip_header_size;
-    unsigned char ip_header_size_tx;
     uint16_t received_id;
     uint16_t received_sequence;
-    constexpr unsigned int IP_HEADER_LENGTH_MASK = 0x0F;
+    Nedrysoft::ICMPPacket::Protocol received_protocol;
+    constexpr unsigned int IP_HEADER_OFFSET = 0x08;
 
     auto mainSpan = gsl::span<const unsigned char>(
             reinterpret_cast<const unsigned char *>(dataBuffer.data()),
@@ -142,14 +259,17 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::fromData_v4(const QByteArray &dataBuffer
     ip_vhl = mainSpan[0];
     ip_header_size = ( ip_vhl & IP_HEADER_LENGTH_MASK ) * sizeof(uint32_t);
 
+    if (mainSpan.size() < ip_header_size + IP_HEADER_OFFSET) {
+        return ICMPPacket();
+    }
+
     auto responseSpan = mainSpan.subspan(ip_header_size);
 
     auto icmp_response = reinterpret_cast<const struct icmp *>(responseSpan.data());
+    auto ip_response = reinterpret_cast<const struct ip *>(dataBuffer.data());
 
     if (icmp_response->icmp_code == ICMP_ECHOREPLY) {
         if (icmp_response->icmp_type == ICMP_ECHOREPLY) {
-            auto ip_response = reinterpret_cast<const struct ip *>(dataBuffer.data());
-
             received_id = qFromBigEndian<uint16_t>(icmp_response->icmp_hun.ih_idseq.icd_id);
             received_sequence = qFromBigEndian<uint16_t>(icmp_response->icmp_hun.ih_idseq.icd_seq);
 
@@ -157,20 +277,176 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::fromData_v4(const QByteArray &dataBuffer
         }
 
         if (icmp_response->icmp_type == ICMP_TIMXCEED) {
-            constexpr unsigned int IP_HEADER_OFFSET = 0x08;
+            if (!decodeQuotedProbe_v4(
+                    responseSpan.subspan(IP_HEADER_OFFSET),
+                    received_protocol,
+                    received_id,
+                    received_sequence )) {
 
-            ip_vhl_tx = mainSpan[ip_header_size + IP_HEADER_OFFSET];
-            ip_header_size_tx = ( ip_vhl_tx & IP_HEADER_LENGTH_MASK ) * sizeof(uint32_t);
+                return ICMPPacket();
+            }
 
-            auto receivedRequestSpan = mainSpan.subspan(ip_header_size + IP_HEADER_OFFSET + ip_header_size_tx);
+            return ICMPPacket(received_id, received_sequence, TimeExceeded, V4, -1, -1, received_protocol);
+        }
+    }
 
-            auto received_icmp_request = reinterpret_cast<const struct icmp *>(receivedRequestSpan.data());
+    if (icmp_response->icmp_type == ICMP_DESTINATION_UNREACHABLE) {
+        if (!decodeQuotedProbe_v4(
+                responseSpan.subspan(IP_HEADER_OFFSET),
+                received_protocol,
+                received_id,
+                received_sequence )) {
 
-            received_id = qFromBigEndian<uint16_t>(received_icmp_request->icmp_hun.ih_idseq.icd_id);
+            return ICMPPacket();
+        }
 
-            received_sequence = qFromBigEndian<uint16_t>(received_icmp_request->icmp_hun.ih_idseq.icd_seq);
+        if (icmp_response->icmp_code == ICMP_FRAGMENTATION_NEEDED) {
+            int nextHopMtu = qFromBigEndian<uint16_t>(icmp_response->icmp_hun.ih_pmtu.ipm_nextmtu);
+
+            return ICMPPacket(
+                received_id,
+                received_sequence,
+                FragmentationNeeded,
+                V4,
+                -1,
+                nextHopMtu ? nextHopMtu : -1,
+                received_protocol
+            );
+        }
 
-            return ICMPPacket(received_id, received_sequence, TimeExceeded, V4, -1);
+        if (icmp_response->icmp_code == ICMP_PORT_UNREACHABLE) {
+            return ICMPPacket(
+                received_id,
+                received_sequence,
+                PortUnreachable,
+                V4,
+                ip_response->ip_ttl,
+                -1,
+                received_protocol
+            );
+        }
+    }
+
+    return ICMPPacket();
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::fromTCPData(
+        const QByteArray &dataBuffer,
+        Nedrysoft::ICMPPacket::IPVersion version) -> Nedrysoft::ICMPPacket::ICMPPacket {
+
+    constexpr unsigned int IP_TTL_OFFSET = 8;
+    unsigned int tcp_offset = 0;
+    int ttl = -1;
+
+    auto mainSpan = gsl::span<const unsigned char>(
+            reinterpret_cast<const unsigned char *>(dataBuffer.data()),
+            dataBuffer.length() );
+
+    if (version == Nedrysoft::ICMPPacket::V4) {
+        if (mainSpan.size() <= IP_TTL_OFFSET) {
+            return ICMPPacket();
+        }
+
+        tcp_offset = ( mainSpan[0] & IP_HEADER_LENGTH_MASK ) * sizeof(uint32_t);
+        ttl = mainSpan[IP_TTL_OFFSET];
+    } else if (version != Nedrysoft::ICMPPacket::V6) {
+        return ICMPPacket();
+    }
+
+    if (mainSpan.size() < tcp_offset + sizeof(tcp_header)) {
+        return ICMPPacket();
+    }
+
+    auto tcp_response = reinterpret_cast<const struct tcp_header *>(mainSpan.subspan(tcp_offset).data());
+
+    // a RST without ACK does not acknowledge the probe, so cannot be matched to it
+
+    if (!( tcp_response->flags & TCP_ACK )) {
+        return ICMPPacket();
+    }
+
+    ResultCode resultCode;
+
+    if (tcp_response->flags & TCP_RST) {
+        resultCode = Reset;
+    } else if (tcp_response->flags & TCP_SYN) {
+        resultCode = SynAck;
+    } else {
+        return ICMPPacket();
+    }
+
+    auto acknowledgedSequence = qFromBigEndian<uint32_t>(tcp_response->acknowledgementNumber) - 1;
+
+    return ICMPPacket(
+        static_cast<uint16_t>(acknowledgedSequence >> ( sizeof(uint16_t) * CHAR_BIT )),
+        static_cast<uint16_t>(acknowledgedSequence & UINT16_MAX),
+        resultCode,
+        version,
+        ttl,
+        -1,
+        TCP
+    );
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::fromDatagramData(
+        const QByteArray &dataBuffer,
+        Nedrysoft::ICMPPacket::IPVersion version) -> Nedrysoft::ICMPPacket::ICMPPacket {
+
+    if (version == Nedrysoft::ICMPPacket::V6) {
+        return fromData_v6(dataBuffer);
+    }
+
+    if (( version != Nedrysoft::ICMPPacket::V4 ) || ( dataBuffer.length() < static_cast<int>(sizeof(icmp_header)) )) {
+        return ICMPPacket();
+    }
+
+    auto icmp_response = reinterpret_cast<const struct icmp *>(dataBuffer.constData());
+
+    if (( icmp_response->icmp_type != ICMP_ECHOREPLY ) || ( icmp_response->icmp_code != 0 )) {
+        return ICMPPacket();
+    }
+
+    return ICMPPacket(
+        qFromBigEndian<uint16_t>(icmp_response->icmp_hun.ih_idseq.icd_id),
+        qFromBigEndian<uint16_t>(icmp_response->icmp_hun.ih_idseq.icd_seq),
+        EchoReply,
+        V4,
+        -1
+    );
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::fromSocketError(
+        const QByteArray &requestBuffer,
+        int type,
+        int code,
+        uint32_t info,
+        Nedrysoft::ICMPPacket::IPVersion version) -> Nedrysoft::ICMPPacket::ICMPPacket {
+
+    if (requestBuffer.length() < static_cast<int>(sizeof(icmp_header))) {
+        return ICMPPacket();
+    }
+
+    auto icmp_request = reinterpret_cast<const struct icmp *>(requestBuffer.constData());
+
+    auto request_id = qFromBigEndian<uint16_t>(icmp_request->icmp_hun.ih_idseq.icd_id);
+    auto request_sequence = qFromBigEndian<uint16_t>(icmp_request->icmp_hun.ih_idseq.icd_seq);
+    auto nextHopMtu = info ? static_cast<int>(info) : -1;
+
+    if (version == Nedrysoft::ICMPPacket::V4) {
+        if (type == ICMP_TIMXCEED) {
+            return ICMPPacket(request_id, request_sequence, TimeExceeded, V4, -1);
+        }
+
+        if (( type == ICMP_DESTINATION_UNREACHABLE ) && ( code == ICMP_FRAGMENTATION_NEEDED )) {
+            return ICMPPacket(request_id, request_sequence, FragmentationNeeded, V4, -1, nextHopMtu);
+        }
+    } else if (version == Nedrysoft::ICMPPacket::V6) {
+        if (type == ICMP6_TIME_EXCEEDED) {
+            return ICMPPacket(request_id, request_sequence, TimeExceeded, V6, -1);
+        }
+
+        if (type == ICMP6_PACKET_TOO_BIG) {
+            return ICMPPacket(request_id, request_sequence, FragmentationNeeded, V6, -1, nextHopMtu);
         }
     }
 
@@ -178,6 +454,8 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::fromData_v4(const QByteArray &dataBuffer
 }
 
 auto Nedrysoft::ICMPPacket::ICMPPacket::fromData_v6(const QByteArray &dataBuffer) -> Nedrysoft::ICMPPacket::ICMPPacket {
+    constexpr unsigned int QUOTED_PROBE_SIZE = 8;
+    constexpr unsigned int QUOTED_ERROR_SIZE = sizeof(icmp_header) + sizeof(ipv6_header) + QUOTED_PROBE_SIZE;
     uint16_t received_id;
     uint16_t received_sequence;
 
@@ -185,6 +463,10 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::fromData_v6(const QByteArray &dataBuffer
             reinterpret_cast<const unsigned char *>(dataBuffer.data()),
             dataBuffer.length() );
 
+    if (responseSpan.size() < sizeof(icmp_header)) {
+        return ICMPPacket();
+    }
+
     auto icmp_response = reinterpret_cast<const struct icmp *>(responseSpan.data());
 
     if (icmp_response->icmp_code == 0) {
@@ -195,7 +477,30 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::fromData_v6(const QByteArray &dataBuffer
             return ICMPPacket(received_id, received_sequence, EchoReply, V6, -1);
         }
 
-        if (icmp_response->icmp_type == 3) {
+        // error messages quote the ip header and the start of the probe, which holds the id and sequence.
+
+        auto isError = ( icmp_response->icmp_type == ICMP6_PACKET_TOO_BIG ) ||
+                       ( icmp_response->icmp_type == ICMP6_TIME_EXCEEDED );
+
+        if (( isError ) && ( responseSpan.size() < QUOTED_ERROR_SIZE )) {
+            return ICMPPacket();
+        }
+
+        if (icmp_response->icmp_type == ICMP6_PACKET_TOO_BIG) {
+            auto request_icmp_header = responseSpan.subspan(sizeof(icmp_header) + sizeof(ipv6_header));
+
+            auto rx_icmp_request = reinterpret_cast<const struct icmp *>(request_icmp_header.data());
+            auto packet_too_big = reinterpret_cast<const struct icmp_header *>(responseSpan.data());
+
+            received_id = qFromBigEndian<uint16_t>(rx_icmp_request->icmp_hun.ih_idseq.icd_id);
+            received_sequence = qFromBigEndian<uint16_t>(rx_icmp_request->icmp_hun.ih_idseq.icd_seq);
+
+            auto nextHopMtu = static_cast<int>(qFromBigEndian<uint32_t>(packet_too_big->reserved));
+
+            return ICMPPacket(received_id, received_sequence, FragmentationNeeded, V6, -1, nextHopMtu);
+        }
+
+        if (icmp_response->icmp_type == ICMP6_TIME_EXCEEDED) {
             auto ip_response = reinterpret_cast<const struct ipv6_header *>(dataBuffer.data());
             auto request_icmp_header = responseSpan.subspan(sizeof(icmp_header) + sizeof(ipv6_header));
 
@@ -249,29 +554,122 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
         const QHostAddress &destinationAddress,
         Nedrysoft::ICMPPacket::IPVersion version) -> QByteArray {
 
+    return pingPacket(id, sequence, QByteArray(payloadLength, 0), destinationAddress, version);
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
+        uint16_t id,
+        uint16_t sequence,
+        const QByteArray &payload,
+        const QHostAddress &destinationAddress,
+        Nedrysoft::ICMPPacket::IPVersion version) -> QByteArray {
+
+    if (version == Nedrysoft::ICMPPacket::V4) {
+        return pingPacket_v4(id, sequence, payload, destinationAddress);
+    } else if (version == Nedrysoft::ICMPPacket::V6) {
+        return pingPacket_v6(id, sequence, payload, destinationAddress);
+    } else {
+        return QByteArray();
+    }
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::pingPacketOfSize(
+        uint16_t id,
+        uint16_t sequence,
+        int packetSize,
+        const QHostAddress &destinationAddress,
+        Nedrysoft::ICMPPacket::IPVersion version) -> QByteArray {
+
+    int headerSize;
+
     if (version == Nedrysoft::ICMPPacket::V4) {
-        return pingPacket_v4(id, sequence, payloadLength, destinationAddress);
+        headerSize = sizeof(struct ip) + sizeof(icmp_header);
     } else if (version == Nedrysoft::ICMPPacket::V6) {
-        return pingPacket_v6(id, sequence, payloadLength, destinationAddress);
+        headerSize = sizeof(ipv6_header) + sizeof(icmp_header);
     } else {
         return QByteArray();
     }
+
+    if (packetSize < headerSize) {
+        return QByteArray();
+    }
+
+    return pingPacket(id, sequence, packetSize - headerSize, destinationAddress, version);
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::tcpSynPacket(
+        uint16_t id,
+        uint16_t sequence,
+        uint16_t destinationPort,
+        const QHostAddress &sourceAddress,
+        const QHostAddress &destinationAddress,
+        Nedrysoft::ICMPPacket::IPVersion version) -> QByteArray {
+
+    struct tcp_header synHeader = {};
+    QByteArray checksumBuffer;
+
+    synHeader.sourcePort = qToBigEndian<uint16_t>(id);
+    synHeader.destinationPort = qToBigEndian<uint16_t>(destinationPort);
+    synHeader.sequenceNumber = qToBigEndian<uint32_t>(Nedrysoft::Utils::fzMake32(id, sequence));
+    synHeader.dataOffset = ( sizeof(tcp_header) / sizeof(uint32_t) ) << TCP_DATA_OFFSET_SHIFT;
+    synHeader.flags = TCP_SYN;
+    synHeader.window = qToBigEndian<uint16_t>(TCP_WINDOW_SIZE);
+
+    if (version == Nedrysoft::ICMPPacket::V4) {
+        struct ipv4_pseudo_header pseudoHeader = {};
+
+        pseudoHeader.sourceAddress = qToBigEndian<uint32_t>(sourceAddress.toIPv4Address());
+        pseudoHeader.destinationAddress = qToBigEndian<uint32_t>(destinationAddress.toIPv4Address());
+        pseudoHeader.protocol = Nedrysoft::ICMPPacket::TCP;
+        pseudoHeader.length = qToBigEndian<uint16_t>(sizeof(tcp_header));
+
+        checksumBuffer.append(reinterpret_cast<const char *>(&pseudoHeader), sizeof(pseudoHeader));
+    } else if (version == Nedrysoft::ICMPPacket::V6) {
+        struct ipv6_pseudo_header pseudoHeader = {};
+
+        auto sourceAddressRaw = sourceAddress.toIPv6Address();
+        auto destinationAddressRaw = destinationAddress.toIPv6Address();
+
+        memcpy(pseudoHeader.sourceAddress.s6_addr, &sourceAddressRaw, 16);
+        memcpy(pseudoHeader.destinationAddress.s6_addr, &destinationAddressRaw, 16);
+
+        pseudoHeader.packetLength = qToBigEndian<uint32_t>(sizeof(tcp_header));
+        pseudoHeader.nextHeader = Nedrysoft::ICMPPacket::TCP;
+
+        checksumBuffer.append(reinterpret_cast<const char *>(&pseudoHeader), sizeof(pseudoHeader));
+    } else {
+        return QByteArray();
+    }
+
+    checksumBuffer.append(reinterpret_cast<const char *>(&synHeader), sizeof(synHeader));
+
+    synHeader.checksum = Nedrysoft::ICMPPacket::ICMPPacket::checksum(checksumBuffer.data(), checksumBuffer.length());
+
+    return QByteArray(reinterpret_cast<const char *>(&synHeader), sizeof(synHeader));
 }
 
 auto Nedrysoft::ICMPPacket::ICMPPacket::pingPacket_v6(
         uint16_t id,
         uint16_t sequence,
-        int payloadLength,
+        const QByteArray &payload,
         const QHostAddress &destinationAddress) -> QByteArray {
 
-    QByteArray echoRequestBuffer(payloadLength + sizeof(icmp_v6), 0);
+    auto payloadLength = static_cast<int>(payload.size());
+    // struct icmp includes the fields of other message types, only the echo header precedes the payload.
+
+    QByteArray echoRequestBuffer(payloadLength + sizeof(ipv6_pseudo_header) + sizeof(icmp_header), 0);
     auto echoRequestLength = static_cast<int>(echoRequestBuffer.size());
     auto icmp_v6 = reinterpret_cast<struct icmp_v6 *>(echoRequestBuffer.data());
     auto icmp_request = &icmp_v6->icmp;
 
     memset(echoRequestBuffer.data(), 0, echoRequestBuffer.size());
+    memcpy(
+        echoRequestBuffer.data() + sizeof(ipv6_pseudo_header) + sizeof(icmp_header),
+        payload.constData(),
+        payloadLength
+    );
 
-    icmp_v6->header.packetLength = sizeof(icmp) + payloadLength;
+    icmp_v6->header.packetLength = sizeof(icmp_header) + payloadLength;
     icmp_v6->header.nextHeader = IPPROTO_ICMPV6;
 
     icmp_v6->header.sourceAddress.s6_addr[15] = 1;
@@ -294,15 +692,19 @@ auto Nedrysoft::ICMPPacket::ICMPPacket::pingPacket_v6(
 auto Nedrysoft::ICMPPacket::ICMPPacket::pingPacket_v4(
         uint16_t id,
         uint16_t sequence,
-        int payloadLength,
+        const QByteArray &payload,
         const QHostAddress &destinationAddress) -> QByteArray {
 
     Q_UNUSED(destinationAddress)
 
-    QByteArray echoRequestBuffer(payloadLength + sizeof(icmp), 0);
+    // struct icmp includes the fields of other message types, only the echo header precedes the payload.
+
+    QByteArray echoRequestBuffer(payload.size() + sizeof(icmp_header), 0);
     auto echoRequestLength = static_cast<int>(echoRequestBuffer.size());
     auto icmp_request = reinterpret_cast<icmp *>(echoRequestBuffer.data());
 
+    memcpy(echoRequestBuffer.data() + sizeof(icmp_header), payload.constData(), payload.size());
+
     icmp_request->icmp_type = ICMP_ECHO;
     icmp_request->icmp_code = 0;
     icmp_request->icmp_cksum = 0;
@@ -349,6 +751,22 @@ Nedrysoft::ICMPPacket::ICMPPacket::operator std::string() {
             resultCodeString = "Time Exceeded";
             break;
         }
+        case FragmentationNeeded: {
+            resultCodeString = QString("Fragmentation Needed (MTU=%1)").arg(m_mtu);
+            break;
+        }
+        case PortUnreachable: {
+            resultCodeString = "Port Unreachable";
+            break;
+        }
+        case SynAck: {
+            resultCodeString = "SYN-ACK";
+            break;
+        }
+        case Reset: {
+            resultCodeString = "Reset";
+            break;
+        }
 
         default: {
             resultCodeString = QString("Unknown (%1)").arg(m_resultCode);
@@ -367,4 +785,12 @@ Nedrysoft::ICMPPacket::ICMPPacket::operator std::string() {
 
 auto Nedrysoft::ICMPPacket::ICMPPacket::ttl() -> int {
     return m_ttl;
-}
\ No newline at end of file
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::mtu() -> int {
+    return m_mtu;
+}
+
+auto Nedrysoft::ICMPPacket::ICMPPacket::protocol() -> Nedrysoft::ICMPPacket::Protocol {
+    return m_protocol;
+}
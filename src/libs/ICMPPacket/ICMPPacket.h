@@ -51,7 +51,20 @@ namespace Nedrysoft { namespace ICMPPacket {
     enum ResultCode {
         Invalid = 0,
         EchoReply = 1,
-        TimeExceeded = 2
+        TimeExceeded = 2,
+        FragmentationNeeded = 3,
+        PortUnreachable = 4,
+        SynAck = 5,
+        Reset = 6
+    };
+
+    /**
+     * @brief       The transport protocol of a probe, the values match the IP protocol numbers.
+     */
+    enum Protocol {
+        ICMP = 1,
+        TCP = 6,
+        UDP = 17
     };
 
     /**
@@ -69,6 +82,55 @@ namespace Nedrysoft { namespace ICMPPacket {
              */
             static auto fromData(const QByteArray &dataBuffer, IPVersion version) -> ICMPPacket;
 
+            /**
+             * @brief       Creates a packet from a raw TCP segment received in response to a TCP SYN probe.
+             *
+             * @details     A SYN-ACK or RST from the target acknowledges the sequence number of the probe, the id
+             *              and sequence are recovered from the acknowledgement number.
+             *
+             * @note        IPv4 raw sockets deliver the IP header in front of the segment, IPv6 raw sockets do not.
+             *
+             * @param[in]   dataBuffer the raw tcp segment.
+             * @param[in]   version version of IP of the socket the segment was received on.
+             *
+             * @returns     the decoded packet.
+             */
+            static auto fromTCPData(const QByteArray &dataBuffer, IPVersion version) -> ICMPPacket;
+
+            /**
+             * @brief       Creates an ICMP packet from data read from an unprivileged ICMP datagram socket.
+             *
+             * @note        Datagram sockets deliver the ICMP message without the IP header for both IP versions.
+             *
+             * @param[in]   dataBuffer the raw icmp message.
+             * @param[in]   version version of ICMP packet we are expecting.
+             *
+             * @returns     the decoded packet.
+             */
+            static auto fromDatagramData(const QByteArray &dataBuffer, IPVersion version) -> ICMPPacket;
+
+            /**
+             * @brief       Creates an ICMP packet from an error read from the error queue of a datagram socket.
+             *
+             * @details     The error queue returns the probe that caused the error along with the ICMP type and
+             *              code of the error, the id and sequence are recovered from the probe.
+             *
+             * @param[in]   requestBuffer the probe that caused the error, starting at the ICMP header.
+             * @param[in]   type the ICMP type of the error.
+             * @param[in]   code the ICMP code of the error.
+             * @param[in]   info the next hop MTU if the error was a fragmentation needed message.
+             * @param[in]   version version of ICMP packet we are expecting.
+             *
+             * @returns     the decoded packet.
+             */
+            static auto fromSocketError(
+                const QByteArray &requestBuffer,
+                int type,
+                int code,
+                uint32_t info,
+                IPVersion version
+            ) -> ICMPPacket;
+
             /**
              * @brief       Calculate ICMP crc16 from raw data.
              *
@@ -100,6 +162,76 @@ namespace Nedrysoft { namespace ICMPPacket {
                 Nedrysoft::ICMPPacket::IPVersion version
             ) -> QByteArray;
 
+            /**
+             * @brief       Create a ping request packet which is a given size once the IP header is added.
+             *
+             * @details     Path MTU probes must be exactly the size being tested on the wire, the IP header that
+             *              the operating system adds (without options) and the echo header are subtracted from
+             *              the size to find the length of the payload.
+             *
+             * @param[in]   id the packet id.
+             * @param[in]   sequence the packet sequence.
+             * @param[in]   packetSize the size of the IP packet in bytes.
+             * @param[in]   destinationAddress the address of the target.
+             * @param[in]   version the ip version of the icmp packet.
+             *
+             * @returns     a QByteArray containing the created raw packet; an empty QByteArray if the size is
+             *              smaller than the headers.
+             */
+            static auto pingPacketOfSize(
+                uint16_t id,
+                uint16_t sequence,
+                int packetSize,
+                const QHostAddress &destinationAddress,
+                Nedrysoft::ICMPPacket::IPVersion version
+            ) -> QByteArray;
+
+            /**
+             * @brief       Create a ping request packet with the given payload.
+             *
+             * @note        Depending on platform the id/sequence fields may be overwritten by the operating system.
+             *
+             * @param[in]   id the packet id.
+             * @param[in]   sequence the packet sequence.
+             * @param[in]   payload the payload to place after the icmp header.
+             * @param[in]   destinationAddress the address of the target.
+             * @param[in]   version the ip version of the icmp packet.
+             *
+             * @returns     a QByteArray containing the created raw packet.
+             */
+            static auto pingPacket(
+                uint16_t id,
+                uint16_t sequence,
+                const QByteArray &payload,
+                const QHostAddress &destinationAddress,
+                Nedrysoft::ICMPPacket::IPVersion version
+            ) -> QByteArray;
+
+            /**
+             * @brief       Create a TCP SYN segment for use as a probe.
+             *
+             * @details     The id and sequence of the probe are carried in the TCP sequence number so that they can
+             *              be recovered from the quote in an ICMP time exceeded message or from the acknowledgement
+             *              number of a SYN-ACK or RST sent by the target.
+             *
+             * @param[in]   id the probe id, also used as the source port.
+             * @param[in]   sequence the probe sequence.
+             * @param[in]   destinationPort the destination port of the segment.
+             * @param[in]   sourceAddress the local address used to calculate the checksum.
+             * @param[in]   destinationAddress the address of the target.
+             * @param[in]   version the ip version of the segment.
+             *
+             * @returns     a QByteArray containing the tcp segment, the operating system adds the ip header.
+             */
+            static auto tcpSynPacket(
+                uint16_t id,
+                uint16_t sequence,
+                uint16_t destinationPort,
+                const QHostAddress &sourceAddress,
+                const QHostAddress &destinationAddress,
+                Nedrysoft::ICMPPacket::IPVersion version
+            ) -> QByteArray;
+
             /**
              * @brief       Returns the result of a packet decode.
              *
@@ -128,6 +260,26 @@ namespace Nedrysoft { namespace ICMPPacket {
              */
             auto ttl() -> int;
 
+            /**
+             * @brief       The next hop MTU reported by a fragmentation needed (IPv4) or packet too big (IPv6) message.
+             *
+             * @note        Routers which predate RFC 1191 do not report the MTU, in which case the caller should
+             *              fall back to searching for the MTU.
+             *
+             * @returns     the reported MTU if available; otherwise -1.
+             */
+            auto mtu() -> int;
+
+            /**
+             * @brief       The protocol of the probe that this packet is a response to.
+             *
+             * @details     ICMP error messages quote the header of the probe that caused them, this allows the
+             *              response to be matched against probes of the same protocol only.
+             *
+             * @returns     the protocol of the probe.
+             */
+            auto protocol() -> Nedrysoft::ICMPPacket::Protocol;
+
             /**
              * @brief       Cast to std::string operator.
              *
@@ -149,8 +301,18 @@ namespace Nedrysoft { namespace ICMPPacket {
              * @param[in]   resultCode the initial result code.
              * @param[in]   ipVersion the IP version of the packet.
              * @param[in]   ttl the ttl of the response packet if available; otherwise false.
+             * @param[in]   mtu the next hop mtu if the packet was a fragmentation needed message; otherwise -1.
+             * @param[in]   protocol the protocol of the probe that the packet is a response to.
              */
-            ICMPPacket(uint16_t id, uint16_t sequence, ResultCode resultCode, IPVersion ipVersion, int ttl);
+            ICMPPacket(
+                uint16_t id,
+                uint16_t sequence,
+                ResultCode resultCode,
+                IPVersion ipVersion,
+                int ttl,
+                int mtu = -1,
+                Protocol protocol = ICMP
+            );
 
             /**
              * @brief       Decodes an ipv4 icmp packet for from raw data.
@@ -175,7 +337,7 @@ namespace Nedrysoft { namespace ICMPPacket {
              *
              * @param[in]   id the id to be used in the packet.
              * @param[in]   sequence  the sequence to be used in the packet.
-             * @param[in]   payLoadLength the payLoadLength to be used in the packet.
+             * @param[in]   payload the payload to be used in the packet.
              * @param[in]   destinationAddress the destination address of the ping.
              *
              * @returns     a QByteArray containing the raw ipv4 icmp packet.
@@ -183,7 +345,7 @@ namespace Nedrysoft { namespace ICMPPacket {
             static auto pingPacket_v6(
                 uint16_t id,
                 uint16_t sequence,
-                int payLoadLength,
+                const QByteArray &payload,
                 const QHostAddress &destinationAddress
             ) -> QByteArray;
 
@@ -192,7 +354,7 @@ namespace Nedrysoft { namespace ICMPPacket {
              *
              * @param[in]   id the id to be used in the packet.
              * @param[in]   sequence the sequence to be used in the packet.
-             * @param[in]   payLoadLength the payLoadLength to be used in the packet.
+             * @param[in]   payload the payload to be used in the packet.
              * @param[in]   destinationAddress the destination address of the ping.
              *
              * @returns     a QByteArray containing the raw ipv6 icmp packet.
@@ -200,7 +362,7 @@ namespace Nedrysoft { namespace ICMPPacket {
             static auto  pingPacket_v4(
                 uint16_t id,
                 uint16_t sequence,
-                int payLoadLength,
+                const QByteArray &payload,
                 const QHostAddress &destinationAddress
             ) -> QByteArray;
 
@@ -224,6 +386,8 @@ namespace Nedrysoft { namespace ICMPPacket {
             uint16_t m_sequence;
             IPVersion m_ipVersion;
             int m_ttl;
+            int m_mtu;
+            Protocol m_protocol;
 
             //! @endcond
     };
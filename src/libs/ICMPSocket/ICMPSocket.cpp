@@ -30,12 +30,19 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#if defined(Q_OS_LINUX)
+#include <linux/errqueue.h>
+#include <linux/filter.h>
+#endif
+
 #elif defined(Q_OS_WIN)
 #include <WS2tcpip.h>
 #include <WinSock2.h>
 #endif
 
 #include <QtEndian>
+#include <algorithm>
+#include <vector>
 
 #if defined(Q_OS_WIN)
 constexpr int SocketError = SOCKET_ERROR;
@@ -48,7 +55,8 @@ constexpr auto ReceiveBufferSize = 4096;
 Nedrysoft::ICMPSocket::ICMPSocket::ICMPSocket(Nedrysoft::ICMPSocket::ICMPSocket::socket_t socket, IPVersion version) :
         m_socketDescriptor(socket),
         m_version(version),
-        m_ttl(64) {
+        m_ttl(64),
+        m_datagram(false) {
 
 }
 
@@ -293,12 +301,21 @@ auto Nedrysoft::ICMPSocket::ICMPSocket::recvfrom(
 }
 
 auto Nedrysoft::ICMPSocket::ICMPSocket::sendto(QByteArray &buffer, const QHostAddress &hostAddress) -> int {
+    return sendto(buffer, hostAddress, 0);
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::sendto(
+        QByteArray &buffer,
+        const QHostAddress &hostAddress,
+        uint16_t port) -> int {
+
     if (m_version == V4) {
         struct sockaddr_in toAddress = {};
 
         memset(&toAddress, 0, sizeof(toAddress));
 
         toAddress.sin_family = AF_INET;
+        toAddress.sin_port = qToBigEndian<uint16_t>(port);
         toAddress.sin_addr.s_addr = qToBigEndian<uint32_t>(hostAddress.toIPv4Address());
 
         return ::sendto(m_socketDescriptor, buffer.data(), buffer.length(), 0,
@@ -309,6 +326,7 @@ auto Nedrysoft::ICMPSocket::ICMPSocket::sendto(QByteArray &buffer, const QHostAd
         auto destinationAddress = hostAddress.toIPv6Address();
 
         toAddress.sin6_family = AF_INET6;
+        toAddress.sin6_port = qToBigEndian<uint16_t>(port);
         memcpy(toAddress.sin6_addr.s6_addr, &destinationAddress, 16);
 
         return ::sendto(m_socketDescriptor, buffer.data(), buffer.length(), 0,
@@ -318,6 +336,430 @@ auto Nedrysoft::ICMPSocket::ICMPSocket::sendto(QByteArray &buffer, const QHostAd
     return -1;
 }
 
+auto Nedrysoft::ICMPSocket::ICMPSocket::localPort() -> uint16_t {
+#if defined(Q_OS_UNIX)
+    socklen_t addressLength;
+#elif defined(Q_OS_WIN)
+    int addressLength;
+#endif
+    struct sockaddr_storage localAddress = {};
+
+    addressLength = sizeof(localAddress);
+
+    if (getsockname(m_socketDescriptor, reinterpret_cast<sockaddr *>(&localAddress), &addressLength) == SocketError) {
+        return 0;
+    }
+
+    if (localAddress.ss_family == AF_INET) {
+        return qFromBigEndian<uint16_t>(reinterpret_cast<sockaddr_in *>(&localAddress)->sin_port);
+    } else if (localAddress.ss_family == AF_INET6) {
+        return qFromBigEndian<uint16_t>(reinterpret_cast<sockaddr_in6 *>(&localAddress)->sin6_port);
+    }
+
+    return 0;
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::createDatagramSocket(
+        int ttl,
+        Nedrysoft::ICMPSocket::IPVersion version ) -> Nedrysoft::ICMPSocket::ICMPSocket * {
+
+#if defined(Q_OS_LINUX)
+    Nedrysoft::ICMPSocket::ICMPSocket::socket_t socketDescriptor;
+    struct sockaddr_storage source = {};
+    int sourceLength;
+    int receiveErrors = 1;
+    int result;
+
+    initialiseSockets();
+
+    memset(&source, 0, sizeof(source));
+
+    if (version == Nedrysoft::ICMPSocket::V4) {
+        auto sourceAddress = reinterpret_cast<sockaddr_in *>(&source);
+
+        sourceAddress->sin_family = AF_INET;
+        sourceAddress->sin_addr.s_addr = qToBigEndian<uint32_t>(INADDR_ANY);
+
+        sourceLength = sizeof(sockaddr_in);
+
+        socketDescriptor = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_ICMP);
+    } else if (version == Nedrysoft::ICMPSocket::V6) {
+        auto sourceAddress = reinterpret_cast<sockaddr_in6 *>(&source);
+
+        sourceAddress->sin6_family = AF_INET6;
+        sourceAddress->sin6_addr = in6addr_any;
+
+        sourceLength = sizeof(sockaddr_in6);
+
+        socketDescriptor = socket(AF_INET6, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_ICMPV6);
+    } else {
+        qWarning() << QObject::tr("Unknown IP version");
+
+        return nullptr;
+    }
+
+    // failure is expected if the group of the user is outside of net.ipv4.ping_group_range, so no warning is given.
+
+    if (!isValid(socketDescriptor)) {
+        return nullptr;
+    }
+
+    auto socketInstance = new Nedrysoft::ICMPSocket::ICMPSocket(socketDescriptor, version);
+
+    socketInstance->m_datagram = true;
+
+    // binding to port 0 allocates the echo identifier that the kernel will use for this socket.
+
+    if (bind(socketDescriptor, reinterpret_cast<sockaddr *>(&source), sourceLength) == SocketError) {
+        qWarning() << QObject::tr("Error binding socket.");
+
+        delete socketInstance;
+
+        return nullptr;
+    }
+
+    if (version == Nedrysoft::ICMPSocket::V4) {
+        result = setsockopt(socketDescriptor, SOL_IP, IP_RECVERR, &receiveErrors, sizeof(receiveErrors));
+    } else {
+        result = setsockopt(socketDescriptor, SOL_IPV6, IPV6_RECVERR, &receiveErrors, sizeof(receiveErrors));
+    }
+
+    if (result == SocketError) {
+        qWarning() << QObject::tr("Error enabling ICMP error reporting on socket.");
+    }
+
+    if (ttl) {
+        if (version == V4) {
+            socketInstance->setTTL(ttl);
+        } else {
+            socketInstance->setHopLimit(ttl);
+        }
+    }
+
+    return socketInstance;
+#else
+    Q_UNUSED(ttl)
+    Q_UNUSED(version)
+
+    return nullptr;
+#endif
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::datagramSocketsAvailable() -> bool {
+    auto socket = createDatagramSocket(0, Nedrysoft::ICMPSocket::V4);
+
+    if (socket) {
+        delete socket;
+
+        return true;
+    }
+
+    return false;
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::recvError(
+        QByteArray &buffer,
+        QHostAddress &offenderAddress,
+        int &type,
+        int &code,
+        uint32_t &info) -> int {
+
+#if defined(Q_OS_LINUX)
+    constexpr auto ControlBufferSize = 512;
+    char controlBuffer[ControlBufferSize];
+    struct sockaddr_storage fromAddress = {};
+    struct iovec ioVector = {};
+    struct msghdr message = {};
+
+    buffer.resize(ReceiveBufferSize);
+
+    ioVector.iov_base = buffer.data();
+    ioVector.iov_len = buffer.length();
+
+    message.msg_name = &fromAddress;
+    message.msg_namelen = sizeof(fromAddress);
+    message.msg_iov = &ioVector;
+    message.msg_iovlen = 1;
+    message.msg_control = controlBuffer;
+    message.msg_controllen = sizeof(controlBuffer);
+
+    auto result = recvmsg(m_socketDescriptor, &message, MSG_ERRQUEUE | MSG_DONTWAIT);
+
+    if (result < 0) {
+        return -1;
+    }
+
+    buffer.resize(result);
+
+    for (auto controlMessage = CMSG_FIRSTHDR(&message);
+         controlMessage;
+         controlMessage = CMSG_NXTHDR(&message, controlMessage)) {
+
+        if (!(( controlMessage->cmsg_level == SOL_IP ) && ( controlMessage->cmsg_type == IP_RECVERR )) &&
+            !(( controlMessage->cmsg_level == SOL_IPV6 ) && ( controlMessage->cmsg_type == IPV6_RECVERR ))) {
+            continue;
+        }
+
+        auto socketError = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(controlMessage));
+
+        if (( socketError->ee_origin != SO_EE_ORIGIN_ICMP ) && ( socketError->ee_origin != SO_EE_ORIGIN_ICMP6 )) {
+            continue;
+        }
+
+        type = socketError->ee_type;
+        code = socketError->ee_code;
+        info = socketError->ee_info;
+
+        offenderAddress = QHostAddress(SO_EE_OFFENDER(socketError));
+
+        return static_cast<int>(result);
+    }
+
+    return -1;
+#else
+    Q_UNUSED(buffer)
+    Q_UNUSED(offenderAddress)
+    Q_UNUSED(type)
+    Q_UNUSED(code)
+    Q_UNUSED(info)
+
+    return -1;
+#endif
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::createUDPWriteSocket(
+        int ttl,
+        Nedrysoft::ICMPSocket::IPVersion version ) -> Nedrysoft::ICMPSocket::ICMPSocket * {
+
+    Nedrysoft::ICMPSocket::ICMPSocket::socket_t socketDescriptor;
+    struct sockaddr_storage source = {};
+    int sourceLength;
+
+    initialiseSockets();
+
+    memset(&source, 0, sizeof(source));
+
+    if (version == Nedrysoft::ICMPSocket::V4) {
+        auto sourceAddress = reinterpret_cast<sockaddr_in *>(&source);
+
+        sourceAddress->sin_family = AF_INET;
+        sourceAddress->sin_port = 0;
+        sourceAddress->sin_addr.s_addr = qToBigEndian<uint32_t>(INADDR_ANY);
+
+        sourceLength = sizeof(sockaddr_in);
+
+        socketDescriptor = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    } else if (version == Nedrysoft::ICMPSocket::V6) {
+        auto sourceAddress = reinterpret_cast<sockaddr_in6 *>(&source);
+
+        sourceAddress->sin6_family = AF_INET6;
+        sourceAddress->sin6_port = 0;
+        sourceAddress->sin6_addr = in6addr_any;
+
+        sourceLength = sizeof(sockaddr_in6);
+
+        socketDescriptor = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    } else {
+        qWarning() << QObject::tr("Unknown IP version");
+
+        return nullptr;
+    }
+
+    if (!isValid(socketDescriptor)) {
+        qWarning() << QObject::tr("Error creating socket descriptor.");
+
+        return nullptr;
+    }
+
+    auto socketInstance = new Nedrysoft::ICMPSocket::ICMPSocket(socketDescriptor, version);
+
+#if defined(Q_OS_UNIX)
+    auto result = fcntl(socketDescriptor, F_SETFL, fcntl(socketDescriptor, F_GETFL, 0) |
+                                                   O_NONBLOCK); // NOLINT(cppcoreguidelines-pro-type-vararg)
+
+    if (result < 0) {
+        qWarning() << QObject::tr("Error setting non blocking on socket");
+    }
+#elif defined(Q_OS_WIN)
+    int socketFlags = 1;
+
+    auto result = ioctlsocket(socketDescriptor, static_cast<long>(FIONBIO), reinterpret_cast<u_long *>(&socketFlags));
+
+    if (result == SocketError) {
+        qWarning() << QObject::tr("Error setting non blocking on socket");
+    }
+#endif
+
+    if (bind(socketDescriptor, reinterpret_cast<sockaddr *>(&source), sourceLength) == SocketError) {
+        qWarning() << QObject::tr("Error binding socket.");
+
+        delete socketInstance;
+
+        return nullptr;
+    }
+
+    if (ttl) {
+        if (version == V4) {
+            socketInstance->setTTL(ttl);
+        } else {
+            socketInstance->setHopLimit(ttl);
+        }
+    }
+
+    return socketInstance;
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::createTCPReadSocket(
+        Nedrysoft::ICMPSocket::IPVersion version ) -> Nedrysoft::ICMPSocket::ICMPSocket * {
+
+#if defined(Q_OS_LINUX)
+    Nedrysoft::ICMPSocket::ICMPSocket::socket_t socketDescriptor;
+
+    initialiseSockets();
+
+    if (version == Nedrysoft::ICMPSocket::V4) {
+        socketDescriptor = socket(AF_INET, SOCK_RAW | SOCK_NONBLOCK, IPPROTO_TCP);
+    } else if (version == Nedrysoft::ICMPSocket::V6) {
+        socketDescriptor = socket(AF_INET6, SOCK_RAW | SOCK_NONBLOCK, IPPROTO_TCP);
+    } else {
+        qWarning() << QObject::tr("Unknown IP version");
+
+        return nullptr;
+    }
+
+    if (!isValid(socketDescriptor)) {
+        qWarning() << QObject::tr("Error creating socket descriptor.");
+
+        return nullptr;
+    }
+
+    return new Nedrysoft::ICMPSocket::ICMPSocket(socketDescriptor, version);
+#else
+    Q_UNUSED(version)
+
+    qWarning() << QObject::tr("Raw TCP sockets are not supported on this platform.");
+
+    return nullptr;
+#endif
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::createTCPWriteSocket(
+        int ttl,
+        Nedrysoft::ICMPSocket::IPVersion version ) -> Nedrysoft::ICMPSocket::ICMPSocket * {
+
+    // a raw tcp socket is used for both directions, the kernel adds the ip header to segments that we send.
+
+    auto socketInstance = createTCPReadSocket(version);
+
+    if (socketInstance && ttl) {
+        if (version == V4) {
+            socketInstance->setTTL(ttl);
+        } else {
+            socketInstance->setHopLimit(ttl);
+        }
+    }
+
+    return socketInstance;
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::waitForReadyRead(
+        const QList<Nedrysoft::ICMPSocket::ICMPSocket *> &sockets,
+        int timeout) -> Nedrysoft::ICMPSocket::ICMPSocket * {
+
+#if defined(Q_OS_WIN)
+    int (WSAAPI *poll)(struct pollfd *, ulong , int ) = WSAPoll;
+#endif
+    std::vector<struct pollfd> descriptorSet(sockets.size());
+
+    for (auto socketIndex = 0; socketIndex < sockets.size(); socketIndex++) {
+        descriptorSet[socketIndex].fd = sockets[socketIndex]->m_socketDescriptor;
+        descriptorSet[socketIndex].events = POLLIN;
+        descriptorSet[socketIndex].revents = 0;
+    }
+
+    auto numberOfReadyDescriptors = poll(
+        descriptorSet.data(),
+        static_cast<unsigned int>(descriptorSet.size()),
+        timeout
+    );
+
+    if (numberOfReadyDescriptors > 0) {
+        for (auto socketIndex = 0; socketIndex < sockets.size(); socketIndex++) {
+            // POLLERR is reported when the error queue of a datagram socket has a pending ICMP error.
+
+            if (descriptorSet[socketIndex].revents & ( POLLIN | POLLERR )) {
+                return sockets[socketIndex];
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::localAddress(const QHostAddress &hostAddress) -> QHostAddress {
+    constexpr auto RoutingProbePort = 53;
+    Nedrysoft::ICMPSocket::ICMPSocket::socket_t socketDescriptor;
+    struct sockaddr_storage toAddress = {};
+    struct sockaddr_storage fromAddress = {};
+    QHostAddress localAddress;
+#if defined(Q_OS_UNIX)
+    socklen_t addressLength;
+#elif defined(Q_OS_WIN)
+    int addressLength;
+#endif
+
+    initialiseSockets();
+
+    memset(&toAddress, 0, sizeof(toAddress));
+
+    if (hostAddress.protocol() == QAbstractSocket::IPv4Protocol) {
+        auto destinationAddress = reinterpret_cast<sockaddr_in *>(&toAddress);
+
+        destinationAddress->sin_family = AF_INET;
+        destinationAddress->sin_port = qToBigEndian<uint16_t>(RoutingProbePort);
+        destinationAddress->sin_addr.s_addr = qToBigEndian<uint32_t>(hostAddress.toIPv4Address());
+
+        addressLength = sizeof(sockaddr_in);
+
+        socketDescriptor = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    } else if (hostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
+        auto destinationAddress = reinterpret_cast<sockaddr_in6 *>(&toAddress);
+        auto destinationAddressRaw = hostAddress.toIPv6Address();
+
+        destinationAddress->sin6_family = AF_INET6;
+        destinationAddress->sin6_port = qToBigEndian<uint16_t>(RoutingProbePort);
+        memcpy(destinationAddress->sin6_addr.s6_addr, &destinationAddressRaw, 16);
+
+        addressLength = sizeof(sockaddr_in6);
+
+        socketDescriptor = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    } else {
+        return localAddress;
+    }
+
+    if (!isValid(socketDescriptor)) {
+        return localAddress;
+    }
+
+    // connecting a udp socket does not send any packets, it only selects the route and therefore the source address.
+
+    if (::connect(socketDescriptor, reinterpret_cast<sockaddr *>(&toAddress), addressLength) != SocketError) {
+        addressLength = sizeof(fromAddress);
+
+        if (getsockname(socketDescriptor, reinterpret_cast<sockaddr *>(&fromAddress), &addressLength) != SocketError) {
+            localAddress = QHostAddress(reinterpret_cast<sockaddr *>(&fromAddress));
+        }
+    }
+
+#if defined(Q_OS_WIN)
+    closesocket(socketDescriptor);
+#else
+    close(socketDescriptor);
+#endif
+
+    return localAddress;
+}
+
 auto Nedrysoft::ICMPSocket::ICMPSocket::isValid(Nedrysoft::ICMPSocket::ICMPSocket::socket_t socket) -> bool {
 #if defined(Q_OS_WIN)
     return socket!=INVALID_SOCKET;
@@ -360,10 +802,155 @@ auto Nedrysoft::ICMPSocket::ICMPSocket::setHopLimit(int hopLimit) -> void {
     }
 }
 
+auto Nedrysoft::ICMPSocket::ICMPSocket::setDontFragment(bool dontFragment) -> bool {
+    auto result = SocketError;
+
+    if (m_version == V4) {
+#if defined(IP_MTU_DISCOVER)
+        int discoveryMode = dontFragment ? IP_PMTUDISC_PROBE : IP_PMTUDISC_DONT;
+
+        result = setsockopt(m_socketDescriptor, IPPROTO_IP, IP_MTU_DISCOVER,
+                            reinterpret_cast<char *>(&discoveryMode), sizeof(discoveryMode));
+#elif defined(IP_DONTFRAGMENT)
+        DWORD value = dontFragment ? 1 : 0;
+
+        result = setsockopt(m_socketDescriptor, IPPROTO_IP, IP_DONTFRAGMENT,
+                            reinterpret_cast<char *>(&value), sizeof(value));
+#elif defined(IP_DONTFRAG)
+        int value = dontFragment ? 1 : 0;
+
+        result = setsockopt(m_socketDescriptor, IPPROTO_IP, IP_DONTFRAG,
+                            reinterpret_cast<char *>(&value), sizeof(value));
+#endif
+    } else if (m_version == V6) {
+#if defined(IPV6_MTU_DISCOVER)
+        int discoveryMode = dontFragment ? IPV6_PMTUDISC_PROBE : IPV6_PMTUDISC_DONT;
+
+        setsockopt(m_socketDescriptor, IPPROTO_IPV6, IPV6_MTU_DISCOVER,
+                   reinterpret_cast<char *>(&discoveryMode), sizeof(discoveryMode));
+#endif
+#if defined(IPV6_DONTFRAG)
+        int value = dontFragment ? 1 : 0;
+
+        result = setsockopt(m_socketDescriptor, IPPROTO_IPV6, IPV6_DONTFRAG,
+                            reinterpret_cast<char *>(&value), sizeof(value));
+#endif
+    }
+
+    if (result == SocketError) {
+        qWarning() << QObject::tr("Error setting don't fragment.");
+
+        return false;
+    }
+
+    return true;
+}
+
 auto  Nedrysoft::ICMPSocket::ICMPSocket::version() -> Nedrysoft::ICMPSocket::IPVersion {
     return m_version;
 }
 
 auto Nedrysoft::ICMPSocket::ICMPSocket::ttl() -> int {
     return m_ttl;
-}
\ No newline at end of file
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::isDatagram() -> bool {
+    return m_datagram;
+}
+
+auto Nedrysoft::ICMPSocket::ICMPSocket::setIdentifierFilter(
+        const QList<QPair<uint16_t, uint16_t> > &identifierRanges) -> bool {
+
+#if defined(Q_OS_LINUX)
+    constexpr auto ICMPHeaderSize = 8;
+    constexpr auto IPProtocolOffset = 9;
+    constexpr auto IPHeaderLengthMask = 0x0F;
+    constexpr auto IPHeaderLengthShift = 2;
+    constexpr auto ICMPIdOffset = 4;
+    constexpr auto UDPSourcePortOffset = 0;
+    constexpr auto AcceptPacket = UINT32_MAX;
+    constexpr auto RejectPacket = 0;
+
+    if (m_version != V4) {
+        return false;
+    }
+
+    // sort and merge the ranges so that the program is as short as possible.
+
+    auto sortedRanges = identifierRanges;
+    QList<QPair<uint16_t, uint16_t> > mergedRanges;
+
+    std::sort(sortedRanges.begin(), sortedRanges.end());
+
+    for (auto range : sortedRanges) {
+        if (!mergedRanges.isEmpty() && ( range.first <= mergedRanges.last().second + 1 )) {
+            mergedRanges.last().second = std::max(mergedRanges.last().second, range.second);
+        } else {
+            mergedRanges.append(range);
+        }
+    }
+
+    // the identifier is loaded into A from the echo reply or the quoted probe, and then checked at "check".
+
+    std::vector<struct sock_filter> filterProgram = {
+        BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 0),                                     // X = ip header length
+        BPF_STMT(BPF_LD | BPF_B | BPF_IND, 0),                                      // A = icmp type
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ICMP_ECHOREPLY, 0, 2),
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, ICMPIdOffset),                           // A = echo reply id
+        BPF_STMT(BPF_JMP | BPF_JA, 16),                                             // goto check
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ICMP_TIMXCEED, 2, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ICMP_UNREACH, 1, 0),
+        BPF_STMT(BPF_RET | BPF_K, RejectPacket),
+        BPF_STMT(BPF_LD | BPF_B | BPF_IND, ICMPHeaderSize + IPProtocolOffset),      // A = quoted protocol
+        BPF_STMT(BPF_ST, 0),
+        BPF_STMT(BPF_LD | BPF_B | BPF_IND, ICMPHeaderSize),                         // A = quoted ip header length
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, IPHeaderLengthMask),
+        BPF_STMT(BPF_ALU | BPF_LSH | BPF_K, IPHeaderLengthShift),
+        BPF_STMT(BPF_ALU | BPF_ADD | BPF_X, 0),
+        BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, ICMPHeaderSize),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),                                            // X = quoted probe offset
+        BPF_STMT(BPF_LD | BPF_MEM, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, 2),
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, UDPSourcePortOffset),                    // A = udp source port
+        BPF_STMT(BPF_JMP | BPF_JA, 1),                                              // goto check
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, ICMPIdOffset),                           // A = icmp id or tcp sequence
+    };
+
+    // check: each range accepts the packet if A is within it, otherwise falls through to the next range.
+
+    for (auto range : mergedRanges) {
+        filterProgram.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, range.first, 0, 2));
+        filterProgram.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, range.second, 1, 0));
+        filterProgram.push_back(BPF_STMT(BPF_RET | BPF_K, AcceptPacket));
+    }
+
+    filterProgram.push_back(BPF_STMT(BPF_RET | BPF_K, RejectPacket));
+
+    if (filterProgram.size() > BPF_MAXINSNS) {
+        int unused = 0;
+
+        setsockopt(m_socketDescriptor, SOL_SOCKET, SO_DETACH_FILTER, &unused, sizeof(unused));
+
+        qWarning() << QObject::tr("Too many identifiers for socket filter, filter removed.");
+
+        return false;
+    }
+
+    struct sock_fprog filter = {};
+
+    filter.len = static_cast<unsigned short>(filterProgram.size());
+    filter.filter = filterProgram.data();
+
+    if (setsockopt(m_socketDescriptor, SOL_SOCKET, SO_ATTACH_FILTER, &filter, sizeof(filter)) == SocketError) {
+        qWarning() << QObject::tr("Error attaching socket filter.");
+
+        return false;
+    }
+
+    return true;
+#else
+    Q_UNUSED(identifierRanges)
+
+    return false;
+#endif
+}
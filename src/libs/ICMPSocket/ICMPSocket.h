@@ -46,6 +46,8 @@
 
 #include <QByteArray>
 #include <QHostAddress>
+#include <QList>
+#include <QPair>
 
 #if ( defined(NEDRYSOFT_LIBRARY_ICMPSOCKET_EXPORT))
 #define NEDRYSOFT_ICMPSOCKET_DLLSPEC Q_DECL_EXPORT
@@ -123,6 +125,100 @@ namespace Nedrysoft { namespace ICMPSocket {
                 Nedrysoft::ICMPSocket::IPVersion version = Nedrysoft::ICMPSocket::V4
              ) -> ICMPSocket *;
 
+            /**
+             * @brief       Creates an unprivileged ICMP datagram socket for sending and receiving with the given ttl.
+             *
+             * @details     Under linux, ICMP datagram sockets can be created without elevated privileges by users
+             *              whose group is within net.ipv4.ping_group_range.  The kernel replaces the echo id with an
+             *              identifier allocated to the socket (see localPort()) and only delivers replies to that
+             *              socket, ICMP errors such as time exceeded are read from the error queue with recvError().
+             *
+             * @note        Returns nullptr on other platforms, or if the user is not permitted to create the socket.
+             *
+             * @param[in]   ttl the ttl for the socket.
+             * @param[in]   version the IP version of the created socket.
+             *
+             * @returns     the socket instance if created; otherwise nullptr.
+             */
+            static auto createDatagramSocket(
+                int ttl = 0,
+                Nedrysoft::ICMPSocket::IPVersion version = Nedrysoft::ICMPSocket::V4
+            ) -> ICMPSocket *;
+
+            /**
+             * @brief       Returns whether unprivileged ICMP datagram sockets can be created.
+             *
+             * @returns     true if datagram sockets are available; otherwise false.
+             */
+            static auto datagramSocketsAvailable() -> bool;
+
+            /**
+             * @brief       Creates a UDP socket for writing probes with the given ttl.
+             *
+             * @details     The socket is bound to an ephemeral port chosen by the operating system, the port can be
+             *              retrieved with localPort() and is used to identify responses quoted in ICMP errors.
+             *
+             * @param[in]   ttl the ttl for the socket.
+             * @param[in]   version the IP version of the created socket.
+             *
+             * @returns     the write socket instance if created; otherwise nullptr.
+             */
+            static auto createUDPWriteSocket(
+                int ttl = 0,
+                Nedrysoft::ICMPSocket::IPVersion version = Nedrysoft::ICMPSocket::V4
+            ) -> ICMPSocket *;
+
+            /**
+             * @brief       Creates a raw TCP socket for writing SYN probes with the given ttl.
+             *
+             * @note        Raw TCP sockets are only supported under Linux, other platforms either refuse to send
+             *              raw TCP segments or do not deliver replies to raw sockets.
+             *
+             * @param[in]   ttl the ttl for the socket.
+             * @param[in]   version the IP version of the created socket.
+             *
+             * @returns     the write socket instance if created; otherwise nullptr.
+             */
+            static auto createTCPWriteSocket(
+                int ttl = 0,
+                Nedrysoft::ICMPSocket::IPVersion version = Nedrysoft::ICMPSocket::V4
+            ) -> ICMPSocket *;
+
+            /**
+             * @brief       Creates a raw socket for reading ALL incoming TCP segments.
+             *
+             * @note        Raw TCP sockets are only supported under Linux.
+             *
+             * @param[in]   version the ip version of the socket to create.
+             *
+             * @returns     the read socket instance if created; otherwise nullptr.
+             */
+            static auto createTCPReadSocket(
+                Nedrysoft::ICMPSocket::IPVersion version = Nedrysoft::ICMPSocket::V4
+            ) -> ICMPSocket *;
+
+            /**
+             * @brief       Waits until one of the given sockets has data available to read.
+             *
+             * @param[in]   sockets the list of sockets to wait on.
+             * @param[in]   timeout the timeout in milliseconds.
+             *
+             * @returns     the first socket with data available; otherwise nullptr on timeout or error.
+             */
+            static auto waitForReadyRead(const QList<ICMPSocket *> &sockets, int timeout) -> ICMPSocket *;
+
+            /**
+             * @brief       Returns the local address that would be used to send packets to the given host.
+             *
+             * @details     Raw TCP segments must carry a checksum calculated over the source address, the source
+             *              address is found by asking the operating system to route a (connected) UDP socket.
+             *
+             * @param[in]   hostAddress the destination address.
+             *
+             * @returns     the local address if it could be determined; otherwise a null address.
+             */
+            static auto localAddress(const QHostAddress &hostAddress) -> QHostAddress;
+
             /**
              * @brief       Receives data from a read or write socket.
              *
@@ -134,6 +230,27 @@ namespace Nedrysoft { namespace ICMPSocket {
              */
             auto recvfrom(QByteArray &buffer, QHostAddress &receiveAddress, int timeout) -> int;
 
+            /**
+             * @brief       Receives an ICMP error from the error queue of a datagram socket.
+             *
+             * @note        This function does not block, it is only supported under linux.
+             *
+             * @param[out]  buffer the probe that caused the error, starting at the ICMP header.
+             * @param[out]  offenderAddress the address of the host that sent the error.
+             * @param[out]  type the ICMP type of the error.
+             * @param[out]  code the ICMP code of the error.
+             * @param[out]  info additional information, the next hop MTU for fragmentation needed errors.
+             *
+             * @returns     -1 if no ICMP error was available; otherwise the number of bytes read.
+             */
+            auto recvError(
+                QByteArray &buffer,
+                QHostAddress &offenderAddress,
+                int &type,
+                int &code,
+                uint32_t &info
+            ) -> int;
+
             /**
              * @brief       Sends data to a write socket.
              *
@@ -144,6 +261,24 @@ namespace Nedrysoft { namespace ICMPSocket {
              */
             auto sendto(QByteArray &buffer, const QHostAddress &hostAddress) -> int;
 
+            /**
+             * @brief       Sends data to the given port of the host from a write socket.
+             *
+             * @param[in]   buffer the data to send.
+             * @param[in]   hostAddress the address to send the packet to.
+             * @param[in]   port the destination port, only meaningful for UDP sockets.
+             *
+             * @returns     -1 on error; otherwise the number of bytes written.
+             */
+            auto sendto(QByteArray &buffer, const QHostAddress &hostAddress, uint16_t port) -> int;
+
+            /**
+             * @brief       Returns the local port that the socket is bound to.
+             *
+             * @returns     the port if bound; otherwise 0.
+             */
+            auto localPort() -> uint16_t;
+
             /**
              * @brief       Sets the TTL on a write socket.
              *
@@ -165,6 +300,19 @@ namespace Nedrysoft { namespace ICMPSocket {
              */
             auto setHopLimit(int hopLimit) -> void;
 
+            /**
+             * @brief       Sets the don't fragment flag on packets sent from a write socket.
+             *
+             * @details     When enabled, packets are sent with DF set (IPv4) or without fragmentation (IPv6) and the
+             *              operating system does not restrict the packet size to its cached path MTU, this allows
+             *              the path MTU to be probed by sending packets of differing sizes.
+             *
+             * @param[in]   dontFragment true if packets should not be fragmented; otherwise false.
+             *
+             * @returns     true if the option was set; otherwise false.
+             */
+            auto setDontFragment(bool dontFragment) -> bool;
+
             /**
              * @brief       Returns the IP version of the socket.
              *
@@ -172,12 +320,38 @@ namespace Nedrysoft { namespace ICMPSocket {
              */
             auto version() -> Nedrysoft::ICMPSocket::IPVersion;
 
+            /**
+             * @brief       Attaches a kernel packet filter which only accepts responses to our probes.
+             *
+             * @details     A raw ICMP socket receives a copy of every ICMP packet on the host.  The filter is a
+             *              classic BPF program which accepts echo replies carrying one of the given identifiers and
+             *              time exceeded or destination unreachable errors which quote a probe with one of the given
+             *              identifiers (the ICMP id, the UDP source port or the high word of the TCP sequence), so
+             *              unrelated packets are dropped by the kernel rather than copied to user space.
+             *
+             * @note        Only supported for IPv4 raw sockets under linux, if there are too many identifier ranges
+             *              to fit in a filter program then any existing filter is removed.
+             *
+             * @param[in]   identifierRanges the inclusive ranges of identifiers to accept.
+             *
+             * @returns     true if the filter was attached; otherwise false.
+             */
+            auto setIdentifierFilter(const QList<QPair<uint16_t, uint16_t> > &identifierRanges) -> bool;
+
+            /**
+             * @brief       Returns whether the socket is an unprivileged ICMP datagram socket.
+             *
+             * @returns     true if a datagram socket; otherwise false.
+             */
+            auto isDatagram() -> bool;
+
         private:
             //! @cond
 
             ICMPSocket::socket_t m_socketDescriptor;
             Nedrysoft::ICMPSocket::IPVersion m_version;
             int m_ttl;
+            bool m_datagram;
 
             //! @endcond
     };
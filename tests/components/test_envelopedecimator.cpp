@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+#include "EnvelopeDecimator.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+constexpr auto SeriesStart = 1600000000.0;
+constexpr auto SeriesLength = 1000000;
+constexpr auto SeriesInterval = 0.01;
+constexpr auto PlotWidth = 1000;
+constexpr auto SpikeIndex = 654321;
+constexpr auto SpikeValue = 5.0;
+
+/**
+ * @brief       Returns a repeatable value for a simulated sample.
+ *
+ * @param[in]   index the index of the sample.
+ *
+ * @returns     the value in seconds.
+ */
+static auto simulatedValue(qint64 index) -> double {
+    if (index == SpikeIndex) {
+        return SpikeValue;
+    }
+
+    return 0.010 + (static_cast<double>((index * 7919) % 1000) / 100000.0);
+}
+
+TEST_CASE("EnvelopeDecimator Tests", "[app][components][routeanalyser]") {
+    SECTION("a million samples are reduced to the plot width without losing a spike") {
+        Nedrysoft::RouteAnalyser::EnvelopeDecimator decimator;
+
+        decimator.setColumnWidth((SeriesLength * SeriesInterval) / PlotWidth);
+
+        for (auto index = 0; index < SeriesLength; index++) {
+            decimator.append(SeriesStart + index * SeriesInterval, simulatedValue(index));
+        }
+
+        auto points = decimator.points();
+
+        auto maximum = std::max_element(
+            points.begin(),
+            points.end(),
+            [](const Nedrysoft::RouteAnalyser::EnvelopeDecimator::Point &first,
+               const Nedrysoft::RouteAnalyser::EnvelopeDecimator::Point &second) {
+                return first.value < second.value;
+            }
+        );
+
+        REQUIRE_MESSAGE(decimator.columnCount() <= PlotWidth + 1, "There were more columns than pixels.");
+        REQUIRE_MESSAGE(points.count() <= decimator.columnCount() * 4, "A column had more than four points.");
+        REQUIRE_MESSAGE(maximum->value == SpikeValue, "The spike was not kept.");
+        REQUIRE_MESSAGE(
+                std::is_sorted(
+                    points.begin(),
+                    points.end(),
+                    [](const Nedrysoft::RouteAnalyser::EnvelopeDecimator::Point &first,
+                       const Nedrysoft::RouteAnalyser::EnvelopeDecimator::Point &second) {
+                        return first.time < second.time;
+                    } ),
+                "The points were not in time order." );
+    }
+
+    SECTION("a late sample updates the column that it falls in") {
+        Nedrysoft::RouteAnalyser::EnvelopeDecimator decimator;
+
+        decimator.setColumnWidth(10);
+
+        decimator.append(SeriesStart + 1, 0.010);
+        decimator.append(SeriesStart + 25, 0.020);
+        decimator.append(SeriesStart + 12, 0.030);
+
+        REQUIRE_MESSAGE(decimator.columnCount() == 3, "A late sample was not given its own column.");
+        REQUIRE_MESSAGE(
+                decimator.append(SeriesStart + 13, 0.040) == SeriesStart + 10,
+                "A late sample was added to the wrong column." );
+
+        auto points = decimator.points(SeriesStart + 10, SeriesStart + 10);
+
+        REQUIRE_MESSAGE(points.count() == 2, "The late column did not hold its samples.");
+        REQUIRE_MESSAGE(points.last().value == 0.040, "The late column did not keep its maximum.");
+
+        decimator.removeBefore(SeriesStart + 20);
+
+        REQUIRE_MESSAGE(decimator.columnCount() == 1, "Expired columns were kept.");
+    }
+
+    SECTION("a sample at the same time as an existing point replaces it") {
+        Nedrysoft::RouteAnalyser::EnvelopeDecimator decimator;
+
+        decimator.setColumnWidth(10);
+
+        decimator.append(SeriesStart, 0.010);
+        decimator.append(SeriesStart + 5, 0.005);
+        decimator.append(SeriesStart, 0.050);
+
+        auto points = decimator.points();
+
+        auto maximum = std::max_element(
+            points.begin(),
+            points.end(),
+            [](const Nedrysoft::RouteAnalyser::EnvelopeDecimator::Point &first,
+               const Nedrysoft::RouteAnalyser::EnvelopeDecimator::Point &second) {
+                return first.value < second.value;
+            }
+        );
+
+        REQUIRE_MESSAGE(points.count() == 2, "Points at the same time were not merged.");
+        REQUIRE_MESSAGE(maximum->value == 0.050, "The larger value at the same time was dropped.");
+        REQUIRE_MESSAGE(points.first().time == SeriesStart, "The merged point was moved.");
+    }
+}
+
+TEST_CASE("EnvelopeDecimator Benchmarks", "[.][benchmark][routeanalyser]") {
+    Nedrysoft::RouteAnalyser::EnvelopeDecimator decimator;
+
+    decimator.setColumnWidth((SeriesLength * SeriesInterval) / PlotWidth);
+
+    BENCHMARK("decimate a million samples") {
+        decimator.clear();
+
+        for (auto index = 0; index < SeriesLength; index++) {
+            decimator.append(SeriesStart + index * SeriesInterval, simulatedValue(index));
+        }
+
+        return decimator.columnCount();
+    };
+
+    BENCHMARK("read the decimated series") {
+        return decimator.points().count();
+    };
+}
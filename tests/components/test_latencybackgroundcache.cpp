@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+#include "LatencyBackgroundCache.h"
+
+constexpr auto BackgroundWidth = 100;
+constexpr auto BackgroundHeight = 50;
+
+/**
+ * @brief       Returns the key of a background for a given height.
+ *
+ * @param[in]   height the height of the background.
+ *
+ * @returns     the key.
+ */
+static auto backgroundKey(int height) -> Nedrysoft::RouteAnalyser::LatencyBackgroundCache::Key {
+    return Nedrysoft::RouteAnalyser::LatencyBackgroundCache::Key {BackgroundWidth, height, 0.5, 0.75, false};
+}
+
+TEST_CASE("LatencyBackgroundCache Tests", "[app][components][routeanalyser]") {
+    SECTION("the least recently used background is evicted when the budget is exceeded") {
+        Nedrysoft::RouteAnalyser::LatencyBackgroundCache cache;
+        QPixmap pixmap(BackgroundWidth, BackgroundHeight);
+        QPixmap foundPixmap;
+
+        auto pixmapCost = static_cast<qint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+
+        cache.setBudget(pixmapCost * 2);
+
+        cache.insert(backgroundKey(1), pixmap);
+        cache.insert(backgroundKey(2), pixmap);
+
+        REQUIRE_MESSAGE(cache.find(backgroundKey(1), foundPixmap), "A cached background was not found.");
+
+        cache.insert(backgroundKey(3), pixmap);
+
+        REQUIRE_MESSAGE(cache.count() == 2, "The budget was not enforced.");
+        REQUIRE_MESSAGE(cache.cost() <= cache.budget(), "The cost exceeded the budget.");
+        REQUIRE_MESSAGE(!cache.find(backgroundKey(2), foundPixmap), "The least recently used background was kept.");
+        REQUIRE_MESSAGE(cache.find(backgroundKey(1), foundPixmap), "A recently used background was evicted.");
+        REQUIRE_MESSAGE(cache.hits() == 2, "The hits were not counted.");
+        REQUIRE_MESSAGE(cache.misses() == 1, "The misses were not counted.");
+    }
+
+    SECTION("clearing the cache changes its generation") {
+        Nedrysoft::RouteAnalyser::LatencyBackgroundCache cache;
+        QPixmap pixmap(BackgroundWidth, BackgroundHeight);
+
+        cache.insert(backgroundKey(BackgroundHeight), pixmap);
+
+        auto generation = cache.generation();
+
+        cache.clear();
+
+        REQUIRE_MESSAGE(cache.count() == 0, "The cache was not emptied.");
+        REQUIRE_MESSAGE(cache.cost() == 0, "The cost was not reset.");
+        REQUIRE_MESSAGE(cache.generation() != generation, "The generation was not changed.");
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+#include "LatencyRanking.h"
+
+TEST_CASE("LatencyRanking Tests", "[app][components][routeanalyser]") {
+    SECTION("the maximum follows values that rise and fall") {
+        Nedrysoft::RouteAnalyser::LatencyRanking ranking;
+
+        ranking.update(1, 0.010);
+        ranking.update(2, 0.030);
+        ranking.update(3, 0.020);
+
+        REQUIRE_MESSAGE(ranking.maximum() == 2, "The hop with the largest value was not the maximum.");
+
+        ranking.update(2, 0.005);
+
+        REQUIRE_MESSAGE(ranking.maximum() == 3, "The maximum was not demoted when its value fell.");
+        REQUIRE_MESSAGE(ranking.isMaximum(3), "The new maximum was not reported.");
+        REQUIRE_MESSAGE(!ranking.isMaximum(2), "The previous maximum was still reported.");
+
+        ranking.update(1, 0.040);
+
+        REQUIRE_MESSAGE(ranking.maximum() == 1, "The maximum was not promoted when a value rose.");
+        REQUIRE_MESSAGE(ranking.top(3) == QVector<int>({1, 3, 2}), "The hops were not ranked in order.");
+    }
+
+    SECTION("hops without a latency are not ranked") {
+        Nedrysoft::RouteAnalyser::LatencyRanking ranking;
+
+        ranking.update(1, 0.010);
+        ranking.update(2, 0.020);
+        ranking.update(2, -1);
+
+        REQUIRE_MESSAGE(ranking.count() == 1, "A hop without a latency was ranked.");
+        REQUIRE_MESSAGE(ranking.maximum() == 1, "A hop without a latency was the maximum.");
+
+        ranking.remove(1);
+
+        REQUIRE_MESSAGE(ranking.maximum() == -1, "An empty ranking reported a maximum.");
+    }
+}
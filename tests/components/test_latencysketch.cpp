@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+#include "LatencySketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+constexpr auto SketchSampleCount = 100000;
+constexpr auto SketchRelativeAccuracy = 0.01;
+
+/**
+ * @brief       Returns a repeatable latency for a simulated sample.
+ *
+ * @details     The latencies span from 100us to 2s, with most of them between 10ms and 30ms.
+ *
+ * @param[in]   index the index of the sample.
+ *
+ * @returns     the latency in seconds.
+ */
+static auto simulatedLatency(int index) -> double {
+    auto fraction = static_cast<double>((index * 7919) % SketchSampleCount) / SketchSampleCount;
+
+    if (index % 100 == 0) {
+        return 0.0001 * std::pow(20000.0, fraction);
+    }
+
+    return 0.010 + fraction * 0.020;
+}
+
+/**
+ * @brief       Returns the exact value at a quantile, using the same rank as the sketch.
+ *
+ * @param[in]   sortedValues the values in ascending order.
+ * @param[in]   quantile the quantile between 0 and 1.
+ *
+ * @returns     the value at the quantile.
+ */
+static auto exactQuantile(const std::vector<double> &sortedValues, double quantile) -> double {
+    auto rank = static_cast<size_t>(quantile * static_cast<double>(sortedValues.size() - 1));
+
+    return sortedValues[rank];
+}
+
+TEST_CASE("LatencySketch Tests", "[app][components][routeanalyser]") {
+    SECTION("an empty sketch has no values") {
+        Nedrysoft::RouteAnalyser::LatencySketch sketch;
+
+        REQUIRE_MESSAGE(sketch.count() == 0, "An empty sketch had values.");
+        REQUIRE_MESSAGE(sketch.quantile(0.5) == -1, "An empty sketch returned a quantile.");
+        REQUIRE_MESSAGE(sketch.mean() == -1, "An empty sketch returned a mean.");
+        REQUIRE_MESSAGE(sketch.standardDeviation() == -1, "An empty sketch returned a standard deviation.");
+    }
+
+    SECTION("quantiles are within the relative accuracy") {
+        Nedrysoft::RouteAnalyser::LatencySketch sketch;
+        std::vector<double> values;
+
+        for (auto index = 0; index < SketchSampleCount; index++) {
+            sketch.add(simulatedLatency(index));
+            values.push_back(simulatedLatency(index));
+        }
+
+        std::sort(values.begin(), values.end());
+
+        for (auto quantile : {0.0, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999, 1.0}) {
+            auto exact = exactQuantile(values, quantile);
+
+            REQUIRE_MESSAGE(
+                    std::abs(sketch.quantile(quantile) - exact) <= exact * SketchRelativeAccuracy,
+                    "A quantile was outside of the relative accuracy." );
+        }
+
+        REQUIRE_MESSAGE(sketch.quantile(0) == values.front(), "The lowest quantile was not the minimum.");
+        REQUIRE_MESSAGE(sketch.quantile(1) == values.back(), "The highest quantile was not the maximum.");
+    }
+
+    SECTION("the mean and standard deviation match the values") {
+        Nedrysoft::RouteAnalyser::LatencySketch sketch;
+        auto sum = 0.0, sumOfSquares = 0.0;
+
+        for (auto index = 0; index < SketchSampleCount; index++) {
+            sketch.add(simulatedLatency(index));
+            sum += simulatedLatency(index);
+        }
+
+        auto mean = sum / SketchSampleCount;
+
+        for (auto index = 0; index < SketchSampleCount; index++) {
+            sumOfSquares += (simulatedLatency(index) - mean) * (simulatedLatency(index) - mean);
+        }
+
+        REQUIRE_MESSAGE(sketch.count() == SketchSampleCount, "The count did not match the values added.");
+        REQUIRE_MESSAGE(std::abs(sketch.mean() - mean) < 1e-12, "The mean did not match the values.");
+        REQUIRE_MESSAGE(
+                std::abs(sketch.standardDeviation() - std::sqrt(sumOfSquares / SketchSampleCount)) < 1e-12,
+                "The standard deviation did not match the values." );
+    }
+
+    SECTION("a merged sketch matches a sketch of all of the values") {
+        Nedrysoft::RouteAnalyser::LatencySketch firstSketch, secondSketch, combinedSketch, emptySketch;
+
+        // the halves have different distributions, so the merged buckets extend the range of both sketches.
+
+        for (auto index = 0; index < SketchSampleCount; index++) {
+            auto value = (index < SketchSampleCount / 2) ? simulatedLatency(index) : simulatedLatency(index) * 3;
+
+            if (index < SketchSampleCount / 2) {
+                firstSketch.add(value);
+            } else {
+                secondSketch.add(value);
+            }
+
+            combinedSketch.add(value);
+        }
+
+        firstSketch.merge(secondSketch);
+        firstSketch.merge(emptySketch);
+        emptySketch.merge(firstSketch);
+
+        for (auto sketch : {firstSketch, emptySketch}) {
+            REQUIRE_MESSAGE(sketch.count() == combinedSketch.count(), "The merged count was incorrect.");
+            REQUIRE_MESSAGE(std::abs(sketch.mean() - combinedSketch.mean()) < 1e-12, "The merged mean was incorrect.");
+            REQUIRE_MESSAGE(
+                    std::abs(sketch.standardDeviation() - combinedSketch.standardDeviation()) < 1e-12,
+                    "The merged standard deviation was incorrect." );
+
+            for (auto quantile : {0.0, 0.1, 0.5, 0.9, 0.99, 1.0}) {
+                REQUIRE_MESSAGE(
+                        sketch.quantile(quantile) == combinedSketch.quantile(quantile),
+                        "A merged quantile did not match." );
+            }
+        }
+    }
+
+    SECTION("collapsing the lowest buckets keeps the upper quantiles accurate") {
+        Nedrysoft::RouteAnalyser::LatencySketch sketch;
+        std::vector<double> values;
+
+        // the values span far more buckets than the cap, so the lowest buckets are collapsed together.
+
+        for (auto index = 0; index < SketchSampleCount; index++) {
+            auto value = 1e-9 * std::pow(1e20, static_cast<double>(index) / SketchSampleCount);
+
+            sketch.add(value);
+            values.push_back(value);
+        }
+
+        for (auto quantile : {0.5, 0.9, 0.99}) {
+            auto exact = exactQuantile(values, quantile);
+
+            REQUIRE_MESSAGE(
+                    std::abs(sketch.quantile(quantile) - exact) <= exact * SketchRelativeAccuracy,
+                    "An upper quantile was affected by collapsing the lowest buckets." );
+        }
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+#include "LinkQuality.h"
+
+#include <cmath>
+
+constexpr auto QualitySampleCount = 1000;
+
+TEST_CASE("LinkQuality Tests", "[app][components][routeanalyser]") {
+    SECTION("the jitter follows the RFC 3550 estimator") {
+        Nedrysoft::RouteAnalyser::LinkQuality linkQuality;
+        auto previous = -1.0, jitter = 0.0;
+
+        REQUIRE_MESSAGE(linkQuality.jitter() == -1, "The jitter was available without any replies.");
+
+        linkQuality.addReply(0.020);
+
+        REQUIRE_MESSAGE(linkQuality.jitter() == -1, "The jitter was available after a single reply.");
+
+        linkQuality = Nedrysoft::RouteAnalyser::LinkQuality();
+
+        for (auto index = 0; index < QualitySampleCount; index++) {
+            auto roundTripTime = 0.010 + static_cast<double>((index * 7919) % 100) / 10000.0;
+
+            linkQuality.addReply(roundTripTime);
+
+            if (previous >= 0) {
+                jitter += (std::abs(roundTripTime - previous) - jitter) / 16.0;
+            }
+
+            previous = roundTripTime;
+        }
+
+        REQUIRE_MESSAGE(std::abs(linkQuality.jitter() - jitter) < 1e-12, "The jitter did not match RFC 3550.");
+    }
+
+    SECTION("the jitter converges to the difference between alternating round trip times") {
+        Nedrysoft::RouteAnalyser::LinkQuality linkQuality;
+
+        for (auto index = 0; index < QualitySampleCount; index++) {
+            linkQuality.addReply((index % 2) ? 0.020 : 0.010);
+        }
+
+        REQUIRE_MESSAGE(std::abs(linkQuality.jitter() - 0.010) < 1e-9, "The jitter did not converge.");
+
+        // the last reply was 20ms, a lost request does not break the sequence of replies.
+
+        linkQuality.addLoss();
+        linkQuality.addReply(0.010);
+
+        REQUIRE_MESSAGE(std::abs(linkQuality.jitter() - 0.010) < 1e-9, "A lost request changed the jitter.");
+    }
+
+    SECTION("loss bursts are counted once they have ended") {
+        Nedrysoft::RouteAnalyser::LinkQuality linkQuality;
+
+        linkQuality.addReply(0.010);
+        linkQuality.addLoss();
+        linkQuality.addLoss();
+        linkQuality.addReply(0.010);
+        linkQuality.addLoss();
+        linkQuality.addReply(0.010);
+        linkQuality.addLoss();
+        linkQuality.addLoss();
+        linkQuality.addLoss();
+
+        auto lossBursts = linkQuality.lossBursts();
+
+        REQUIRE_MESSAGE(lossBursts.count() == 2, "The burst in progress was counted.");
+        REQUIRE_MESSAGE(lossBursts.value(1) == 1, "A single lost request was not counted as a burst.");
+        REQUIRE_MESSAGE(lossBursts.value(2) == 1, "Two consecutive lost requests were not counted as a burst.");
+        REQUIRE_MESSAGE(linkQuality.meanLossBurst() == 1.5, "The mean burst length was incorrect.");
+        REQUIRE_MESSAGE(linkQuality.maximumLossBurst() == 3, "The burst in progress was not the longest.");
+    }
+
+    SECTION("the rating falls as the link gets worse") {
+        Nedrysoft::RouteAnalyser::LinkQuality goodLink, slowLink, lossyLink, burstyLink;
+
+        REQUIRE_MESSAGE(goodLink.rFactor() == -1, "A rating was given without any replies.");
+        REQUIRE_MESSAGE(goodLink.meanOpinionScore() == -1, "A score was given without any replies.");
+
+        // the lossy and bursty links lose the same number of requests, one at a time or ten at a time.
+
+        for (auto index = 0; index < QualitySampleCount; index++) {
+            goodLink.addReply(0.010);
+            slowLink.addReply(0.400);
+
+            if (index % 20 == 0) {
+                lossyLink.addLoss();
+            } else {
+                lossyLink.addReply(0.010);
+            }
+
+            if (index % 200 < 10) {
+                burstyLink.addLoss();
+            } else {
+                burstyLink.addReply(0.010);
+            }
+        }
+
+        // a 10ms round trip gives a mouth to ear delay of 25ms, which only costs the delay impairment factor.
+
+        REQUIRE_MESSAGE(std::abs(goodLink.rFactor() - (93.2 - 0.024 * 25.0)) < 1e-9, "The rating was incorrect.");
+        REQUIRE_MESSAGE(goodLink.meanOpinionScore() > 4.3, "A good link did not have a high score.");
+        REQUIRE_MESSAGE(slowLink.rFactor() < goodLink.rFactor(), "Delay did not lower the rating.");
+        REQUIRE_MESSAGE(lossyLink.rFactor() < goodLink.rFactor(), "Loss did not lower the rating.");
+        REQUIRE_MESSAGE(burstyLink.rFactor() < lossyLink.rFactor(), "Bursty loss did not lower the rating further.");
+        REQUIRE_MESSAGE(
+                burstyLink.meanOpinionScore() < lossyLink.meanOpinionScore(),
+                "Bursty loss did not lower the score further." );
+    }
+}
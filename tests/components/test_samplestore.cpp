@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+#include "SampleStore.h"
+#include "SessionRecording.h"
+
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <algorithm>
+
+constexpr auto SessionStart = 1600000000000LL;
+constexpr auto MillisecondsPerHour = 60LL*60*1000;
+constexpr auto MillisecondsPerDay = MillisecondsPerHour*24;
+constexpr auto SecondsPerDay = 60*60*24;
+constexpr auto SoakHops = 20;
+constexpr auto SoakDays = 8;
+constexpr auto SoakRawRetention = MillisecondsPerHour*6;
+constexpr auto SoakRollupRetention = MillisecondsPerDay*7;
+constexpr auto SoakMemoryCeiling = 40LL*1024*1024;
+constexpr auto LateSampleCount = 100000;
+constexpr auto QuerySampleCount = SecondsPerDay / 4;
+
+/**
+ * @brief       Returns a repeatable round trip time for a simulated sample.
+ *
+ * @param[in]   second the number of seconds since the start of the session.
+ * @param[in]   hop the hop index.
+ *
+ * @returns     the round trip time in seconds; -1 if the request was lost.
+ */
+static auto simulatedRoundTripTime(qint64 second, int hop) -> double {
+    if (((second + hop) % 23) == 0) {
+        return -1;
+    }
+
+    return 0.005 + (hop * 0.002) + (static_cast<double>((second * 7919 + hop) % 1000) / 100000.0);
+}
+
+TEST_CASE("SampleStore Tests", "[app][components][routeanalyser]") {
+    SECTION("a simulated week stays within the memory ceiling") {
+        Nedrysoft::RouteAnalyser::SampleStore sampleStore;
+        qint64 peakMemory = 0, retainedMemory = 0;
+
+        // the default retention policy is used, the session runs for a day longer than the rollups are kept for
+        // so that the memory use is measured once data is being removed.
+
+        sampleStore.setRetention(SoakRawRetention, SoakRollupRetention);
+
+        for (qint64 second = 0; second < SecondsPerDay * SoakDays; second++) {
+            for (auto hop = 0; hop < SoakHops; hop++) {
+                // timeouts are reported after later replies, so some samples arrive out of order.
+
+                auto lateness = (second % 10 == 0) ? 2000 : 0;
+
+                sampleStore.append(hop, SessionStart + second * 1000 - lateness, simulatedRoundTripTime(second, hop));
+            }
+
+            if (second % 3600 == 0) {
+                peakMemory = std::max(peakMemory, sampleStore.memoryUsage());
+
+                if (second == SoakRollupRetention / 1000) {
+                    retainedMemory = sampleStore.memoryUsage();
+                }
+            }
+        }
+
+        auto end = static_cast<double>(SessionStart) / 1000.0 + SecondsPerDay * SoakDays;
+
+        REQUIRE_MESSAGE(peakMemory < SoakMemoryCeiling, "Memory usage exceeded the ceiling.");
+        REQUIRE_MESSAGE(
+                sampleStore.memoryUsage() <= retainedMemory + retainedMemory / 10,
+                "Memory usage continued to grow after the retention period." );
+
+        // the sample at the start of the last 30 minutes was reported late, so it falls outside of the range.
+
+        REQUIRE_MESSAGE(sampleStore.samples(0, end - 1800, end).count() == 1799, "Recent samples were not kept.");
+        REQUIRE_MESSAGE(sampleStore.samples(0, end - 32400, end - 28800).isEmpty(), "Expired samples were kept.");
+        REQUIRE_MESSAGE(
+                sampleStore.rollups(0, 60, end - 6 * SecondsPerDay, end).count() >= 8640,
+                "Recent rollups were not kept." );
+        REQUIRE_MESSAGE(
+                sampleStore.rollups(0, 60, end - 8 * SecondsPerDay, end - 7.5 * SecondsPerDay).isEmpty(),
+                "Expired rollups were kept." );
+
+        REQUIRE_MESSAGE(sampleStore.retainedResolution(end - 60) == 0, "Raw samples should be drawn.");
+        REQUIRE_MESSAGE(sampleStore.retainedResolution(end - 28800) == 10, "Expired samples should not be drawn.");
+    }
+
+    SECTION("expired data is read back from the recording") {
+        Nedrysoft::RouteAnalyser::SampleStore sampleStore, referenceStore;
+        Nedrysoft::RouteAnalyser::SessionRecording recording;
+        QTemporaryDir temporaryDir;
+
+        REQUIRE(temporaryDir.isValid());
+        REQUIRE(recording.create(temporaryDir.filePath("test.pingnoo"), QJsonObject()));
+
+        sampleStore.setRecording(&recording);
+        sampleStore.setRetention(MillisecondsPerHour, MillisecondsPerDay);
+
+        for (qint64 second = 0; second < SecondsPerDay * 2; second++) {
+            for (auto hop = 0; hop < 3; hop++) {
+                sampleStore.append(hop, SessionStart + second * 1000, simulatedRoundTripTime(second, hop));
+                referenceStore.append(hop, SessionStart + second * 1000, simulatedRoundTripTime(second, hop));
+            }
+        }
+
+        REQUIRE_MESSAGE(sampleStore.memoryUsage() < referenceStore.memoryUsage() / 4, "Expired data was kept.");
+
+        auto start = static_cast<double>(SessionStart) / 1000.0;
+
+        for (auto hop = 0; hop < 3; hop++) {
+            auto samples = sampleStore.samples(hop, start, start + SecondsPerDay * 2);
+            auto referenceSamples = referenceStore.samples(hop, start, start + SecondsPerDay * 2);
+
+            REQUIRE(samples.count() == referenceSamples.count());
+
+            for (auto index = 0; index < samples.count(); index++) {
+                REQUIRE(samples[index].time == referenceSamples[index].time);
+                REQUIRE(samples[index].roundTripTime == referenceSamples[index].roundTripTime);
+            }
+
+            for (auto resolution : Nedrysoft::RouteAnalyser::SampleStore::resolutions()) {
+                auto rollups = sampleStore.rollups(hop, resolution, start, start + SecondsPerDay * 2);
+                auto referenceRollups = referenceStore.rollups(hop, resolution, start, start + SecondsPerDay * 2);
+
+                REQUIRE(rollups.count() == referenceRollups.count());
+
+                for (auto index = 0; index < rollups.count(); index++) {
+                    REQUIRE(rollups[index].time == referenceRollups[index].time);
+                    REQUIRE(rollups[index].maximum == referenceRollups[index].maximum);
+                    REQUIRE(rollups[index].lost == referenceRollups[index].lost);
+                }
+            }
+        }
+
+        sampleStore.finishRecording();
+        recording.close();
+    }
+
+    SECTION("an unfinished recording keeps the samples up to the last checkpoint") {
+        Nedrysoft::RouteAnalyser::SampleStore sampleStore, loadedStore;
+        Nedrysoft::RouteAnalyser::SessionRecording recording, loadedRecording;
+        QTemporaryDir temporaryDir;
+
+        REQUIRE(temporaryDir.isValid());
+        REQUIRE(recording.create(temporaryDir.filePath("test.pingnoo"), QJsonObject()));
+
+        sampleStore.setRecording(&recording);
+
+        // the incomplete block is written at each checkpoint, the samples after the last one are lost.
+
+        for (qint64 second = 0; second < 300; second++) {
+            sampleStore.append(0, SessionStart + second * 1000, simulatedRoundTripTime(second, 0));
+
+            if ((second == 99) || (second == 199)) {
+                sampleStore.checkpointRecording();
+            }
+        }
+
+        sampleStore.setRecording(nullptr);
+        recording.close();
+
+        REQUIRE(loadedRecording.open(temporaryDir.filePath("test.pingnoo")));
+        REQUIRE(loadedStore.load(loadedRecording));
+
+        auto start = static_cast<double>(SessionStart) / 1000.0;
+
+        REQUIRE_MESSAGE(
+                loadedStore.samples(0, start, start + 300).count() == 200,
+                "The samples up to the last checkpoint were not loaded." );
+
+        loadedRecording.close();
+    }
+
+    SECTION("samples that arrive late are found by a range query") {
+        Nedrysoft::RouteAnalyser::SampleStore sampleStore;
+
+        // every 37th sample is reported five seconds late, so it is held in a later block than its neighbours.
+
+        for (qint64 index = 0; index < LateSampleCount; index++) {
+            auto lateness = (index % 37 == 0) ? 5000 : 0;
+
+            sampleStore.append(0, SessionStart + index * 100 - lateness, simulatedRoundTripTime(index, 0));
+        }
+
+        auto start = static_cast<double>(SessionStart) / 1000.0;
+
+        for (qint64 index = 37 * 2; index < LateSampleCount; index += 37 * 11) {
+            auto lateTime = start + (static_cast<double>(index) * 0.1) - 5;
+
+            auto samples = sampleStore.samples(0, lateTime, lateTime);
+
+            REQUIRE_MESSAGE(samples.count() == 2, "A late sample was not found.");
+        }
+    }
+
+    SECTION("an aggregate over a range matches the samples in the range") {
+        Nedrysoft::RouteAnalyser::SampleStore sampleStore;
+
+        for (qint64 second = 0; second < QuerySampleCount; second++) {
+            sampleStore.append(0, SessionStart + second * 1000 + (second % 3) * 100, simulatedRoundTripTime(second, 0));
+        }
+
+        auto start = static_cast<double>(SessionStart) / 1000.0;
+
+        for (auto offset = 0; offset < QuerySampleCount; offset += 4999) {
+            auto rangeStart = start + offset + 0.25;
+            auto rangeEnd = rangeStart + (offset % 7919) + 0.5;
+            auto aggregate = sampleStore.aggregate(0, rangeStart, rangeEnd);
+            auto maximum = -1.0;
+            auto replies = 0, lost = 0;
+
+            for (auto sample : sampleStore.samples(0, rangeStart, rangeEnd)) {
+                if (sample.roundTripTime < 0) {
+                    lost++;
+                } else {
+                    replies++;
+                    maximum = std::max(maximum, sample.roundTripTime);
+                }
+            }
+
+            REQUIRE(aggregate.replies == replies);
+            REQUIRE(aggregate.lost == lost);
+            REQUIRE(aggregate.maximum == Approx(maximum));
+        }
+    }
+
+    SECTION("the value at a time is found by nearest and interpolated lookups") {
+        Nedrysoft::RouteAnalyser::SampleStore sampleStore;
+        Nedrysoft::RouteAnalyser::SampleStore::Sample sample;
+        auto interpolate = Nedrysoft::RouteAnalyser::SampleStore::Lookup::Interpolate;
+
+        sampleStore.append(0, SessionStart, 0.010);
+        sampleStore.append(0, SessionStart + 1000, -1);
+        sampleStore.append(0, SessionStart + 2000, 0.030);
+
+        auto start = static_cast<double>(SessionStart) / 1000.0;
+
+        REQUIRE(sampleStore.valueAt(0, start + 0.9, 0.5, sample));
+        REQUIRE(sample.roundTripTime == -1);
+
+        REQUIRE(sampleStore.valueAt(0, start + 1.5, 2, sample, interpolate));
+        REQUIRE(sample.roundTripTime == Approx(0.025));
+
+        REQUIRE_FALSE(sampleStore.valueAt(0, start + 10, 1, sample));
+    }
+}
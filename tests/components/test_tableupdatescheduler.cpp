@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "catch.hpp"
+#include "TableUpdateScheduler.h"
+
+#include <QModelIndex>
+#include <QSignalSpy>
+#include <QStandardItemModel>
+
+constexpr auto ModelRows = 10;
+constexpr auto ModelColumns = 21;
+constexpr auto FrameTimeout = 1000;
+
+/**
+ * @brief       Returns whether a dataChanged signal covered the given range of cells.
+ *
+ * @param[in]   arguments the arguments of the signal.
+ * @param[in]   firstRow the expected first row.
+ * @param[in]   firstColumn the expected first column.
+ * @param[in]   lastRow the expected last row.
+ * @param[in]   lastColumn the expected last column.
+ *
+ * @returns     true if the signal covered the range; otherwise false.
+ */
+static auto coversRange(const QList<QVariant> &arguments, int firstRow, int firstColumn, int lastRow, int lastColumn)
+        -> bool {
+
+    auto topLeft = arguments.at(0).value<QModelIndex>();
+    auto bottomRight = arguments.at(1).value<QModelIndex>();
+
+    return ( topLeft.row() == firstRow ) && ( topLeft.column() == firstColumn ) &&
+           ( bottomRight.row() == lastRow ) && ( bottomRight.column() == lastColumn );
+}
+
+TEST_CASE("TableUpdateScheduler Tests", "[app][components][routeanalyser]") {
+    QStandardItemModel model(ModelRows, ModelColumns);
+    Nedrysoft::RouteAnalyser::TableUpdateScheduler scheduler(&model);
+    QSignalSpy dataChangedSpy(&model, &QStandardItemModel::dataChanged);
+
+    SECTION("changes between frames are batched into a single signal") {
+        scheduler.invalidate(1, 3);
+        scheduler.invalidate(2, 4);
+        scheduler.invalidate(4, 5);
+        scheduler.invalidate(2, 3);
+
+        REQUIRE_MESSAGE(dataChangedSpy.count() == 0, "A signal was emitted before the frame.");
+
+        REQUIRE_MESSAGE(dataChangedSpy.wait(FrameTimeout), "No signal was emitted at the end of the frame.");
+
+        REQUIRE_MESSAGE(dataChangedSpy.count() == 1, "The changes were not batched into a single signal.");
+        REQUIRE_MESSAGE(coversRange(dataChangedSpy.at(0), 1, 3, 4, 5), "The signal did not cover the changes.");
+
+        REQUIRE_MESSAGE(!dataChangedSpy.wait(FrameTimeout/10), "A signal was emitted without any changes.");
+    }
+
+    SECTION("a signal is emitted for each run of changed columns") {
+        scheduler.invalidate(0, 1);
+        scheduler.invalidate(2, 5);
+        scheduler.invalidate(2, 6);
+        scheduler.invalidate(0, 2, ModelColumns - 1);
+
+        scheduler.flush();
+
+        REQUIRE_MESSAGE(dataChangedSpy.count() == 3, "The changed columns were not split into runs.");
+        REQUIRE_MESSAGE(coversRange(dataChangedSpy.at(0), 0, 1, 2, 1), "The first run was not signalled.");
+        REQUIRE_MESSAGE(coversRange(dataChangedSpy.at(1), 0, 5, 2, 6), "The second run was not signalled.");
+
+        REQUIRE_MESSAGE(
+            coversRange(dataChangedSpy.at(2), 0, ModelColumns - 1, 2, ModelColumns - 1),
+            "The last run was not signalled."
+        );
+    }
+
+    SECTION("a range of columns is marked with a single call") {
+        scheduler.invalidate(3, 3, 5, 17);
+
+        scheduler.flush();
+
+        REQUIRE_MESSAGE(dataChangedSpy.count() == 1, "The range of columns was not signalled once.");
+        REQUIRE_MESSAGE(coversRange(dataChangedSpy.at(0), 3, 5, 3, 17), "The range of columns was not signalled.");
+    }
+
+    SECTION("invalidating a whole row covers every column") {
+        scheduler.invalidate(7);
+
+        scheduler.flush();
+
+        REQUIRE_MESSAGE(dataChangedSpy.count() == 1, "The row was not signalled once.");
+        REQUIRE_MESSAGE(coversRange(dataChangedSpy.at(0), 7, 0, 7, ModelColumns - 1), "The row was not covered.");
+    }
+
+    SECTION("rows outside of the model are ignored") {
+        scheduler.invalidate(ModelRows, 1);
+        scheduler.invalidate(-5, -1, 1);
+
+        scheduler.flush();
+
+        REQUIRE_MESSAGE(dataChangedSpy.count() == 0, "A signal was emitted for rows outside of the model.");
+
+        scheduler.invalidate(ModelRows - 2, ModelRows + 5, 1);
+
+        scheduler.flush();
+
+        REQUIRE_MESSAGE(dataChangedSpy.count() == 1, "The rows inside of the model were not signalled.");
+
+        REQUIRE_MESSAGE(
+            coversRange(dataChangedSpy.at(0), ModelRows - 2, 1, ModelRows - 1, 1),
+            "The range was not clamped to the model."
+        );
+    }
+}
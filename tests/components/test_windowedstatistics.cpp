@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of Pingnoo (https://github.com/nedrysoft/pingnoo)
+ *
+ * An open-source cross-platform traceroute analyser.
+ *
+ * Created by Adrian Carpenter on 18/10/2026.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch.hpp"
+#include "WindowedStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+constexpr auto WindowSampleCount = 10000;
+constexpr auto WindowSize = 60.0;
+
+/**
+ * @brief       Returns a repeatable latency for a simulated sample.
+ *
+ * @param[in]   index the index of the sample.
+ *
+ * @returns     the latency in seconds; -1 if the request was lost.
+ */
+static auto simulatedLatency(int index) -> double {
+    if (index % 17 == 0) {
+        return -1;
+    }
+
+    return 0.005 + static_cast<double>((index * 7919) % 1000) / 10000.0;
+}
+
+TEST_CASE("WindowedStatistics Tests", "[app][components][routeanalyser]") {
+    SECTION("an empty window has no statistics") {
+        Nedrysoft::RouteAnalyser::WindowedStatistics statistics;
+
+        REQUIRE_MESSAGE(statistics.minimum() == -1, "An empty window returned a minimum.");
+        REQUIRE_MESSAGE(statistics.maximum() == -1, "An empty window returned a maximum.");
+        REQUIRE_MESSAGE(statistics.average() == -1, "An empty window returned an average.");
+        REQUIRE_MESSAGE(statistics.packetLoss() == -1, "An empty window returned a packet loss.");
+
+        statistics.add(1, -1);
+
+        REQUIRE_MESSAGE(statistics.minimum() == -1, "A window without replies returned a minimum.");
+        REQUIRE_MESSAGE(statistics.average() == -1, "A window without replies returned an average.");
+        REQUIRE_MESSAGE(statistics.packetLoss() == 100, "A window without replies did not report all as lost.");
+    }
+
+    SECTION("the statistics match a scan of the window") {
+        Nedrysoft::RouteAnalyser::WindowedStatistics statistics(WindowSize);
+
+        // the samples are half a second apart, so each window holds about 120 samples.
+
+        for (auto index = 0; index < WindowSampleCount; index++) {
+            auto time = index * 0.5;
+
+            statistics.add(time, simulatedLatency(index));
+
+            if (index % 97 != 96) {
+                continue;
+            }
+
+            auto minimum = -1.0, maximum = -1.0, sum = 0.0;
+            auto replies = 0, lost = 0;
+
+            for (auto previous = index; (previous >= 0) && (previous * 0.5 >= time - WindowSize); previous--) {
+                auto latency = simulatedLatency(previous);
+
+                if (latency < 0) {
+                    lost++;
+
+                    continue;
+                }
+
+                minimum = (minimum < 0) ? latency : std::min(minimum, latency);
+                maximum = std::max(maximum, latency);
+                sum += latency;
+                replies++;
+            }
+
+            REQUIRE_MESSAGE(std::abs(statistics.minimum() - minimum) < 1e-6, "The minimum did not match the window.");
+            REQUIRE_MESSAGE(std::abs(statistics.maximum() - maximum) < 1e-6, "The maximum did not match the window.");
+            REQUIRE_MESSAGE(
+                    std::abs(statistics.average() - (sum / replies)) < 1e-6,
+                    "The average did not match the window." );
+            REQUIRE_MESSAGE(
+                    std::abs(statistics.packetLoss() - (100.0 * lost / (replies + lost))) < 1e-9,
+                    "The packet loss did not match the window." );
+        }
+    }
+
+    SECTION("the extremes are evicted when they leave the window") {
+        Nedrysoft::RouteAnalyser::WindowedStatistics statistics(10);
+
+        statistics.add(0, 0.100);
+        statistics.add(1, 0.001);
+        statistics.add(2, 0.020);
+
+        REQUIRE_MESSAGE(statistics.maximum() == 0.100, "The maximum was not the largest latency.");
+        REQUIRE_MESSAGE(statistics.minimum() == 0.001, "The minimum was not the smallest latency.");
+
+        statistics.add(10.5, 0.030);
+
+        REQUIRE_MESSAGE(statistics.maximum() == 0.030, "The maximum was kept after it left the window.");
+
+        statistics.add(11.5, 0.025);
+
+        REQUIRE_MESSAGE(statistics.minimum() == 0.020, "The minimum was kept after it left the window.");
+    }
+
+    SECTION("a late sample does not move the window back") {
+        Nedrysoft::RouteAnalyser::WindowedStatistics statistics(10);
+
+        statistics.add(0, 0.100);
+        statistics.add(20, 0.010);
+        statistics.add(15, -1);
+
+        REQUIRE_MESSAGE(statistics.maximum() == 0.010, "A late sample restored an expired sample.");
+        REQUIRE_MESSAGE(statistics.packetLoss() == 50, "A late sample inside the window was not counted.");
+
+        statistics.add(31, 0.020);
+
+        REQUIRE_MESSAGE(statistics.packetLoss() == 0, "A late sample was kept after it left the window.");
+
+        // the window is measured back from the latest sample, not from the sample that was added last.
+
+        statistics.setWindowSize(30);
+        statistics.add(39, 0.005);
+        statistics.add(45, 0.030);
+        statistics.add(38, -1);
+        statistics.setWindowSize(5);
+
+        REQUIRE_MESSAGE(statistics.minimum() == 0.030, "The window was measured back from a late sample.");
+    }
+
+    SECTION("reducing the window size evicts samples") {
+        Nedrysoft::RouteAnalyser::WindowedStatistics statistics(WindowSize);
+
+        for (auto index = 0; index < 60; index++) {
+            statistics.add(index, (index < 30) ? -1 : 0.010);
+        }
+
+        REQUIRE_MESSAGE(statistics.packetLoss() == 50, "The packet loss did not cover the window.");
+
+        statistics.setWindowSize(20);
+
+        REQUIRE_MESSAGE(statistics.windowSize() == 20, "The window size was not changed.");
+        REQUIRE_MESSAGE(statistics.packetLoss() == 0, "Samples outside of the smaller window were kept.");
+
+        statistics.clear();
+
+        REQUIRE_MESSAGE(statistics.packetLoss() == -1, "Samples were kept after the window was cleared.");
+    }
+}
@@ -26,6 +26,7 @@
 
 #include <QString>
 #include <QHostAddress>
+#include <QtEndian>
 
 TEST_CASE("ICMPPacket Tests", "[app][libs][network]") {
     QByteArray testData = QString("This Is A Test Of The ICMP Checksum Routine").toLatin1();
@@ -35,4 +36,175 @@ TEST_CASE("ICMPPacket Tests", "[app][libs][network]") {
 
         REQUIRE_MESSAGE(checksum==0x38D1, "ICMP checksum was calculated incorrectly.");
     }
+
+    SECTION("ping packet carries the supplied payload") {
+        auto packet = Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
+                1234,
+                1,
+                testData,
+                QHostAddress("127.0.0.1"),
+                Nedrysoft::ICMPPacket::V4 );
+
+        REQUIRE_MESSAGE(packet.size()==testData.size()+8, "ICMP packet length was incorrect.");
+        REQUIRE_MESSAGE(packet.mid(8)==testData, "ICMP packet payload was incorrect.");
+        REQUIRE_MESSAGE(
+                Nedrysoft::ICMPPacket::ICMPPacket::checksum(packet.data(), packet.length())==0,
+                "ICMP packet checksum was incorrect." );
+
+        auto packet_v6 = Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
+                1234,
+                1,
+                testData,
+                QHostAddress("::1"),
+                Nedrysoft::ICMPPacket::V6 );
+
+        REQUIRE_MESSAGE(packet_v6.size()==testData.size()+8, "ICMPv6 packet length was incorrect.");
+        REQUIRE_MESSAGE(packet_v6.mid(8)==testData, "ICMPv6 packet payload was incorrect.");
+    }
+
+    SECTION("path mtu probes are the tested size on the wire") {
+        constexpr auto IPv4HeaderSize = 20;
+        constexpr auto IPv6HeaderSize = 40;
+
+        for (auto probeSize : {68, 576, 1492, 1500, 9000}) {
+            auto packet = Nedrysoft::ICMPPacket::ICMPPacket::pingPacketOfSize(
+                    1234,
+                    1,
+                    probeSize,
+                    QHostAddress("127.0.0.1"),
+                    Nedrysoft::ICMPPacket::V4 );
+
+            REQUIRE_MESSAGE(packet.size()+IPv4HeaderSize==probeSize, "IPv4 probe size was incorrect.");
+        }
+
+        for (auto probeSize : {1280, 1500, 9000}) {
+            auto packet = Nedrysoft::ICMPPacket::ICMPPacket::pingPacketOfSize(
+                    1234,
+                    1,
+                    probeSize,
+                    QHostAddress("::1"),
+                    Nedrysoft::ICMPPacket::V6 );
+
+            REQUIRE_MESSAGE(packet.size()+IPv6HeaderSize==probeSize, "IPv6 probe size was incorrect.");
+        }
+
+        auto packet = Nedrysoft::ICMPPacket::ICMPPacket::pingPacketOfSize(
+                1234,
+                1,
+                IPv4HeaderSize,
+                QHostAddress("127.0.0.1"),
+                Nedrysoft::ICMPPacket::V4 );
+
+        REQUIRE_MESSAGE(packet.isEmpty(), "A probe smaller than the headers was created.");
+    }
+
+    SECTION("port unreachable quoting a udp probe is decoded") {
+        const unsigned char response[] = {
+            0x45, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00,     // ip header
+            0x7F, 0x00, 0x00, 0x01, 0x7F, 0x00, 0x00, 0x01,
+            0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,                             // port unreachable
+            0x45, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x00, 0x00,     // quoted ip header
+            0x7F, 0x00, 0x00, 0x01, 0x7F, 0x00, 0x00, 0x01,
+            0x9C, 0x40, 0x82, 0x9A, 0x00, 0x10, 0x00, 0x00                              // quoted udp header
+        };
+
+        auto packet = Nedrysoft::ICMPPacket::ICMPPacket::fromData(
+                QByteArray(reinterpret_cast<const char *>(response), sizeof(response)),
+                Nedrysoft::ICMPPacket::V4 );
+
+        REQUIRE_MESSAGE(packet.resultCode()==Nedrysoft::ICMPPacket::PortUnreachable, "Result code was incorrect.");
+        REQUIRE_MESSAGE(packet.protocol()==Nedrysoft::ICMPPacket::UDP, "Quoted protocol was incorrect.");
+        REQUIRE_MESSAGE(packet.id()==40000, "UDP source port was not decoded as the id.");
+        REQUIRE_MESSAGE(packet.sequence()==33434, "UDP destination port was not decoded as the sequence.");
+    }
+
+    SECTION("packet too big is decoded and truncated errors are rejected") {
+        const unsigned char response[] = {
+            0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00,                             // packet too big, mtu 1280
+            0x60, 0x00, 0x00, 0x00, 0x05, 0xD8, 0x3A, 0x40,                             // quoted ipv6 header
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+            0x80, 0x00, 0x00, 0x00, 0x04, 0xD2, 0x00, 0x2A                              // quoted echo request
+        };
+
+        auto packet = Nedrysoft::ICMPPacket::ICMPPacket::fromData(
+                QByteArray(reinterpret_cast<const char *>(response), sizeof(response)),
+                Nedrysoft::ICMPPacket::V6 );
+
+        REQUIRE_MESSAGE(packet.resultCode()==Nedrysoft::ICMPPacket::FragmentationNeeded, "Result code was incorrect.");
+        REQUIRE_MESSAGE(packet.mtu()==1280, "Next hop MTU was incorrect.");
+        REQUIRE_MESSAGE(packet.id()==1234, "Quoted id was incorrect.");
+        REQUIRE_MESSAGE(packet.sequence()==42, "Quoted sequence was incorrect.");
+
+        for (auto length : {4, 8, 47, 55}) {
+            auto truncatedPacket = Nedrysoft::ICMPPacket::ICMPPacket::fromData(
+                    QByteArray(reinterpret_cast<const char *>(response), length),
+                    Nedrysoft::ICMPPacket::V6 );
+
+            REQUIRE_MESSAGE(
+                    truncatedPacket.resultCode()==Nedrysoft::ICMPPacket::Invalid,
+                    "A truncated error was decoded." );
+        }
+    }
+
+    SECTION("syn-ack acknowledging a tcp syn probe is decoded") {
+        auto synPacket = Nedrysoft::ICMPPacket::ICMPPacket::tcpSynPacket(
+                1234,
+                5678,
+                443,
+                QHostAddress("::1"),
+                QHostAddress("::1"),
+                Nedrysoft::ICMPPacket::V6 );
+
+        REQUIRE_MESSAGE(synPacket.size()==20, "TCP SYN packet length was incorrect.");
+
+        auto synAckPacket = synPacket;
+
+        auto acknowledgement = qToBigEndian<uint32_t>(qFromBigEndian<uint32_t>(synPacket.constData()+4)+1);
+
+        memcpy(synAckPacket.data()+8, &acknowledgement, sizeof(acknowledgement));
+
+        synAckPacket[13] = 0x12;
+
+        auto packet = Nedrysoft::ICMPPacket::ICMPPacket::fromTCPData(synAckPacket, Nedrysoft::ICMPPacket::V6);
+
+        REQUIRE_MESSAGE(packet.resultCode()==Nedrysoft::ICMPPacket::SynAck, "Result code was incorrect.");
+        REQUIRE_MESSAGE(packet.protocol()==Nedrysoft::ICMPPacket::TCP, "Protocol was incorrect.");
+        REQUIRE_MESSAGE(packet.id()==1234, "TCP acknowledgement was not decoded as the id.");
+        REQUIRE_MESSAGE(packet.sequence()==5678, "TCP acknowledgement was not decoded as the sequence.");
+
+        auto synOnlyPacket = Nedrysoft::ICMPPacket::ICMPPacket::fromTCPData(synPacket, Nedrysoft::ICMPPacket::V6);
+
+        REQUIRE_MESSAGE(synOnlyPacket.resultCode()==Nedrysoft::ICMPPacket::Invalid, "SYN was decoded as a reply.");
+    }
+
+    SECTION("datagram socket replies and errors are decoded") {
+        auto request = Nedrysoft::ICMPPacket::ICMPPacket::pingPacket(
+                4321,
+                99,
+                testData,
+                QHostAddress("127.0.0.1"),
+                Nedrysoft::ICMPPacket::V4 );
+
+        auto timeExceeded = Nedrysoft::ICMPPacket::ICMPPacket::fromSocketError(
+                request,
+                11,
+                0,
+                0,
+                Nedrysoft::ICMPPacket::V4 );
+
+        REQUIRE_MESSAGE(timeExceeded.resultCode()==Nedrysoft::ICMPPacket::TimeExceeded, "Error was not decoded.");
+        REQUIRE_MESSAGE(timeExceeded.id()==4321, "Error id was incorrect.");
+        REQUIRE_MESSAGE(timeExceeded.sequence()==99, "Error sequence was incorrect.");
+
+        auto reply = request;
+
+        reply[0] = 0;
+
+        auto echoReply = Nedrysoft::ICMPPacket::ICMPPacket::fromDatagramData(reply, Nedrysoft::ICMPPacket::V4);
+
+        REQUIRE_MESSAGE(echoReply.resultCode()==Nedrysoft::ICMPPacket::EchoReply, "Echo reply was not decoded.");
+        REQUIRE_MESSAGE(echoReply.id()==4321, "Echo reply id was incorrect.");
+        REQUIRE_MESSAGE(echoReply.sequence()==99, "Echo reply sequence was incorrect.");
+    }
 }